@@ -0,0 +1,5 @@
+// revbench: see revbench_sst.h
+#ifndef _SST_REVBENCH_MODEL_ELEMENT_PYTHON_H_
+#define _SST_REVBENCH_MODEL_ELEMENT_PYTHON_H_
+#include "../revbench_sst.h"
+#endif
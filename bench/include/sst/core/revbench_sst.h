@@ -0,0 +1,521 @@
+//
+// _revbench_sst_h_
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+// Minimal host-side implementation of the SST core interfaces used by the
+// RevCPU hot paths.  This is only sufficient to construct and drive the
+// Rev objects from the revbench microbenchmarks; it is not a simulator.
+//
+
+#ifndef _SST_REVBENCH_SST_H_
+#define _SST_REVBENCH_SST_H_
+
+#include <atomic>
+#include <cinttypes>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#define CALL_INFO __LINE__, __FILE__, __FUNCTION__
+
+#define SST_ELI_DOCUMENT_PARAMS(...)
+#define SST_ELI_DOCUMENT_STATISTICS(...)
+#define SST_ELI_DOCUMENT_PORTS(...)
+#define SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(...)
+#define SST_ELI_REGISTER_COMPONENT(...)
+#define SST_ELI_REGISTER_SUBCOMPONENT_API(...)
+#define SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(...)
+#define SST_ELI_REGISTER_SUBCOMPONENT(...)
+#define SST_ELI_ELEMENT_VERSION(...) 0
+#define SST_ELI_REGISTER_PYTHON_MODULE(...)
+#define SST_ELI_EXPORT(...)
+#define COMPONENT_CATEGORY_PROCESSOR 0
+#define ImplementSerializable(x)
+
+namespace SST {
+
+typedef uint64_t ComponentId_t;
+typedef uint64_t Cycle_t;
+typedef uint64_t SimTime_t;
+
+class Output {
+public:
+  enum output_location_t { NONE, STDOUT, STDERR, FILE };
+
+  Output() : verbosity(0) {}
+  Output(const std::string& Prefix, uint32_t Verbosity, uint32_t, output_location_t)
+    : prefix(Prefix), verbosity(Verbosity) {}
+
+  void init(const std::string& Prefix, uint32_t Verbosity, uint32_t, output_location_t){
+    prefix = Prefix;
+    verbosity = Verbosity;
+  }
+
+  void verbose(uint32_t, const char*, const char*, uint32_t Level, uint32_t,
+               const char* Fmt, ...) const __attribute__((format(printf,7,8))) {
+    if( Level > verbosity )
+      return ;
+    va_list Args;
+    va_start(Args, Fmt);
+    vprintf(Fmt, Args);
+    va_end(Args);
+  }
+
+  void fatal(uint32_t Line, const char* File, const char* Func, int Code,
+             const char* Fmt, ...) const __attribute__((format(printf,6,7))) {
+    fprintf(stderr, "FATAL: %s:%u (%s): ", File, Line, Func);
+    va_list Args;
+    va_start(Args, Fmt);
+    vfprintf(stderr, Fmt, Args);
+    va_end(Args);
+    exit(Code);
+  }
+
+  void output(const char* Fmt, ...) const __attribute__((format(printf,2,3))) {
+    va_list Args;
+    va_start(Args, Fmt);
+    vprintf(Fmt, Args);
+    va_end(Args);
+  }
+
+  uint32_t getVerboseLevel() const { return verbosity; }
+
+private:
+  std::string prefix;
+  uint32_t verbosity;
+};
+
+class Params {
+public:
+  template<class T> T find(const std::string& Key, T Def) const {
+    auto it = values.find(Key);
+    if( it == values.end() )
+      return Def;
+    return convert<T>(it->second);
+  }
+  template<class T> T find(const std::string& Key, const char* Def) const {
+    auto it = values.find(Key);
+    return convert<T>(it == values.end() ? std::string(Def) : it->second);
+  }
+  template<class T> T find(const std::string& Key) const {
+    auto it = values.find(Key);
+    return (it == values.end()) ? T() : convert<T>(it->second);
+  }
+  template<class T> void find_array(const std::string& Key, std::vector<T>& Out) const {
+    Out.clear();
+    auto it = values.find(Key);
+    if( it == values.end() )
+      return ;
+    std::string S = it->second;
+    for( char &C : S ){
+      if( (C == '[') || (C == ']') || (C == ',') )
+        C = ' ';
+    }
+    std::istringstream In(S);
+    std::string Tok;
+    while( In >> Tok )
+      Out.push_back(convert<T>(Tok));
+  }
+  bool contains(const std::string& Key) const { return values.count(Key) != 0; }
+  void insert(const std::string& Key, const std::string& Value, bool=true){ values[Key] = Value; }
+
+private:
+  std::map<std::string,std::string> values;
+
+  template<class T> static T convert(const std::string& S){
+    std::istringstream In(S);
+    T V = T();
+    In >> V;
+    return V;
+  }
+};
+
+template<> inline std::string Params::convert<std::string>(const std::string& S){ return S; }
+template<> inline bool Params::convert<bool>(const std::string& S){
+  return (S == "1") || (S == "true") || (S == "True") || (S == "TRUE");
+}
+
+class TimeConverter { public: SimTime_t getFactor(){ return 1; } };
+
+namespace Core { namespace Serialization {
+class serializer { public: template<class T> serializer& operator&(T&){ return *this; } };
+} }
+
+class Event {
+public:
+  Event(){}
+  virtual ~Event(){}
+  virtual Event* clone(){ return nullptr; }
+  virtual void serialize_order(Core::Serialization::serializer&){}
+
+  class HandlerBase {
+  public:
+    virtual ~HandlerBase(){}
+    virtual void operator()(Event*) = 0;
+  };
+  template<class C, class D=void> class Handler : public HandlerBase {
+  public:
+    Handler(C* O, void (C::*F)(Event*)) : obj(O), func(F) {}
+    void operator()(Event* E) override { (obj->*func)(E); }
+  private:
+    C* obj;
+    void (C::*func)(Event*);
+  };
+};
+
+class Link {
+public:
+  void send(Event* E){ delete E; }
+  Event* recv(){ return nullptr; }
+  void sendUntimedData(Event* E){ delete E; }
+  Event* recvUntimedData(){ return nullptr; }
+};
+
+namespace Clock {
+  class HandlerBase { public: virtual ~HandlerBase(){} };
+  template<class C, class D=void> class Handler : public HandlerBase {
+  public: Handler(C*, bool (C::*)(Cycle_t)){} };
+}
+
+template<class T> class Statistic {
+public:
+  Statistic() : count(0), sum(T()) {}
+  void addData(T V){ count++; sum += V; }
+  uint64_t getCollectionCount() const { return count; }
+  T getSum() const { return sum; }
+private:
+  uint64_t count;
+  T sum;
+};
+namespace Statistics { template<class T> class AccumulatorStatistic; }
+
+class ComponentInfo {
+public:
+  enum { SHARE_NONE=0, SHARE_PORTS=1, SHARE_STATS=2, INSERT_STATS=4 };
+};
+
+class SubComponent;
+
+namespace RevBench {
+  /// builds the subcomponent for a slot from the handler passed by the parent
+  typedef std::function<SubComponent*(void *Handler)> SlotFactory;
+
+  /// slot name to factory; filled in by the benchmark before the parent is built
+  inline std::map<std::string,SlotFactory>& Slots(){
+    static std::map<std::string,SlotFactory> S;
+    return S;
+  }
+}
+
+class BaseComponent {
+public:
+  BaseComponent(ComponentId_t Id) : id(Id) {}
+  virtual ~BaseComponent(){
+    for( auto S : stats )
+      S.second();
+  }
+
+  TimeConverter* registerClock(const std::string&, Clock::HandlerBase* H, bool=true){
+    delete H;
+    return nullptr;
+  }
+  TimeConverter* getTimeConverter(const std::string&){ return nullptr; }
+
+  template<class T> Statistic<T>* registerStatistic(const std::string& Name, const std::string& ="") {
+    Statistic<T> *S = new Statistic<T>();
+    stats.push_back(std::make_pair(Name, [S](){ delete S; }));
+    return S;
+  }
+
+  template<class T> T* loadUserSubComponent(const std::string& Slot){
+    return loadSlot<T>(Slot, nullptr);
+  }
+  template<class T, class H> T* loadUserSubComponent(const std::string& Slot, uint64_t,
+                                                     TimeConverter*, H* Handler){
+    return loadSlot<T>(Slot, (void *)(Handler));
+  }
+  template<class T, class... A> T* loadUserSubComponent(const std::string& Slot, uint64_t, A...){
+    return loadSlot<T>(Slot, nullptr);
+  }
+  template<class T, class... A> T* loadAnonymousSubComponent(const std::string&, const std::string&,
+                                                            int, uint64_t, Params&, A...){
+    return nullptr;
+  }
+
+  Link* configureLink(const std::string&, Event::HandlerBase* =nullptr){ return nullptr; }
+  Link* configureLink(const std::string&, const std::string&, Event::HandlerBase* =nullptr){ return nullptr; }
+  const std::string& getName() const { static std::string s("revbench"); return s; }
+  SimTime_t getCurrentSimCycle() const { return 0; }
+  SimTime_t getCurrentSimTime(TimeConverter*) const { return 0; }
+  SimTime_t getCurrentSimTimeNano() const { return 0; }
+  bool isPortConnected(const std::string&) const { return false; }
+  ComponentId_t getId() const { return id; }
+
+private:
+  ComponentId_t id;
+  std::vector<std::pair<std::string,std::function<void()>>> stats;
+
+  template<class T> T* loadSlot(const std::string& Slot, void *Handler);
+};
+
+class Component : public BaseComponent {
+public:
+  Component(ComponentId_t id) : BaseComponent(id){}
+  virtual void init(unsigned int){}
+  virtual void setup(){}
+  virtual void finish(){}
+  void registerAsPrimaryComponent(){}
+  void primaryComponentDoNotEndSim(){}
+  void primaryComponentOKToEndSim(){}
+};
+
+class SubComponent : public BaseComponent {
+public:
+  SubComponent(ComponentId_t id) : BaseComponent(id){}
+  virtual void init(unsigned int){}
+  virtual void setup(){}
+  virtual void finish(){}
+};
+
+template<class T> T* BaseComponent::loadSlot(const std::string& Slot, void *Handler){
+  auto it = RevBench::Slots().find(Slot);
+  if( it == RevBench::Slots().end() )
+    return nullptr;
+  return dynamic_cast<T*>(it->second(Handler));
+}
+
+namespace Interfaces {
+
+class StandardMem : public SubComponent {
+public:
+  StandardMem() : SubComponent(0){}
+
+  class Request;
+  class RequestHandler;
+  class ReadResp;
+  class WriteResp;
+  class FlushResp;
+  class CustomResp;
+  class InvNotify;
+
+  class Request {
+  public:
+    typedef uint64_t id_t;
+    typedef uint32_t flags_t;
+    Request(flags_t F=0) : id(nextID()), flags(F) {}
+    Request(id_t Id, flags_t F) : id(Id), flags(F) {}
+    virtual ~Request(){}
+    id_t getID(){ return id; }
+    flags_t getAllFlags(){ return flags; }
+    bool getFail(){ return (flags & (1 << 2)) != 0; }   // StandardMem::Request::Flag::F_FAIL
+    virtual Request* makeResponse(){ return nullptr; }
+    virtual void handle(RequestHandler*){}
+  protected:
+    id_t id;
+    flags_t flags;
+  private:
+    static id_t nextID(){
+      static std::atomic<id_t> Next(0);
+      return Next++;
+    }
+  };
+
+  class ReadResp : public Request {
+  public:
+    ReadResp(id_t Id, uint64_t P, uint64_t S, std::vector<uint8_t> D, flags_t F=0,
+             uint64_t V=0, uint64_t I=0, uint32_t T=0)
+      : Request(Id,F), pAddr(P), vAddr(V), size(S), data(D), iPtr(I), tid(T) {}
+    void handle(RequestHandler* H) override;
+    uint64_t pAddr; uint64_t vAddr; uint64_t size; std::vector<uint8_t> data;
+    uint64_t iPtr; uint32_t tid;
+  };
+
+  class Read : public Request {
+  public:
+    Read(uint64_t P, uint64_t S, flags_t F=0, uint64_t V=0, uint64_t I=0, uint32_t T=0)
+      : Request(F), pAddr(P), vAddr(V), size(S), iPtr(I), tid(T) {}
+    Request* makeResponse() override {
+      return new ReadResp(id, pAddr, size, std::vector<uint8_t>(size, 0), flags, vAddr, iPtr, tid);
+    }
+    uint64_t pAddr; uint64_t vAddr; uint64_t size; uint64_t iPtr; uint32_t tid;
+  };
+
+  class WriteResp : public Request {
+  public:
+    WriteResp(id_t Id, uint64_t P, uint64_t S, flags_t F=0, uint64_t V=0, uint64_t I=0, uint32_t T=0)
+      : Request(Id,F), pAddr(P), vAddr(V), size(S), iPtr(I), tid(T) {}
+    void handle(RequestHandler* H) override;
+    uint64_t pAddr; uint64_t vAddr; uint64_t size; uint64_t iPtr; uint32_t tid;
+  };
+
+  class Write : public Request {
+  public:
+    Write(uint64_t P, uint64_t S, std::vector<uint8_t> D, bool P2=false, flags_t F=0,
+          uint64_t V=0, uint64_t I=0, uint32_t T=0)
+      : Request(F), pAddr(P), vAddr(V), size(S), data(D), posted(P2), iPtr(I), tid(T) {}
+    Write(uint64_t P, uint64_t S, std::vector<uint8_t> D, flags_t F)
+      : Request(F), pAddr(P), vAddr(0), size(S), data(D), posted(false), iPtr(0), tid(0) {}
+    Request* makeResponse() override {
+      return new WriteResp(id, pAddr, size, flags, vAddr, iPtr, tid);
+    }
+    uint64_t pAddr; uint64_t vAddr; uint64_t size; std::vector<uint8_t> data;
+    bool posted; uint64_t iPtr; uint32_t tid;
+  };
+
+  class FlushResp : public Request {
+  public:
+    FlushResp(id_t Id, flags_t F=0) : Request(Id,F) {}
+    void handle(RequestHandler* H) override;
+  };
+  class FlushAddr : public Request {
+  public:
+    FlushAddr(uint64_t, uint64_t, bool, uint32_t, flags_t F=0) : Request(F) {}
+    Request* makeResponse() override { return new FlushResp(id, flags); }
+  };
+
+  class ReadLock : public Request {
+  public:
+    ReadLock(uint64_t P, uint64_t S, flags_t F=0) : Request(F), pAddr(P), size(S) {}
+    Request* makeResponse() override {
+      return new ReadResp(id, pAddr, size, std::vector<uint8_t>(size, 0), flags);
+    }
+    uint64_t pAddr; uint64_t size;
+  };
+  class WriteUnlock : public Request {
+  public:
+    WriteUnlock(uint64_t P, uint64_t S, std::vector<uint8_t>, bool=false, flags_t F=0)
+      : Request(F), pAddr(P), size(S) {}
+    Request* makeResponse() override { return new WriteResp(id, pAddr, size, flags); }
+    uint64_t pAddr; uint64_t size;
+  };
+  class LoadLink : public Request {
+  public:
+    LoadLink(uint64_t P, uint64_t S, flags_t F=0) : Request(F), pAddr(P), size(S) {}
+    Request* makeResponse() override {
+      return new ReadResp(id, pAddr, size, std::vector<uint8_t>(size, 0), flags);
+    }
+    uint64_t pAddr; uint64_t size;
+  };
+  class StoreConditional : public Request {
+  public:
+    StoreConditional(uint64_t P, uint64_t S, std::vector<uint8_t>, flags_t F=0)
+      : Request(F), pAddr(P), size(S) {}
+    Request* makeResponse() override { return new WriteResp(id, pAddr, size, flags); }
+    uint64_t pAddr; uint64_t size;
+  };
+
+  class CustomData { public: virtual ~CustomData(){} };
+  class CustomResp : public Request {
+  public:
+    CustomResp(id_t Id, flags_t F=0) : Request(Id,F) {}
+    void handle(RequestHandler* H) override;
+  };
+  class CustomReq : public Request {
+  public:
+    CustomReq(CustomData*, flags_t F=0) : Request(F) {}
+    Request* makeResponse() override { return new CustomResp(id, flags); }
+  };
+  class InvNotify : public Request {
+  public:
+    InvNotify() : Request(0) {}
+    void handle(RequestHandler* H) override;
+  };
+
+  class RequestHandler {
+  public:
+    RequestHandler(Output* O) : out(O) {}
+    virtual ~RequestHandler(){}
+    virtual void handle(ReadResp*){}
+    virtual void handle(WriteResp*){}
+    virtual void handle(FlushResp*){}
+    virtual void handle(CustomResp*){}
+    virtual void handle(InvNotify*){}
+  protected:
+    Output* out;
+  };
+
+  class HandlerBase {
+  public:
+    virtual ~HandlerBase(){}
+    virtual void operator()(Request*) = 0;
+  };
+  template<class C, class D=void> class Handler : public HandlerBase {
+  public:
+    Handler(C* O, void (C::*F)(Request*)) : obj(O), func(F) {}
+    void operator()(Request* R) override { (obj->*func)(R); }
+  private:
+    C* obj;
+    void (C::*func)(Request*);
+  };
+
+  virtual void init(unsigned int){}
+  virtual void setup(){}
+  virtual void send(Request*) = 0;
+  virtual void sendUntimedData(Request* R){ delete R; }
+  virtual Request* recvUntimedData(){ return nullptr; }
+  virtual uint64_t getLineSize(){ return 0; }
+};
+
+inline void StandardMem::ReadResp::handle(RequestHandler* H){ H->handle(this); }
+inline void StandardMem::WriteResp::handle(RequestHandler* H){ H->handle(this); }
+inline void StandardMem::FlushResp::handle(RequestHandler* H){ H->handle(this); }
+inline void StandardMem::CustomResp::handle(RequestHandler* H){ H->handle(this); }
+inline void StandardMem::InvNotify::handle(RequestHandler* H){ H->handle(this); }
+
+class SimpleNetwork : public SubComponent {
+public:
+  SimpleNetwork() : SubComponent(0){}
+  typedef int64_t nid_t;
+  static const nid_t INIT_BROADCAST_ADDR = -1;
+  class Request {
+  public:
+    Request() : dest(0), src(0), vn(0), size_in_bits(0), head(false), tail(false), payload(nullptr) {}
+    Request(nid_t D, nid_t S, size_t B, bool H, bool T, Event* P=nullptr)
+      : dest(D), src(S), vn(0), size_in_bits(B), head(H), tail(T), payload(P) {}
+    ~Request(){ delete payload; }
+    void givePayload(Event* P){ payload = P; }
+    Event* takePayload(){ Event* P = payload; payload = nullptr; return P; }
+    nid_t dest, src;
+    int vn;
+    size_t size_in_bits;
+    bool head, tail;
+  private:
+    Event* payload;
+  };
+  class HandlerBase { public: virtual ~HandlerBase(){} };
+  template<class C, class D=void> class Handler : public HandlerBase {
+  public: Handler(C*, bool (C::*)(int)){} };
+  virtual bool send(Request* R, int){ delete R; return true; }
+  virtual Request* recv(int){ return nullptr; }
+  virtual void sendUntimedData(Request* R){ delete R; }
+  virtual Request* recvUntimedData(){ return nullptr; }
+  virtual bool spaceToSend(int, int){ return true; }
+  virtual void sendInitData(Request* R){ delete R; }
+  virtual Request* recvInitData(){ return nullptr; }
+  virtual bool requestToReceive(int){ return false; }
+  virtual void setNotifyOnReceive(HandlerBase*){}
+  virtual bool isNetworkInitialized() const { return true; }
+  virtual nid_t getEndpointID() const { return 0; }
+  virtual void init(unsigned int){}
+  virtual void setup(){}
+};
+
+} // namespace Interfaces
+} // namespace SST
+
+#endif // _SST_REVBENCH_SST_H_
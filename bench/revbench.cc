@@ -0,0 +1,502 @@
+//
+// _revbench_cc_
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+// Host-side microbenchmarks for the RevCPU hot paths.  Each benchmark
+// drives the simulator objects directly with a fixed input and reports
+// the host time per operation.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "../include/RevMem.h"
+#include "../include/RevMemCtrl.h"
+#include "../include/RevLoader.h"
+#include "../include/RevOpts.h"
+#include "../include/RevPrefetcher.h"
+#include "../include/RevProc.h"
+#include "../include/PanNet.h"
+
+using namespace SST;
+using namespace SST::RevCPU;
+
+#define REVBENCH_MEM_SIZE   (64ull * 1024ull * 1024ull)
+#define REVBENCH_CODE_BASE  0x20000ull
+#define REVBENCH_DATA_BASE  0x100000ull
+#define REVBENCH_DATA_SIZE  (1ull * 1024ull * 1024ull)
+
+// ------------------------------------------------------------------------
+// Benchmark harness
+// ------------------------------------------------------------------------
+/// RevBench: a single microbenchmark; Body runs Ops operations per call
+typedef struct{
+  std::string Name;                   ///< RevBench: benchmark name
+  uint64_t Ops;                       ///< RevBench: operations per call of Body
+  std::function<void()> Body;         ///< RevBench: benchmark kernel
+}RevBenchCase;
+
+/// RevBench: run a benchmark; returns the best ns/op over Reps repetitions
+static double RunBench(const RevBenchCase &B, double MinSecs, unsigned Reps, uint64_t &TotalOps){
+  // warm up the caches and size the batch to the minimum run time
+  uint64_t Calls = 1;
+  for(;;){
+    auto Start = std::chrono::steady_clock::now();
+    for( uint64_t i=0; i<Calls; i++ ){
+      B.Body();
+    }
+    double Secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+    if( Secs >= (MinSecs / 4.0) ){
+      Calls = std::max<uint64_t>(1, (uint64_t)((double)(Calls) * MinSecs / Secs));
+      break;
+    }
+    Calls *= 2;
+  }
+
+  double Best = 0.0;
+  TotalOps = 0x00ull;
+  for( unsigned r=0; r<Reps; r++ ){
+    auto Start = std::chrono::steady_clock::now();
+    for( uint64_t i=0; i<Calls; i++ ){
+      B.Body();
+    }
+    double Secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+    double NsOp = (Secs * 1.0e9) / (double)(Calls * B.Ops);
+    if( (r == 0) || (NsOp < Best) ){
+      Best = NsOp;
+    }
+    TotalOps += Calls * B.Ops;
+  }
+  return Best;
+}
+
+// ------------------------------------------------------------------------
+// Fixed inputs
+// ------------------------------------------------------------------------
+static uint32_t EncR(uint32_t F7, uint32_t Rs2, uint32_t Rs1, uint32_t F3, uint32_t Rd, uint32_t Op){
+  return (F7 << 25) | (Rs2 << 20) | (Rs1 << 15) | (F3 << 12) | (Rd << 7) | Op;
+}
+
+static uint32_t EncI(int32_t Imm, uint32_t Rs1, uint32_t F3, uint32_t Rd, uint32_t Op){
+  return (((uint32_t)(Imm) & 0xFFF) << 20) | (Rs1 << 15) | (F3 << 12) | (Rd << 7) | Op;
+}
+
+static uint32_t EncS(int32_t Imm, uint32_t Rs2, uint32_t Rs1, uint32_t F3, uint32_t Op){
+  uint32_t I = (uint32_t)(Imm) & 0xFFF;
+  return ((I >> 5) << 25) | (Rs2 << 20) | (Rs1 << 15) | (F3 << 12) | ((I & 0x1F) << 7) | Op;
+}
+
+static uint32_t EncB(int32_t Imm, uint32_t Rs2, uint32_t Rs1, uint32_t F3){
+  uint32_t I = (uint32_t)(Imm) & 0x1FFF;
+  return (((I >> 12) & 1) << 31) | (((I >> 5) & 0x3F) << 25) | (Rs2 << 20) | (Rs1 << 15) |
+         (F3 << 12) | (((I >> 1) & 0xF) << 8) | (((I >> 11) & 1) << 7) | 0x63;
+}
+
+static uint32_t EncU(uint32_t Imm, uint32_t Rd, uint32_t Op){
+  return (Imm << 12) | (Rd << 7) | Op;
+}
+
+static uint32_t EncJ(int32_t Imm, uint32_t Rd){
+  uint32_t I = (uint32_t)(Imm) & 0x1FFFFF;
+  return (((I >> 20) & 1) << 31) | (((I >> 1) & 0x3FF) << 21) | (((I >> 11) & 1) << 20) |
+         (((I >> 12) & 0xFF) << 12) | (Rd << 7) | 0x6F;
+}
+
+/// RevBench: representative RV64GC instruction mix; 16bit entries are compressed
+static std::vector<uint32_t> InstMix(){
+  return {
+    EncI(1, 5, 0b000, 5, 0x13),             // addi   x5, x5, 1
+    EncR(0, 7, 5, 0b000, 6, 0x33),          // add    x6, x5, x7
+    EncI(16, 2, 0b011, 8, 0x03),            // ld     x8, 16(x2)
+    EncS(24, 8, 2, 0b011, 0x23),            // sd     x8, 24(x2)
+    0x0505,                                 // c.addi a0, 1
+    EncR(1, 7, 5, 0b000, 9, 0x33),          // mul    x9, x5, x7
+    EncI(3, 6, 0b001, 10, 0x13),            // slli   x10, x6, 3
+    EncI(0, 2, 0b010, 11, 0x03),            // lw     x11, 0(x2)
+    0x4505,                                 // c.li   a0, 1
+    EncU(0x12345, 12, 0x37),                // lui    x12, 0x12345
+    EncR(0, 11, 10, 0b111, 13, 0x33),       // and    x13, x10, x11
+    EncR(1, 3, 2, 0b111, 1, 0x53),          // fadd.d f1, f2, f3
+    0x852E,                                 // c.mv   a0, a1
+    EncI(8, 2, 0b011, 2, 0x07),             // fld    f2, 8(x2)
+    EncR(0, 5, 10, 0b010, 14, 0x2F),        // amoadd.w x14, x5, (x10)
+    EncB(8, 6, 5, 0b001),                   // bne    x5, x6, +8
+    EncJ(16, 1),                            // jal    x1, +16
+  };
+}
+
+/// RevBench: instruction length in bytes
+static unsigned InstLen(uint32_t Inst){
+  return ((Inst & 0b11) == 0b11) ? 4 : 2;
+}
+
+/// RevBench: lay out Count instructions from the mix; returns the image and the PC of each
+static std::vector<uint8_t> BuildCode(unsigned Count, std::vector<uint64_t> &PCs){
+  std::vector<uint32_t> Mix = InstMix();
+  std::vector<uint8_t> Code;
+  PCs.clear();
+  for( unsigned i=0; i<Count; i++ ){
+    uint32_t Inst = Mix[i % Mix.size()];
+    PCs.push_back(REVBENCH_CODE_BASE + Code.size());
+    for( unsigned b=0; b<InstLen(Inst); b++ ){
+      Code.push_back((uint8_t)(Inst >> (8*b)));
+    }
+  }
+  return Code;
+}
+
+/// RevBench: write a minimal RV64 executable holding Code at REVBENCH_CODE_BASE
+static bool WriteElf(const std::string &Path, const std::vector<uint8_t> &Code){
+  static const char ShStrTab[] = "\0.shstrtab\0.text";
+  const uint64_t CodeOff = sizeof(Elf64_Ehdr) + sizeof(Elf64_Phdr);
+  const uint64_t StrOff  = CodeOff + Code.size();
+  const uint64_t ShOff   = (StrOff + sizeof(ShStrTab) + 7) & ~7ull;
+
+  Elf64_Ehdr Eh;
+  memset(&Eh, 0, sizeof(Eh));
+  memcpy(Eh.e_ident, "\177ELF", 4);
+  Eh.e_ident[4]  = 2;                       // ELFCLASS64
+  Eh.e_ident[5]  = 1;                       // little endian
+  Eh.e_ident[6]  = 1;                       // EV_CURRENT
+  Eh.e_type      = 2;                       // ET_EXEC
+  Eh.e_machine   = 243;                     // EM_RISCV
+  Eh.e_version   = 1;
+  Eh.e_entry     = REVBENCH_CODE_BASE;
+  Eh.e_phoff     = sizeof(Elf64_Ehdr);
+  Eh.e_shoff     = ShOff;
+  Eh.e_ehsize    = sizeof(Elf64_Ehdr);
+  Eh.e_phentsize = sizeof(Elf64_Phdr);
+  Eh.e_phnum     = 1;
+  Eh.e_shentsize = sizeof(Elf64_Shdr);
+  Eh.e_shnum     = 3;
+  Eh.e_shstrndx  = 1;
+
+  Elf64_Phdr Ph;
+  memset(&Ph, 0, sizeof(Ph));
+  Ph.p_type   = PT_LOAD;
+  Ph.p_flags  = 0x5;                        // PF_R | PF_X
+  Ph.p_offset = CodeOff;
+  Ph.p_vaddr  = REVBENCH_CODE_BASE;
+  Ph.p_paddr  = REVBENCH_CODE_BASE;
+  Ph.p_filesz = Code.size();
+  Ph.p_memsz  = Code.size();
+  Ph.p_align  = 4;
+
+  Elf64_Shdr Sh[3];
+  memset(Sh, 0, sizeof(Sh));
+  Sh[1].sh_name   = 1;
+  Sh[1].sh_type   = 3;                      // SHT_STRTAB
+  Sh[1].sh_offset = StrOff;
+  Sh[1].sh_size   = sizeof(ShStrTab);
+  Sh[2].sh_name   = 11;
+  Sh[2].sh_type   = 1;                      // SHT_PROGBITS
+  Sh[2].sh_flags  = 0x6;                    // SHF_ALLOC | SHF_EXECINSTR
+  Sh[2].sh_addr   = REVBENCH_CODE_BASE;
+  Sh[2].sh_offset = CodeOff;
+  Sh[2].sh_size   = Code.size();
+
+  std::vector<uint8_t> Img(ShOff + sizeof(Sh), 0);
+  memcpy(&Img[0], &Eh, sizeof(Eh));
+  memcpy(&Img[sizeof(Eh)], &Ph, sizeof(Ph));
+  memcpy(&Img[CodeOff], Code.data(), Code.size());
+  memcpy(&Img[StrOff], ShStrTab, sizeof(ShStrTab));
+  memcpy(&Img[ShOff], Sh, sizeof(Sh));
+
+  FILE *F = fopen(Path.c_str(), "wb");
+  if( !F ){
+    return false;
+  }
+  bool Ok = (fwrite(Img.data(), 1, Img.size(), F) == Img.size());
+  fclose(F);
+  return Ok;
+}
+
+// ------------------------------------------------------------------------
+// Memory interface model for RevBasicMemCtrl
+// ------------------------------------------------------------------------
+/// RevBenchMem: StandardMem endpoint that answers every request on the next Deliver
+class RevBenchMem : public Interfaces::StandardMem {
+public:
+  RevBenchMem(void *Handler) : handler((Interfaces::StandardMem::HandlerBase *)(Handler)) {}
+  ~RevBenchMem(){ delete handler; }
+
+  void send(Request *R) override {
+    // responses are deferred: the controller records the request after send returns
+    pending.push_back(R->makeResponse());
+    delete R;
+  }
+
+  void Deliver(){
+    while( !pending.empty() ){
+      Request *R = pending.front();
+      pending.pop_front();
+      (*handler)(R);
+    }
+  }
+
+private:
+  Interfaces::StandardMem::HandlerBase *handler;
+  std::deque<Request *> pending;
+};
+
+// ------------------------------------------------------------------------
+// Main
+// ------------------------------------------------------------------------
+static void Usage(const char *Prog){
+  printf("usage: %s [-l] [-f filter] [-t seconds] [-r reps]\n", Prog);
+  printf("  -l          list the benchmarks\n");
+  printf("  -f filter   run the benchmarks whose name contains filter\n");
+  printf("  -t seconds  minimum time per repetition (default 0.2)\n");
+  printf("  -r reps     repetitions; the best is reported (default 5)\n");
+}
+
+int main(int argc, char **argv){
+  std::string Filter;
+  double MinSecs = 0.2;
+  unsigned Reps = 5;
+  bool List = false;
+  int Opt = 0;
+  while( (Opt = getopt(argc, argv, "lf:t:r:h")) != -1 ){
+    switch( Opt ){
+    case 'l': List = true; break;
+    case 'f': Filter = optarg; break;
+    case 't': MinSecs = atof(optarg); break;
+    case 'r': Reps = (unsigned)(atoi(optarg)); break;
+    default:
+      Usage(argv[0]);
+      return (Opt == 'h') ? 0 : 1;
+    }
+  }
+  if( (MinSecs <= 0.0) || (Reps == 0) ){
+    Usage(argv[0]);
+    return 1;
+  }
+
+  SST::Output Out("", 0, 0, SST::Output::STDOUT);
+
+  // -- core and memory under test
+  std::vector<uint64_t> PCs;
+  std::vector<uint8_t> Code = BuildCode(4096, PCs);
+  char ElfPath[] = "/tmp/revbench.XXXXXX";
+  int Fd = mkstemp(ElfPath);
+  if( Fd < 0 ){
+    fprintf(stderr, "revbench: failed to create a temporary executable\n");
+    return 1;
+  }
+  close(Fd);
+  if( !WriteElf(ElfPath, Code) ){
+    fprintf(stderr, "revbench: failed to write %s\n", ElfPath);
+    unlink(ElfPath);
+    return 1;
+  }
+
+  RevOpts *Opts = new RevOpts(1, 0);
+  Opts->InitMachineModels({"0:RV64GC"});
+  Opts->InitStartAddrs({"0:" + std::to_string(REVBENCH_CODE_BASE)});
+  RevMem *Mem = new RevMem(REVBENCH_MEM_SIZE, Opts, &Out);
+  RevLoader *Loader = new RevLoader(ElfPath, "", Mem, &Out);
+  RevProc *Proc = new RevProc(0, Opts, Mem, Loader, &Out);
+  unlink(ElfPath);
+
+  // -- a memory controller answered by the host model
+  RevBenchMem *IMem = nullptr;
+  SST::RevBench::Slots()["memIface"] = [&IMem](void *H) -> SST::SubComponent* {
+    IMem = new RevBenchMem(H);
+    return IMem;
+  };
+  SST::Params CtrlParams;
+  CtrlParams.insert("max_loads", "1024");
+  CtrlParams.insert("max_stores", "1024");
+  CtrlParams.insert("ops_per_cycle", "64");
+  RevBasicMemCtrl *Ctrl = new RevBasicMemCtrl(0, CtrlParams);
+  Ctrl->init(0);
+  Ctrl->init(1);
+  Ctrl->setup();
+
+  RevPrefetcher *Pref = new RevPrefetcher(Mem, 16);
+
+  // prime the core prefetcher and verify that the whole mix decodes
+  for( unsigned i=0; i<PCs.size(); i++ ){
+    RevInst Check;
+    if( !Proc->DebugDecode(PCs[i], Check) && !Proc->DebugDecode(PCs[i], Check) ){
+      fprintf(stderr, "revbench: failed to decode the instruction at 0x%" PRIx64 "\n", PCs[i]);
+      return 1;
+    }
+  }
+
+  std::vector<uint8_t> Buf(64, 0x5A);
+  std::vector<uint64_t> PanData(8, 0xDEADBEEFull);
+  uint64_t Sink = 0x00ull;
+  SST::Cycle_t Cycle = 0;
+
+  std::vector<RevBenchCase> Benches;
+
+  // instruction decode over the fixed mix; compressed forms take the pre-expanded table
+  Benches.push_back({"decode.mix", (uint64_t)(PCs.size()), [&](){
+    RevInst Inst;
+    for( unsigned i=0; i<PCs.size(); i++ ){
+      Proc->DebugDecode(PCs[i], Inst);
+      Sink += Inst.entry;
+    }
+  }});
+
+  // core construction; the decode tables are shared with the resident core
+  Benches.push_back({"proc.construct", 16, [&](){
+    for( unsigned i=0; i<16; i++ ){
+      RevProc *P = new RevProc(0, Opts, Mem, Loader, &Out);
+      Sink += P->GetNumEntries();
+      delete P;
+    }
+  }});
+
+  // 8 byte data accesses striding through a 1MB region
+  Benches.push_back({"mem.read8", 4096, [&](){
+    for( uint64_t i=0; i<4096; i++ ){
+      uint64_t V = 0x00ull;
+      Mem->ReadMem(REVBENCH_DATA_BASE + ((i * 264) % REVBENCH_DATA_SIZE), 8, (void *)(&V), 0);
+      Sink += V;
+    }
+  }});
+  Benches.push_back({"mem.write8", 4096, [&](){
+    for( uint64_t i=0; i<4096; i++ ){
+      uint64_t V = i;
+      Mem->WriteMem(REVBENCH_DATA_BASE + ((i * 264) % REVBENCH_DATA_SIZE), 8, (void *)(&V), 0);
+    }
+  }});
+  Benches.push_back({"mem.read64", 1024, [&](){
+    for( uint64_t i=0; i<1024; i++ ){
+      Mem->ReadMem(REVBENCH_DATA_BASE + ((i * 4160) % REVBENCH_DATA_SIZE), 64, (void *)(Buf.data()), 0);
+    }
+  }});
+
+  // sequential instruction fetch through the stream prefetcher
+  Benches.push_back({"prefetch.seq", (uint64_t)(PCs.size()), [&](){
+    uint32_t Inst = 0;
+    for( unsigned i=0; i<PCs.size(); i++ ){
+      Pref->IsAvail(PCs[i], Inst);
+      Sink += Inst;
+    }
+  }});
+
+  // memory controller: one request in flight at a time
+  Benches.push_back({"memctrl.read", 256, [&](){
+    for( uint64_t i=0; i<256; i++ ){
+      uint64_t A = REVBENCH_DATA_BASE + (i * 64);
+      Ctrl->sendREADRequest(A, A, 8, (void *)(Buf.data()), nullptr, 0);
+      Ctrl->clockTick(Cycle++);
+      IMem->Deliver();
+    }
+  }});
+  Benches.push_back({"memctrl.write", 256, [&](){
+    for( uint64_t i=0; i<256; i++ ){
+      uint64_t A = REVBENCH_DATA_BASE + (i * 64);
+      Ctrl->sendWRITERequest(A, A, 8, (char *)(Buf.data()), 0);
+      Ctrl->clockTick(Cycle++);
+      IMem->Deliver();
+    }
+  }});
+
+  // memory controller: an AMO round trip; the readlock response queues the writeunlock
+  Benches.push_back({"memctrl.amo", 256, [&](){
+    for( uint64_t i=0; i<256; i++ ){
+      uint64_t A = REVBENCH_DATA_BASE + (i * 64);
+      uint64_t Old = 0x00ull;
+      Ctrl->sendAMORequest(A, A, 8, (char *)(&i), (void *)(&Old), nullptr,
+                           REVMEM_FLAGS(RevCPU::RevFlag::F_AMOADD));
+      Ctrl->clockTick(Cycle++);
+      IMem->Deliver();
+      Ctrl->clockTick(Cycle++);
+      IMem->Deliver();
+      Sink += Old;
+    }
+  }});
+
+  // memory controller: a burst of requests queued before the controller drains them
+  Benches.push_back({"memctrl.burst256", 256, [&](){
+    for( uint64_t i=0; i<256; i++ ){
+      uint64_t A = REVBENCH_DATA_BASE + (i * 64);
+      Ctrl->sendREADRequest(A, A, 8, (void *)(Buf.data()), nullptr, 0);
+    }
+    while( Ctrl->outstandingRqsts() ){
+      Ctrl->clockTick(Cycle++);
+      IMem->Deliver();
+    }
+  }});
+
+  // memory controller: interleaved loads and stores that fill the request
+  // windows before any response returns
+  Benches.push_back({"memctrl.window1024", 1024, [&](){
+    for( uint64_t i=0; i<512; i++ ){
+      uint64_t A = REVBENCH_DATA_BASE + (i * 64);
+      Ctrl->sendREADRequest(A, A, 8, (void *)(Buf.data()), nullptr, 0);
+      Ctrl->sendWRITERequest(A + 32, A + 32, 8, (char *)(Buf.data()), 0);
+    }
+    for( unsigned i=0; i<(1024/64)+1; i++ ){
+      Ctrl->clockTick(Cycle++);
+    }
+    IMem->Deliver();
+  }});
+
+
+  // PAN command packet construction
+  Benches.push_back({"pan.syncget", 1024, [&](){
+    for( uint32_t i=0; i<1024; i++ ){
+      panNicEvent *Ev = new panNicEvent("revbench");
+      Ev->buildSyncGet(i, (uint8_t)(i), REVBENCH_DATA_BASE, 64);
+      Sink += Ev->getToken();
+      delete Ev;
+    }
+  }});
+  Benches.push_back({"pan.syncput64", 1024, [&](){
+    for( uint32_t i=0; i<1024; i++ ){
+      panNicEvent *Ev = new panNicEvent("revbench");
+      Ev->buildSyncPut(i, (uint8_t)(i), REVBENCH_DATA_BASE, 64, PanData.data());
+      Sink += Ev->getSize();
+      delete Ev;
+    }
+  }});
+
+  if( List ){
+    for( unsigned i=0; i<Benches.size(); i++ ){
+      printf("%s\n", Benches[i].Name.c_str());
+    }
+  }else{
+    printf("%-20s %12s %12s %14s\n", "benchmark", "ns/op", "Mops/s", "ops");
+    for( unsigned i=0; i<Benches.size(); i++ ){
+      if( !Filter.empty() && (Benches[i].Name.find(Filter) == std::string::npos) ){
+        continue;
+      }
+      uint64_t Ops = 0x00ull;
+      double NsOp = RunBench(Benches[i], MinSecs, Reps, Ops);
+      printf("%-20s %12.2f %12.2f %14" PRIu64 "\n", Benches[i].Name.c_str(), NsOp,
+             (NsOp > 0.0) ? (1.0e3 / NsOp) : 0.0, Ops);
+      fflush(stdout);
+    }
+  }
+
+  delete Pref;
+  delete Ctrl;
+  delete Proc;
+  delete Loader;
+  delete Mem;
+  delete Opts;
+
+  // keep the results of the kernels observable
+  return (Sink == 0x01ull) ? 2 : 0;
+}
+
+// EOF
@@ -0,0 +1,114 @@
+//
+// _RevBranchPred_h_
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#ifndef _SST_REVCPU_REVBRANCHPRED_H_
+#define _SST_REVCPU_REVBRANCHPRED_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace SST{
+namespace RevCPU {
+
+class RevBranchPred{
+public:
+  /// RevBranchPred: direction predictor types
+  typedef enum{
+    BPNone    = 0,    ///< RevBranchPred: no prediction; redirects are free
+    BPStatic  = 1,    ///< RevBranchPred: static backward taken, forward not taken
+    BPBimodal = 2,    ///< RevBranchPred: PC indexed table of 2-bit counters
+    BPGshare  = 3     ///< RevBranchPred: global history xor PC indexed 2-bit counters
+  }BPType;
+
+  /// RevBranchPred: control flow instruction classes
+  typedef enum{
+    CFNone      = 0,  ///< RevBranchPred: not a control flow instruction
+    CFBranch    = 1,  ///< RevBranchPred: conditional branch
+    CFJump      = 2,  ///< RevBranchPred: direct unconditional jump
+    CFCall      = 3,  ///< RevBranchPred: direct or indirect call (link to x1/x5)
+    CFReturn    = 4,  ///< RevBranchPred: return through x1/x5
+    CFIndirect  = 5   ///< RevBranchPred: any other indirect jump
+  }CFType;
+
+  /// RevBranchPred: default constructor
+  RevBranchPred(BPType Type, unsigned Entries, unsigned BTBEntries,
+                unsigned RASDepth);
+
+  /// RevBranchPred: default destructor
+  ~RevBranchPred();
+
+  /// RevBranchPred: convert a predictor name to its type; returns false if unknown
+  static bool ParseType(const std::string &Name, BPType &Type);
+
+  /// RevBranchPred: predict the next fetch address for the control flow instruction at PC
+  uint64_t Predict(uint64_t PC, CFType Kind, uint64_t Fallthrough, uint64_t Target);
+
+  /// RevBranchPred: train the predictor with the resolved next PC; returns true if Pred was correct
+  bool Update(uint64_t PC, CFType Kind, uint64_t Fallthrough,
+              uint64_t Pred, uint64_t Actual);
+
+  /// RevBranchPred: retrieve the predictor type
+  BPType GetType() { return type; }
+
+  /// RevBranchPred: retrieve the number of control flow instructions resolved
+  uint64_t GetBranches() { return branches; }
+
+  /// RevBranchPred: retrieve the number of mispredicted control flow instructions
+  uint64_t GetMispredicts() { return mispredicts; }
+
+  /// RevBranchPred: retrieve the number of taken transfers that missed in the BTB
+  uint64_t GetBTBMisses() { return btbMisses; }
+
+  /// RevBranchPred: retrieve the number of returns that were mispredicted by the RAS
+  uint64_t GetRASMisses() { return rasMisses; }
+
+private:
+  BPType type;                    ///< RevBranchPred: direction predictor type
+  unsigned phtMask;               ///< RevBranchPred: pattern history table index mask
+  unsigned btbMask;               ///< RevBranchPred: branch target buffer index mask
+  unsigned rasDepth;              ///< RevBranchPred: return address stack depth
+  unsigned rasTop;                ///< RevBranchPred: return address stack top index
+  unsigned rasCount;              ///< RevBranchPred: valid return address stack entries
+  uint64_t ghr;                   ///< RevBranchPred: global history register
+
+  std::vector<uint8_t> pht;       ///< RevBranchPred: pattern history table of 2-bit counters
+  std::vector<uint64_t> btbTag;   ///< RevBranchPred: branch target buffer tags (source PC)
+  std::vector<uint64_t> btbTarget;///< RevBranchPred: branch target buffer targets
+  std::vector<uint64_t> ras;      ///< RevBranchPred: return address stack
+
+  uint64_t branches;              ///< RevBranchPred: resolved control flow instructions
+  uint64_t mispredicts;           ///< RevBranchPred: mispredicted control flow instructions
+  uint64_t btbMisses;             ///< RevBranchPred: taken transfers that missed in the BTB
+  uint64_t rasMisses;             ///< RevBranchPred: mispredicted returns
+
+  /// RevBranchPred: rounds the target value down to a power of two
+  static unsigned PowerOfTwo(unsigned Val);
+
+  /// RevBranchPred: pattern history table index for the target PC
+  unsigned PHTIndex(uint64_t PC);
+
+  /// RevBranchPred: predict the direction of the conditional branch at PC
+  bool PredictTaken(uint64_t PC, uint64_t Target);
+
+  /// RevBranchPred: look up the target PC in the BTB
+  bool BTBLookup(uint64_t PC, uint64_t &Target);
+
+  /// RevBranchPred: push a return address onto the RAS
+  void RASPush(uint64_t Addr);
+
+  /// RevBranchPred: pop a return address from the RAS
+  bool RASPop(uint64_t &Addr);
+};
+
+} // namespace RevCPU
+} // namespace SST
+
+#endif // _SST_REVCPU_REVBRANCHPRED_H_
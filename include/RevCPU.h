@@ -29,6 +29,7 @@
 // -- Rev Headers
 #include "RevOpts.h"
 #include "RevMem.h"
+#include "RevHostProf.h"
 #include "RevMemCtrl.h"
 #include "RevLoader.h"
 #include "RevProc.h"
@@ -40,6 +41,7 @@
 #include "../common/include/PanAddr.h"
 
 #define _MAX_PAN_TEST_ 11
+#define _REV_CORE_ACTIVE_ (~0ull)
 
 namespace SST {
   namespace RevCPU {
@@ -89,12 +91,29 @@ namespace SST {
         {"program",         "Sets the binary executable",                   "a.out" },
         {"args",            "Sets the argument list",                       ""},
         {"numCores",        "Number of RISC-V cores to instantiate",        "1" },
+        {"coreBase",        "Node-wide index of the first core when a node is split across components", "0" },
+        {"nodeCores",       "Node-wide core count when a node is split across components; 0 if the component holds the whole node", "0" },
         {"memSize",         "Main memory size in bytes",                    "1073741824"},
         {"startAddr",       "Starting PC of the target core",               "core:0x80000000"},
         {"startSymbol",     "Starting symbol name of the target core",      "core:symbol"},
         {"machine",         "RISC-V machine model of the target core",      "core:G"},
         {"memCost",         "Memory latency range in cycles min:max",       "core:0:10"},
-        {"prefetchDepth",   "Instruction prefetch depth per core",          "core:1"},
+        {"prefetchDepth",   "Instruction prefetch stream depth (in 32bit words; rounded down to a power of two) per core", "core:1"},
+        {"branchPred",      "Branch predictor per core: none,static,bimodal,gshare", "core:none"},
+        {"branchPenalty",   "Fetch redirect penalty in cycles per core",    "core:3"},
+        {"bpredEntries",    "Branch pattern history table entries per core","core:4096"},
+        {"btbEntries",      "Branch target buffer entries per core",        "core:512"},
+        {"rasDepth",        "Return address stack depth per core",          "core:16"},
+        {"fusion",          "Macro-op fusion timing per core: none,fused,split", "core:none"},
+        {"jit",             "Hot block translation per core: off,check; check runs each translated block against the interpreter", "core:off"},
+        {"profile",         "Guest profile output prefix per core; empty disables", "core:"},
+        {"trace",           "Binary instruction trace output prefix per core; empty disables", "core:"},
+        {"memTrace",        "Sampled data access trace file shared by all cores; empty disables", ""},
+        {"memTraceSample",  "Record one in every N traced data accesses",   "1"},
+        {"memTraceFilter",  "Traced virtual address ranges lo:hi; empty traces every address", ""},
+        {"selfProfile",     "Measure the host time spent in each simulator subsystem", "0"},
+        {"selfProfileSample","Time one in every N clock ticks when self profiling", "64"},
+        {"selfProfileInterval","Cycles between periodic self profile reports; 0 reports at finish only", "0"},
         {"table",           "Instruction cost table",                       "core:/path/to/table"},
         {"enable_nic",      "Enable the internal RevNIC",                   "0"},
         {"enable_pan",      "Enable PAN network endpoint",                  "0"},
@@ -188,10 +207,40 @@ namespace SST {
         {"BytesRead",           "Total bytes read",                                     "count",  1},
         {"BytesWritten",        "Total bytes written",                                  "count",  1},
         {"FloatsExec",          "Total SP or DP float instructions executed",           "count",  1},
+        {"BranchesExec",        "Total control flow instructions executed",             "count",  1},
+        {"BranchMispredicts",   "Total mispredicted control flow instructions",         "count",  1},
+        {"BTBMisses",           "Total taken control flow instructions missing the BTB","count",  1},
+        {"RASMisses",           "Total returns mispredicted by the RAS",                "count",  1},
+        {"CyclesRedirect",      "Cycles lost to fetch redirects",                       "count",  1},
+        {"PrefetchHits",        "Instruction fetches serviced from a stream buffer",    "count",  1},
+        {"PrefetchMisses",      "Instruction fetches that missed every stream buffer",  "count",  1},
+        {"PrefetchStalls",      "Fetch attempts waiting on a stream buffer fill",       "count",  1},
+        {"FusedPairs",          "Total instruction pairs executed as fused macro-ops",  "count",  1},
+        {"JITBlocks",           "Total hot blocks translated",                          "count",  1},
+        {"JITChecks",           "Translated block executions matching the interpreter", "count",  1},
+        {"InstALU",             "Total retired integer ALU instructions",               "count",  1},
+        {"InstMulDiv",          "Total retired integer multiply/divide instructions",   "count",  1},
+        {"InstLoad",            "Total retired load instructions",                      "count",  1},
+        {"InstStore",           "Total retired store instructions",                     "count",  1},
+        {"InstAMO",             "Total retired atomic memory instructions",             "count",  1},
+        {"InstBranch",          "Total retired branch and jump instructions",           "count",  1},
+        {"InstFP",              "Total retired floating point arithmetic instructions", "count",  1},
+        {"InstSystem",          "Total retired fence, ecall and CSR instructions",      "count",  1},
+        {"StallALU",            "Cycles without issue behind integer ALU ops",          "count",  1},
+        {"StallMulDiv",         "Cycles without issue behind multiply/divide",          "count",  1},
+        {"StallLoad",           "Cycles without issue behind loads",                    "count",  1},
+        {"StallStore",          "Cycles without issue behind stores",                   "count",  1},
+        {"StallAMO",            "Cycles without issue behind atomic memory ops",        "count",  1},
+        {"StallBranch",         "Cycles without issue behind branches and jumps",       "count",  1},
+        {"StallFP",             "Cycles without issue behind floating point ops",       "count",  1},
+        {"StallSystem",         "Cycles without issue behind fence, ecall and CSR ops", "count",  1},
+        {"InstMix",             "Retired instructions per mnemonic",                    "count",  3},
       )
 
     private:
       unsigned numCores;                  ///< RevCPU: number of RISC-V cores
+      unsigned coreBase;                  ///< RevCPU: node-wide index of the first core of this component
+      unsigned nodeCores;                 ///< RevCPU: node-wide core count; 0 if the component holds the whole node
       unsigned msgPerCycle;               ///< RevCPU: number of messages to send per cycle
       unsigned RDMAPerCycle;              ///< RevCPU: number of RDMA messages per cycle to inject into PAN network
       unsigned testStage;                 ///< RevCPU: controls the PAN Test harness staging
@@ -203,6 +252,10 @@ namespace SST {
       RevLoader *Loader;                  ///< RevCPU: RISC-V loader
       std::vector<RevProc *> Procs;       ///< RevCPU: RISC-V processor objects
       bool *Enabled;                      ///< RevCPU: Completion structure
+      std::vector<unsigned> ActiveCores;  ///< RevCPU: worklist of the cores clocked each cycle; in core order
+      std::vector<uint64_t> ParkedAt;     ///< RevCPU: tick at which each quiesced core was parked; _REV_CORE_ACTIVE_ otherwise
+      unsigned LiveCores;                 ///< RevCPU: number of cores that have not completed
+      uint64_t Ticks;                     ///< RevCPU: number of clock ticks handled
 
       uint8_t PrivTag;                    ///< RevCPU: private tag locator
       uint64_t LToken;                    ///< RevCPU: token identifier for PAN Test
@@ -239,6 +292,9 @@ namespace SST {
       panNicAPI *PNic;                    ///< RevCPU: PAN network interface controller
       PanExec *PExec;                     ///< RevCPU: PAN execution context
       RevMemCtrl *Ctrl;                   ///< RevCPU: Rev memory controller
+      RevMemTrace *MemTrace;              ///< RevCPU: sampled data access trace
+      RevHostProf *HostProf;              ///< RevCPU: simulator self profile
+      uint64_t HostProfInterval;          ///< RevCPU: cycles between self profile reports
 
       std::queue<std::pair<panNicEvent *,int>> SendMB;  ///< RevCPU: outgoing command mailbox; pair<Cmd,Dest>
       std::queue<std::pair<uint32_t,char *>> ZeroRqst;  ///< RevCPU: tracks incoming zero address put requests; pair<Size,Data>
@@ -318,6 +374,20 @@ namespace SST {
       std::vector<Statistic<uint64_t>*> BytesRead;
       std::vector<Statistic<uint64_t>*> BytesWritten;
       std::vector<Statistic<uint64_t>*> FloatsExec;
+      std::vector<Statistic<uint64_t>*> BranchesExec;
+      std::vector<Statistic<uint64_t>*> BranchMispredicts;
+      std::vector<Statistic<uint64_t>*> BTBMisses;
+      std::vector<Statistic<uint64_t>*> RASMisses;
+      std::vector<Statistic<uint64_t>*> CyclesRedirect;
+      std::vector<Statistic<uint64_t>*> PrefetchHits;
+      std::vector<Statistic<uint64_t>*> PrefetchMisses;
+      std::vector<Statistic<uint64_t>*> PrefetchStalls;
+      std::vector<Statistic<uint64_t>*> FusedPairs;
+      std::vector<Statistic<uint64_t>*> JITBlocks;
+      std::vector<Statistic<uint64_t>*> JITChecks;
+      std::vector<std::vector<Statistic<uint64_t>*>> ClassInsts;
+      std::vector<std::vector<Statistic<uint64_t>*>> ClassStalls;
+      std::vector<std::vector<Statistic<uint64_t>*>> InstMix;
 
       //-------------------------------------------------------
       // -- FUNCTIONS
@@ -326,6 +396,15 @@ namespace SST {
       /// RevCPU: initializes the PAN NIC tables
       void initNICMem();
 
+      /// RevCPU: print the simulator self profile
+      void ReportHostProf(SST::Cycle_t currentCycle);
+
+      /// RevCPU: clock the active cores and retire completed or quiesced cores from the worklist
+      void ClockActiveCores(SST::Cycle_t currentCycle, bool UpdateStats);
+
+      /// RevCPU: return a parked core to the active worklist
+      void WakeCore(unsigned Core);
+
       /// RevCPU: decode the fault codes
       void DecodeFaultCodes(std::vector<std::string> faults);
 
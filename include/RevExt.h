@@ -38,14 +38,14 @@ namespace SST{
       /// RevExt: standard destructor
       ~RevExt();
 
-      /// RevExt: sets the internal instruction table
-      void SetTable(std::vector<RevInstEntry> InstVect);
+      /// RevExt: sets the internal instruction table; the table is referenced, not copied
+      void SetTable(const std::vector<RevInstEntry> &InstVect);
 
-      /// RevExt: sets the internal compressed instruction table
-      void SetCTable(std::vector<RevInstEntry> InstVect);
+      /// RevExt: sets the internal compressed instruction table; the table is referenced, not copied
+      void SetCTable(const std::vector<RevInstEntry> &InstVect);
 
       /// RevExt: sets the optional table (used for variant-specific compressed encodings)
-      void SetOTable(std::vector<RevInstEntry> InstVect);
+      void SetOTable(const std::vector<RevInstEntry> &InstVect);
 
       /// RevExt: retrieve the extension name
       std::string GetName() { return name; }
@@ -54,13 +54,13 @@ namespace SST{
       bool Execute(unsigned Inst, RevInst Payload, uint16_t threadID);
 
       /// RevExt: retrieves the extension's instruction table
-      std::vector<RevInstEntry> GetInstTable() { return table; }
+      const std::vector<RevInstEntry> &GetInstTable() { return *table; }
 
       /// RevExt: retrieves the extension's compressed instruction table
-      std::vector<RevInstEntry> GetCInstTable() { return ctable; }
+      const std::vector<RevInstEntry> &GetCInstTable() { return *ctable; }
 
       /// RevExt: retrieves the extension's optional instruction table
-      std::vector<RevInstEntry> GetOInstTable() { return otable; }
+      const std::vector<RevInstEntry> &GetOInstTable() { return *otable; }
 
       /// RevExt: updates the RegFile pointer prior to instruction execution
       ///         such that the currently executing RevThreadCtx is the one 
@@ -75,9 +75,9 @@ namespace SST{
     private:
       std::string name;                 ///< RevExt: extension name
       SST::Output *output;              ///< RevExt: output handler
-      std::vector<RevInstEntry> table;  ///< RevExt: instruction table
-      std::vector<RevInstEntry> ctable; ///< RevExt: compressed instruction table
-      std::vector<RevInstEntry> otable; ///< RevExt: optional compressed instruction table
+      const std::vector<RevInstEntry> *table;  ///< RevExt: instruction table
+      const std::vector<RevInstEntry> *ctable; ///< RevExt: compressed instruction table
+      const std::vector<RevInstEntry> *otable; ///< RevExt: optional compressed instruction table
 
     }; // class RevExt
   } // namespace RevCPU
@@ -91,6 +91,9 @@ namespace SST{
       /// RevFeature: Returns whether RV32 or RV64 "C" is enabled
       bool HasCompressed();
 
+      /// RevFeature: Returns whether RV32 or RV64 "D" is enabled; single precision values then live in the D registers
+      bool HasDouble();
+
       /// RevFeature: Retrieve the hart of the target object
       unsigned GetHart() { return Hart; }
 
@@ -0,0 +1,160 @@
+//
+// _RevHostProf_h_
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#ifndef _SST_REVCPU_REVHOSTPROF_H_
+#define _SST_REVCPU_REVHOSTPROF_H_
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace SST{
+namespace RevCPU {
+
+#define REVHOST_MAX_DEPTH 8
+
+class RevHostProf{
+public:
+  /// RevHostProf: simulator subsystems charged with host time
+  typedef enum{
+    HostCore    = 0,    ///< RevHostProf: core bookkeeping outside the phases below
+    HostFetch   = 1,    ///< RevHostProf: instruction prefetch
+    HostDecode  = 2,    ///< RevHostProf: instruction decode and block lookup
+    HostExecute = 3,    ///< RevHostProf: instruction execution
+    HostMem     = 4,    ///< RevHostProf: RevMem data and fetch accesses
+    HostEcall   = 5,    ///< RevHostProf: system call emulation
+    HostMemCtrl = 6,    ///< RevHostProf: memory controller clock
+    HostPAN     = 7,    ///< RevHostProf: PAN network processing
+    HostPhaseCount = 8
+  }HostPhase;
+
+  /// RevHostProf: default constructor; times one in every Sample clock ticks
+  RevHostProf(unsigned Sample, unsigned Cores);
+
+  /// RevHostProf: default destructor
+  ~RevHostProf();
+
+  /// RevHostProf: read the host timestamp counter
+  static uint64_t ReadTSC(){
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t V;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(V));
+    return V;
+#else
+    return (uint64_t)(std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+  }
+
+  /// RevHostProf: advance to the next component clock tick
+  void Tick(){
+    active = (++tickCount >= sample);
+    if( active ){
+      tickCount = 0;
+    }
+  }
+
+  /// RevHostProf: charge the host time that follows to Phase until the matching Leave
+  void Enter(HostPhase Phase){
+    if( !active ){
+      return ;
+    }
+    if( depth == REVHOST_MAX_DEPTH ){
+      overflow++;
+      return ;
+    }
+    uint64_t Now = ReadTSC();
+    if( depth ){
+      ticks[stack[depth-1]] += Now - mark;
+    }
+    stack[depth++] = Phase;
+    mark = Now;
+  }
+
+  /// RevHostProf: return to the enclosing phase
+  void Leave(){
+    if( overflow ){
+      overflow--;
+      return ;
+    }
+    if( !depth ){
+      return ;
+    }
+    uint64_t Now = ReadTSC();
+    ticks[stack[--depth]] += Now - mark;
+    mark = Now;
+  }
+
+  /// RevHostProf: charge the host time that follows to a core
+  void EnterCore(unsigned Core){
+    if( active ){
+      coreMark = ReadTSC();
+      Enter(HostCore);
+    }
+  }
+
+  /// RevHostProf: stop charging host time to a core
+  void LeaveCore(unsigned Core){
+    if( active ){
+      Leave();
+      coreTicks[Core] += ReadTSC() - coreMark;
+    }
+  }
+
+  /// RevHostProf: record the host time spent constructing the component and restart the run clock
+  void MarkBuilt(double Seconds);
+
+  /// RevHostProf: format the report for the retired instructions of each core
+  std::string Report(uint64_t Cycle, const std::vector<uint64_t> &CoreInsts);
+
+  /// RevHostProf: retrieve the name of a phase
+  static const char *GetPhaseName(HostPhase Phase);
+
+private:
+  unsigned sample;                        ///< RevHostProf: time one in every sample ticks
+  unsigned tickCount;                     ///< RevHostProf: ticks since the last timed tick
+  bool active;                            ///< RevHostProf: the current tick is timed
+  unsigned depth;                         ///< RevHostProf: nested phases
+  unsigned overflow;                      ///< RevHostProf: phases entered beyond the stack depth
+  HostPhase stack[REVHOST_MAX_DEPTH];     ///< RevHostProf: nested phase stack
+  uint64_t mark;                          ///< RevHostProf: timestamp of the last phase change
+  uint64_t coreMark;                      ///< RevHostProf: timestamp of the last EnterCore
+  uint64_t ticks[HostPhaseCount];         ///< RevHostProf: sampled timestamp ticks per phase
+  std::vector<uint64_t> coreTicks;        ///< RevHostProf: sampled timestamp ticks per core
+  double buildSeconds;                    ///< RevHostProf: host seconds spent in construction
+
+  uint64_t startTSC;                      ///< RevHostProf: timestamp at the start of the run
+  std::chrono::steady_clock::time_point startWall; ///< RevHostProf: wall clock at the start of the run
+};
+
+/// RevHostScope: charges the enclosing scope to a phase; a null profiler costs one test
+class RevHostScope{
+public:
+  RevHostScope(RevHostProf *P, RevHostProf::HostPhase Phase) : prof(P) {
+    if( prof ) prof->Enter(Phase);
+  }
+  ~RevHostScope() {
+    if( prof ) prof->Leave();
+  }
+private:
+  RevHostProf *prof;                      ///< RevHostScope: profiler, if enabled
+};
+
+} // namespace RevCPU
+} // namespace SST
+
+#endif // _SST_REVCPU_REVHOSTPROF_H_
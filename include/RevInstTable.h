@@ -36,6 +36,10 @@
 #define _REV_INVALID_HART_ID_ (uint16_t)~(uint16_t(0))
 #endif
 
+#ifndef _REV_INVALID_ENTRY_
+#define _REV_INVALID_ENTRY_ (unsigned)~(unsigned(0))
+#endif
+
 // Masks
 #define MASK8   0b11111111                          // 8bit mask
 #define MASK16  0b1111111111111111                  // 16bit mask
@@ -278,6 +282,7 @@ namespace SST{
       uint32_t cost;                    ///< RevRegFile: Cost of the instruction
       bool trigger;                     ///< RevRegFile: Has the instruction been triggered?
       unsigned Entry;                   ///< RevRegFile: Instruction entry
+      unsigned pending;                 ///< RevRegFile: controller reads not yet delivered to the register file
     }RevRegFile;                        ///< RevProc: register file construct
 
     static std::bitset<_REV_HART_COUNT_> HART_CTS; ///< RevProc: Thread is clear to start (proceed with decode)
@@ -348,6 +353,8 @@ namespace SST{
       bool compressed;      ///< RevInst: determines if the instruction is compressed
       uint32_t cost;        ///< RevInst: the cost to execute this instruction, in clock cycles
       unsigned entry;       ///< RevInst: Where to find this instruction in the InstTables
+      uint8_t fuseRd;       ///< RevInst: rd of the fused tail that retires with this instruction; 0 if none
+      uint32_t encoding;    ///< RevInst: instruction word as fetched
     }RevInst;
 
     /// RevInstEntry: Holds the compressed index to normal index mapping
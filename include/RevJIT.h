@@ -0,0 +1,126 @@
+//
+// _RevJIT_h_
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#ifndef _SST_REVCPU_REVJIT_H_
+#define _SST_REVCPU_REVJIT_H_
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../include/RevMem.h"
+#include "../include/RevInstTable.h"
+
+namespace SST{
+namespace RevCPU {
+
+#define REVJIT_HOT_THRESHOLD 16   // block entries before a block is translated
+#define REVJIT_MAX_BLOCK     64   // instructions in a translated block
+
+class RevJIT{
+public:
+  /// RevJIT: operating mode
+  typedef enum{
+    JITOff      = 0,    ///< no translation
+    JITCheck    = 1     ///< translate hot blocks and check each execution against the interpreter
+  }JITMode;
+
+  /// RevJIT: guest state of a translated block; the register file is pinned in one structure
+  typedef struct{
+    uint64_t x[32];     ///< RevJIT: integer registers
+    uint64_t pc;        ///< RevJIT: program counter
+  }RevJITCtx;
+
+  /// RevJIT: default constructor
+  RevJIT(RevMem *Mem, SST::Output *Output, unsigned Core);
+
+  /// RevJIT: default destructor
+  ~RevJIT();
+
+  /// RevJIT: parse a mode name; returns false if it is unknown
+  static bool ParseMode(const std::string &Name, JITMode &Mode);
+
+  /// RevJIT: called before the interpreter executes the instruction at PC; a hot block entered at PC is run from a copy of the registers
+  void Enter(unsigned Hart, uint64_t PC, RevRegFile *Regs);
+
+  /// RevJIT: called after the interpreter executed the instruction at PC; once the interpreter has run the block, its state must match the translation
+  void Retire(unsigned Hart, uint64_t PC, unsigned Size, RevRegFile *Regs);
+
+  /// RevJIT: discard every translation such that modified instructions are translated again
+  void Invalidate();
+
+  /// RevJIT: retrieve the number of blocks translated
+  uint64_t GetBlocks() { return blocks; }
+
+  /// RevJIT: retrieve the number of block executions that matched the interpreter
+  uint64_t GetChecks() { return checks; }
+
+private:
+  /// RevJIT: a decoded RV64I/M instruction
+  typedef struct{
+    uint64_t PC;        ///< RevJIT: instruction address
+    int64_t Imm;        ///< RevJIT: sign extended immediate
+    uint8_t Opc;        ///< RevJIT: major opcode
+    uint8_t F3;         ///< RevJIT: funct3
+    uint8_t F7;         ///< RevJIT: funct7
+    uint8_t Rd;         ///< RevJIT: destination register
+    uint8_t Rs1;        ///< RevJIT: first source register
+    uint8_t Rs2;        ///< RevJIT: second source register
+  }RevJITOp;
+
+  /// RevJIT: a straight line run of instructions; conditional branches leave it early
+  typedef struct{
+    uint64_t PC;                    ///< RevJIT: entry address
+    std::vector<RevJITOp> Ops;      ///< RevJIT: instructions in program order
+  }RevJITBlock;
+
+  RevMem *mem;                                  ///< RevJIT: memory object
+  SST::Output *output;                          ///< RevJIT: output handler
+  unsigned core;                                ///< RevJIT: owning core
+
+  std::unordered_map<uint64_t,unsigned> heat;   ///< RevJIT: entries of each block address not yet translated
+  std::unordered_map<uint64_t,RevJITBlock *> cache; ///< RevJIT: translations; nullptr if the entry instruction cannot be translated
+  std::vector<bool> entry;                      ///< RevJIT: whether the next instruction of each hart starts a block
+
+  RevJITBlock *check;                           ///< RevJIT: block being checked
+  unsigned checkHart;                           ///< RevJIT: hart running the checked block
+  unsigned checkIdx;                            ///< RevJIT: instructions of the checked block the interpreter has executed
+  unsigned checkLen;                            ///< RevJIT: instructions the translation executed
+  RevJITCtx ctx;                                ///< RevJIT: register state the translation produced
+  std::map<uint64_t,uint8_t> stores;            ///< RevJIT: bytes the translation stored, held back from memory
+
+  uint64_t blocks;                              ///< RevJIT: blocks translated
+  uint64_t checks;                              ///< RevJIT: block executions that matched the interpreter
+
+  /// decodes the instruction at the target address; returns false if it is not translated
+  bool Decode(uint64_t PC, RevJITOp &Op);
+
+  /// translates the block at the target address; returns nullptr if its first instruction is not translated
+  RevJITBlock *Translate(uint64_t PC);
+
+  /// runs a translated block on the context; returns the number of instructions executed
+  unsigned Run(const RevJITBlock *B, RevJITCtx &C);
+
+  /// loads from memory through the held back stores
+  uint64_t Load(uint64_t Addr, unsigned Size);
+
+  /// holds back a store
+  void Store(uint64_t Addr, unsigned Size, uint64_t Val);
+
+  /// compares the interpreter state with the translation
+  void Compare(RevRegFile *Regs);
+};
+
+} // namespace RevCPU
+} // namespace SST
+
+#endif // _SST_REVCPU_REVJIT_H_
@@ -12,7 +12,10 @@
 #define _SST_REVCPU_REVLOADER_H_
 
 // -- Standard Headers
+#include <algorithm>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <cstring>
 #include <string>
 #include <vector>
@@ -39,6 +42,18 @@
 #define SHT_NOBITS 8
 #endif
 
+#ifndef STT_SECTION
+#define STT_SECTION 3
+#endif
+
+#ifndef STT_FILE
+#define STT_FILE 4
+#endif
+
+#ifndef SHN_LORESERVE
+#define SHN_LORESERVE 0xff00
+#endif
+
 using namespace SST::RevCPU;
 
 template<typename T> static inline T from_le(T n) { return n; }
@@ -164,6 +179,45 @@ namespace SST {
       uint64_t instret0;
     } ElfInfo;
 
+    typedef struct{
+      uint64_t start;           ///< RevSymbol: first address covered by the symbol
+      uint64_t size;            ///< RevSymbol: number of bytes covered by the symbol
+      std::string name;         ///< RevSymbol: symbol name
+      std::string section;      ///< RevSymbol: name of the section holding the symbol
+    } RevSymbol;
+
+    typedef struct{
+      uint64_t paddr;           ///< RevElfSegment: physical load address
+      uint64_t filesz;          ///< RevElfSegment: bytes backed by the file
+      uint64_t memsz;           ///< RevElfSegment: total bytes in memory
+      const char *data;         ///< RevElfSegment: file contents within the image mapping
+    } RevElfSegment;
+
+    class RevElfImage {
+    public:
+      /// RevElfImage: standard constructor
+      RevElfImage( char *MemBuf, size_t Size );
+
+      /// RevElfImage: standard destructor; releases the file mapping
+      ~RevElfImage();
+
+      char *membuf;             ///< RevElfImage: read-only mapping of the executable
+      size_t size;              ///< RevElfImage: size of the mapping
+      bool is64;                ///< RevElfImage: Elf64 image
+      uint64_t entry;           ///< RevElfImage: entry point
+      ElfInfo info;             ///< RevElfImage: program header info
+
+      std::vector<RevElfSegment> segments;      ///< RevElfImage: PT_LOAD segments
+      std::map<std::string,uint64_t> symtable;  ///< RevElfImage: symbol table
+      std::vector<RevSymbol> symbols;           ///< RevElfImage: address sorted symbol intervals
+
+      /// RevElfImage: records a symbol for the address index
+      void AddSymbol( const char *Name, uint64_t Start, uint64_t Size, const char *Section );
+
+      /// RevElfImage: sorts the symbol intervals and sizes the zero length entries
+      void BuildSymbolIndex();
+    }; // class RevElfImage
+
     class RevLoader {
     public:
       /// RevLoader: standard constructor
@@ -175,6 +229,12 @@ namespace SST {
       /// RevLoader: retrieves the address for the target symbol; 0x00ull if the symbol doesn't exist
       uint64_t GetSymbolAddr(std::string Symbol);
 
+      /// RevLoader: retrieves the symbol covering the target address; Hint caches the last hit for the caller
+      const RevSymbol *FindSymbol(uint64_t Addr, unsigned &Hint);
+
+      /// RevLoader: retrieves the number of indexed symbol intervals
+      unsigned GetNumSymbols() { return (unsigned)(image->symbols.size()); }
+
       /// RevLoader: retrieves the value for 'argc'
       unsigned GetArgc() { return argv.size(); }
 
@@ -195,7 +255,10 @@ namespace SST {
 
       ElfInfo elfinfo;          ///< RevLoader: elf info from the loaded program
 
-      std::map<std::string,uint64_t> symtable;  ///< RevLoader: loaded symbol table
+      std::shared_ptr<RevElfImage> image;       ///< RevLoader: parsed executable image
+
+      static std::map<std::string,std::weak_ptr<RevElfImage>> imageCache; ///< RevLoader: images shared by every loader in the process
+      static std::mutex imageLock;              ///< RevLoader: protects the image cache
 
       std::vector<std::string> argv;            ///< RevLoader: The actual argv table
 
@@ -220,18 +283,21 @@ namespace SST {
       /// Determines if the target header is big endian
       bool IsRVBig( const Elf64_Ehdr eh64 );
 
-      /// Loads a 32bit Elf binary
-      bool LoadElf32(char *MemBuf, size_t Size);
+      /// Retrieves the parsed image for the executable, parsing it on first use
+      std::shared_ptr<RevElfImage> GetImage();
+
+      /// Parses a 32bit Elf binary
+      bool ParseElf32(RevElfImage *Image);
 
-      /// Loads a 64bit Elf binary
-      bool LoadElf64(char *MemBuf, size_t Size);
+      /// Parses a 64bit Elf binary
+      bool ParseElf64(RevElfImage *Image);
+
+      /// Loads the parsed image into memory
+      bool LoadImage();
 
       ///< Splits a string into tokens
       void splitStr(const std::string& s,char c,std::vector<std::string>& v);
 
-      ///< Breaks bulk writes into cache lines
-      bool WriteCacheLine(uint64_t Addr, size_t Len, void *Data);
-
     }; // class Loader
   } // namespace RevCPU
 } // namespace SST
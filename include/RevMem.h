@@ -29,6 +29,7 @@
 // -- RevCPU Headers
 #include "RevOpts.h"
 #include "RevMemCtrl.h"
+#include "RevMemTrace.h"
 
 #ifndef _REVMEM_BASE_
 #define _REVMEM_BASE_ 0x00000000
@@ -67,6 +68,9 @@ namespace SST {
       /// RevMem: set the stack_top address
       void SetStackTop(uint64_t Addr) { stacktop = Addr; }
 
+      /// RevMem: get the page size in bytes
+      uint32_t GetPageSize() { return pageSize; }
+
       /// RevMem: initiate a memory fence
       bool FenceMem();
 
@@ -79,6 +83,15 @@ namespace SST {
       /// RevMem: write to the target memory location
       bool WriteMem( uint64_t Addr, size_t Len, void *Data );
 
+      /// RevMem: write to the target memory location without timing; used to preload the program image
+      bool InitMem( uint64_t Addr, size_t Len, void *Data );
+
+      /// RevMem: read the local memory image without timing, statistics or tracing; used to check translated code
+      bool PeekMem( uint64_t Addr, size_t Len, void *Data );
+
+      /// RevMem: declare a zero-initialized region; untouched pages are zero when first mapped
+      bool ZeroMem( uint64_t Addr, size_t Len );
+
       /// RevMem: write to the target memory location with the target flags
       bool WriteMem( uint64_t Addr, size_t Len, void *Data,
                      StandardMem::Request::flags_t flags );
@@ -87,6 +100,9 @@ namespace SST {
       bool ReadMem( uint64_t Addr, size_t Len, void *Target,
                     StandardMem::Request::flags_t flags);
 
+      /// RevMem: fetch instructions from the target memory location; a non-null Pending counts the fetch until its data reaches Target
+      bool FetchMem( uint64_t Addr, size_t Len, void *Target, unsigned *Pending );
+
       /// RevMem: DEPRECATED: read data from the target memory location
       [[deprecated("Simple RevMem interfaces have been deprecated")]]
       bool ReadMem( uint64_t Addr, size_t Len, void *Data );
@@ -149,12 +165,34 @@ namespace SST {
       // ----------------------------------------------------
       // ---- Atomic/Future/LRSC Interfaces
       // ----------------------------------------------------
-      /// RevMem: Add a memory reservation for the target address
+      /// RevMem: Add a memory reservation for the target address; replaces the hart's previous reservation
       bool LR(unsigned Hart, uint64_t Addr);
 
-      /// RevMem: Clear a memory reservation for the target address
+      /// RevMem: Clear the hart's reservation; returns true if it was held on the target address
       bool SC(unsigned Hart, uint64_t Addr);
 
+      /// RevMem: a store ends every reservation on the bytes it writes
+      void ClearLRSC(uint64_t Addr, size_t Len);
+
+      /// RevMem: load reserved; Target receives the loaded value
+      bool LRMem( unsigned Hart, uint64_t Addr, size_t Len, void *Target,
+                  StandardMem::Request::flags_t flags );
+
+      /// RevMem: store conditional of Data; Target receives 0 on success and 1 on failure
+      bool SCMem( unsigned Hart, uint64_t Addr, size_t Len, void *Data, void *Target,
+                  StandardMem::Request::flags_t flags );
+
+      /// RevMem: template AMO interface; Data holds the operand and Target receives the old value
+      template <typename T>
+      bool AMOVal( uint64_t Addr, T *Data, void *Target,
+                   StandardMem::Request::flags_t flags ){
+        return AMOMem(Addr, sizeof(T), (void *)(Data), Target, flags);
+      }
+
+      /// RevMem: atomic read-modify-write of the target memory location; the flags select the operation
+      bool AMOMem( uint64_t Addr, size_t Len, void *Data, void *Target,
+                   StandardMem::Request::flags_t flags );
+
       /// RevMem: Initiates a future operation [RV64P only]
       bool SetFuture( uint64_t Addr );
 
@@ -169,7 +207,54 @@ namespace SST {
 
       /// RevMem: Used to access & incremenet the global software PID counter
       uint32_t GetNewThreadPID();
+
+      /// RevMem: sets the next PID to be assigned; must precede the creation of any thread
+      void SetPIDBase( uint32_t Base ) { PIDCount = Base - 1; }
+
+      /// RevMem: marks the memory as shared with the other components of a split node
+      void SetSplitNode( bool Split ) { splitNode = Split; }
+
+      /// RevMem: determines whether the memory is shared with the other components of a split node
+      bool IsSplitNode() { return splitNode; }
   
+      /// RevMem: clears the record of the most recent data access
+      void ClearLastAccess() { lastAccess = 0; }
+
+      /// RevMem: retrieves the most recent data access; returns false if there was none
+      bool GetLastAccess( uint64_t &Addr, bool &Write ){
+        Addr  = lastAddr;
+        Write = (lastAccess == 2);
+        return (lastAccess != 0);
+      }
+
+      /// RevMem: attach the sampled data access trace; nullptr detaches it
+      void SetMemTrace( RevMemTrace *Trace ) { memTrace = Trace; }
+
+      /// RevMem: determines whether data accesses are being traced
+      bool IsMemTraced() { return (memTrace != nullptr); }
+
+      /// RevMem: attributes the following data accesses to the executing instruction
+      void SetTraceCtx( unsigned Core, unsigned Hart, uint64_t PC, uint64_t Cycle, bool AMO ){
+        traceCore   = Core;
+        traceHart   = Hart;
+        tracePC     = PC;
+        traceCycle  = Cycle;
+        traceAMO    = AMO;
+        traceArmed  = true;
+      }
+
+      /// RevMem: stops attributing data accesses; fetches and loader writes are never traced
+      void ClearTraceCtx() { traceArmed = false; }
+
+      /// RevMem: counts the executing instruction's controller reads in Pending until their data is delivered
+      void SetPendingCtx( unsigned *Pending ) { pendingCtx = Pending; }
+
+      /// RevMem: stops counting controller reads against an instruction
+      void ClearPendingCtx() { pendingCtx = nullptr; }
+
+      /// RevMem: charge memory accesses to the simulator self profile; nullptr disables
+      void SetHostProf( RevHostProf *Prof ) { hostProf = Prof; }
+
       ///< RevMem: default memory size allocated to new threads (Unimplemented)
       uint64_t DefaultThreadMemSize = 4*1024*1024;    
 
@@ -196,8 +281,21 @@ namespace SST {
 
       uint64_t CalcPhysAddr(uint64_t pageNum, uint64_t Addr);
 
+      /// RevMem: records a data access in the sampled access trace
+      void TraceAccess(uint64_t Addr, uint64_t PAddr, size_t Len, bool Write){
+        if( memTrace && traceArmed ){
+          RevMemTrace::MemTraceOp Op = Write ? RevMemTrace::MemTraceWrite :
+                                               RevMemTrace::MemTraceRead;
+          if( traceAMO )
+            Op = Write ? RevMemTrace::MemTraceAMOWrite : RevMemTrace::MemTraceAMORead;
+          memTrace->Record(traceCycle, tracePC, Addr, PAddr,
+                           traceCore, traceHart, Len, Op);
+        }
+      }
+
       std::mutex m_mtx;         ///< RevMem: used for incrementing ThreadCtx PID counter
       uint32_t PIDCount = 1023; ///< RevMem: Monotonically increasing PID counter for assigning new PIDs without conflicts
+      bool splitNode = false;   ///< RevMem: the memory is shared with the other components of a split node
 
       //c++11 should guarentee that these are all zero-initializaed
       std::map<uint64_t, std::pair<uint32_t, bool>> pageMap;   ///< RevMem: map of logical to pair<physical addresses, allocated>
@@ -208,6 +306,19 @@ namespace SST {
 
       uint64_t stacktop;        ///< RevMem: top of the stack
 
+      uint64_t lastAddr = 0;    ///< RevMem: address of the most recent data access
+      uint8_t lastAccess = 0;   ///< RevMem: most recent data access; 0=none, 1=read, 2=write
+
+      RevMemTrace *memTrace = nullptr;  ///< RevMem: sampled data access trace
+      RevHostProf *hostProf = nullptr;  ///< RevMem: simulator self profile
+      bool traceArmed = false;  ///< RevMem: an instruction is executing; its accesses are traced
+      unsigned *pendingCtx = nullptr; ///< RevMem: undelivered read count of the executing instruction's hart
+      bool traceAMO = false;    ///< RevMem: the executing instruction is an atomic memory operation
+      unsigned traceCore = 0;   ///< RevMem: core of the executing instruction
+      unsigned traceHart = 0;   ///< RevMem: hart of the executing instruction
+      uint64_t tracePC = 0;     ///< RevMem: address of the executing instruction
+      uint64_t traceCycle = 0;  ///< RevMem: cycle of the executing instruction
+
       std::vector<uint64_t> FutureRes;  ///< RevMem: future operation reservations
 
       std::vector<std::pair<unsigned,uint64_t>> LRSC;   ///< RevMem: load reserve/store conditional vector
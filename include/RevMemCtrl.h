@@ -13,8 +13,11 @@
 
 // -- C++ Headers
 #include <ctime>
+#include <functional>
 #include <vector>
+#include <deque>
 #include <list>
+#include <new>
 #include <algorithm>
 #include <stdio.h>
 #include <stdlib.h>
@@ -29,6 +32,7 @@
 
 // -- RevCPU Headers
 #include "RevOpts.h"
+#include "RevHostProf.h"
 
 // RV{32,64} Register Operation Macros
                     //(r) = ((r) & (~r));
@@ -75,12 +79,65 @@ namespace SST {
     // ----------------------------------------
     enum class RevFlag {
       F_NONCACHEABLE = 1 << 1,/// non cacheable
-      F_SEXT32 = 1 << 17,     /// sign extend the 32bit result
-      F_SEXT64 = 1 << 18,     /// sign extend the 64bit result
-      F_ZEXT32 = 1 << 19,     /// zero extend the 32bit result
-      F_ZEXT64 = 1 << 20      /// zero extend the 64bit result
+      F_SEXT32 = 1 << 17,     /// sign extend the result to a 32bit target
+      F_SEXT64 = 1 << 18,     /// sign extend the result to a 64bit target
+      F_ZEXT32 = 1 << 19,     /// zero extend the result to a 32bit target
+      F_ZEXT64 = 1 << 20,     /// zero extend the result to a 64bit target
+      F_AMOADD = 1 << 21,     /// AMO: add
+      F_AMOXOR = 1 << 22,     /// AMO: xor
+      F_AMOAND = 1 << 23,     /// AMO: and
+      F_AMOOR = 1 << 24,      /// AMO: or
+      F_AMOMIN = 1 << 25,     /// AMO: signed minimum
+      F_AMOMAX = 1 << 26,     /// AMO: signed maximum
+      F_AMOMINU = 1 << 27,    /// AMO: unsigned minimum
+      F_AMOMAXU = 1 << 28,    /// AMO: unsigned maximum
+      F_AMOSWAP = 1 << 29,    /// AMO: swap
+      F_FLOAT64 = 1 << 30     /// widen a single precision result to a double precision target
     };
 
+    /// RevAMOApply: combine the old memory value with the AMO operand; returns the value to store
+    inline uint64_t RevAMOApply( StandardMem::Request::flags_t flags, uint32_t Size,
+                                 uint64_t Old, uint64_t Src ){
+      uint64_t Mask = (Size == 4) ? 0xFFFFFFFFull : ~0x00ull;
+      Old &= Mask;
+      Src &= Mask;
+      // signed comparisons see the operands sign extended from their width
+      int64_t SOld = (Size == 4) ? (int64_t)((int32_t)(Old)) : (int64_t)(Old);
+      int64_t SSrc = (Size == 4) ? (int64_t)((int32_t)(Src)) : (int64_t)(Src);
+      uint32_t F = (uint32_t)(flags);
+      if( F & (uint32_t)(RevFlag::F_AMOADD) )
+        return (Old + Src) & Mask;
+      if( F & (uint32_t)(RevFlag::F_AMOXOR) )
+        return Old ^ Src;
+      if( F & (uint32_t)(RevFlag::F_AMOAND) )
+        return Old & Src;
+      if( F & (uint32_t)(RevFlag::F_AMOOR) )
+        return Old | Src;
+      if( F & (uint32_t)(RevFlag::F_AMOMIN) )
+        return (SOld < SSrc) ? Old : Src;
+      if( F & (uint32_t)(RevFlag::F_AMOMAX) )
+        return (SOld > SSrc) ? Old : Src;
+      if( F & (uint32_t)(RevFlag::F_AMOMINU) )
+        return (Old < Src) ? Old : Src;
+      if( F & (uint32_t)(RevFlag::F_AMOMAXU) )
+        return (Old > Src) ? Old : Src;
+      return Src;   // F_AMOSWAP
+    }
+
+    /// RevAMOResult: deliver the result of an AMO, LR or SC to its target register; a null target discards it
+    inline void RevAMOResult( StandardMem::Request::flags_t flags, uint32_t Size,
+                              uint64_t Old, void *Target ){
+      if( !Target )
+        return ;
+      if( Size == 8 ){
+        *(uint64_t *)(Target) = Old;
+      }else if( (uint32_t)(flags) & (uint32_t)(RevFlag::F_SEXT64) ){
+        *(uint64_t *)(Target) = (uint64_t)((int64_t)((int32_t)(Old)));
+      }else{
+        *(uint32_t *)(Target) = (uint32_t)(Old);
+      }
+    }
+
     // ----------------------------------------
     // RevMemOp
     // ----------------------------------------
@@ -110,6 +167,11 @@ namespace SST {
       RevMemOp( uint64_t Addr, uint64_t PAddr, uint32_t Size, char *buffer,
                 RevMemOp::MemOp Op, StandardMem::Request::flags_t flags );
 
+      /// RevMemOp overloaded constructor; carries an operand and a result target (AMOs, store conditionals)
+      RevMemOp( uint64_t Addr, uint64_t PAddr, uint32_t Size, char *buffer,
+                void *target, RevMemOp::MemOp Op,
+                StandardMem::Request::flags_t flags );
+
       /// RevMemOp overloaded constructor
       RevMemOp( uint64_t Addr, uint64_t PAddr, uint32_t Size, void *target,
                 unsigned CustomOpc, RevMemOp::MemOp Op,
@@ -139,7 +201,7 @@ namespace SST {
       uint32_t getSize() { return Size; }
 
       /// RevMemOp: retrieve the memory buffer
-      std::vector<uint8_t> getBuf() { return membuf; }
+      const std::vector<uint8_t> &getBuf() { return membuf; }
 
       /// RevMemOp: retrieve the memory operation flags
       StandardMem::Request::flags_t getFlags() { return flags; }
@@ -162,9 +224,46 @@ namespace SST {
       /// RevMemOp: retrieve the number of split cache line requests
       unsigned getSplitRqst() { return SplitRqst; }
 
+      /// RevMemOp: records the response to one split cache line request; returns true once all have arrived
+      bool retireSplitRqst() { return (++SplitDone >= SplitRqst); }
+
+      /// RevMemOp: record an operation coalesced into this request
+      void addMerged(RevMemOp *Op) { merged.push_back(Op); }
+
+      /// RevMemOp: retrieve the operations coalesced into this request
+      const std::vector<RevMemOp *> &getMerged() { return merged; }
+
+      /// RevMemOp: widen the request to the target address range
+      void setRange(uint64_t NewAddr, uint32_t NewSize);
+
+      /// RevMemOp: widen a write to cover a contiguous or overlapping younger write and overlay its data
+      void overlayWrite(RevMemOp *Op);
+
+      /// RevMemOp: capture the bytes of a read from a write that covers it; they reach the target when the read completes
+      void forwardFrom(RevMemOp *Op);
+
+      /// RevMemOp: determines if the request lies within a single cache line
+      bool inLine(unsigned LineSize) {
+        return (LineSize > 0) && (Size > 0) && ((Addr/LineSize) == ((Addr+Size-1)/LineSize));
+      }
+
       /// RevMemOp: retrieve the target address
       void *getTarget() { return target; }
 
+      /// RevMemOp: count the operation against its requestor until the result is delivered
+      void setPending(unsigned *P) {
+        pending = P;
+        if( pending )
+          (*pending)++;
+      }
+
+      /// RevMemOp: the result has reached its target; release the requestor
+      void deliver() {
+        if( pending )
+          (*pending)--;
+        pending = nullptr;
+      }
+
       // RevMemOp: determine if the request is cache-able
       bool isCacheable() { if( (flags & 0b10) > 0 ){ return false; } return true; }
 
@@ -176,9 +275,48 @@ namespace SST {
       MemOp Op;           ///< RevMemOp: target memory operation
       unsigned CustomOpc; ///< RevMemOp: custom memory opcode
       unsigned SplitRqst; ///< RevMemOp: number of split cache line requests
+      unsigned SplitDone; ///< RevMemOp: number of split cache line requests that have responded
       std::vector<uint8_t> membuf;          ///< RevMemOp: buffer
+      std::vector<RevMemOp *> merged;       ///< RevMemOp: operations coalesced into this request
       StandardMem::Request::flags_t flags;  ///< RevMemOp: request flags
       void *target;                         ///< RevMemOp: target register pointer
+      unsigned *pending;                    ///< RevMemOp: requestor count of undelivered results
+    };
+
+    // ----------------------------------------
+    // RevRqstMap
+    // ----------------------------------------
+    /// RevRqstMap: open addressing map from outstanding StandardMem request ids to their RevMemOp
+    class RevRqstMap {
+    public:
+      /// RevRqstMap: constructor; Capacity is rounded up to a power of two
+      RevRqstMap( unsigned Capacity = 64 );
+
+      /// RevRqstMap: record the operation that owns an outstanding request
+      void insert( StandardMem::Request::id_t Id, RevMemOp *Op );
+
+      /// RevRqstMap: remove an outstanding request; returns its operation or nullptr if it is unknown
+      RevMemOp *remove( StandardMem::Request::id_t Id );
+
+      /// RevRqstMap: retrieve the number of outstanding requests
+      size_t size() { return count; }
+
+      /// RevRqstMap: determines if there are no outstanding requests
+      bool empty() { return (count == 0); }
+
+    private:
+      /// RevRqstMap: home slot of a request id
+      size_t slot( StandardMem::Request::id_t Id ){
+        return (size_t)((Id * 0x9E3779B97F4A7C15ull) >> shift);
+      }
+
+      /// RevRqstMap: double the table and rehash the outstanding requests
+      void grow();
+
+      std::vector<StandardMem::Request::id_t> keys; ///< RevRqstMap: request ids
+      std::vector<RevMemOp *> vals;                 ///< RevRqstMap: owning operations; nullptr marks a free slot
+      size_t count;                                 ///< RevRqstMap: number of occupied slots
+      unsigned shift;                               ///< RevRqstMap: 64 - log2(table size)
     };
 
     // ----------------------------------------
@@ -215,9 +353,9 @@ namespace SST {
                                     uint32_t Size, bool Inv,
                                     StandardMem::Request::flags_t flags) = 0;
 
-      /// RevMemCtrl: send a read request
+      /// RevMemCtrl: send a read request; a non-null pending counts the request until its data reaches target
       virtual bool sendREADRequest(uint64_t Addr, uint64_t PAddr,
-                                   uint32_t Size, void *target,
+                                   uint32_t Size, void *target, unsigned *pending,
                                    StandardMem::Request::flags_t flags) = 0;
 
       /// RevMemCtrl: send a write request
@@ -235,14 +373,22 @@ namespace SST {
                                         uint32_t Size, char *buffer,
                                         StandardMem::Request::flags_t flags) = 0;
 
+      /// RevMemCtrl: send an AMO request; the flags select the operation
+      virtual bool sendAMORequest(uint64_t Addr, uint64_t PAddr,
+                                  uint32_t Size, char *buffer, void *target,
+                                  unsigned *pending,
+                                  StandardMem::Request::flags_t flags) = 0;
+
       /// RevMemCtrl: send a loadlink request
       virtual bool sendLOADLINKRequest(uint64_t Addr, uint64_t PAddr,
-                                       uint32_t Size,
+                                       uint32_t Size, void *target,
+                                       unsigned *pending,
                                        StandardMem::Request::flags_t flags) = 0;
 
-      /// RevMemCtrl: send a storecond request
+      /// RevMemCtrl: send a storecond request; target receives zero on success
       virtual bool sendSTORECONDRequest(uint64_t Addr, uint64_t PAddr,
-                                        uint32_t Size, char *buffer,
+                                        uint32_t Size, char *buffer, void *target,
+                                        unsigned *pending,
                                         StandardMem::Request::flags_t flags) = 0;
 
       /// RevMemCtrl: send an void custom read memory request
@@ -260,6 +406,14 @@ namespace SST {
       /// RevMemCtrl: send a FENCE request
       virtual bool sendFENCE() = 0;
 
+      /// RevMemCtrl: send an instruction fetch request; a non-null pending counts the request until its data reaches target
+      virtual bool sendIFETCHRequest(uint64_t Addr, uint64_t PAddr,
+                                     uint32_t Size, void *target, unsigned *pending,
+                                     StandardMem::Request::flags_t flags) = 0;
+
+      /// RevMemCtrl: queue an untimed write for the init phase; returns false once the init phase has passed
+      virtual bool sendINITWrite(uint64_t Addr, uint32_t Size, char *buffer) = 0;
+
       /// RevMemCtrl: handle a read response
       virtual void handleReadResp(StandardMem::ReadResp* ev) = 0;
 
@@ -281,8 +435,16 @@ namespace SST {
       /// RevMemCtrl: returns the cache line size
       virtual unsigned getLineSize() = 0;
 
+      /// RevMemCtrl: registers a handler invoked with the address of each read or write as it completes
+      void setCompletionHandler(std::function<void(uint64_t,bool)> Handler) { completion = Handler; }
+
+      /// RevMemCtrl: charge the controller clock to the simulator self profile; nullptr disables
+      void setHostProf(RevHostProf *Prof) { hostProf = Prof; }
+
     protected:
       SST::Output *output;        ///< RevMemCtrl: sst output object
+      std::function<void(uint64_t,bool)> completion; ///< RevMemCtrl: read/write completion handler
+      RevHostProf *hostProf = nullptr;  ///< RevMemCtrl: simulator self profile
     }; // class RevMemCtrl
 
     // ----------------------------------------
@@ -306,10 +468,13 @@ namespace SST {
                               { "max_readlock",   "Sets the maxmium number of outstanding readlock events",   "64"},
                               { "max_writeunlock","Sets the maximum number of outstanding writeunlock events","64"},
                               { "max_custom",     "Sets the maximum number of outstanding custom events",     "64"},
-                              { "ops_per_cycle",  "Sets the maximum number of operations to issue per cycle", "2" }
+                              { "ops_per_cycle",  "Sets the maximum number of operations to issue per cycle", "2" },
+                              { "max_ifetch",     "Sets the maximum number of outstanding instruction fetches on iMemIface", "16"},
+                              { "ifetch_per_cycle","Sets the maximum number of instruction fetches to issue per cycle on iMemIface", "1"}
       )
 
-      SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS({ "memIface", "Set the interface to memory", "SST::Interfaces::StandardMem" })
+      SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS({ "memIface", "Set the interface to memory", "SST::Interfaces::StandardMem" },
+                                          { "iMemIface", "Set the optional instruction fetch interface to memory", "SST::Interfaces::StandardMem" })
 
       SST_ELI_DOCUMENT_PORTS()
 
@@ -335,7 +500,13 @@ namespace SST {
         {"CustomInFlight",      "Counts the number of custom commands in flight",   "count", 1},
         {"CustomPending",       "Counts the number of custom commands pending",     "count", 1},
         {"CustomBytes",         "Counts the number of bytes in custom transactions","bytes", 1},
-        {"FencePending",        "Counts the number of fence operations pending",    "count", 1}
+        {"FencePending",        "Counts the number of fence operations pending",    "count", 1},
+        {"IFetchInFlight",      "Counts the number of instruction fetches in flight","count", 1},
+        {"IFetchPending",       "Counts the number of instruction fetches pending", "count", 1},
+        {"IFetchBytes",         "Counts the number of instruction bytes fetched",   "bytes", 1},
+        {"ReadsMerged",         "Counts the number of reads coalesced into a queued line read",   "count", 1},
+        {"WritesMerged",        "Counts the number of writes coalesced into a queued write",      "count", 1},
+        {"LoadsForwarded",      "Counts the number of reads satisfied from a pending write",      "count", 1}
       )
 
       typedef enum{
@@ -360,7 +531,13 @@ namespace SST {
         CustomInFlight      = 18,
         CustomPending       = 19,
         CustomBytes         = 20,
-        FencePending        = 21
+        FencePending        = 21,
+        IFetchInFlight      = 22,
+        IFetchPending       = 23,
+        IFetchBytes         = 24,
+        ReadsMerged         = 25,
+        WritesMerged        = 26,
+        LoadsForwarded      = 27
       }MemCtrlStats;
 
       /// RevBasicMemCtrl: constructor
@@ -390,6 +567,9 @@ namespace SST {
       /// RevBasicMemCtrl: memory event processing handler
       void processMemEvent(StandardMem::Request* ev);
 
+      /// RevBasicMemCtrl: instruction fetch event processing handler
+      void processIMemEvent(StandardMem::Request* ev);
+
       /// RevBasicMemCtrl: send a flush request
       virtual bool sendFLUSHRequest(uint64_t Addr, uint64_t PAdr, uint32_t Size,
                                     bool Inv,
@@ -397,7 +577,7 @@ namespace SST {
 
       /// RevBasicMemCtrl: send a read request
       virtual bool sendREADRequest(uint64_t Addr, uint64_t PAddr,
-                                   uint32_t Size, void *target,
+                                   uint32_t Size, void *target, unsigned *pending,
                                    StandardMem::Request::flags_t flags) override;
 
       /// RevBasicMemCtrl: send a write request
@@ -415,14 +595,22 @@ namespace SST {
                                         uint32_t Size, char *buffer,
                                         StandardMem::Request::flags_t flags) override;
 
+      /// RevBasicMemCtrl: send an AMO request; issued as a readlock whose response sends the writeunlock
+      virtual bool sendAMORequest(uint64_t Addr, uint64_t PAddr,
+                                  uint32_t Size, char *buffer, void *target,
+                                  unsigned *pending,
+                                  StandardMem::Request::flags_t flags) override;
+
       // RevBasicMemCtrl: send a loadlink request
       virtual bool sendLOADLINKRequest(uint64_t Addr, uint64_t PAddr,
-                                       uint32_t Size,
+                                       uint32_t Size, void *target,
+                                       unsigned *pending,
                                        StandardMem::Request::flags_t flags) override;
 
       // RevBasicMemCtrl: send a storecond request
       virtual bool sendSTORECONDRequest(uint64_t Addr, uint64_t PAddr,
-                                        uint32_t Size, char *buffer,
+                                        uint32_t Size, char *buffer, void *target,
+                                        unsigned *pending,
                                         StandardMem::Request::flags_t flags) override;
 
       // RevBasicMemCtrl: send an void custom read memory request
@@ -440,6 +628,14 @@ namespace SST {
       // RevBasicMemCtrl: send a FENCE request
       virtual bool sendFENCE() override;
 
+      /// RevBasicMemCtrl: send an instruction fetch request
+      virtual bool sendIFETCHRequest(uint64_t Addr, uint64_t PAddr,
+                                     uint32_t Size, void *target, unsigned *pending,
+                                     StandardMem::Request::flags_t flags) override;
+
+      /// RevBasicMemCtrl: queue an untimed write for the init phase
+      virtual bool sendINITWrite(uint64_t Addr, uint32_t Size, char *buffer) override;
+
       /// RevBasicMemCtrl: handle a read response
       virtual void handleReadResp(StandardMem::ReadResp* ev) override;
 
@@ -458,6 +654,9 @@ namespace SST {
       /// RevBasicMemCtrl: handle RevMemCtrl flags for write responses
       virtual void handleFlagResp(RevMemOp *op) override;
 
+      /// RevBasicMemCtrl: complete the readlock of an AMO and send its writeunlock
+      void handleAMOResp(RevMemOp *op, StandardMem::ReadResp* ev);
+
     protected:
       // ----------------------------------------
       // RevStdMemHandlers
@@ -505,6 +704,12 @@ namespace SST {
                         unsigned &t_max_readlock, unsigned &t_max_writeunlock,
                         unsigned &t_max_custom);
 
+      /// RevBasicMemCtrl: process the next instruction fetch request
+      bool processNextIFetch();
+
+      /// RevBasicMemCtrl: handle an instruction fetch read response
+      void handleIFetchResp(StandardMem::ReadResp* ev);
+
       /// RevBasicMemCtrl: build a standard memory request
       bool buildStandardMemRqst(RevMemOp *op, bool &Success);
 
@@ -514,6 +719,70 @@ namespace SST {
       /// RevBasicMemCtrl: build cache-aligned requests
       bool buildCacheMemRqst(RevMemOp *op, bool &Success);
 
+      /// RevBasicMemCtrl: notify the completion handler and release the operation; coalesced requests retire each of their operations
+      void retireOp(RevMemOp *op){
+        if( !op->getMerged().empty() ){
+          for( unsigned i=0; i<op->getMerged().size(); i++ ){
+            retireOp(op->getMerged()[i]);
+          }
+          freeOp(op);
+          return ;
+        }
+        op->deliver();
+        if( completion ){
+          completion(op->getAddr(), (op->getOp() == RevMemOp::MemOp::MemOpWRITE));
+        }
+        freeOp(op);
+      }
+
+      /// RevBasicMemCtrl: construct a memory operation in storage recycled from the operation pool
+      template<typename... Args>
+      RevMemOp *allocOp(Args&&... args){
+        void *Mem = nullptr;
+        if( opPool.empty() ){
+          Mem = ::operator new(sizeof(RevMemOp));
+        }else{
+          Mem = opPool.back();
+          opPool.pop_back();
+        }
+        return new (Mem) RevMemOp(std::forward<Args>(args)...);
+      }
+
+      /// RevBasicMemCtrl: destroy a memory operation and return its storage to the operation pool
+      void freeOp(RevMemOp *op){
+        if( op == fwdWrite )
+          fwdWrite = nullptr;
+        op->~RevMemOp();
+        opPool.push_back((void *)(op));
+      }
+
+      /// RevBasicMemCtrl: append an operation to the request queue of its class
+      void queueOp(RevMemOp *op);
+
+      /// RevBasicMemCtrl: remove the oldest operation from the request queue of a class
+      void dequeueOp(unsigned q);
+
+      /// RevBasicMemCtrl: coalesce a read into the open line read or forward it from the youngest write; returns false if it must be queued
+      bool mergeRead(RevMemOp *op);
+
+      /// RevBasicMemCtrl: coalesce a write into the open write; returns false if it must be queued
+      bool mergeWrite(RevMemOp *op);
+
+      /// RevBasicMemCtrl: stop coalescing into queued requests that a new operation must not be reordered with
+      void closeMerges(RevMemOp *op);
+
+      /// RevBasicMemCtrl: determines whether the head of a class queue touches the bytes of an older queued operation of another class
+      bool hasOlderConflict(unsigned q);
+
+      /// RevBasicMemCtrl: record and send a request on behalf of an operation
+      void sendRqst(Interfaces::StandardMem::Request *rqst, RevMemOp *op){
+        outstanding.insert(rqst->getID(), op);
+        memIface->send(rqst);
+      }
+
+      /// RevBasicMemCtrl: remove the operation of a response from the outstanding requests
+      RevMemOp *claimRqst(StandardMem::Request *ev, const char *Kind);
+
       /// RevBasicMemCtrl: register statistics
       void registerStats();
 
@@ -529,14 +798,14 @@ namespace SST {
       /// RevBasicMemCtrl: Retrieve the base cache line request size
       unsigned getBaseCacheLineSize(uint64_t Addr, uint32_t Size);
 
-      /// RevBasicMemCtrl: retrieve the number of outstanding requests on the wire
-      unsigned getNumSplitRqsts(RevMemOp *op);
-
       // -- private data members
       StandardMem* memIface;                  ///< StandardMem memory interface
+      StandardMem* iMemIface;                 ///< StandardMem instruction fetch interface
       RevStdMemHandlers* stdMemHandlers;      ///< StandardMem interface response handlers
       bool hasCache;                          ///< detects whether cache layers are present
       unsigned lineSize;                      ///< cache line size
+      bool iHasCache;                         ///< detects whether cache layers are present on iMemIface
+      unsigned iLineSize;                     ///< instruction fetch cache line size
       unsigned max_loads;                     ///< maximum number of outstanding loads
       unsigned max_stores;                    ///< maximum number of outstanding stores
       unsigned max_flush;                     ///< maximum number of oustanding flush events
@@ -545,6 +814,8 @@ namespace SST {
       unsigned max_writeunlock;               ///< maximum number of oustanding writelock events
       unsigned max_custom;                    ///< maximum number of oustanding custom events
       unsigned max_ops;                       ///< maximum number of ops to issue per cycle
+      unsigned max_ifetch;                    ///< maximum number of outstanding instruction fetches
+      unsigned max_ifetch_ops;                ///< maximum number of instruction fetches to issue per cycle
 
       uint64_t num_read;                      ///< number of outstanding read requests
       uint64_t num_write;                     ///< number of outstanding write requests
@@ -554,10 +825,24 @@ namespace SST {
       uint64_t num_writeunlock;               ///< number of oustanding writelock requests
       uint64_t num_custom;                    ///< number of outstanding custom requests
       uint64_t num_fence;                     ///< number of oustanding fence requests
-
-      std::vector<StandardMem::Request::id_t> requests;               ///< outstanding StandardMem requests
-      std::vector<RevMemOp *> rqstQ;                                  ///< queued memory requests
-      std::map<StandardMem::Request::id_t,RevMemOp *> outstanding;    ///< map of outstanding requests
+      uint64_t num_ifetch;                    ///< number of outstanding instruction fetch requests
+
+      static const unsigned NumOpQueues = RevMemOp::MemOp::MemOpFENCE + 1; ///< number of memory operation classes
+
+      std::deque<std::pair<uint64_t,RevMemOp *>> rqstQ[NumOpQueues];  ///< queued memory requests per operation class, tagged with their issue order
+      uint64_t rqstSeq;                                               ///< issue order of the next queued memory request
+      uint64_t rqstCount;                                             ///< number of queued memory requests
+      RevRqstMap outstanding;                                         ///< map of outstanding requests
+      std::deque<RevMemOp *> ifetchQ;                                 ///< queued instruction fetch requests
+      RevRqstMap ioutstanding;                                        ///< map of outstanding instruction fetch requests
+      std::vector<void *> opPool;                                     ///< storage of released memory operations
+      RevMemOp *openRead;                                             ///< queued read that younger reads to its line may coalesce into
+      RevMemOp *openWrite;                                            ///< queued write that younger adjacent writes may coalesce into
+      RevMemOp *fwdWrite;                                             ///< youngest queued or in flight write that reads may forward from
+      std::vector<RevMemOp *> fwdQ;                                   ///< forwarded reads that complete on the next clock
+      std::vector<StandardMem::Request *> initQ;                      ///< untimed writes awaiting the init phase
+      uint64_t initBytes;                                             ///< bytes queued for the init phase
+      bool initDone;                                                  ///< the init phase has passed
 
       std::vector<Statistic<uint64_t>*> stats;                        ///< statistics vector
 
@@ -0,0 +1,179 @@
+//
+// _RevMemReplay_h_
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#ifndef _SST_REVCPU_REVMEMREPLAY_H_
+#define _SST_REVCPU_REVMEMREPLAY_H_
+
+// -- C++ Headers
+#include <cstdio>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+// -- SST Headers
+#include <sst/core/sst_config.h>
+#include <sst/core/component.h>
+
+// -- RevCPU Headers
+#include "RevMemCtrl.h"
+#include "RevMemTrace.h"
+
+// records read from the trace per refill
+#define REVREPLAY_READ_RECS 4096
+
+namespace SST {
+  namespace RevCPU {
+    class RevMemReplay : public SST::Component {
+
+    public:
+      /// RevMemReplay: top-level SST component constructor
+      RevMemReplay( SST::ComponentId_t id, SST::Params& params );
+
+      /// RevMemReplay: top-level SST component destructor
+      ~RevMemReplay();
+
+      /// RevMemReplay: standard SST component 'setup' function
+      void setup();
+
+      /// RevMemReplay: standard SST component 'finish' function
+      void finish();
+
+      /// RevMemReplay: standard SST component 'init' function
+      void init( unsigned int phase );
+
+      /// RevMemReplay: standard SST component clock function
+      bool clockTick( SST::Cycle_t currentCycle );
+
+      // -------------------------------------------------------
+      // RevMemReplay Component Registration Data
+      // -------------------------------------------------------
+      /// RevMemReplay: Register the component with the SST core
+      SST_ELI_REGISTER_COMPONENT(
+                                  RevMemReplay,                       // component class
+                                  "revcpu",                           // component library
+                                  "RevMemReplay",                     // component name
+                                  SST_ELI_ELEMENT_VERSION( 1, 0, 0 ),
+                                  "Replays a Rev memory access trace into a Rev memory controller",
+                                  COMPONENT_CATEGORY_PROCESSOR
+                                )
+
+      // -------------------------------------------------------
+      // RevMemReplay Component Parameter Data
+      // -------------------------------------------------------
+      SST_ELI_DOCUMENT_PARAMS(
+        {"verbose",         "Sets the verbosity level of output",           "0" },
+        {"clock",           "Clock for the replay driver",                  "1GHz" },
+        {"trace",           "Memory access trace written by RevCPU memTrace", "memtrace.mtr" },
+        {"core",            "Replay a single core; -1 replays every core",  "-1" },
+        {"timing",          "Preserve the recorded cycle gaps between the accesses of each hart", "1" },
+        {"maxOutstanding",  "Maximum outstanding accesses per hart",        "16" },
+        {"physical",        "Issue the recorded physical rather than virtual addresses", "0" },
+        {"lookahead",       "Maximum accesses buffered per hart ahead of issue", "64" }
+      )
+
+      // -------------------------------------------------------
+      // RevMemReplay Port Parameter Data
+      // -------------------------------------------------------
+      SST_ELI_DOCUMENT_PORTS(
+      )
+
+      // -------------------------------------------------------
+      // RevMemReplay SubComponent Parameter Data
+      // -------------------------------------------------------
+      SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
+        {"memory", "Memory controller to drive", "SST::RevCPU::RevMemCtrl"}
+      )
+
+      // -------------------------------------------------------
+      // RevMemReplay Statistics Data
+      // -------------------------------------------------------
+      SST_ELI_DOCUMENT_STATISTICS(
+        {"ReplayReads",       "Reads issued to the memory controller",          "count", 1},
+        {"ReplayWrites",      "Writes issued to the memory controller",         "count", 1},
+        {"ReplayAMOs",        "Atomic memory operations issued",                "count", 1},
+        {"DependencyStalls",  "Hart cycles stalled on an outstanding dependent access", "count", 1},
+        {"WindowStalls",      "Hart cycles stalled on the outstanding access limit", "count", 1},
+        {"GapCycles",         "Hart cycles spent waiting out recorded timing gaps", "count", 1}
+      )
+
+    private:
+      /// RevMemReplay: outstanding access
+      typedef struct{
+        uint64_t Addr;          ///< RevMemReplay: issued address
+        uint32_t Size;          ///< RevMemReplay: access size in bytes
+        bool Write;             ///< RevMemReplay: the access is a write
+        bool AMO;               ///< RevMemReplay: the access belongs to an atomic memory operation
+      }RevReplayAccess;
+
+      /// RevMemReplay: per-hart replay stream
+      typedef struct{
+        std::deque<RevMemTrace::RevMemTraceRec> pending;  ///< RevMemReplay: accesses awaiting issue
+        std::vector<RevReplayAccess> outstanding;         ///< RevMemReplay: accesses awaiting completion
+        uint64_t lastCycle;     ///< RevMemReplay: recorded cycle of the last issued access
+        uint64_t lastIssue;     ///< RevMemReplay: replay cycle of the last issued access
+        bool started;           ///< RevMemReplay: an access has been issued
+      }RevReplayStream;
+
+      SST::Output output;                 ///< RevMemReplay: SST output handler
+      RevMemCtrl *Ctrl;                   ///< RevMemReplay: driven memory controller
+      FILE *trace;                        ///< RevMemReplay: memory access trace
+      std::string traceFile;              ///< RevMemReplay: memory access trace file name
+      int core;                           ///< RevMemReplay: replayed core; -1 for all
+      bool timing;                        ///< RevMemReplay: preserve recorded gaps
+      bool physical;                      ///< RevMemReplay: issue physical addresses
+      unsigned maxOutstanding;            ///< RevMemReplay: outstanding accesses per hart
+      unsigned lookahead;                 ///< RevMemReplay: buffered accesses per hart
+
+      std::vector<uint8_t> readBuf;       ///< RevMemReplay: raw records read from the trace
+      unsigned readPos;                   ///< RevMemReplay: next raw record
+      unsigned readCount;                 ///< RevMemReplay: raw records in the buffer
+      bool eof;                           ///< RevMemReplay: the trace has been consumed
+      bool held;                          ///< RevMemReplay: the decoded record waits for room in its stream
+      RevMemTrace::RevMemTraceRec next;   ///< RevMemReplay: next decoded record
+
+      std::vector<RevReplayStream> streams;           ///< RevMemReplay: replay streams
+      std::map<uint64_t,unsigned> streamIdx;          ///< RevMemReplay: core/hart to stream index
+      std::map<std::pair<uint64_t,bool>,std::deque<unsigned>> inflight; ///< RevMemReplay: address/write to issuing streams
+      unsigned numOutstanding;            ///< RevMemReplay: accesses awaiting completion
+      uint64_t replayed;                  ///< RevMemReplay: accesses issued
+      std::vector<uint8_t> sink;          ///< RevMemReplay: read target and write source
+
+      std::vector<Statistic<uint64_t>*> stats; ///< RevMemReplay: statistics vector
+
+      /// RevMemReplay: statistics indices
+      typedef enum{
+        ReplayReads       = 0,
+        ReplayWrites      = 1,
+        ReplayAMOs        = 2,
+        DependencyStalls  = 3,
+        WindowStalls      = 4,
+        GapCycles         = 5
+      }ReplayStats;
+
+      /// RevMemReplay: decode the next record of the trace; returns false at the end of the trace
+      bool ReadNext();
+
+      /// RevMemReplay: distribute trace records into the stream lookahead buffers
+      void Refill();
+
+      /// RevMemReplay: determine whether the access depends on an outstanding access of its stream
+      bool HasDependency(RevReplayStream &S, const RevMemTrace::RevMemTraceRec &R);
+
+      /// RevMemReplay: attempt to issue the next access of a stream
+      void IssueStream(unsigned Idx, SST::Cycle_t currentCycle);
+
+      /// RevMemReplay: completion handler registered with the memory controller
+      void Complete(uint64_t Addr, bool Write);
+    };
+  } // namespace RevCPU
+} // namespace SST
+
+#endif // _SST_REVCPU_REVMEMREPLAY_H_
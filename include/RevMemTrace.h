@@ -0,0 +1,156 @@
+//
+// _RevMemTrace_h_
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#ifndef _SST_REVCPU_REVMEMTRACE_H_
+#define _SST_REVCPU_REVMEMTRACE_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace SST{
+namespace RevCPU {
+
+#define REVMTR_MAGIC      "REVMTR01"
+#define REVMTR_REC_BYTES  40
+#define REVMTR_CHUNK_RECS 32768
+#define REVMTR_CHUNKS     8
+
+class RevMemTrace{
+public:
+  /// RevMemTrace: access types
+  typedef enum{
+    MemTraceRead  = 0,      ///< RevMemTrace: data load
+    MemTraceWrite = 1,      ///< RevMemTrace: data store
+    MemTraceAMORead  = 2,   ///< RevMemTrace: read half of an atomic memory operation
+    MemTraceAMOWrite = 3    ///< RevMemTrace: write half of an atomic memory operation
+  }MemTraceOp;
+
+  /// RevMemTrace: sampled memory access record
+  typedef struct{
+    uint64_t Cycle;         ///< RevMemTrace: core cycle of the issuing instruction
+    uint64_t PC;            ///< RevMemTrace: address of the issuing instruction
+    uint64_t Addr;          ///< RevMemTrace: virtual data address
+    uint64_t PAddr;         ///< RevMemTrace: physical data address
+    uint32_t Core;          ///< RevMemTrace: issuing core
+    uint16_t Hart;          ///< RevMemTrace: issuing hart
+    uint8_t Size;           ///< RevMemTrace: access size in bytes
+    uint8_t Op;             ///< RevMemTrace: MemTraceOp
+  }RevMemTraceRec;
+
+  /// RevMemTrace: default constructor; opens the trace file and starts the writer
+  RevMemTrace(const std::string &File, unsigned Sample,
+              const std::vector<std::pair<uint64_t,uint64_t>> &Filters);
+
+  /// RevMemTrace: default destructor; drains the buffer and stops the writer
+  ~RevMemTrace();
+
+  /// RevMemTrace: parses a lo:hi address filter; returns false if malformed
+  static bool ParseFilter(const std::string &Filter, std::pair<uint64_t,uint64_t> &Range);
+
+  /// RevMemTrace: determines whether the trace file was opened
+  bool IsOpen() { return (file != nullptr); }
+
+  /// RevMemTrace: records an access if it passes the address filters and the sampler
+  void Record(uint64_t Cycle, uint64_t PC, uint64_t Addr, uint64_t PAddr,
+              unsigned Core, unsigned Hart, size_t Size, MemTraceOp Op){
+    if( !filters.empty() && !Match(Addr) ){
+      return ;
+    }
+    if( --skip ){
+      return ;
+    }
+    skip = sample;
+    if( count == REVMTR_CHUNK_RECS ){
+      Submit();
+    }
+    if( dropping ){
+      dropped++;
+      return ;
+    }
+    RevMemTraceRec &R = chunks[cur][count++];
+    R.Cycle = Cycle;
+    R.PC    = PC;
+    R.Addr  = Addr;
+    R.PAddr = PAddr;
+    R.Core  = (uint32_t)(Core);
+    R.Hart  = (uint16_t)(Hart);
+    R.Size  = (uint8_t)(Size);
+    R.Op    = (uint8_t)(Op);
+    records++;
+  }
+
+  /// RevMemTrace: hand the buffered records to the writer and wait for them to reach the file
+  void Flush();
+
+  /// RevMemTrace: retrieve the number of records written
+  uint64_t GetRecords() { return records; }
+
+  /// RevMemTrace: retrieve the number of sampled records lost to a full buffer
+  uint64_t GetDropped() { return dropped; }
+
+private:
+  FILE *file;                                 ///< RevMemTrace: trace file
+  unsigned sample;                            ///< RevMemTrace: record one in every sample accesses
+  unsigned skip;                              ///< RevMemTrace: accesses until the next sample
+  std::vector<std::pair<uint64_t,uint64_t>> filters; ///< RevMemTrace: traced [lo,hi) address ranges
+  std::vector<std::vector<RevMemTraceRec>> chunks; ///< RevMemTrace: ring of record chunks
+  unsigned cur;                               ///< RevMemTrace: chunk being filled
+  unsigned count;                             ///< RevMemTrace: records in the current chunk
+  bool dropping;                              ///< RevMemTrace: no chunk was free; records are discarded
+  uint64_t records;                           ///< RevMemTrace: records kept
+  uint64_t dropped;                           ///< RevMemTrace: records discarded
+
+  std::vector<unsigned> fill;                 ///< RevMemTrace: record count of each chunk handed to the writer
+  std::deque<unsigned> freeQ;                 ///< RevMemTrace: chunks available to the producer
+  std::deque<unsigned> fullQ;                 ///< RevMemTrace: chunks waiting for the writer
+  std::mutex lock;                            ///< RevMemTrace: protects the chunk queues
+  std::condition_variable freeCV;             ///< RevMemTrace: signals a chunk was released
+  std::condition_variable fullCV;             ///< RevMemTrace: signals a chunk was submitted
+  bool done;                                  ///< RevMemTrace: the writer should exit once drained
+  std::thread writer;                         ///< RevMemTrace: background writer thread
+  std::vector<uint8_t> buf;                   ///< RevMemTrace: encoding buffer; only touched by the writer
+
+  /// RevMemTrace: determines whether the address falls in a traced range
+  bool Match(uint64_t Addr){
+    for( unsigned i=0; i<filters.size(); i++ ){
+      if( (Addr >= filters[i].first) && (Addr < filters[i].second) )
+        return true;
+    }
+    return false;
+  }
+
+  /// RevMemTrace: hand the current chunk to the writer and claim a free one without waiting
+  void Submit();
+
+  /// RevMemTrace: writer thread body
+  void Run();
+
+  /// RevMemTrace: encode a chunk into the trace file
+  void Encode(const std::vector<RevMemTraceRec> &Chunk, unsigned Count);
+
+  /// RevMemTrace: append a little endian value to the encoding buffer
+  void Put(uint64_t Val, unsigned Bytes){
+    for( unsigned i=0; i<Bytes; i++ ){
+      buf.push_back((uint8_t)(Val >> (8*i)));
+    }
+  }
+};
+
+} // namespace RevCPU
+} // namespace SST
+
+#endif // _SST_REVCPU_REVMEMTRACE_H_
@@ -62,6 +62,33 @@ namespace SST {
       /// RevOpts: initialize the prefetch depths
       bool InitPrefetchDepth( std::vector<std::string> Depths );
 
+      /// RevOpts: initialize the branch predictor types
+      bool InitBranchPred( std::vector<std::string> Preds );
+
+      /// RevOpts: initialize the branch misprediction redirect penalties
+      bool InitBranchPenalty( std::vector<std::string> Penalties );
+
+      /// RevOpts: initialize the branch predictor pattern table sizes
+      bool InitBranchPredEntries( std::vector<std::string> Entries );
+
+      /// RevOpts: initialize the branch target buffer sizes
+      bool InitBTBEntries( std::vector<std::string> Entries );
+
+      /// RevOpts: initialize the return address stack depths
+      bool InitRASDepth( std::vector<std::string> Depths );
+
+      /// RevOpts: initialize the macro-op fusion policies
+      bool InitFusion( std::vector<std::string> Policies );
+
+      /// RevOpts: initialize the hot block translation modes
+      bool InitJIT( std::vector<std::string> Modes );
+
+      /// RevOpts: initialize the guest profile output prefixes
+      bool InitProfile( std::vector<std::string> Prefixes );
+
+      /// RevOpts: initialize the instruction trace output prefixes
+      bool InitTrace( std::vector<std::string> Prefixes );
+
       /// RevOpts: retrieve the start address for the target core
       bool GetStartAddr( unsigned Core, uint64_t &StartAddr );
 
@@ -80,6 +107,33 @@ namespace SST {
       /// RevOpts: retrieve the prefetch depth for the target core
       bool GetPrefetchDepth( unsigned Core, unsigned &Depth );
 
+      /// RevOpts: retrieve the branch predictor type for the target core
+      bool GetBranchPred( unsigned Core, std::string &Pred );
+
+      /// RevOpts: retrieve the branch redirect penalty for the target core
+      bool GetBranchPenalty( unsigned Core, unsigned &Penalty );
+
+      /// RevOpts: retrieve the branch predictor pattern table size for the target core
+      bool GetBranchPredEntries( unsigned Core, unsigned &Entries );
+
+      /// RevOpts: retrieve the branch target buffer size for the target core
+      bool GetBTBEntries( unsigned Core, unsigned &Entries );
+
+      /// RevOpts: retrieve the return address stack depth for the target core
+      bool GetRASDepth( unsigned Core, unsigned &Depth );
+
+      /// RevOpts: retrieve the macro-op fusion policy for the target core
+      bool GetFusion( unsigned Core, std::string &Policy );
+
+      /// RevOpts: retrieve the hot block translation mode for the target core
+      bool GetJIT( unsigned Core, std::string &Mode );
+
+      /// RevOpts: retrieve the guest profile output prefix for the target core
+      bool GetProfile( unsigned Core, std::string &Prefix );
+
+      /// RevOpts: retrieve the instruction trace output prefix for the target core
+      bool GetTrace( unsigned Core, std::string &Prefix );
+
     private:
       unsigned numCores;                            ///< RevOpts: number of initialized cores
       int verbosity;                                ///< RevOpts: verbosity level
@@ -89,12 +143,29 @@ namespace SST {
       std::map<unsigned,std::string> machine;       ///< RevOpts: map of core id to machine model
       std::map<unsigned,std::string> table;         ///< RevOpts: map of core id to inst table
       std::map<unsigned,unsigned> prefetchDepth;    ///< RevOpts: map of core id to prefretch depth
+      std::map<unsigned,std::string> branchPred;    ///< RevOpts: map of core id to branch predictor type
+      std::map<unsigned,unsigned> branchPenalty;    ///< RevOpts: map of core id to branch redirect penalty
+      std::map<unsigned,unsigned> bpredEntries;     ///< RevOpts: map of core id to pattern table entries
+      std::map<unsigned,unsigned> btbEntries;       ///< RevOpts: map of core id to BTB entries
+      std::map<unsigned,unsigned> rasDepth;         ///< RevOpts: map of core id to RAS depth
+      std::map<unsigned,std::string> fusion;        ///< RevOpts: map of core id to fusion policy
+      std::map<unsigned,std::string> jit;           ///< RevOpts: map of core id to hot block translation mode
+      std::map<unsigned,std::string> profile;       ///< RevOpts: map of core id to guest profile output prefix
+      std::map<unsigned,std::string> trace;         ///< RevOpts: map of core id to instruction trace output prefix
 
       std::vector<std::pair<unsigned,unsigned>> memCosts; ///< RevOpts: vector of memory cost ranges
 
       /// RevOpts: splits a string into tokens
       void splitStr(const std::string& s,char c,std::vector<std::string>& v);
 
+      /// RevOpts: parses a set of core:value pairs into the target map
+      bool InitCoreValues( std::vector<std::string> Values,
+                           std::map<unsigned,unsigned> &Target );
+
+      /// RevOpts: parses a set of core:string pairs into the target map
+      bool InitCoreStrings( std::vector<std::string> Values,
+                            std::map<unsigned,std::string> &Target );
+
     }; // class RevOpts
   } // namespace RevCPU
 } // namespace SST
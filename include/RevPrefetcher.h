@@ -12,6 +12,7 @@
 #define _SST_REVCPU_REVPREFETCHER_H_
 
 #include <vector>
+#include <cassert>
 
 #include "../include/RevMem.h"
 #include "../include/RevFeature.h"
@@ -19,43 +20,71 @@
 namespace SST{
 namespace RevCPU {
 
-#define REVPREF_INIT_ADDR ((uint32_t)(0xdeadbeef))
+#define REVPREF_INVALID   (~(uint64_t)(0x00ull))
+#define REVPREF_NUM_STREAMS 4
 
 class RevPrefetcher{
 public:
   /// RevPrefetcher: default constructor
-  RevPrefetcher(RevMem *Mem, unsigned Depth)
-    : mem(Mem), depth(Depth){}
+  RevPrefetcher(RevMem *Mem, unsigned Depth);
 
   /// RevPrefetcher: default destructor
-  ~RevPrefetcher(){
-    // delete all the existing streams
-    baseAddr.clear();
-    for( unsigned i=0; i<iStack.size(); i++ ){
-      delete [] iStack[i];
-    }
-  }
+  ~RevPrefetcher();
 
-  /// RevPrefetcher: fetch the next instruction
-  bool InstFetch(uint64_t Addr, bool &Fetched, uint32_t &Inst);
+  /// RevPrefetcher: determines if the target instruction is already cached in a stream; returns it in Inst
+  bool IsAvail(uint64_t Addr, uint32_t &Inst);
 
-  /// RevPrefetcher: determines in the target instruction is already cached in a stream
-  bool IsAvail(uint64_t Addr);
+  /// RevPrefetcher: retrieve the target instruction only if a stream already holds it; never fills a stream or updates the statistics
+  bool IsResident(uint64_t Addr, uint32_t &Inst);
+
+  /// RevPrefetcher: discard every stream such that subsequent fetches observe modified instructions
+  void Invalidate();
+
+  /// RevPrefetcher: retrieve the number of fetches serviced from a stream
+  uint64_t GetHits() { return hits; }
+
+  /// RevPrefetcher: retrieve the number of fetches that missed every stream
+  uint64_t GetMisses() { return misses; }
+
+  /// RevPrefetcher: retrieve the number of fetch attempts waiting on a fill
+  uint64_t GetStalls() { return stalls; }
 
 private:
+  /// RevPrefetcher: lookup status of a stream access
+  typedef enum{
+    PrefReady   = 0,    ///< data is present in the stream
+    PrefPending = 1,    ///< the stream is allocated, data is in flight
+    PrefMiss    = 2     ///< no stream holds the address
+  }PrefStatus;
+
   RevMem *mem;                                ///< RevMem object
-  unsigned depth;                             ///< Depth of each prefetcher stream
-  std::vector<uint64_t> baseAddr;             ///< Vector of base addresses for each stream
-  std::vector<uint32_t*> iStack;              ///< Vector of instruction vectors
+  unsigned depth;                             ///< Depth of each prefetcher stream (in 32bit words)
+  unsigned blockSize;                         ///< Size of each prefetcher stream in bytes
+  uint64_t blockMask;                         ///< Mask to align an address to its stream block
+  unsigned blockShift;                        ///< log2(blockSize)
+  std::vector<uint64_t> baseAddr;             ///< Base address of each stream
+  std::vector<unsigned> pending;              ///< Fill requests of each stream whose data has not yet landed
+  std::vector<bool> stale;                    ///< Determines whether each stream was invalidated with a fill in flight
+  std::vector<uint32_t> iStack;               ///< Contiguous instruction storage for all streams
+
+  uint64_t hits;                              ///< Fetches serviced from a stream
+  uint64_t misses;                            ///< Fetches that missed every stream
+  uint64_t stalls;                            ///< Fetch attempts waiting on a fill
+
+  /// retrieves the stream slot for the target address
+  unsigned Slot(uint64_t Addr) { return (unsigned)((Addr >> blockShift) & (REVPREF_NUM_STREAMS-1)); }
+
+  /// determines whether the target stream still has a fill in flight
+  bool IsPending(unsigned S);
 
-  /// fills a missed stream cache instruction
-  void Fill(uint64_t Addr);
+  /// fills the stream block at the target base address
+  bool Fill(uint64_t Base);
 
-  /// deletes the target stream buffer
-  void DeleteStream(unsigned i);
+  /// retrieves the 16bit parcel at the target address; a miss fills its block when Allocate is set
+  PrefStatus FetchHalf(uint64_t Addr, uint32_t &Half, bool Allocate);
 
-  /// attempts to fetch the upper half of a 32bit word of an unaligned base address
-  bool FetchUpper(uint64_t Addr, bool &Fetched, uint32_t &UInst);
+  /// retrieves the full instruction at the target address; a miss fills its block when Allocate is set
+  PrefStatus Fetch(uint64_t Addr, uint32_t &Inst, bool Allocate);
 };
 
 } // namespace RevCPU
@@ -26,6 +26,8 @@
 #include <random>
 #include <queue>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <inttypes.h>
 
 // -- RevCPU Headers
@@ -37,6 +39,10 @@
 #include "RevInstTables.h"
 #include "PanExec.h"
 #include "RevPrefetcher.h"
+#include "RevBranchPred.h"
+#include "RevProfiler.h"
+#include "RevTracer.h"
+#include "RevJIT.h"
 #include "RevThreadCtx.h"
 #include "../common/syscalls/SysFlags.h"
 
@@ -68,6 +74,12 @@ namespace SST{
       /// RevProc: execute a single step
       bool SingleStepHart();
 
+      /// RevProc: determines whether the core is halted with nothing in flight and may skip its clock
+      bool IsQuiesced();
+
+      /// RevProc: charge the cycles the core skipped while quiesced as idle cycles
+      void SkipIdleCycles(uint64_t Cycles);
+
       /// RevProc: retrieve the local PC for the correct feature set
       uint64_t GetPC();
 
@@ -77,12 +89,18 @@ namespace SST{
       /// RevProc: Debug mode write a register
       bool DebugWriteReg(unsigned Idx, uint64_t Value);
 
+      /// RevProc: Debug mode decode the instruction at the target PC; false while the fetch is in flight
+      bool DebugDecode(uint64_t PC, RevInst &Inst);
+
       /// RevProc: Is this an RV32 machine?
       bool DebugIsRV32() { return feature->IsRV32(); }
 
       /// RevProc: Set the PAN execution context
       void SetExecCtx(PanExec *P) { PExec = P; }
 
+      /// RevProc: Set the simulator self profile; nullptr disables
+      void SetHostProf(RevHostProf *P) { hostProf = P; }
+
       /// RevProc: Retrieve a random memory cost value
       unsigned RandCost() { return mem->RandCost(feature->GetMinCost(),feature->GetMaxCost()); }
 
@@ -95,9 +113,35 @@ namespace SST{
       /// RevProc: Handle ALU faults
       void HandleALUFault(unsigned width);
 
+      /// RevProc: write the guest profile if profiling is enabled
+      bool WriteProfile();
+
       /// RevProc: Initialize ThreadTable & First Thread
       bool InitThreadTable();
 
+      /// RevProc: macro-op fusion timing policies
+      typedef enum{
+        FuseNone  = 0,    ///< RevProc: fusion disabled
+        FuseOne   = 1,    ///< RevProc: fused pairs are timed as a single op
+        FuseTwo   = 2     ///< RevProc: fused pairs are timed as the original two ops
+      }FusePolicy;
+
+      /// RevProc: retired instruction classes
+      typedef enum{
+        InstALU     = 0,  ///< RevProc: integer ALU and immediate ops
+        InstMulDiv  = 1,  ///< RevProc: integer multiply and divide
+        InstLoad    = 2,  ///< RevProc: integer and FP loads
+        InstStore   = 3,  ///< RevProc: integer and FP stores
+        InstAMO     = 4,  ///< RevProc: atomic memory operations
+        InstBranch  = 5,  ///< RevProc: branches and jumps
+        InstFP      = 6,  ///< RevProc: floating point arithmetic and conversion
+        InstSystem  = 7,  ///< RevProc: fences, ecalls and CSR accesses
+        InstClassCount = 8
+      }InstClass;
+
+      /// RevProc: retrieve the name of the target instruction class
+      static const char *GetInstClassName(unsigned Class);
+
       class RevProcStats {
         public:
           uint64_t totalCycles;
@@ -109,10 +153,35 @@ namespace SST{
           RevMem::RevMemStats memStats;
           uint64_t cyclesIdle_Pipeline;
           uint64_t cyclesIdle_MemoryFetch;
+          uint64_t branchesExec;
+          uint64_t branchMispredicts;
+          uint64_t btbMisses;
+          uint64_t rasMisses;
+          uint64_t cyclesRedirect;
+          uint64_t fetchHits;
+          uint64_t fetchMisses;
+          uint64_t fetchStalls;
+          uint64_t fusedPairs;
+          uint64_t jitBlocks;
+          uint64_t jitChecks;
+          uint64_t classInsts[InstClassCount];
+          uint64_t classStalls[InstClassCount];
       };
 
       RevProcStats GetStats();
 
+      /// RevProc: retrieve the number of retired instructions
+      uint64_t GetRetired() { return Retired; }
+
+      /// RevProc: retrieve the number of instruction table entries
+      unsigned GetNumEntries() { return (unsigned)(Tables->InstTable.size()); }
+
+      /// RevProc: retrieve the mnemonic of the target instruction table entry
+      std::string GetEntryMnemonic(unsigned Entry) { return ExtractMnemonic(Tables->InstTable[Entry]); }
+
+      /// RevProc: retrieve the retired instruction count per instruction table entry
+      const std::vector<uint64_t> &GetInstMix() { return InstMix; }
+
       RevMem& GetMem(){ return *mem; }
 
       /// RevProc: Add a RevThreadCtx to the Proc's ThreadTable
@@ -193,6 +262,16 @@ namespace SST{
       PanExec *PExec;           ///< RevProc: PAN exeuction context
       RevProcStats Stats;       ///< RevProc: collection of performance stats
       RevPrefetcher *sfetch;    ///< RevProc: stream instruction prefetcher
+      uint32_t fetchWord;       ///< RevProc: instruction word returned by the last successful prefetch
+      RevBranchPred *bpred;     ///< RevProc: branch predictor; null if disabled
+      unsigned branchPenalty;   ///< RevProc: fetch redirect penalty in cycles
+      FusePolicy fusion;        ///< RevProc: macro-op fusion timing policy
+
+      RevProfiler *profiler;    ///< RevProc: guest profiler; null if disabled
+      std::string profPrefix;   ///< RevProc: guest profile output prefix
+      RevTracer *tracer;        ///< RevProc: binary instruction tracer; null if disabled
+      RevJIT *jit;              ///< RevProc: hot block translator; null if disabled
+      RevHostProf *hostProf;    ///< RevProc: simulator self profile; null if disabled
 
       RevRegFile* RegFile = nullptr; ///< RevProc: Initial pointer to HartToDecode RegFile
 
@@ -255,20 +334,35 @@ namespace SST{
       std::vector<uint32_t> ActivePIDs;
 
       RevInst Inst;             ///< RevProc: instruction payload
+      RevInst FuseTail;         ///< RevProc: sequential successor decoded with a fusible head
+      bool FuseValid;           ///< RevProc: FuseTail completes a pair with the decoded instruction
 
-      std::vector<RevInstEntry> InstTable;        ///< RevProc: target instruction table
+      /// RevProc: decode tables shared by every core with the same machine model and cost table
+      class RevTableSet {
+        public:
+          std::vector<RevInstEntry> InstTable;        ///< RevTableSet: target instruction table
+          std::map<std::string,unsigned> NameToEntry; ///< RevTableSet: instruction mnemonic to table entry mapping
+          std::map<uint32_t,unsigned> EncToEntry;     ///< RevTableSet: instruction encoding to table entry mapping
+          std::map<uint32_t,unsigned> CEncToEntry;    ///< RevTableSet: compressed instruction encoding to table entry mapping
+          std::vector<RevInst> CDecodeTable;          ///< RevTableSet: pre-expanded compressed instructions indexed by encoding
+          std::vector<uint8_t> EntryClass;            ///< RevTableSet: instruction class of each table entry
+
+          std::map<unsigned,std::pair<unsigned,unsigned>> EntryToExt; ///< RevTableSet: instruction entry to extension object mapping
+                                                                      ///           first = Master table entry number
+                                                                      ///           second = pair<Extension Index, Extension Entry>
+      };
+
+      static std::map<std::string,std::weak_ptr<const RevTableSet>> TableSets; ///< RevProc: live table sets by machine model and cost table
+      static std::mutex TableSetMtx;              ///< RevProc: guards TableSets
+
+      std::shared_ptr<const RevTableSet> Tables;  ///< RevProc: decode tables of this core
+      RevTableSet *BuildTables;                   ///< RevProc: table set under construction; null once shared
 
       std::vector<RevExt *> Extensions;           ///< RevProc: vector of enabled extensions
 
       std::queue<std::pair<uint16_t, RevInst>>   Pipeline; ///< RevProc: pipeline of instructions - bypass paths not supported
 
-      std::map<std::string,unsigned> NameToEntry; ///< RevProc: instruction mnemonic to table entry mapping
-      std::map<uint32_t,unsigned> EncToEntry;     ///< RevProc: instruction encoding to table entry mapping
-      std::map<uint32_t,unsigned> CEncToEntry;    ///< RevProc: compressed instruction encoding to table entry mapping
-
-      std::map<unsigned,std::pair<unsigned,unsigned>> EntryToExt;     ///< RevProc: instruction entry to extension object mapping
-                                                                      ///           first = Master table entry number
-                                                                      ///           second = pair<Extension Index, Extension Entry>
+      std::vector<uint64_t> InstMix;              ///< RevProc: retired instructions per table entry
 
       /// RevProc: splits a string into tokens
       void splitStr(const std::string& s, char c, std::vector<std::string>& v);
@@ -276,7 +370,7 @@ namespace SST{
       /// RevProc: parses the feature string for the target core
       bool ParseFeatureStr(std::string Feature);
 
-      /// RevProc: loads the instruction table using the target features
+      /// RevProc: loads the instruction table using the target features; shares an existing table set if possible
       bool LoadInstructionTable();
 
       /// RevProc: see the instruction table the target features
@@ -291,6 +385,35 @@ namespace SST{
       /// RevProc: read in the user defined cost tables
       bool ReadOverrideTables();
 
+      /// RevProc: pre-expands every compressed encoding to its 32bit equivalent
+      bool InitCompressedTable();
+
+      /// RevProc: classifies every instruction table entry for the instruction mix
+      bool InitInstClasses();
+
+      /// RevProc: derives the instruction class of the target table entry
+      InstClass ClassifyEntry(const RevInstEntry &Entry);
+
+      /// RevProc: records an executed instruction in the binary trace
+      void TraceInst(uint64_t PC, RevInst *Inst);
+
+      /// RevProc: records a retired instruction in the instruction mix
+      void RetireInst(unsigned Entry){
+        if( Entry < InstMix.size() ){
+          InstMix[Entry]++;
+          Stats.classInsts[Tables->EntryClass[Entry]]++;
+        }
+      }
+
+      /// RevProc: expands a compressed instruction to its 32bit encoding; returns 0 if reserved
+      uint32_t ExpandCompressed(uint16_t Inst);
+
+      /// RevProc: looks up the table entry for a 32bit instruction
+      bool LookupEntry(uint32_t Inst, unsigned &Entry);
+
+      /// RevProc: looks up the table entry for a compressed instruction
+      bool LookupCEntry(uint16_t Inst, unsigned &Entry);
+
       /// RevProc: compresses the encoding structure to a single value
       uint32_t CompressEncoding(RevInstEntry Entry);
 
@@ -315,6 +438,9 @@ namespace SST{
       /// RevProc: decode a compressed instruction
       RevInst DecodeCompressed(uint32_t Inst);
 
+      /// RevProc: decode a 32bit instruction using its table entry
+      RevInst DecodeStdInst(uint32_t Inst, unsigned Entry);
+
       /// RevProc: decode an R-type instruction
       RevInst DecodeRInst(uint32_t Inst, unsigned Entry);
 
@@ -381,6 +507,30 @@ namespace SST{
       /// RevProc: Clear scoreboard on instruction retirement
       void DependencyClear(uint16_t threadID, RevInst* Inst);
 
+      /// RevProc: classify the control flow behavior of the instruction
+      RevBranchPred::CFType GetCFType(RevInst *Inst);
+
+      /// RevProc: compute the direct control flow target of the instruction
+      uint64_t GetCFTarget(uint64_t PC, RevInst *Inst);
+
+      /// RevProc: resolve the branch prediction and apply the redirect penalty
+      void ResolveBranch(uint64_t PC, RevInst *Inst);
+
+      /// RevProc: determines whether the instruction can lead a fused pair
+      bool IsFuseHead(RevInst *Inst);
+
+      /// RevProc: determines whether the tail completes a fused pair with the head
+      bool IsFuseTail(RevInst *Head, RevInst *Tail);
+
+      /// RevProc: decode the sequential successor of the head into FuseTail if it is already fetched and completes a pair
+      bool DecodeFuseTail(RevInst *Head);
+
+      /// RevProc: execute the decoded FuseTail alongside its head as a fused macro-op
+      bool FuseInst(RevInst *Head);
+
+      /// RevProc: execute a decoded instruction and run the per-instruction trace, profile and prediction hooks
+      bool ExecInst(RevExt *Ext, unsigned Idx, RevInst *Inst, uint64_t PC);
+
     }; // class RevProc
   } // namespace RevCPU
 } // namespace SST
@@ -0,0 +1,118 @@
+//
+// _RevProfiler_h_
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#ifndef _SST_REVCPU_REVPROFILER_H_
+#define _SST_REVCPU_REVPROFILER_H_
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "RevLoader.h"
+#include "RevBranchPred.h"
+
+namespace SST{
+namespace RevCPU {
+
+#define REVPROF_MAX_DEPTH 256
+#define REVPROF_HOT_PCS   64
+
+class RevProfiler{
+public:
+  /// RevProfiler: default constructor
+  RevProfiler(RevLoader *Loader, unsigned Harts);
+
+  /// RevProfiler: default destructor
+  ~RevProfiler();
+
+  /// RevProfiler: record an executed instruction and its control flow class
+  void Exec(unsigned Hart, uint64_t PC, RevBranchPred::CFType Kind);
+
+  /// RevProfiler: charge one core cycle to the most recently executed instruction
+  void Tick() {
+    if( lastCount ){
+      lastCount->cycles++;
+      nodes[lastNode].cycles++;
+    }
+    cycles++;
+  }
+
+  /// RevProfiler: charge a run of idle core cycles to the most recently executed instruction
+  void Tick(uint64_t Cycles) {
+    if( lastCount ){
+      lastCount->cycles += Cycles;
+      nodes[lastNode].cycles += Cycles;
+    }
+    cycles += Cycles;
+  }
+
+  /// RevProfiler: write the flat profile and the folded call stacks
+  bool Write(const std::string &Prefix, unsigned Core);
+
+private:
+  /// RevProfiler: per-PC counters
+  typedef struct{
+    uint64_t insts;                           ///< RevProfiler: executed instructions
+    uint64_t cycles;                          ///< RevProfiler: charged cycles
+  }RevProfCount;
+
+  /// RevProfiler: per-function counters
+  typedef struct{
+    const RevSymbol *sym;                     ///< RevProfiler: function symbol; null if unknown
+    std::vector<RevProfCount> pcs;            ///< RevProfiler: counters per 16bit parcel of the function
+  }RevProfFunc;
+
+  /// RevProfiler: calling context tree node
+  typedef struct{
+    unsigned func;                            ///< RevProfiler: function index
+    unsigned parent;                          ///< RevProfiler: parent node
+    unsigned depth;                           ///< RevProfiler: call depth of the node
+    uint64_t insts;                           ///< RevProfiler: instructions executed in the node
+    uint64_t cycles;                          ///< RevProfiler: cycles charged to the node
+    std::map<unsigned,unsigned> children;     ///< RevProfiler: callee function to child node
+  }RevProfNode;
+
+  /// RevProfiler: per-hart call stack state
+  typedef struct{
+    unsigned node;                            ///< RevProfiler: current node
+    unsigned overflow;                        ///< RevProfiler: calls beyond the maximum depth
+    bool call;                                ///< RevProfiler: the next instruction enters a callee
+  }RevProfHart;
+
+  RevLoader *loader;                          ///< RevProfiler: loader object
+  unsigned numFuncs;                          ///< RevProfiler: number of indexed functions
+  unsigned symHint;                           ///< RevProfiler: symbol lookup hint
+  uint64_t cycles;                            ///< RevProfiler: total cycles observed
+  uint64_t insts;                             ///< RevProfiler: total instructions observed
+
+  std::vector<RevProfFunc> funcs;             ///< RevProfiler: functions; the last entry collects unknown PCs
+  std::unordered_map<uint64_t,RevProfCount> unknown;  ///< RevProfiler: counters for PCs outside any symbol
+  std::vector<RevProfNode> nodes;             ///< RevProfiler: calling context tree; node 0 is the root
+  std::vector<RevProfHart> harts;             ///< RevProfiler: per-hart call stacks
+
+  RevProfCount *lastCount;                    ///< RevProfiler: counters of the last executed PC
+  unsigned lastNode;                          ///< RevProfiler: node of the last executed PC
+
+  /// RevProfiler: retrieves the counters for the target PC
+  RevProfCount *GetCount(uint64_t PC, unsigned &Func);
+
+  /// RevProfiler: retrieves the child of Parent for the target function
+  unsigned GetChild(unsigned Parent, unsigned Func);
+
+  /// RevProfiler: retrieves the printable name of the target function
+  std::string FuncName(unsigned Func);
+};
+
+} // namespace RevCPU
+} // namespace SST
+
+#endif // _SST_REVCPU_REVPROFILER_H_
@@ -0,0 +1,126 @@
+//
+// _RevTracer_h_
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#ifndef _SST_REVCPU_REVTRACER_H_
+#define _SST_REVCPU_REVTRACER_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace SST{
+namespace RevCPU {
+
+#define REVTRC_MAGIC      "REVTRC01"
+#define REVTRC_CHUNK_RECS 65536
+#define REVTRC_CHUNKS     4
+
+class RevTracer{
+public:
+  /// RevTracer: record flags
+  typedef enum{
+    TraceRd       = 0x01,   ///< RevTracer: the instruction wrote a register
+    TraceRdFP     = 0x02,   ///< RevTracer: the written register is a floating point register
+    TraceMem      = 0x04,   ///< RevTracer: the instruction accessed data memory
+    TraceMemWrite = 0x08    ///< RevTracer: the data access was a write
+  }TraceFlags;
+
+  /// RevTracer: committed instruction record
+  typedef struct{
+    uint64_t PC;            ///< RevTracer: instruction address
+    uint64_t RdVal;         ///< RevTracer: value written to the destination register
+    uint64_t MemAddr;       ///< RevTracer: data address
+    uint32_t Inst;          ///< RevTracer: instruction encoding
+    uint8_t Size;           ///< RevTracer: instruction size in bytes
+    uint8_t Rd;             ///< RevTracer: destination register
+    uint8_t Flags;          ///< RevTracer: TraceFlags
+  }RevTraceRec;
+
+  /// RevTracer: default constructor; opens the trace file and starts the writer
+  RevTracer(const std::string &File, unsigned Core, unsigned Xlen);
+
+  /// RevTracer: default destructor; drains the buffer and stops the writer
+  ~RevTracer();
+
+  /// RevTracer: determines whether the trace file was opened
+  bool IsOpen() { return (file != nullptr); }
+
+  /// RevTracer: retrieve the next free record; the previous record is committed
+  RevTraceRec &Next(){
+    if( count == REVTRC_CHUNK_RECS ){
+      Submit();
+    }
+    records++;
+    return chunks[cur][count++];
+  }
+
+  /// RevTracer: hand the buffered records to the writer and wait for them to reach the file
+  void Flush();
+
+  /// RevTracer: retrieve the number of records traced
+  uint64_t GetRecords() { return records; }
+
+private:
+  FILE *file;                                 ///< RevTracer: trace file
+  std::vector<std::vector<RevTraceRec>> chunks; ///< RevTracer: ring of record chunks
+  unsigned cur;                               ///< RevTracer: chunk being filled
+  unsigned count;                             ///< RevTracer: records in the current chunk
+  uint64_t records;                           ///< RevTracer: records traced
+
+  std::vector<unsigned> fill;                 ///< RevTracer: record count of each chunk handed to the writer
+  std::deque<unsigned> freeQ;                 ///< RevTracer: chunks available to the producer
+  std::deque<unsigned> fullQ;                 ///< RevTracer: chunks waiting for the writer
+  std::mutex lock;                            ///< RevTracer: protects the chunk queues
+  std::condition_variable freeCV;             ///< RevTracer: signals a chunk was released
+  std::condition_variable fullCV;             ///< RevTracer: signals a chunk was submitted
+  bool done;                                  ///< RevTracer: the writer should exit once drained
+  std::thread writer;                         ///< RevTracer: background writer thread
+
+  // -- encoder state; only touched by the writer thread
+  uint64_t prevPC;                            ///< RevTracer: address of the previous record
+  uint64_t prevNext;                          ///< RevTracer: sequential successor of the previous record
+  uint64_t prevMem;                           ///< RevTracer: previous data address
+  uint64_t lastReg[64];                       ///< RevTracer: last value written to each integer and FP register
+  std::vector<uint8_t> buf;                   ///< RevTracer: encoding buffer
+
+  /// RevTracer: hand the current chunk to the writer and claim a free one
+  void Submit();
+
+  /// RevTracer: writer thread body
+  void Run();
+
+  /// RevTracer: encode a chunk into the trace file
+  void Encode(const std::vector<RevTraceRec> &Chunk, unsigned Count);
+
+  /// RevTracer: append a LEB128 encoded value to the encoding buffer
+  void PutVar(uint64_t Val){
+    while( Val >= 0x80 ){
+      buf.push_back((uint8_t)(Val | 0x80));
+      Val >>= 7;
+    }
+    buf.push_back((uint8_t)(Val));
+  }
+
+  /// RevTracer: append a zigzag LEB128 encoded delta to the encoding buffer
+  void PutDelta(uint64_t Cur, uint64_t Prev){
+    int64_t D = (int64_t)(Cur - Prev);
+    PutVar(((uint64_t)(D) << 1) ^ (uint64_t)(D >> 63));
+  }
+};
+
+} // namespace RevCPU
+} // namespace SST
+
+#endif // _SST_REVCPU_REVTRACER_H_
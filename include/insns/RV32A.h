@@ -22,13 +22,15 @@ namespace SST{
 
       static bool lrw(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
         if( F->IsRV32() ){
-          SEXT(R->RV32[Inst.rd],M->ReadU32( (uint64_t)(R->RV32[Inst.rs1])), 32 );
-          if( !M->LR(F->GetHart(), (uint64_t)(R->RV32[Inst.rs1])) )
+          if( !M->LRMem(F->GetHart(), (uint64_t)(R->RV32[Inst.rs1]), 4,
+                        (Inst.rd != 0) ? (void *)(&R->RV32[Inst.rd]) : nullptr,
+                        REVMEM_FLAGS(0x00)) )
             return false;
           R->RV32_PC += Inst.instSize;
         }else{
-          SEXT(R->RV64[Inst.rd],M->ReadU32( (uint64_t)(R->RV64[Inst.rs1])), 64 );
-          if( !M->LR(F->GetHart(), (uint64_t)(R->RV64[Inst.rs1])) )
+          if( !M->LRMem(F->GetHart(), (uint64_t)(R->RV64[Inst.rs1]), 4,
+                        (Inst.rd != 0) ? (void *)(&R->RV64[Inst.rd]) : nullptr,
+                        REVMEM_FLAGS(RevCPU::RevFlag::F_SEXT64)) )
             return false;
           R->RV64_PC += Inst.instSize;
         }
@@ -38,58 +40,37 @@ namespace SST{
       }
 
       static bool scw(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
+        // a failed store conditional still retires; rd reports the outcome
         if( F->IsRV32() ){
-          if( M->SC(F->GetHart(), (uint64_t)(R->RV32[Inst.rs1])) ){
-            // successfully cleared the reservation
-            M->WriteU32( (uint64_t)(R->RV32[Inst.rs1]), (uint32_t)(R->RV32[Inst.rs2]) );
-            R->RV32[Inst.rd] = 0;
-            R->RV32_PC += Inst.instSize;
-            return true;
-          }else{
-            // failed to clear the reservation
-            R->RV32[Inst.rd] = 1;
-            return true;
-          }
-        }else{
-          if( M->SC(F->GetHart(), (uint64_t)(R->RV64[Inst.rs1])) ){
-            // successfully cleared the reservation
-            M->WriteU32( (uint64_t)(R->RV64[Inst.rs1]), (uint32_t)(R->RV64[Inst.rs2]) );
-            R->RV64[Inst.rd] = 0;
-            R->RV64_PC += Inst.instSize;
-            return true;
-          }else{
-            // failed to clear the reservation
-            R->RV64[Inst.rd] = 1;
-            return true;
-          }
-        }
-      }
-
-      static bool amoswapw(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        if( F->IsRV32() ){
-          SEXT(R->RV32[Inst.rd],M->ReadU32( (uint64_t)(R->RV32[Inst.rs1])), 32 );
-          M->WriteU32((uint64_t)(R->RV32[Inst.rs1]), (uint32_t)(R->RV32[Inst.rs2]));
+          uint32_t Src = R->RV32[Inst.rs2];
+          M->SCMem(F->GetHart(), (uint64_t)(R->RV32[Inst.rs1]), 4, &Src,
+                   (Inst.rd != 0) ? (void *)(&R->RV32[Inst.rd]) : nullptr,
+                   REVMEM_FLAGS(0x00));
           R->RV32_PC += Inst.instSize;
         }else{
-          SEXT(R->RV64[Inst.rd],M->ReadU32( (uint64_t)(R->RV64[Inst.rs1])), 64 );
-          M->WriteU32((uint64_t)(R->RV64[Inst.rs1]), (uint32_t)(R->RV64[Inst.rs2]));
+          uint32_t Src = (uint32_t)(R->RV64[Inst.rs2]);
+          M->SCMem(F->GetHart(), (uint64_t)(R->RV64[Inst.rs1]), 4, &Src,
+                   (Inst.rd != 0) ? (void *)(&R->RV64[Inst.rd]) : nullptr,
+                   REVMEM_FLAGS(RevCPU::RevFlag::F_SEXT64));
           R->RV64_PC += Inst.instSize;
         }
-        // update the cost
-        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
         return true;
       }
 
-      static bool amoaddw(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
+      /// RV32A: issue a word AMO; rd receives the old value, sign extended on RV64
+      static bool amow(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst,
+                       RevCPU::RevFlag Op) {
         if( F->IsRV32() ){
-          M->WriteU32((uint64_t)(R->RV32[Inst.rs1]),
-                      dt_u32((int32_t)(td_u32(R->RV32[Inst.rd],32))+
-                             (int32_t)(td_u32(R->RV32[Inst.rs2],32)),32));
+          uint32_t Src = R->RV32[Inst.rs2];
+          M->AMOVal((uint64_t)(R->RV32[Inst.rs1]), &Src,
+                    (Inst.rd != 0) ? (void *)(&R->RV32[Inst.rd]) : nullptr,
+                    REVMEM_FLAGS(Op));
           R->RV32_PC += Inst.instSize;
         }else{
-          M->WriteU32((uint64_t)(R->RV64[Inst.rs1]),
-                      dt_u32((int32_t)(td_u32(R->RV64[Inst.rd],32))+
-                             (int32_t)(td_u32(R->RV64[Inst.rs2],32)),32));
+          uint32_t Src = (uint32_t)(R->RV64[Inst.rs2]);
+          M->AMOVal((uint64_t)(R->RV64[Inst.rs1]), &Src,
+                    (Inst.rd != 0) ? (void *)(&R->RV64[Inst.rd]) : nullptr,
+                    REVMEM_FLAGS((uint32_t)(Op) | (uint32_t)(RevCPU::RevFlag::F_SEXT64)));
           R->RV64_PC += Inst.instSize;
         }
         // update the cost
@@ -97,163 +78,40 @@ namespace SST{
         return true;
       }
 
+      static bool amoswapw(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
+        return amow(F, R, M, Inst, RevCPU::RevFlag::F_AMOSWAP);
+      }
+
+      static bool amoaddw(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
+        return amow(F, R, M, Inst, RevCPU::RevFlag::F_AMOADD);
+      }
+
       static bool amoxorw(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        if( F->IsRV32() ){
-          M->WriteU32((uint64_t)(R->RV32[Inst.rs1]),
-                      dt_u32((int32_t)(td_u32(R->RV32[Inst.rd],32))^
-                             (int32_t)(td_u32(R->RV32[Inst.rs2],32)),32));
-          R->RV32_PC += Inst.instSize;
-        }else{
-          M->WriteU32((uint64_t)(R->RV64[Inst.rs1]),
-                      dt_u32((int32_t)(td_u32(R->RV64[Inst.rd],32))^
-                             (int32_t)(td_u32(R->RV64[Inst.rs2],32)),32));
-          R->RV64_PC += Inst.instSize;
-        }
-        // update the cost
-        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
-        return true;
+        return amow(F, R, M, Inst, RevCPU::RevFlag::F_AMOXOR);
       }
 
       static bool amoandw(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        if( F->IsRV32() ){
-          M->WriteU32((uint64_t)(R->RV32[Inst.rs1]),
-                      dt_u32((int32_t)(td_u32(R->RV32[Inst.rd],32))&
-                             (int32_t)(td_u32(R->RV32[Inst.rs2],32)),32));
-          R->RV32_PC += Inst.instSize;
-        }else{
-          M->WriteU32((uint64_t)(R->RV64[Inst.rs1]),
-                      dt_u32((int32_t)(td_u32(R->RV64[Inst.rd],32))&
-                             (int32_t)(td_u32(R->RV64[Inst.rs2],32)),32));
-          R->RV64_PC += Inst.instSize;
-        }
-        // update the cost
-        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
-        return true;
+        return amow(F, R, M, Inst, RevCPU::RevFlag::F_AMOAND);
       }
 
       static bool amoorw(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        if( F->IsRV32() ){
-          M->WriteU32((uint64_t)(R->RV32[Inst.rs1]),
-                      dt_u32((int32_t)(td_u32(R->RV32[Inst.rd],32))|
-                             (int32_t)(td_u32(R->RV32[Inst.rs2],32)),32));
-          R->RV32_PC += Inst.instSize;
-        }else{
-          M->WriteU32((uint64_t)(R->RV64[Inst.rs1]),
-                      dt_u32((int32_t)(td_u32(R->RV64[Inst.rd],32))|
-                             (int32_t)(td_u32(R->RV64[Inst.rs2],32)),32));
-          R->RV64_PC += Inst.instSize;
-        }
-        // update the cost
-        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
-        return true;
+        return amow(F, R, M, Inst, RevCPU::RevFlag::F_AMOOR);
       }
 
       static bool amominw(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        if( F->IsRV32() ){
-          SEXT(R->RV32[Inst.rd],M->ReadU32( (uint64_t)(R->RV32[Inst.rs1])), 32 );
-          if( (int32_t)(td_u32(R->RV32[Inst.rd],32)) < (int32_t)(td_u32(R->RV32[Inst.rs2],32)) ){
-            M->WriteU32((uint64_t)(R->RV32[Inst.rs1]),
-                        (uint32_t)(R->RV32[Inst.rd]));
-          }else{
-            M->WriteU32((uint64_t)(R->RV32[Inst.rs1]),
-                        (uint32_t)(R->RV32[Inst.rs2]));
-          }
-          R->RV32_PC += Inst.instSize;
-        }else{
-          SEXT(R->RV64[Inst.rd],M->ReadU32( (uint64_t)(R->RV64[Inst.rs1])), 64 );
-          if( (int32_t)(td_u32(R->RV64[Inst.rd],32)) < (int32_t)(td_u32(R->RV64[Inst.rs2],32)) ){
-            M->WriteU32((uint64_t)(R->RV64[Inst.rs1]),
-                        (uint32_t)(R->RV64[Inst.rd]));
-          }else{
-            M->WriteU32((uint64_t)(R->RV64[Inst.rs1]),
-                        (uint32_t)(R->RV64[Inst.rs2]));
-          }
-          R->RV64_PC += Inst.instSize;
-        }
-        // update the cost
-        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
-        return true;
+        return amow(F, R, M, Inst, RevCPU::RevFlag::F_AMOMIN);
       }
 
       static bool amomaxw(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        if( F->IsRV32() ){
-          SEXT(R->RV32[Inst.rd],M->ReadU32( (uint64_t)(R->RV32[Inst.rs1])), 32 );
-          if( (int32_t)(td_u32(R->RV32[Inst.rd],32)) > (int32_t)(td_u32(R->RV32[Inst.rs2],32)) ){
-            M->WriteU32((uint64_t)(R->RV32[Inst.rs1]),
-                        (uint32_t)(R->RV32[Inst.rd]));
-          }else{
-            M->WriteU32((uint64_t)(R->RV32[Inst.rs1]),
-                        (uint32_t)(R->RV32[Inst.rs2]));
-          }
-          R->RV32_PC += Inst.instSize;
-        }else{
-          SEXT(R->RV64[Inst.rd],M->ReadU32( (uint64_t)(R->RV64[Inst.rs1])), 64 );
-          if( (int32_t)(td_u32(R->RV64[Inst.rd],32)) > (int32_t)(td_u32(R->RV64[Inst.rs2],32)) ){
-            M->WriteU32((uint64_t)(R->RV64[Inst.rs1]),
-                        (uint32_t)(R->RV64[Inst.rd]));
-          }else{
-            M->WriteU32((uint64_t)(R->RV64[Inst.rs1]),
-                        (uint32_t)(R->RV64[Inst.rs2]));
-          }
-          R->RV64_PC += Inst.instSize;
-        }
-        // update the cost
-        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
-        return true;
+        return amow(F, R, M, Inst, RevCPU::RevFlag::F_AMOMAX);
       }
 
       static bool amominuw(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        if( F->IsRV32() ){
-          SEXT(R->RV32[Inst.rd],M->ReadU32( (uint64_t)(R->RV32[Inst.rs1])), 32 );
-          if( (uint32_t)(R->RV32[Inst.rd]) < (uint32_t)(R->RV32[Inst.rs2]) ){
-            M->WriteU32((uint64_t)(R->RV32[Inst.rs1]),
-                        (uint32_t)(R->RV32[Inst.rd]));
-          }else{
-            M->WriteU32((uint64_t)(R->RV32[Inst.rs1]),
-                        (uint32_t)(R->RV32[Inst.rs2]));
-          }
-          R->RV32_PC += Inst.instSize;
-        }else{
-          SEXT(R->RV64[Inst.rd],M->ReadU32( (uint64_t)(R->RV64[Inst.rs1])), 64 );
-          if( (uint32_t)(R->RV64[Inst.rd]) < (uint32_t)(R->RV64[Inst.rs2]) ){
-            M->WriteU32((uint64_t)(R->RV64[Inst.rs1]),
-                        (uint32_t)(R->RV64[Inst.rd]));
-          }else{
-            M->WriteU32((uint64_t)(R->RV64[Inst.rs1]),
-                        (uint32_t)(R->RV64[Inst.rs2]));
-          }
-          R->RV64_PC += Inst.instSize;
-        }
-        // update the cost
-        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
-        return true;
+        return amow(F, R, M, Inst, RevCPU::RevFlag::F_AMOMINU);
       }
 
       static bool amomaxuw(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        if( F->IsRV32() ){
-          SEXT(R->RV32[Inst.rd],M->ReadU32( (uint64_t)(R->RV32[Inst.rs1])), 32 );
-          if( (uint32_t)(R->RV32[Inst.rd]) > (uint32_t)(R->RV32[Inst.rs2]) ){
-            M->WriteU32((uint64_t)(R->RV32[Inst.rs1]),
-                        (uint32_t)(R->RV32[Inst.rd]));
-          }else{
-            M->WriteU32((uint64_t)(R->RV32[Inst.rs1]),
-                        (uint32_t)(R->RV32[Inst.rs2]));
-          }
-          R->RV32_PC += Inst.instSize;
-        }else{
-          SEXT(R->RV64[Inst.rd],M->ReadU32( (uint64_t)(R->RV64[Inst.rs1])), 64 );
-          if( (uint32_t)(R->RV64[Inst.rd]) > (uint32_t)(R->RV64[Inst.rs2]) ){
-            M->WriteU32((uint64_t)(R->RV64[Inst.rs1]),
-                        (uint32_t)(R->RV64[Inst.rd]));
-          }else{
-            M->WriteU32((uint64_t)(R->RV64[Inst.rs1]),
-                        (uint32_t)(R->RV64[Inst.rs2]));
-          }
-          R->RV64_PC += Inst.instSize;
-        }
-        // update the cost
-        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
-        return true;
+        return amow(F, R, M, Inst, RevCPU::RevFlag::F_AMOMAXU);
       }
 
       // ----------------------------------------------------------------------
@@ -264,7 +122,7 @@ namespace SST{
       // <mnemonic> <cost> <opcode> <funct3> <funct7> <rdClass> <rs1Class>
       //            <rs2Class> <rs3Class> <format> <func> <nullEntry>
       // ----------------------------------------------------------------------
-      std::vector<RevInstEntry> RV32ATable = {
+      static inline const std::vector<RevInstEntry> RV32ATable = {
       {RevInstEntryBuilder<RevInstDefaults>().SetMnemonic("lr.w %rd, (%rs1)").SetCost(          1).SetOpcode( 0b0101111).SetFunct3(0b010).SetFunct7( 0b00010).SetImplFunc( &lrw).Setrs2Class(RegUNKNOWN).InstEntry},
       {RevInstEntryBuilder<RevInstDefaults>().SetMnemonic("sc.w %rd, %rs1, %rs2").SetCost(      1).SetOpcode( 0b0101111).SetFunct3(0b010).SetFunct7( 0b00011).SetImplFunc( &scw ).InstEntry},
       {RevInstEntryBuilder<RevInstDefaults>().SetMnemonic("amoswap.w %rd, %rs1, %rs2").SetCost( 1).SetOpcode( 0b0101111).SetFunct3(0b010).SetFunct7( 0b00001).SetImplFunc( &amoswapw ).InstEntry},
@@ -75,10 +75,10 @@ namespace SST{
 
       static bool fsd(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
         if( F->IsRV32() ){
-          M->WriteDouble((uint64_t)(R->RV32[Inst.rs1]+Inst.imm), (double)(R->DPF[Inst.rs2]));
+          M->WriteDouble((uint64_t)(R->RV32[Inst.rs1]+(int32_t)(td_u32(Inst.imm,12))), (double)(R->DPF[Inst.rs2]));
           R->RV32_PC += Inst.instSize;
         }else{
-          M->WriteDouble((uint64_t)(R->RV64[Inst.rs1]+Inst.imm), (double)(R->DPF[Inst.rs2]));
+          M->WriteDouble((uint64_t)(R->RV64[Inst.rs1]+(int32_t)(td_u32(Inst.imm,12))), (double)(R->DPF[Inst.rs2]));
           R->RV64_PC += Inst.instSize;
         }
         return true;
@@ -110,7 +110,7 @@ namespace SST{
 
       static bool fnmsubd(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
         R->DPF[Inst.rd] = (double)((-(double)(R->DPF[Inst.rs1])) *
-                                    (double)(R->DPF[Inst.rs2]) -
+                                    (double)(R->DPF[Inst.rs2]) +
                                     (double)(R->DPF[Inst.rs3]));
         if( F->IsRV32() ){
           R->RV32_PC += Inst.instSize;
@@ -122,7 +122,7 @@ namespace SST{
 
       static bool fnmaddd(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
         R->DPF[Inst.rd] = (double)((-(double)(R->DPF[Inst.rs1])) *
-                                    (double)(R->DPF[Inst.rs2]) +
+                                    (double)(R->DPF[Inst.rs2]) -
                                     (double)(R->DPF[Inst.rs3]));
         if( F->IsRV32() ){
           R->RV32_PC += Inst.instSize;
@@ -211,7 +211,7 @@ namespace SST{
         std::memcpy(&tmp,&R->DPF[Inst.rs1],sizeof(uint64_t));
         tmp &= ~(1ULL<<63);
         std::memcpy(&tmp2,&R->DPF[Inst.rs2],sizeof(uint64_t));
-        tmp2 ^= ~(1ULL<<63);
+        tmp2 ^= (1ULL<<63);
         tmp |= (tmp2&(1ULL<<63));
         std::memcpy(&R->DPF[Inst.rd],&tmp,sizeof(double));
 
@@ -228,9 +228,8 @@ namespace SST{
         uint64_t tmp2 = 0x00ull;
 
         std::memcpy(&tmp,&R->DPF[Inst.rs1],sizeof(uint64_t));
-        tmp &= ~(1ULL<<63);
         std::memcpy(&tmp2,&R->DPF[Inst.rs2],sizeof(uint64_t));
-        tmp |= ((tmp & (1ULL<<63) )^(tmp2 & (1ULL<<63)));
+        tmp ^= (tmp2 & (1ULL<<63));
         std::memcpy(&R->DPF[Inst.rd],&tmp,sizeof(double));
 
         if( F->IsRV32() ){
@@ -276,7 +275,7 @@ namespace SST{
       }
 
       static bool fcvtsd(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        R->DPF[Inst.rd] = (double)(R->DPF[Inst.rs1]);
+        R->DPF[Inst.rd] = (float)(R->DPF[Inst.rs1]);
         if( F->IsRV32() ){
           R->RV32_PC += Inst.instSize;
         }else{
@@ -286,7 +285,7 @@ namespace SST{
       }
 
       static bool fcvtds(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        R->DPF[Inst.rd] = (float)(R->DPF[Inst.rs1]);
+        R->DPF[Inst.rd] = (double)(R->DPF[Inst.rs1]);
         if( F->IsRV32() ){
           R->RV32_PC += Inst.instSize;
         }else{
@@ -297,14 +296,14 @@ namespace SST{
 
       static bool feqd(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
         if( F->IsRV32() ){
-          if( R->DPF[Inst.rs1] == R->DPF[Inst.rs1] ){
+          if( R->DPF[Inst.rs1] == R->DPF[Inst.rs2] ){
             R->RV32[Inst.rd] = 1;
           }else{
             R->RV32[Inst.rd] = 0;
           }
           R->RV32_PC += Inst.instSize;
         }else{
-          if( R->DPF[Inst.rs1] == R->DPF[Inst.rs1] ){
+          if( R->DPF[Inst.rs1] == R->DPF[Inst.rs2] ){
             R->RV64[Inst.rd] = 1;
           }else{
             R->RV64[Inst.rd] = 0;
@@ -316,14 +315,14 @@ namespace SST{
 
       static bool fltd(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
         if( F->IsRV32() ){
-          if( R->DPF[Inst.rs1] < R->DPF[Inst.rs1] ){
+          if( R->DPF[Inst.rs1] < R->DPF[Inst.rs2] ){
             R->RV32[Inst.rd] = 1;
           }else{
             R->RV32[Inst.rd] = 0;
           }
           R->RV32_PC += Inst.instSize;
         }else{
-          if( R->DPF[Inst.rs1] < R->DPF[Inst.rs1] ){
+          if( R->DPF[Inst.rs1] < R->DPF[Inst.rs2] ){
             R->RV64[Inst.rd] = 1;
           }else{
             R->RV64[Inst.rd] = 0;
@@ -335,14 +334,14 @@ namespace SST{
 
       static bool fled(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
         if( F->IsRV32() ){
-          if( R->DPF[Inst.rs1] <= R->DPF[Inst.rs1] ){
+          if( R->DPF[Inst.rs1] <= R->DPF[Inst.rs2] ){
             R->RV32[Inst.rd] = 1;
           }else{
             R->RV32[Inst.rd] = 0;
           }
           R->RV32_PC += Inst.instSize;
         }else{
-          if( R->DPF[Inst.rs1] <= R->DPF[Inst.rs1] ){
+          if( R->DPF[Inst.rs1] <= R->DPF[Inst.rs2] ){
             R->RV64[Inst.rd] = 1;
           }else{
             R->RV64[Inst.rd] = 0;
@@ -419,14 +418,14 @@ namespace SST{
         RevRegClass rs1Class  = RegFLOAT;
         RevRegClass rs2Class  = RegFLOAT;
       };
-      std::vector<RevInstEntry> RV32DTable = {
+      static inline const std::vector<RevInstEntry> RV32DTable = {
       {RevInstEntryBuilder<Rev32DInstDefaults>().SetMnemonic("fld %rd, $imm(%rs1)"           ).SetOpcode( 0b0000111).SetFunct3(0b011 ).SetFunct7(0b0000000	).SetrdClass(RegFLOAT	).Setrs1Class(RegGPR  ).Setrs2Class(RegGPR).Setrs3Class(    RegUNKNOWN).SetFormat(RVTypeI).SetImplFunc(&fld ).InstEntry},
       {RevInstEntryBuilder<Rev32DInstDefaults>().SetMnemonic("fsd %rs2, $imm(%rs1)"          ).SetOpcode( 0b0100111).SetFunct3(0b011 ).SetFunct7(0b0000000	).SetrdClass(RegIMM   ).Setrs1Class(RegFLOAT  ).Setrs2Class(RegFLOAT).Setrs3Class(  RegUNKNOWN).SetFormat(RVTypeS).SetImplFunc(&fsd ).InstEntry},
 
-      {RevInstEntryBuilder<Rev32DInstDefaults>().SetMnemonic("fmadd.d %rd, %rs1, %rs2, %rs3" ).SetOpcode( 0b1000011).SetFunct3(0b0   ).SetFunct7(0b00	    ).SetrdClass(RegFLOAT	).Setrs1Class(RegFLOAT).Setrs2Class(RegFLOAT).Setrs3Class(  RegFLOAT  ).SetFormat(RVTypeR4).SetImplFunc(&fmaddd ).InstEntry},
-      {RevInstEntryBuilder<Rev32DInstDefaults>().SetMnemonic("fmsub.d %rd, %rs1, %rs2, %rs3" ).SetOpcode( 0b1000111).SetFunct3(0b0   ).SetFunct7(0b00	    ).SetrdClass(RegFLOAT	).Setrs1Class(RegFLOAT).Setrs2Class(RegFLOAT).Setrs3Class(  RegFLOAT  ).SetFormat(RVTypeR4).SetImplFunc(&fmsubd ).InstEntry},
-      {RevInstEntryBuilder<Rev32DInstDefaults>().SetMnemonic("fnmsub.d %rd, %rs1, %rs2, %rs3").SetOpcode( 0b1001011).SetFunct3(0b0   ).SetFunct7(0b00	    ).SetrdClass(RegFLOAT	).Setrs1Class(RegFLOAT).Setrs2Class(RegFLOAT).Setrs3Class(  RegFLOAT  ).SetFormat(RVTypeR4).SetImplFunc(&fnmsubd ).InstEntry},
-      {RevInstEntryBuilder<Rev32DInstDefaults>().SetMnemonic("fnmadd.d %rd, %rs1, %rs2, %rs3").SetOpcode( 0b1001111).SetFunct3(0b0   ).SetFunct7(0b00	    ).SetrdClass(RegFLOAT	).Setrs1Class(RegFLOAT).Setrs2Class(RegFLOAT).Setrs3Class(  RegFLOAT  ).SetFormat(RVTypeR4).SetImplFunc(&fnmaddd ).InstEntry},
+      {RevInstEntryBuilder<Rev32DInstDefaults>().SetMnemonic("fmadd.d %rd, %rs1, %rs2, %rs3" ).SetOpcode( 0b1000011).SetFunct3(0b0   ).SetFunct7(0b01	    ).SetrdClass(RegFLOAT	).Setrs1Class(RegFLOAT).Setrs2Class(RegFLOAT).Setrs3Class(  RegFLOAT  ).SetFormat(RVTypeR4).SetImplFunc(&fmaddd ).InstEntry},
+      {RevInstEntryBuilder<Rev32DInstDefaults>().SetMnemonic("fmsub.d %rd, %rs1, %rs2, %rs3" ).SetOpcode( 0b1000111).SetFunct3(0b0   ).SetFunct7(0b01	    ).SetrdClass(RegFLOAT	).Setrs1Class(RegFLOAT).Setrs2Class(RegFLOAT).Setrs3Class(  RegFLOAT  ).SetFormat(RVTypeR4).SetImplFunc(&fmsubd ).InstEntry},
+      {RevInstEntryBuilder<Rev32DInstDefaults>().SetMnemonic("fnmsub.d %rd, %rs1, %rs2, %rs3").SetOpcode( 0b1001011).SetFunct3(0b0   ).SetFunct7(0b01	    ).SetrdClass(RegFLOAT	).Setrs1Class(RegFLOAT).Setrs2Class(RegFLOAT).Setrs3Class(  RegFLOAT  ).SetFormat(RVTypeR4).SetImplFunc(&fnmsubd ).InstEntry},
+      {RevInstEntryBuilder<Rev32DInstDefaults>().SetMnemonic("fnmadd.d %rd, %rs1, %rs2, %rs3").SetOpcode( 0b1001111).SetFunct3(0b0   ).SetFunct7(0b01	    ).SetrdClass(RegFLOAT	).Setrs1Class(RegFLOAT).Setrs2Class(RegFLOAT).Setrs3Class(  RegFLOAT  ).SetFormat(RVTypeR4).SetImplFunc(&fnmaddd ).InstEntry},
 
       {RevInstEntryBuilder<Rev32DInstDefaults>().SetMnemonic("fadd.d %rd, %rs1, %rs2"        ).SetOpcode( 0b1010011).SetFunct3(0b0   ).SetFunct7(0b0000001	).SetrdClass(RegFLOAT	).Setrs1Class(RegFLOAT).Setrs2Class(RegFLOAT).Setrs3Class(  RegUNKNOWN).SetFormat(RVTypeR).SetImplFunc(&faddd ).InstEntry},
       {RevInstEntryBuilder<Rev32DInstDefaults>().SetMnemonic("fsub.d %rd, %rs1, %rs2"        ).SetOpcode( 0b1010011).SetFunct3(0b0   ).SetFunct7(0b0000101	).SetrdClass(RegFLOAT	).Setrs1Class(RegFLOAT).Setrs2Class(RegFLOAT).Setrs3Class(  RegUNKNOWN).SetFormat(RVTypeR).SetImplFunc(&fsubd ).InstEntry},
@@ -441,18 +440,18 @@ namespace SST{
       {RevInstEntryBuilder<Rev32DInstDefaults>().SetMnemonic("fsgnjx.d %rd, %rs1, %rs2"      ).SetOpcode( 0b1010011).SetFunct3(0b010 ).SetFunct7(0b0010001	).SetrdClass(RegFLOAT	).Setrs1Class(RegFLOAT).Setrs2Class(RegFLOAT).Setrs3Class(  RegUNKNOWN).SetFormat(RVTypeR).SetImplFunc(&fsgnjxd ).InstEntry},
 
       {RevInstEntryBuilder<Rev32DInstDefaults>().SetMnemonic("fcvt.s.d %rd, %rs1"            ).SetOpcode( 0b1010011).SetFunct3(0b0   ).SetFunct7(0b0100000	).SetrdClass(RegFLOAT	).Setrs1Class(RegFLOAT).Setrs2Class(RegUNKNOWN).Setrs3Class(RegUNKNOWN).SetFormat(RVTypeR).SetImplFunc(&fcvtsd ).InstEntry},
-      {RevInstEntryBuilder<Rev32DInstDefaults>().SetMnemonic("fcvt.d.s %rd, %rs1"            ).SetOpcode( 0b1010011).SetFunct3(0b0   ).SetFunct7(0b0100001	).SetrdClass(RegFLOAT	).Setrs1Class(RegFLOAT).Setrs2Class(RegUNKNOWN).Setrs3Class(RegUNKNOWN).SetFormat(RVTypeR).SetImplFunc(&fcvtsd ).InstEntry},
+      {RevInstEntryBuilder<Rev32DInstDefaults>().SetMnemonic("fcvt.d.s %rd, %rs1"            ).SetOpcode( 0b1010011).SetFunct3(0b0   ).SetFunct7(0b0100001	).SetrdClass(RegFLOAT	).Setrs1Class(RegFLOAT).Setrs2Class(RegUNKNOWN).Setrs3Class(RegUNKNOWN).SetFormat(RVTypeR).SetImplFunc(&fcvtds ).InstEntry},
       {RevInstEntryBuilder<Rev32DInstDefaults>().SetMnemonic("feq.d %rd, %rs1, %rs2"         ).SetOpcode( 0b1010011).SetFunct3(0b010 ).SetFunct7(0b1010001	).SetrdClass(RegFLOAT	).Setrs1Class(RegFLOAT).Setrs2Class(RegFLOAT).Setrs3Class(  RegUNKNOWN).SetFormat(RVTypeR).SetImplFunc(&feqd ).InstEntry},
       {RevInstEntryBuilder<Rev32DInstDefaults>().SetMnemonic("flt.d %rd, %rs1, %rs2"         ).SetOpcode( 0b1010011).SetFunct3(0b001 ).SetFunct7(0b1010001	).SetrdClass(RegFLOAT	).Setrs1Class(RegFLOAT).Setrs2Class(RegFLOAT).Setrs3Class(  RegUNKNOWN).SetFormat(RVTypeR).SetImplFunc(&fltd ).InstEntry},
       {RevInstEntryBuilder<Rev32DInstDefaults>().SetMnemonic("fle.d %rd, %rs1, %rs2"         ).SetOpcode( 0b1010011).SetFunct3(0b000 ).SetFunct7(0b1010001	).SetrdClass(RegFLOAT	).Setrs1Class(RegFLOAT).Setrs2Class(RegFLOAT).Setrs3Class(  RegUNKNOWN).SetFormat(RVTypeR).SetImplFunc(&fled ).InstEntry},
       {RevInstEntryBuilder<Rev32DInstDefaults>().SetMnemonic("fclass.d %rd, %rs1"            ).SetOpcode( 0b1010011).SetFunct3(0b001 ).SetFunct7(0b1110001	).SetrdClass(RegFLOAT	).Setrs1Class(RegFLOAT).Setrs2Class(RegUNKNOWN).Setrs3Class(RegUNKNOWN).SetFormat(RVTypeR).SetImplFunc(&fclassd ).InstEntry},
-      {RevInstEntryBuilder<Rev32DInstDefaults>().SetMnemonic("fcvt.w.d %rd, %rs1"            ).SetOpcode( 0b1010011).SetFunct3(0b0   ).SetFunct7(0b1100001	).SetrdClass(RegFLOAT	).Setrs1Class(RegFLOAT).Setrs2Class(RegUNKNOWN).Setrs3Class(RegUNKNOWN).SetFormat(RVTypeR).SetImplFunc(&fcvtwd ).InstEntry},
-      {RevInstEntryBuilder<Rev32DInstDefaults>().SetMnemonic("fcvt.wu.d %rd, %rs1"           ).SetOpcode( 0b1010011).SetFunct3(0b0   ).SetFunct7(0b1100001	).SetrdClass(RegFLOAT	).Setrs1Class(RegFLOAT).Setrs2Class(RegUNKNOWN).Setrs3Class(RegUNKNOWN).SetFormat(RVTypeR).SetImplFunc(&fcvtwud ).InstEntry},
-      {RevInstEntryBuilder<Rev32DInstDefaults>().SetMnemonic("fcvt.d.w %rd, %rs1"            ).SetOpcode( 0b1010011).SetFunct3(0b0   ).SetFunct7(0b1101001	).SetrdClass(RegFLOAT	).Setrs1Class(RegFLOAT).Setrs2Class(RegUNKNOWN).Setrs3Class(RegUNKNOWN).SetFormat(RVTypeR).SetImplFunc(&fcvtdw ).InstEntry},
-      {RevInstEntryBuilder<Rev32DInstDefaults>().SetMnemonic("fcvt.d.wu %rd, %rs1"           ).SetOpcode( 0b1010011).SetFunct3(0b0   ).SetFunct7(0b1101001	).SetrdClass(RegFLOAT	).Setrs1Class(RegFLOAT).Setrs2Class(RegUNKNOWN).Setrs3Class(RegUNKNOWN).SetFormat(RVTypeR).SetImplFunc(&fcvtdwu ).InstEntry}
+      {RevInstEntryBuilder<Rev32DInstDefaults>().SetMnemonic("fcvt.w.d %rd, %rs1"            ).SetOpcode( 0b1010011).SetFunct3(0b0   ).SetFunct7(0b1100001	).SetrdClass(RegFLOAT	).Setrs1Class(RegFLOAT).SetfpcvtOp(0b00000).Setrs2Class(RegUNKNOWN).Setrs3Class(RegUNKNOWN).SetFormat(RVTypeR).SetImplFunc(&fcvtwd ).InstEntry},
+      {RevInstEntryBuilder<Rev32DInstDefaults>().SetMnemonic("fcvt.wu.d %rd, %rs1"           ).SetOpcode( 0b1010011).SetFunct3(0b0   ).SetFunct7(0b1100001	).SetrdClass(RegFLOAT	).Setrs1Class(RegFLOAT).SetfpcvtOp(0b00001).Setrs2Class(RegUNKNOWN).Setrs3Class(RegUNKNOWN).SetFormat(RVTypeR).SetImplFunc(&fcvtwud ).InstEntry},
+      {RevInstEntryBuilder<Rev32DInstDefaults>().SetMnemonic("fcvt.d.w %rd, %rs1"            ).SetOpcode( 0b1010011).SetFunct3(0b0   ).SetFunct7(0b1101001	).SetrdClass(RegFLOAT	).Setrs1Class(RegFLOAT).SetfpcvtOp(0b00000).Setrs2Class(RegUNKNOWN).Setrs3Class(RegUNKNOWN).SetFormat(RVTypeR).SetImplFunc(&fcvtdw ).InstEntry},
+      {RevInstEntryBuilder<Rev32DInstDefaults>().SetMnemonic("fcvt.d.wu %rd, %rs1"           ).SetOpcode( 0b1010011).SetFunct3(0b0   ).SetFunct7(0b1101001	).SetrdClass(RegFLOAT	).Setrs1Class(RegFLOAT).SetfpcvtOp(0b00001).Setrs2Class(RegUNKNOWN).Setrs3Class(RegUNKNOWN).SetFormat(RVTypeR).SetImplFunc(&fcvtdwu ).InstEntry}
       };
 
-    std::vector<RevInstEntry> RV32DCTable = {
+    static inline const std::vector<RevInstEntry> RV32DCTable = {
         {RevInstEntryBuilder<RevInstDefaults>().SetMnemonic("c.fldsp %rd, $imm").SetCost(1).SetOpcode(0b10).SetFunct3(0b001).SetrdClass(RegFLOAT).Setrs1Class(RegGPR).Setimm(FVal).SetFormat(RVCTypeCI).SetImplFunc(&cfldsp).SetCompressed(true).InstEntry},
         {RevInstEntryBuilder<RevInstDefaults>().SetMnemonic("c.fsdsp %rs1, $imm").SetCost(1).SetOpcode(0b10).SetFunct3(0b101).Setrs2Class(RegFLOAT).Setrs1Class(RegGPR).Setimm(FVal).SetFormat(RVCTypeCSS).SetImplFunc(&cfsdsp).SetCompressed(true).InstEntry},
         {RevInstEntryBuilder<RevInstDefaults>().SetMnemonic("c.fld %rd, %rs1, $imm").SetCost(1).SetOpcode(0b00).SetFunct3(0b001).Setrs1Class(RegGPR).SetrdClass(RegFLOAT).Setimm(FVal).SetFormat(RVCTypeCL).SetImplFunc(&cfld).SetCompressed(true).InstEntry},
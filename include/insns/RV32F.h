@@ -21,6 +21,21 @@ namespace SST{
   namespace RevCPU{
     class RV32F : public RevExt {
 
+      // with the D extension the F registers hold single precision values
+      // widened to double; these convert to and from the 32-bit encoding
+      static uint32_t SBits(double D){
+        float Val = (float)(D);
+        uint32_t Bits = 0;
+        std::memcpy(&Bits,&Val,sizeof(float));
+        return Bits;
+      }
+
+      static double SVal(uint32_t Bits){
+        float Val = 0.;
+        std::memcpy(&Val,&Bits,sizeof(float));
+        return (double)(Val);
+      }
+
       // Compressed instructions
       static bool cflwsp(RevFeature *F, RevRegFile *R,
                         RevMem *M, RevInst Inst) {
@@ -58,18 +73,20 @@ namespace SST{
 
       // Standard instructions
       static bool flw(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        if( F->IsRV32D() ){
+        if( F->HasDouble() ){
           if( F->IsRV32() ){
             //R->DPF[Inst.rd] = M->ReadFloat((uint64_t)(R->RV32[Inst.rs1]+Inst.imm));
             M->ReadVal<float>((uint64_t)(R->RV32[Inst.rs1]+(int32_t)(td_u32(Inst.imm,12))),
                     (float *)(&R->DPF[Inst.rd]),
-                    REVMEM_FLAGS(0));
+                    REVMEM_FLAGS(RevCPU::RevFlag::F_FLOAT64));
+            R->DPF[Inst.rd] = *(float *)(&R->DPF[Inst.rd]);
             R->RV32_PC += Inst.instSize;
           }else{
             //R->DPF[Inst.rd] = M->ReadFloat((uint64_t)(R->RV64[Inst.rs1]+Inst.imm));
             M->ReadVal<float>((uint64_t)(R->RV64[Inst.rs1]+(int32_t)(td_u32(Inst.imm,12))),
                     (float *)(&R->DPF[Inst.rd]),
-                    REVMEM_FLAGS(0));
+                    REVMEM_FLAGS(RevCPU::RevFlag::F_FLOAT64));
+            R->DPF[Inst.rd] = *(float *)(&R->DPF[Inst.rd]);
             R->RV64_PC += Inst.instSize;
           }
         }else{
@@ -92,7 +109,7 @@ namespace SST{
       }
 
       static bool fsw(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        if( F->IsRV32D() ){
+        if( F->HasDouble() ){
           if( F->IsRV32() ){
             M->WriteFloat((uint64_t)(R->RV32[Inst.rs1]+(int32_t)(td_u32(Inst.imm,12))), (float)(R->DPF[Inst.rs2]));
             R->RV32_PC += Inst.instSize;
@@ -113,7 +130,7 @@ namespace SST{
       }
 
       static bool fmadds(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        if( F->IsRV32D() ){
+        if( F->HasDouble() ){
           R->DPF[Inst.rd] = (float)(((float)(R->DPF[Inst.rs1]) *
                                    (float)(R->DPF[Inst.rs2])) +
                                    (float)(R->DPF[Inst.rs3]));
@@ -134,7 +151,7 @@ namespace SST{
       }
 
       static bool fmsubs(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        if( F->IsRV32D() ){
+        if( F->HasDouble() ){
           R->DPF[Inst.rd] = (float)((float)(R->DPF[Inst.rs1]) *
                                     (float)(R->DPF[Inst.rs2]) -
                                     (float)(R->DPF[Inst.rs3]));
@@ -155,7 +172,7 @@ namespace SST{
       }
 
       static bool fnmsubs(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        if( F->IsRV32D() ){
+        if( F->HasDouble() ){
           R->DPF[Inst.rd] = (float)((-((float)(R->DPF[Inst.rs1])) *
                                     (float)(R->DPF[Inst.rs2])) +
                                     (float)(R->DPF[Inst.rs3]));
@@ -176,7 +193,7 @@ namespace SST{
       }
 
       static bool fnmadds(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        if( F->IsRV32D() ){
+        if( F->HasDouble() ){
           R->DPF[Inst.rd] = (float)(-(((float)(R->DPF[Inst.rs1])) *
                                     (float)(R->DPF[Inst.rs2]) ) -
                                     (float)(R->DPF[Inst.rs3]));
@@ -197,7 +214,7 @@ namespace SST{
       }
 
       static bool fadds(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        if( F->IsRV32D() ){
+        if( F->HasDouble() ){
           R->DPF[Inst.rd] = (float)((float)(R->DPF[Inst.rs1]) +
                                     (float)(R->DPF[Inst.rs2]));
           if( F->IsRV32() ){
@@ -217,7 +234,7 @@ namespace SST{
       }
 
       static bool fsubs(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        if( F->IsRV32D() ){
+        if( F->HasDouble() ){
           R->DPF[Inst.rd] = (float)((float)(R->DPF[Inst.rs1]) -
                                     (float)(R->DPF[Inst.rs2]));
           if( F->IsRV32() ){
@@ -237,7 +254,7 @@ namespace SST{
       }
 
       static bool fmuls(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        if( F->IsRV32D() ){
+        if( F->HasDouble() ){
           R->DPF[Inst.rd] = (float)((float)(R->DPF[Inst.rs1]) *
                                     (float)(R->DPF[Inst.rs2]));
           if( F->IsRV32() ){
@@ -257,7 +274,7 @@ namespace SST{
       }
 
       static bool fdivs(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        if( F->IsRV32D() ){
+        if( F->HasDouble() ){
           R->DPF[Inst.rd] = (float)((float)(R->DPF[Inst.rs1]) /
                                     (float)(R->DPF[Inst.rs2]));
           if( F->IsRV32() ){
@@ -277,7 +294,7 @@ namespace SST{
       }
 
       static bool fsqrts(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        if( F->IsRV32D() ){
+        if( F->HasDouble() ){
           R->DPF[Inst.rd] = (float)(sqrt((float)(R->DPF[Inst.rs1])));
           if( F->IsRV32() ){
             R->RV32_PC += Inst.instSize;
@@ -298,20 +315,20 @@ namespace SST{
       static bool fsgnjs(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
         uint32_t tmp = 0;
         uint32_t tmp2 = 0;
-        if( F->IsRV32D() ){
+        if( F->HasDouble() ){
           if( F->IsRV32() ){
-            std::memcpy(&tmp,&R->DPF[Inst.rs1],sizeof(uint32_t));
+            tmp = SBits(R->DPF[Inst.rs1]);
             tmp &= ~(1<<31);
-            std::memcpy(&tmp2,&R->DPF[Inst.rs2],sizeof(uint32_t));
+            tmp2 = SBits(R->DPF[Inst.rs2]);
             tmp |= (tmp2&(1<<31));
-            std::memcpy(&R->DPF[Inst.rd],&tmp,sizeof(float));
+            R->DPF[Inst.rd] = SVal(tmp);
             R->RV32_PC += Inst.instSize;
           }else{
-            std::memcpy(&tmp,&R->DPF[Inst.rs1],sizeof(uint32_t));
+            tmp = SBits(R->DPF[Inst.rs1]);
             tmp &= ~(1<<31);
-            std::memcpy(&tmp2,&R->DPF[Inst.rs2],sizeof(uint32_t));
+            tmp2 = SBits(R->DPF[Inst.rs2]);
             tmp |= (tmp2&(1<<31));
-            std::memcpy(&R->DPF[Inst.rd],&tmp,sizeof(float));
+            R->DPF[Inst.rd] = SVal(tmp);
             R->RV64_PC += Inst.instSize;
           }
         }else{
@@ -337,24 +354,24 @@ namespace SST{
       static bool fsgnjns(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
         uint32_t tmp = 0;
         uint32_t tmp2 = 0;
-        if( F->IsRV32D() ){
+        if( F->HasDouble() ){
           if( F->IsRV32() ){
-            std::memcpy(&tmp,&R->DPF[Inst.rs1],sizeof(uint32_t));
+            tmp = SBits(R->DPF[Inst.rs1]);
             tmp &= ~(1<<31);
-            std::memcpy(&tmp2,&R->DPF[Inst.rs2],sizeof(uint32_t));
+            tmp2 = SBits(R->DPF[Inst.rs2]);
             tmp2 &= (1 << 31);
             tmp2 ^= (1 << 31);
             tmp |= tmp2;
-            std::memcpy(&R->DPF[Inst.rd],&tmp,sizeof(float));
+            R->DPF[Inst.rd] = SVal(tmp);
             R->RV32_PC += Inst.instSize;
           }else{
-            std::memcpy(&tmp,&R->DPF[Inst.rs1],sizeof(uint32_t));
+            tmp = SBits(R->DPF[Inst.rs1]);
             tmp &= ~(1<<31);
-            std::memcpy(&tmp2,&R->DPF[Inst.rs2],sizeof(uint32_t));
+            tmp2 = SBits(R->DPF[Inst.rs2]);
             tmp2 &= (1 << 31);
             tmp2 ^= (1 << 31);
             tmp |= tmp2;
-            std::memcpy(&R->DPF[Inst.rd],&tmp,sizeof(float));
+            R->DPF[Inst.rd] = SVal(tmp);
             R->RV64_PC += Inst.instSize;
           }
         }else{
@@ -384,22 +401,22 @@ namespace SST{
       static bool fsgnjxs(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
         uint32_t tmp = 0;
         uint32_t tmp2 = 0;
-        if( F->IsRV32D() ){
+        if( F->HasDouble() ){
           if( F->IsRV32() ){
-            std::memcpy(&tmp,&R->DPF[Inst.rs1],sizeof(uint32_t));
-            std::memcpy(&tmp2,&R->DPF[Inst.rs2],sizeof(uint32_t));
+            tmp = SBits(R->DPF[Inst.rs1]);
+            tmp2 = SBits(R->DPF[Inst.rs2]);
             tmp2 &= (1<<31);
             tmp2 = (tmp & (1 << 31)) ^ tmp2;
             tmp = (tmp & ~(1<<31)) | tmp2;
-            std::memcpy(&R->DPF[Inst.rd],&tmp,sizeof(float));
+            R->DPF[Inst.rd] = SVal(tmp);
             R->RV32_PC += Inst.instSize;
           }else{
-            std::memcpy(&tmp,&R->DPF[Inst.rs1],sizeof(uint32_t));
-            std::memcpy(&tmp2,&R->DPF[Inst.rs2],sizeof(uint32_t));
+            tmp = SBits(R->DPF[Inst.rs1]);
+            tmp2 = SBits(R->DPF[Inst.rs2]);
             tmp2 &= (1<<31);
             tmp2 = (tmp & (1 << 31)) ^ tmp2;
             tmp = (tmp & ~(1<<31)) | tmp2;
-            std::memcpy(&R->DPF[Inst.rd],&tmp,sizeof(float));
+            R->DPF[Inst.rd] = SVal(tmp);
             R->RV64_PC += Inst.instSize;
           }
         }else{
@@ -425,7 +442,7 @@ namespace SST{
       static bool fmins(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
         float tmp1;
         float tmp2;
-        if( F->IsRV32D() ){
+        if( F->HasDouble() ){
           tmp1 = (float)(R->DPF[Inst.rs1]);
           tmp2 = (float)(R->DPF[Inst.rs2]);
           if( tmp1 < tmp2 ){
@@ -458,7 +475,7 @@ namespace SST{
       static bool fmaxs(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
         float tmp1;
         float tmp2;
-        if( F->IsRV32D() ){
+        if( F->HasDouble() ){
           tmp1 = (float)(R->DPF[Inst.rs1]);
           tmp2 = (float)(R->DPF[Inst.rs2]);
           if( tmp1 > tmp2 ){
@@ -489,7 +506,7 @@ namespace SST{
       }
 
       static bool fcvtws(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        if( F->IsRV32D() ){
+        if( F->HasDouble() ){
           if( F->IsRV32() ){
             R->RV32[Inst.rd] = (int32_t)((float)(R->DPF[Inst.rs1]));
             R->RV32_PC += Inst.instSize;
@@ -510,7 +527,7 @@ namespace SST{
       }
 
       static bool fcvtwus(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        if( F->IsRV32D() ){
+        if( F->HasDouble() ){
           if( F->IsRV32() ){
             R->RV32[Inst.rd] = (float)(R->DPF[Inst.rs1]) > 0.0 ? (uint32_t)((float)(R->DPF[Inst.rs1])) : 0;
             R->RV32_PC += Inst.instSize;
@@ -531,13 +548,12 @@ namespace SST{
       }
 
       static bool fmvxw(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        if( F->IsRV32D() ){
+        if( F->HasDouble() ){
           if( F->IsRV32() ){
-            std::memcpy(&R->RV32[Inst.rd],&R->DPF[Inst.rs1],sizeof(float));
+            R->RV32[Inst.rd] = SBits(R->DPF[Inst.rs1]);
             R->RV32_PC += Inst.instSize;
           }else{
-            std::memcpy(&R->RV64[Inst.rd],&R->DPF[Inst.rs1],sizeof(float));
-            ZEXTI64(R->RV64[Inst.rd],32);
+            R->RV64[Inst.rd] = SBits(R->DPF[Inst.rs1]);
             SEXTI64(R->RV64[Inst.rd],32);
             R->RV64_PC += Inst.instSize;
           }
@@ -556,7 +572,7 @@ namespace SST{
       }
 
       static bool feqs(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        if( F->IsRV32D() ){
+        if( F->HasDouble() ){
           if( F->IsRV32() ){
             if( R->DPF[Inst.rs1] == R->DPF[Inst.rs2] ){
               R->RV32[Inst.rd] = 1;
@@ -593,7 +609,7 @@ namespace SST{
       }
 
       static bool flts(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        if( F->IsRV32D() ){
+        if( F->HasDouble() ){
           if( F->IsRV32() ){
             if( R->DPF[Inst.rs1] < R->DPF[Inst.rs2] ){
               R->RV32[Inst.rd] = 1;
@@ -630,7 +646,7 @@ namespace SST{
       }
 
       static bool fles(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        if( F->IsRV32D() ){
+        if( F->HasDouble() ){
           if( F->IsRV32() ){
             if( R->DPF[Inst.rs1] <= R->DPF[Inst.rs2] ){
               R->RV32[Inst.rd] = 1;
@@ -669,7 +685,7 @@ namespace SST{
       static bool fclasss(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
         // see: https://github.com/riscv/riscv-isa-sim/blob/master/softfloat/f32_classify.c
         uint32_t fpclass = 0;
-        float val = R->SPF[Inst.rs1];
+        float val = F->HasDouble() ? (float)(R->DPF[Inst.rs1]) : R->SPF[Inst.rs1];
         switch (std::fpclassify(val)){
           case FP_INFINITE:
             fpclass = std::signbit(val) ? 1 : (1 << 7);
@@ -687,7 +703,7 @@ namespace SST{
             fpclass = std::signbit(val) ? (1 << 3) : (1 << 4);
             break;
         }
-        if( F->IsRV32D() ){
+        if( F->HasDouble() ){
           if( F->IsRV32() ){
             R->RV32[Inst.rd] = fpclass; 
             R->RV32_PC += Inst.instSize;
@@ -708,7 +724,7 @@ namespace SST{
       }
 
       static bool fcvtsw(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        if( F->IsRV32D() ){
+        if( F->HasDouble() ){
           if( F->IsRV32() ){
             R->DPF[Inst.rd] = (float)((int32_t)(R->RV32[Inst.rs1]));
             R->RV32_PC += Inst.instSize;
@@ -729,7 +745,7 @@ namespace SST{
       }
 
       static bool fcvtswu(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        if( F->IsRV32D() ){
+        if( F->HasDouble() ){
           if( F->IsRV32() ){
             R->DPF[Inst.rd] = (float)((uint32_t)(R->RV32[Inst.rs1]));
             R->RV32_PC += Inst.instSize;
@@ -750,12 +766,12 @@ namespace SST{
       }
 
       static bool fmvwx(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        if( F->IsRV32D() ){
+        if( F->HasDouble() ){
           if( F->IsRV32() ){
-            std::memcpy(&R->DPF[Inst.rd],&R->RV32[Inst.rs1],sizeof(float));
+            R->DPF[Inst.rd] = SVal(R->RV32[Inst.rs1]);
             R->RV32_PC += Inst.instSize;
           }else{
-            std::memcpy(&R->DPF[Inst.rd],&R->RV64[Inst.rs1],sizeof(float));
+            R->DPF[Inst.rd] = SVal((uint32_t)(R->RV64[Inst.rs1]));
             R->RV64_PC += Inst.instSize;
           }
         }else{
@@ -785,7 +801,7 @@ namespace SST{
         RevRegClass rs2Class  = RegFLOAT;
       };
 
-      std::vector<RevInstEntry>RV32FTable = {
+      static inline const std::vector<RevInstEntry> RV32FTable = {
       {RevInstEntryBuilder<Rev32FInstDefaults>().SetMnemonic("flw %rd, $imm(%rs1)"	          ).SetOpcode( 0b0000111).SetFunct3( 0b010  ).SetFunct7(0b000000).SetrdClass(RegGPR).Setrs1Class(RegGPR).Setrs2Class(RegUNKNOWN).Setrs3Class(RegUNKNOWN).SetFormat(RVTypeI).SetImplFunc( &flw).InstEntry},
       {RevInstEntryBuilder<Rev32FInstDefaults>().SetMnemonic("fsw %rs2, $imm(%rs1)"	        ).SetOpcode( 0b0100111).SetFunct3( 0b010  ).SetFunct7(0b0000000).SetrdClass(RegIMM).Setrs1Class(RegGPR).Setrs2Class(RegFLOAT).Setrs3Class(RegUNKNOWN).SetFormat(RVTypeS).SetImplFunc(&fsw).InstEntry},
 
@@ -818,7 +834,7 @@ namespace SST{
       {RevInstEntryBuilder<Rev32FInstDefaults>().SetMnemonic("fmv.w.x %rd, %rs1"	            ).SetOpcode( 0b1010011).SetFunct3( 0b000	).SetFunct7(0b1111000).Setrs2Class(RegUNKNOWN).Setrs3Class(RegUNKNOWN).SetFormat(RVTypeR).SetImplFunc(&fmvwx ).InstEntry}
       };
 
-    std::vector<RevInstEntry> RV32FCOTable = {
+    static inline const std::vector<RevInstEntry> RV32FCOTable = {
         {RevInstEntryBuilder<RevInstDefaults>().SetMnemonic("c.flwsp %rd, $imm").SetCost(1).SetOpcode(0b10).SetFunct3(0b011).SetrdClass(RegFLOAT).Setrs1Class(RegGPR).Setimm(FVal).SetFormat(RVCTypeCI).SetImplFunc(&cflwsp).SetCompressed(true).InstEntry},
         {RevInstEntryBuilder<RevInstDefaults>().SetMnemonic("c.fswsp %rs2, $imm").SetCost(1).SetOpcode(0b10).SetFunct3(0b111).Setrs2Class(RegFLOAT).Setrs1Class(RegGPR).Setimm(FVal).SetFormat(RVCTypeCSS).SetImplFunc(&cfswsp).SetCompressed(true).InstEntry},
         {RevInstEntryBuilder<RevInstDefaults>().SetMnemonic("c.flw %rd, %rs1, $imm").SetCost(1).SetOpcode(0b00).SetFunct3(0b011).Setrs1Class(RegGPR).SetrdClass(RegFLOAT).Setimm(FVal).SetFormat(RVCTypeCL).SetImplFunc(&cflw).SetCompressed(true).InstEntry},
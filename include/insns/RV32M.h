@@ -21,43 +21,42 @@ namespace SST{
     class RV32M : public RevExt {
 
       static uint64_t mulhu_impl(uint64_t A, uint64_t B){
-        uint64_t t;
-        uint32_t y1, y2, y3;
+        // schoolbook 64x64 multiply on 32-bit halves; returns the upper 64 bits
         uint64_t a0 = (uint32_t)A, a1 = A >> 32;
         uint64_t b0 = (uint32_t)B, b1 = B >> 32;
 
-        t = a1*b0 + ((a0+b0) >> 32);
-        y1 = t;
-        y2 = t >> 32;
+        uint64_t p00 = a0*b0;
+        uint64_t p01 = a0*b1;
+        uint64_t p10 = a1*b0;
+        uint64_t p11 = a1*b1;
 
-        t = a0+b1 + y1;
-        y1 = t;
-
-        t = a1*b1 + y2 + (t >> 32);
-        y2 = t;
-        y3 = t >> 32;
-
-        return ((uint64_t)y3 << 32) | y2;
+        uint64_t mid = (p00 >> 32) + (uint32_t)p01 + (uint32_t)p10;
+        return p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
       }
 
-      static int64_t mulh_impl(int64_t A, int64_t B){
-        int negate = (A < 0) != (B < 0);
-        uint64_t res = mulhu_impl(A < 0 ? -A : A, B < 0 ? -B : B);
-        return negate ? ~res + (A * B == 0) : res;
+      static uint64_t mulh_impl(uint64_t A, uint64_t B){
+        // signed operands subtract the other operand from the unsigned high word
+        uint64_t res = mulhu_impl(A, B);
+        if( (int64_t)(A) < 0 )
+          res -= B;
+        if( (int64_t)(B) < 0 )
+          res -= A;
+        return res;
       }
 
-      static int64_t mulhsu_impl(int64_t A, uint64_t B){
-        int negate = A < 0;
-        uint64_t res = mulhu_impl(A < 0 ? -A : A, B);
-        return negate ? ~res + (A * B == 0 ) : res;
+      static uint64_t mulhsu_impl(uint64_t A, uint64_t B){
+        uint64_t res = mulhu_impl(A, B);
+        if( (int64_t)(A) < 0 )
+          res -= B;
+        return res;
       }
 
       static bool mul(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
         if( F->IsRV32() ){
-          R->RV32[Inst.rd] = dt_u32(td_u32(R->RV32[Inst.rs1],32) * td_u32(R->RV32[Inst.rs2],32),32);
+          R->RV32[Inst.rd] = R->RV32[Inst.rs1] * R->RV32[Inst.rs2];
           R->RV32_PC += Inst.instSize;
         }else{
-          R->RV64[Inst.rd] = dt_u64(td_u64(R->RV64[Inst.rs1],64) * td_u64(R->RV64[Inst.rs2],64),64);
+          R->RV64[Inst.rd] = R->RV64[Inst.rs1] * R->RV64[Inst.rs2];
           R->RV64_PC += Inst.instSize;
         }
         return true;
@@ -65,10 +64,12 @@ namespace SST{
 
       static bool mulh(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
         if( F->IsRV32() ){
-          R->RV32[Inst.rd] = dt_u32(mulh_impl(td_u32(R->RV32[Inst.rs1],32),td_u32(R->RV32[Inst.rs2],32))>>32,32);
+          int64_t tmp = (int64_t)((int32_t)(R->RV32[Inst.rs1])) *
+                        (int64_t)((int32_t)(R->RV32[Inst.rs2]));
+          R->RV32[Inst.rd] = (uint32_t)((uint64_t)(tmp) >> 32);
           R->RV32_PC += Inst.instSize;
         }else{
-          R->RV64[Inst.rd] = dt_u64(mulh_impl(td_u64(R->RV64[Inst.rs1],64),td_u64(R->RV64[Inst.rs2],64)),64);
+          R->RV64[Inst.rd] = mulh_impl(R->RV64[Inst.rs1], R->RV64[Inst.rs2]);
           R->RV64_PC += Inst.instSize;
         }
         return true;
@@ -76,10 +77,12 @@ namespace SST{
 
       static bool mulhsu(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
         if( F->IsRV32() ){
-          R->RV32[Inst.rd] = dt_u32((td_u32(R->RV32[Inst.rs1],32)*td_u32(R->RV32[Inst.rs2],32))>>32,32);
+          int64_t tmp = (int64_t)((int32_t)(R->RV32[Inst.rs1])) *
+                        (int64_t)((uint64_t)(R->RV32[Inst.rs2]));
+          R->RV32[Inst.rd] = (uint32_t)((uint64_t)(tmp) >> 32);
           R->RV32_PC += Inst.instSize;
         }else{
-          R->RV64[Inst.rd] = dt_u64(mulhsu_impl(td_u64(R->RV64[Inst.rs1],32),td_u64(R->RV64[Inst.rs2],32)),32);
+          R->RV64[Inst.rd] = mulhsu_impl(R->RV64[Inst.rs1], R->RV64[Inst.rs2]);
           R->RV64_PC += Inst.instSize;
         }
         return true;
@@ -87,41 +90,40 @@ namespace SST{
 
       static bool mulhu(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
         if( F->IsRV32() ){
-          R->RV32[Inst.rd] = dt_u32((td_u32(R->RV32[Inst.rs1],32)*td_u32(R->RV32[Inst.rs2],32))>>32,32);
+          uint64_t tmp = (uint64_t)(R->RV32[Inst.rs1]) * (uint64_t)(R->RV32[Inst.rs2]);
+          R->RV32[Inst.rd] = (uint32_t)(tmp >> 32);
           R->RV32_PC += Inst.instSize;
         }else{
-          R->RV64[Inst.rd] = dt_u64(mulhu_impl(td_u64(R->RV64[Inst.rs1],32),td_u64(R->RV64[Inst.rs2],32)),32);
+          R->RV64[Inst.rd] = mulhu_impl(R->RV64[Inst.rs1], R->RV64[Inst.rs2]);
           R->RV64_PC += Inst.instSize;
         }
         return true;
       }
 
+      // division by zero and signed overflow do not trap; they return the
+      // values the M extension specifies
       static bool div(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
         if( F->IsRV32() ){
-          uint32_t lhs = td_u32(R->RV32[Inst.rs1],32);
-          uint32_t rhs = td_u32(R->RV32[Inst.rs2],32);
+          int32_t lhs = (int32_t)(R->RV32[Inst.rs1]);
+          int32_t rhs = (int32_t)(R->RV32[Inst.rs2]);
           if( rhs == 0 ){
             R->RV32[Inst.rd] = UINT32_MAX;
-            return true;
-          }else if( (lhs == INT32_MIN) &&
-                    ((int32_t)(rhs) == -1) ){
-            R->RV32[Inst.rd] = dt_u32(lhs,32);
-            return true;
+          }else if( (lhs == INT32_MIN) && (rhs == -1) ){
+            R->RV32[Inst.rd] = (uint32_t)(lhs);
+          }else{
+            R->RV32[Inst.rd] = (uint32_t)(lhs/rhs);
           }
-          R->RV32[Inst.rd] = dt_u32(lhs/rhs,32);
           R->RV32_PC += Inst.instSize;
         }else{
-          uint64_t lhs = td_u64(R->RV64[Inst.rs1],64);
-          uint64_t rhs = td_u64(R->RV64[Inst.rs2],64);
+          int64_t lhs = (int64_t)(R->RV64[Inst.rs1]);
+          int64_t rhs = (int64_t)(R->RV64[Inst.rs2]);
           if( rhs == 0 ){
             R->RV64[Inst.rd] = UINT64_MAX;
-            return true;
-          }else if( (lhs == INT64_MIN) &&
-                    ((int64_t)(rhs) == -1) ){
-            R->RV64[Inst.rd] = dt_u64(lhs,64);
-            return true;
+          }else if( (lhs == INT64_MIN) && (rhs == -1) ){
+            R->RV64[Inst.rd] = (uint64_t)(lhs);
+          }else{
+            R->RV64[Inst.rd] = (uint64_t)(lhs/rhs);
           }
-          R->RV64[Inst.rd] = dt_u64(lhs/rhs,64);
           R->RV64_PC += Inst.instSize;
         }
         return true;
@@ -131,24 +133,12 @@ namespace SST{
         if( F->IsRV32() ){
           uint32_t lhs = R->RV32[Inst.rs1];
           uint32_t rhs = R->RV32[Inst.rs2];
-          ZEXTI(lhs,32);
-          ZEXTI(rhs,32);
-          if( rhs == 0 ){
-            R->RV32[Inst.rd] = UINT32_MAX;
-            return true;
-          }
-          SEXT(R->RV32[Inst.rd], lhs/rhs, 32);
+          R->RV32[Inst.rd] = (rhs == 0) ? UINT32_MAX : (lhs/rhs);
           R->RV32_PC += Inst.instSize;
         }else{
           uint64_t lhs = R->RV64[Inst.rs1];
           uint64_t rhs = R->RV64[Inst.rs2];
-          ZEXTI64(lhs,64);
-          ZEXTI64(rhs,64);
-          if( rhs == 0 ){
-            R->RV64[Inst.rd] = UINT64_MAX;
-            return true;
-          }
-          SEXT(R->RV64[Inst.rd], lhs/rhs, 64);
+          R->RV64[Inst.rd] = (rhs == 0) ? UINT64_MAX : (lhs/rhs);
           R->RV64_PC += Inst.instSize;
         }
         return true;
@@ -156,32 +146,26 @@ namespace SST{
 
       static bool rem(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
         if( F->IsRV32() ){
-          uint32_t lhs = td_u32(R->RV32[Inst.rs1],32);
-          uint32_t rhs = td_u32(R->RV32[Inst.rs2],32);
-          SEXTI(lhs,32);
-          SEXTI(rhs,32);
+          int32_t lhs = (int32_t)(R->RV32[Inst.rs1]);
+          int32_t rhs = (int32_t)(R->RV32[Inst.rs2]);
           if( rhs == 0 ){
-            R->RV32[Inst.rd] = dt_u32(lhs,32);
-            return true;
-          }else if( (lhs == INT32_MIN) &&
-                    ((int32_t)(rhs) == -1) ){
+            R->RV32[Inst.rd] = (uint32_t)(lhs);
+          }else if( (lhs == INT32_MIN) && (rhs == -1) ){
             R->RV32[Inst.rd] = 0;
-            return true;
+          }else{
+            R->RV32[Inst.rd] = (uint32_t)(lhs%rhs);
           }
-          R->RV32[Inst.rd] = dt_u32(lhs%rhs,32);
           R->RV32_PC += Inst.instSize;
         }else{
-          uint64_t lhs = td_u64(R->RV64[Inst.rs1],64);
-          uint64_t rhs = td_u64(R->RV64[Inst.rs2],64);
+          int64_t lhs = (int64_t)(R->RV64[Inst.rs1]);
+          int64_t rhs = (int64_t)(R->RV64[Inst.rs2]);
           if( rhs == 0 ){
-            R->RV64[Inst.rd] = dt_u64(lhs,64);
-            return true;
-          }else if( (lhs == INT64_MIN) &&
-                    ((int64_t)(rhs) == -1) ){
+            R->RV64[Inst.rd] = (uint64_t)(lhs);
+          }else if( (lhs == INT64_MIN) && (rhs == -1) ){
             R->RV64[Inst.rd] = 0;
-            return true;
+          }else{
+            R->RV64[Inst.rd] = (uint64_t)(lhs%rhs);
           }
-          R->RV64[Inst.rd] = dt_u64(lhs%rhs,64);
           R->RV64_PC += Inst.instSize;
         }
         return true;
@@ -191,24 +175,12 @@ namespace SST{
         if( F->IsRV32() ){
           uint32_t lhs = R->RV32[Inst.rs1];
           uint32_t rhs = R->RV32[Inst.rs2];
-          ZEXTI(lhs,32);
-          ZEXTI(rhs,32);
-          if( rhs == 0 ){
-            SEXT(R->RV32[Inst.rd], R->RV32[Inst.rs1], 32);
-            return true;
-          }
-          SEXT(R->RV32[Inst.rd], lhs%rhs, 32);
+          R->RV32[Inst.rd] = (rhs == 0) ? lhs : (lhs%rhs);
           R->RV32_PC += Inst.instSize;
         }else{
           uint64_t lhs = R->RV64[Inst.rs1];
           uint64_t rhs = R->RV64[Inst.rs2];
-          ZEXTI64(lhs,64);
-          ZEXTI64(rhs,64);
-          if( rhs == 0 ){
-            SEXT(R->RV64[Inst.rd], R->RV64[Inst.rs1], 64);
-            return true;
-          }
-          SEXT(R->RV64[Inst.rd], lhs%rhs, 64);
+          R->RV64[Inst.rd] = (rhs == 0) ? lhs : (lhs%rhs);
           R->RV64_PC += Inst.instSize;
         }
         return true;
@@ -227,7 +199,7 @@ namespace SST{
         uint8_t funct7 = 0b0000001;
         uint8_t opcode = 0b0110011;
       };
-      std::vector<RevInstEntry> RV32MTable = {
+      static inline const std::vector<RevInstEntry> RV32MTable = {
       {RevInstEntryBuilder<RevMInstDefaults>().SetMnemonic("mul %rd, %rs1, %rs2"   ).SetFunct3(0b000).SetImplFunc( &mul ).InstEntry},
       {RevInstEntryBuilder<RevMInstDefaults>().SetMnemonic("mulh %rd, %rs1, %rs2"  ).SetFunct3(0b001).SetImplFunc( &mulh ).InstEntry},
       {RevInstEntryBuilder<RevMInstDefaults>().SetMnemonic("mulhsu %rd, %rs1, %rs2").SetFunct3(0b010).SetImplFunc( &mulhsu ).InstEntry},
@@ -235,7 +207,7 @@ namespace SST{
       {RevInstEntryBuilder<RevMInstDefaults>().SetMnemonic("div %rd, %rs1, %rs2"   ).SetFunct3(0b100).SetImplFunc( &div ).InstEntry},
       {RevInstEntryBuilder<RevMInstDefaults>().SetMnemonic("divu %rd, %rs1, %rs2"  ).SetFunct3(0b101).SetImplFunc( &divu ).InstEntry},
       {RevInstEntryBuilder<RevMInstDefaults>().SetMnemonic("rem %rd, %rs1, %rs2"   ).SetFunct3(0b110).SetImplFunc( &rem ).InstEntry},
-      {RevInstEntryBuilder<RevMInstDefaults>().SetMnemonic("remu %rd, %rs1, %rs20" ).SetFunct3(0b111).SetImplFunc( &remu ).InstEntry}
+      {RevInstEntryBuilder<RevMInstDefaults>().SetMnemonic("remu %rd, %rs1, %rs2"  ).SetFunct3(0b111).SetImplFunc( &remu ).InstEntry}
       };
 
     public:
@@ -21,139 +21,73 @@ namespace SST{
     class RV64A : public RevExt {
 
       static bool lrd(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        SEXT(R->RV64[Inst.rd],M->ReadU64( (uint64_t)(R->RV64[Inst.rs1])), 64 );
-        if( !M->LR(F->GetHart(), (uint64_t)(R->RV64[Inst.rs1])) )
+        if( !M->LRMem(F->GetHart(), (uint64_t)(R->RV64[Inst.rs1]), 8,
+                      (Inst.rd != 0) ? (void *)(&R->RV64[Inst.rd]) : nullptr,
+                      REVMEM_FLAGS(0x00)) )
           return false;
         R->RV64_PC += Inst.instSize;
+        // update the cost
+        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
         return true;
       }
 
       static bool scd(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        if( M->SC(F->GetHart(), (uint64_t)(R->RV64[Inst.rs1])) ){
-          // successfully cleared the reservation
-          M->WriteU64( (uint64_t)(R->RV64[Inst.rs1]), (uint64_t)(R->RV64[Inst.rs2]) );
-          R->RV64[Inst.rd] = 0;
-          return true;
-        }else{
-          // failed to clear the reservation
-          R->RV64[Inst.rd] = 1;
-          return true;
-        }
+        // a failed store conditional still retires; rd reports the outcome
+        uint64_t Src = R->RV64[Inst.rs2];
+        M->SCMem(F->GetHart(), (uint64_t)(R->RV64[Inst.rs1]), 8, &Src,
+                 (Inst.rd != 0) ? (void *)(&R->RV64[Inst.rd]) : nullptr,
+                 REVMEM_FLAGS(0x00));
+        R->RV64_PC += Inst.instSize;
+        return true;
       }
 
-      static bool amoswapd(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        SEXT(R->RV64[Inst.rd],M->ReadU32( (uint64_t)(R->RV64[Inst.rs1])), 64 );
-        M->WriteU64((uint64_t)(R->RV64[Inst.rs1]), (uint64_t)(R->RV64[Inst.rs2]));
+      /// RV64A: issue a doubleword AMO; rd receives the old value
+      static bool amod(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst,
+                       RevCPU::RevFlag Op) {
+        uint64_t Src = R->RV64[Inst.rs2];
+        M->AMOVal((uint64_t)(R->RV64[Inst.rs1]), &Src,
+                  (Inst.rd != 0) ? (void *)(&R->RV64[Inst.rd]) : nullptr,
+                  REVMEM_FLAGS(Op));
         R->RV64_PC += Inst.instSize;
         // update the cost
         R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
         return true;
       }
 
+      static bool amoswapd(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
+        return amod(F, R, M, Inst, RevCPU::RevFlag::F_AMOSWAP);
+      }
+
       static bool amoaddd(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        SEXT(R->RV64[Inst.rd],M->ReadU32( (uint64_t)(R->RV64[Inst.rs1])), 64 );
-        M->WriteU64((uint64_t)(R->RV64[Inst.rs1]),
-                    dt_u64((int64_t)(td_u64(R->RV64[Inst.rd],64))+
-                           (int64_t)(td_u64(R->RV64[Inst.rs2],64)),64));
-        R->RV64_PC += Inst.instSize;
-        // update the cost
-        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
-        return true;
+        return amod(F, R, M, Inst, RevCPU::RevFlag::F_AMOADD);
       }
 
       static bool amoxord(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        SEXT(R->RV64[Inst.rd],M->ReadU32( (uint64_t)(R->RV64[Inst.rs1])), 64 );
-        M->WriteU64((uint64_t)(R->RV64[Inst.rs1]),
-                    dt_u64((int64_t)(td_u64(R->RV64[Inst.rd],64))^
-                           (int64_t)(td_u64(R->RV64[Inst.rs2],64)),64));
-        R->RV64_PC += Inst.instSize;
-        // update the cost
-        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
-        return true;
+        return amod(F, R, M, Inst, RevCPU::RevFlag::F_AMOXOR);
       }
 
       static bool amoandd(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        SEXT(R->RV64[Inst.rd],M->ReadU32( (uint64_t)(R->RV64[Inst.rs1])), 64 );
-        M->WriteU64((uint64_t)(R->RV64[Inst.rs1]),
-                    dt_u64((int64_t)(td_u64(R->RV64[Inst.rd],64))&
-                           (int64_t)(td_u64(R->RV64[Inst.rs2],64)),64));
-        R->RV64_PC += Inst.instSize;
-        // update the cost
-        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
-        return true;
+        return amod(F, R, M, Inst, RevCPU::RevFlag::F_AMOAND);
       }
 
       static bool amoord(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        SEXT(R->RV64[Inst.rd],M->ReadU32( (uint64_t)(R->RV64[Inst.rs1])), 64 );
-        M->WriteU64((uint64_t)(R->RV64[Inst.rs1]),
-                    dt_u64((int64_t)(td_u64(R->RV64[Inst.rd],64))|
-                           (int64_t)(td_u64(R->RV64[Inst.rs2],64)),64));
-        R->RV64_PC += Inst.instSize;
-        // update the cost
-        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
-        return true;
+        return amod(F, R, M, Inst, RevCPU::RevFlag::F_AMOOR);
       }
 
       static bool amomind(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        SEXT(R->RV64[Inst.rd],M->ReadU32( (uint64_t)(R->RV64[Inst.rs1])), 64 );
-        if( (int64_t)(td_u64(R->RV64[Inst.rd],64)) <
-            (int64_t)(td_u64(R->RV64[Inst.rs2],64)) ){
-          M->WriteU64((uint64_t)(R->RV64[Inst.rs1]),
-                      (uint64_t)(R->RV64[Inst.rd]));
-        }else{
-          M->WriteU64((uint64_t)(R->RV64[Inst.rs1]),
-                      (uint64_t)(R->RV64[Inst.rs2]));
-        }
-        R->RV64_PC += Inst.instSize;
-        // update the cost
-        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
-        return true;
+        return amod(F, R, M, Inst, RevCPU::RevFlag::F_AMOMIN);
       }
 
       static bool amomaxd(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        SEXT(R->RV64[Inst.rd],M->ReadU32( (uint64_t)(R->RV64[Inst.rs1])), 64 );
-        if( (int64_t)(td_u64(R->RV64[Inst.rd],64)) >
-            (int64_t)(td_u64(R->RV64[Inst.rs2],64)) ){
-          M->WriteU64((uint64_t)(R->RV64[Inst.rs1]),
-                      (uint64_t)(R->RV64[Inst.rd]));
-        }else{
-          M->WriteU64((uint64_t)(R->RV64[Inst.rs1]),
-                      (uint64_t)(R->RV64[Inst.rs2]));
-        }
-        R->RV64_PC += Inst.instSize;
-        // update the cost
-        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
-        return true;
+        return amod(F, R, M, Inst, RevCPU::RevFlag::F_AMOMAX);
       }
 
       static bool amominud(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        SEXT(R->RV64[Inst.rd],M->ReadU32( (uint64_t)(R->RV64[Inst.rs1])), 64 );
-        if( (uint64_t)(R->RV64[Inst.rd]) < (uint64_t)(R->RV64[Inst.rs2]) ){
-          M->WriteU64((uint64_t)(R->RV64[Inst.rs1]),
-                      (uint64_t)(R->RV64[Inst.rd]));
-        }else{
-          M->WriteU64((uint64_t)(R->RV64[Inst.rs1]),
-                      (uint64_t)(R->RV64[Inst.rs2]));
-        }
-        R->RV64_PC += Inst.instSize;
-        // update the cost
-        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
-        return true;
+        return amod(F, R, M, Inst, RevCPU::RevFlag::F_AMOMINU);
       }
 
       static bool amomaxud(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        SEXT(R->RV64[Inst.rd],M->ReadU32( (uint64_t)(R->RV64[Inst.rs1])), 64 );
-        if( (uint64_t)(R->RV64[Inst.rd]) > (uint64_t)(R->RV64[Inst.rs2]) ){
-          M->WriteU64((uint64_t)(R->RV64[Inst.rs1]),
-                      (uint64_t)(R->RV64[Inst.rd]));
-        }else{
-          M->WriteU64((uint64_t)(R->RV64[Inst.rs1]),
-                      (uint64_t)(R->RV64[Inst.rs2]));
-        }
-        R->RV64_PC += Inst.instSize;
-        // update the cost
-        R->cost += M->RandCost(F->GetMinCost(),F->GetMaxCost());
-        return true;
+        return amod(F, R, M, Inst, RevCPU::RevFlag::F_AMOMAXU);
       }
 
       // ----------------------------------------------------------------------
@@ -168,20 +102,19 @@ namespace SST{
         public:
         uint8_t     opcode = 0b0101111;
         uint8_t     funct3 = 0b011;
-        RevRegClass rs2Class = RegUNKNOWN;
       };
-      std::vector<RevInstEntry> RV64ATable = {
-      {RevInstEntryBuilder<Rev64AInstDefaults>().SetMnemonic("lr.d %rd, (%rs1)"          ).SetFunct7(0b00010).Setrs1Class(RegUNKNOWN).Setrs2Class(RegUNKNOWN).SetImplFunc(&lrd ).InstEntry},
-      {RevInstEntryBuilder<Rev64AInstDefaults>().SetMnemonic("sc.d %rd, %rs1, %rs2"      ).SetFunct7(0b00011                        ).Setrs2Class(RegUNKNOWN).SetImplFunc(&scd ).InstEntry},
-      {RevInstEntryBuilder<Rev64AInstDefaults>().SetMnemonic("amoswap.d %rd, %rs1, %rs2" ).SetFunct7(0b00001                        ).Setrs2Class(RegUNKNOWN).SetImplFunc(&amoswapd ).InstEntry},
-      {RevInstEntryBuilder<Rev64AInstDefaults>().SetMnemonic("amoadd.d %rd, %rs1, %rs2"  ).SetFunct7(0b00000												 ).Setrs2Class(RegUNKNOWN).SetImplFunc(&amoaddd ).InstEntry},
-      {RevInstEntryBuilder<Rev64AInstDefaults>().SetMnemonic("amoxor.d %rd, %rs1, %rs2"  ).SetFunct7(0b00100												 ).Setrs2Class(RegUNKNOWN).SetImplFunc(&amoxord ).InstEntry},
-      {RevInstEntryBuilder<Rev64AInstDefaults>().SetMnemonic("amoand.d %rd, %rs1, %rs2"  ).SetFunct7(0b01100												 ).Setrs2Class(RegUNKNOWN).SetImplFunc(&amoandd ).InstEntry},
-      {RevInstEntryBuilder<Rev64AInstDefaults>().SetMnemonic("amoor.d %rd, %rs1, %rs2"   ).SetFunct7(0b01000												 ).Setrs2Class(RegUNKNOWN).SetImplFunc(&amoord ).InstEntry},
-      {RevInstEntryBuilder<Rev64AInstDefaults>().SetMnemonic("amomin.d %rd, %rs1, %rs2"  ).SetFunct7(0b10000												 ).Setrs2Class(RegUNKNOWN).SetImplFunc(&amomind ).InstEntry},
-      {RevInstEntryBuilder<Rev64AInstDefaults>().SetMnemonic("amomax.d %rd, %rs1, %rs2"  ).SetFunct7(0b10100												 ).Setrs2Class(RegUNKNOWN).SetImplFunc(&amomaxd ).InstEntry},
-      {RevInstEntryBuilder<Rev64AInstDefaults>().SetMnemonic("amominu.d %rd, %rs1, %rs2" ).SetFunct7(0b11000												 ).Setrs2Class(RegUNKNOWN).SetImplFunc(&amominud ).InstEntry},
-      {RevInstEntryBuilder<Rev64AInstDefaults>().SetMnemonic("amomaxu.d %rd, %rs1, %rs2" ).SetFunct7(0b11100												 ).Setrs2Class(RegUNKNOWN).SetImplFunc(&amomaxud ).InstEntry}
+      static inline const std::vector<RevInstEntry> RV64ATable = {
+      {RevInstEntryBuilder<Rev64AInstDefaults>().SetMnemonic("lr.d %rd, (%rs1)"          ).SetFunct7(0b00010).Setrs2Class(RegUNKNOWN).SetImplFunc(&lrd ).InstEntry},
+      {RevInstEntryBuilder<Rev64AInstDefaults>().SetMnemonic("sc.d %rd, %rs1, %rs2"      ).SetFunct7(0b00011                        ).SetImplFunc(&scd ).InstEntry},
+      {RevInstEntryBuilder<Rev64AInstDefaults>().SetMnemonic("amoswap.d %rd, %rs1, %rs2" ).SetFunct7(0b00001                        ).SetImplFunc(&amoswapd ).InstEntry},
+      {RevInstEntryBuilder<Rev64AInstDefaults>().SetMnemonic("amoadd.d %rd, %rs1, %rs2"  ).SetFunct7(0b00000												 ).SetImplFunc(&amoaddd ).InstEntry},
+      {RevInstEntryBuilder<Rev64AInstDefaults>().SetMnemonic("amoxor.d %rd, %rs1, %rs2"  ).SetFunct7(0b00100												 ).SetImplFunc(&amoxord ).InstEntry},
+      {RevInstEntryBuilder<Rev64AInstDefaults>().SetMnemonic("amoand.d %rd, %rs1, %rs2"  ).SetFunct7(0b01100												 ).SetImplFunc(&amoandd ).InstEntry},
+      {RevInstEntryBuilder<Rev64AInstDefaults>().SetMnemonic("amoor.d %rd, %rs1, %rs2"   ).SetFunct7(0b01000												 ).SetImplFunc(&amoord ).InstEntry},
+      {RevInstEntryBuilder<Rev64AInstDefaults>().SetMnemonic("amomin.d %rd, %rs1, %rs2"  ).SetFunct7(0b10000												 ).SetImplFunc(&amomind ).InstEntry},
+      {RevInstEntryBuilder<Rev64AInstDefaults>().SetMnemonic("amomax.d %rd, %rs1, %rs2"  ).SetFunct7(0b10100												 ).SetImplFunc(&amomaxd ).InstEntry},
+      {RevInstEntryBuilder<Rev64AInstDefaults>().SetMnemonic("amominu.d %rd, %rs1, %rs2" ).SetFunct7(0b11000												 ).SetImplFunc(&amominud ).InstEntry},
+      {RevInstEntryBuilder<Rev64AInstDefaults>().SetMnemonic("amomaxu.d %rd, %rs1, %rs2" ).SetFunct7(0b11100												 ).SetImplFunc(&amomaxud ).InstEntry}
       };
 
 
@@ -58,7 +58,7 @@ namespace SST{
       }
 
       static bool fmvdx(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        std::memcpy(&R->RV64[Inst.rd],&R->DPF[Inst.rs1],sizeof(double));
+        std::memcpy(&R->DPF[Inst.rd],&R->RV64[Inst.rs1],sizeof(double));
         R->RV64_PC += Inst.instSize;
         return true;
       }
@@ -78,11 +78,11 @@ namespace SST{
         RevRegClass rs1Class = RegFLOAT;
         RevRegClass rs2Class = RegUNKNOWN;
       };
-      std::vector<RevInstEntry> RV64DTable = {
-      {RevInstEntryBuilder<Rev64DInstDefaults>().SetMnemonic("fcvt.l.d %rd, %rs1"  ).SetFunct7(0b1100001).SetImplFunc( &fcvtld ).InstEntry},
-      {RevInstEntryBuilder<Rev64DInstDefaults>().SetMnemonic("fcvt.lu.d %rd, %rs1" ).SetFunct7(0b1100001).SetImplFunc( &fcvtlud ).InstEntry},
-      {RevInstEntryBuilder<Rev64DInstDefaults>().SetMnemonic("fcvt.d.l %rd, %rs1"  ).SetFunct7(0b1101001).SetImplFunc( &fcvtdl ).InstEntry},
-      {RevInstEntryBuilder<Rev64DInstDefaults>().SetMnemonic("fcvt.d.lu %rd, %rs1" ).SetFunct7(0b1101001).SetImplFunc( &fcvtdlu ).InstEntry},
+      static inline const std::vector<RevInstEntry> RV64DTable = {
+      {RevInstEntryBuilder<Rev64DInstDefaults>().SetMnemonic("fcvt.l.d %rd, %rs1"  ).SetFunct7(0b1100001).SetfpcvtOp(0b00010).SetImplFunc( &fcvtld ).InstEntry},
+      {RevInstEntryBuilder<Rev64DInstDefaults>().SetMnemonic("fcvt.lu.d %rd, %rs1" ).SetFunct7(0b1100001).SetfpcvtOp(0b00011).SetImplFunc( &fcvtlud ).InstEntry},
+      {RevInstEntryBuilder<Rev64DInstDefaults>().SetMnemonic("fcvt.d.l %rd, %rs1"  ).SetFunct7(0b1101001).SetfpcvtOp(0b00010).SetImplFunc( &fcvtdl ).InstEntry},
+      {RevInstEntryBuilder<Rev64DInstDefaults>().SetMnemonic("fcvt.d.lu %rd, %rs1" ).SetFunct7(0b1101001).SetfpcvtOp(0b00011).SetImplFunc( &fcvtdlu ).InstEntry},
       {RevInstEntryBuilder<Rev64DInstDefaults>().SetMnemonic("fmv.x.d %rd, %rs1"   ).SetFunct7(0b1110001).SetImplFunc( &fmvxd ).InstEntry},
       {RevInstEntryBuilder<Rev64DInstDefaults>().SetMnemonic("fmv.d.x %rd, %rs1"   ).SetFunct7(0b1111001).SetImplFunc( &fmvdx ).InstEntry},
       {RevInstEntryBuilder<Rev64DInstDefaults>().SetMnemonic("fcvt.w.d %rd, %rs1" ).SetFunct7(0b1100001).SetImplFunc( &fcvtwd ).InstEntry}
@@ -21,25 +21,33 @@ namespace SST{
     class RV64F : public RevExt {
 
       static bool fcvtls(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        R->RV64[Inst.rd] = (int64_t)((float)(R->SPF[Inst.rs1]));
+        float Val = F->HasDouble() ? (float)(R->DPF[Inst.rs1]) : R->SPF[Inst.rs1];
+        R->RV64[Inst.rd] = (int64_t)(Val);
         R->RV64_PC += Inst.instSize;
         return true;
       }
 
       static bool fcvtlus(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        R->RV64[Inst.rd] = (float)(R->SPF[Inst.rs1]) > 0.0 ?  (uint64_t)((float)(R->SPF[Inst.rs1])) : 0;
+        float Val = F->HasDouble() ? (float)(R->DPF[Inst.rs1]) : R->SPF[Inst.rs1];
+        R->RV64[Inst.rd] = Val > 0.0 ?  (uint64_t)(Val) : 0;
         R->RV64_PC += Inst.instSize;
         return true;
       }
 
       static bool fcvtsl(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        R->SPF[Inst.rd] = (float)((int64_t)(R->RV64[Inst.rs1]));
+        if( F->HasDouble() )
+          R->DPF[Inst.rd] = (float)((int64_t)(R->RV64[Inst.rs1]));
+        else
+          R->SPF[Inst.rd] = (float)((int64_t)(R->RV64[Inst.rs1]));
         R->RV64_PC += Inst.instSize;
         return true;
       }
 
       static bool fcvtslu(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        R->SPF[Inst.rd] = (float)((uint64_t)(R->RV64[Inst.rs1]));
+        if( F->HasDouble() )
+          R->DPF[Inst.rd] = (float)((uint64_t)(R->RV64[Inst.rs1]));
+        else
+          R->SPF[Inst.rd] = (float)((uint64_t)(R->RV64[Inst.rs1]));
         R->RV64_PC += Inst.instSize;
         return true;
       }
@@ -61,7 +69,7 @@ namespace SST{
         RevRegClass rs3Class = RegUNKNOWN;
       };
 
-      std::vector<RevInstEntry > RV64FTable = {
+      static inline const std::vector<RevInstEntry> RV64FTable = {
       {RevInstEntryBuilder<Rev64FInstDefaults>().SetMnemonic("fcvt.l.s  %rd, %rs1").SetFunct7( 0b1100000).SetfpcvtOp(0b00010).Setrs2Class(RegUNKNOWN).SetImplFunc(&fcvtls ).InstEntry},
       {RevInstEntryBuilder<Rev64FInstDefaults>().SetMnemonic("fcvt.lu.s %rd, %rs1").SetFunct7( 0b1100000).SetfpcvtOp(0b00011).Setrs2Class(RegUNKNOWN).SetImplFunc(&fcvtlus ).InstEntry},
       {RevInstEntryBuilder<Rev64FInstDefaults>().SetMnemonic("fcvt.s.l %rd, %rs1" ).SetFunct7( 0b1101000).SetfpcvtOp(0b00010).Setrs2Class(RegUNKNOWN).SetImplFunc(&fcvtsl ).InstEntry},
@@ -20,103 +20,61 @@ namespace SST{
   namespace RevCPU{
     class RV64M : public RevExt {
 
-      static uint64_t mulhu64_impl(uint64_t A, uint64_t B){
-        uint64_t t;
-        uint32_t y1, y2, y3;
-        uint64_t a0 = (uint32_t)A, a1 = A >> 32;
-        uint64_t b0 = (uint32_t)B, b1 = B >> 32;
-
-        t = a1*b0 + ((a0+b0) >> 32);
-        y1 = t;
-        y2 = t >> 32;
-
-        t = a0+b1 + y1;
-        y1 = t;
-
-        t = a1*b1 + y2 + (t >> 32);
-        y2 = t;
-        y3 = t >> 32;
-
-        return ((uint64_t)y3 << 32) | y2;
-      }
-
-      static int64_t mulh64_impl(int64_t A, int64_t B){
-        int negate = (A < 0) != (B < 0);
-        uint64_t res = mulhu64_impl(A < 0 ? -A : A, B < 0 ? -B : B);
-        return negate ? ~res + (A * B == 0) : res;
-      }
-
-      static int64_t mulhsu64_impl(int64_t A, uint64_t B){
-        int negate = A < 0;
-        uint64_t res = mulhu64_impl(A < 0 ? -A : A, B);
-        return negate ? ~res + (A * B == 0 ) : res;
-      }
-
+      // the word forms operate on the low 32 bits of each operand and
+      // sign extend the 32-bit result
       static bool mulw(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        R->RV64[Inst.rd] = dt_u64(td_u64(R->RV64[Inst.rs1]&MASK32,32) * td_u64(R->RV64[Inst.rs2]&MASK32,32),32);
+        uint32_t tmp = (uint32_t)(R->RV64[Inst.rs1]) * (uint32_t)(R->RV64[Inst.rs2]);
+        R->RV64[Inst.rd] = (uint64_t)((int64_t)((int32_t)(tmp)));
         R->RV64_PC += Inst.instSize;
         return true;
       }
 
       static bool divw(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        uint64_t lhs = td_u64(R->RV64[Inst.rs1] & MASK32,32);
-        uint64_t rhs = td_u64(R->RV64[Inst.rs2] & MASK32,32);
+        int32_t lhs = (int32_t)(R->RV64[Inst.rs1]);
+        int32_t rhs = (int32_t)(R->RV64[Inst.rs2]);
+        int32_t res = 0;
         if( rhs == 0 ){
-          R->RV64[Inst.rd] = UINT32_MAX;
-          R->RV64_PC += Inst.instSize;
-          return true;
-        }else if( (lhs == INT32_MIN) &&
-                  ((int32_t)(rhs) == -1) ){
-          R->RV64[Inst.rd] = dt_u64(lhs & MASK32,32);
-          R->RV64_PC += Inst.instSize;
-          return true;
+          res = -1;
+        }else if( (lhs == INT32_MIN) && (rhs == -1) ){
+          res = lhs;
+        }else{
+          res = lhs/rhs;
         }
-        R->RV64[Inst.rd] = dt_u64((lhs/rhs)&MASK32,32);
+        R->RV64[Inst.rd] = (uint64_t)((int64_t)(res));
         R->RV64_PC += Inst.instSize;
         return true;
       }
 
       static bool divuw(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        uint64_t lhs = R->RV64[Inst.rs1] & MASK32;
-        uint64_t rhs = R->RV64[Inst.rs2] & MASK32;
-        ZEXTI(lhs,64);
-        ZEXTI(rhs,64);
-        if( rhs == 0 ){
-          R->RV64[Inst.rd] = UINT32_MAX;
-          return true;
-        }
-        SEXT(R->RV64[Inst.rd], (lhs/rhs)&MASK32, 64);
+        uint32_t lhs = (uint32_t)(R->RV64[Inst.rs1]);
+        uint32_t rhs = (uint32_t)(R->RV64[Inst.rs2]);
+        uint32_t res = (rhs == 0) ? UINT32_MAX : (lhs/rhs);
+        R->RV64[Inst.rd] = (uint64_t)((int64_t)((int32_t)(res)));
         R->RV64_PC += Inst.instSize;
         return true;
       }
 
       static bool remw(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        uint64_t lhs = td_u64(R->RV64[Inst.rs1] & MASK32,32);
-        uint64_t rhs = td_u64(R->RV64[Inst.rs2] & MASK32,32);
+        int32_t lhs = (int32_t)(R->RV64[Inst.rs1]);
+        int32_t rhs = (int32_t)(R->RV64[Inst.rs2]);
+        int32_t res = 0;
         if( rhs == 0 ){
-          R->RV64[Inst.rd] = UINT32_MAX;
-          return true;
-        }else if( (lhs == INT32_MIN) &&
-                  ((int32_t)(rhs) == -1) ){
-          R->RV64[Inst.rd] = 0;
-          return true;
+          res = lhs;
+        }else if( (lhs == INT32_MIN) && (rhs == -1) ){
+          res = 0;
+        }else{
+          res = lhs%rhs;
         }
-        R->RV64[Inst.rd] = dt_u64((lhs%rhs)&MASK32,32);
+        R->RV64[Inst.rd] = (uint64_t)((int64_t)(res));
         R->RV64_PC += Inst.instSize;
         return true;
       }
 
       static bool remuw(RevFeature *F, RevRegFile *R,RevMem *M,RevInst Inst) {
-        uint64_t lhs = R->RV64[Inst.rs1] & MASK32;
-        uint64_t rhs = R->RV64[Inst.rs2] & MASK32;
-        ZEXTI(lhs,64);
-        ZEXTI(rhs,64);
-        if( rhs == 0 ){
-          SEXT(R->RV64[Inst.rd], R->RV64[Inst.rs1]&MASK32, 32);
-          R->RV64[Inst.rd] = UINT32_MAX;
-          return true;
-        }
-        SEXT(R->RV64[Inst.rd], (lhs%rhs)&MASK32, 32);
+        uint32_t lhs = (uint32_t)(R->RV64[Inst.rs1]);
+        uint32_t rhs = (uint32_t)(R->RV64[Inst.rs2]);
+        uint32_t res = (rhs == 0) ? lhs : (lhs%rhs);
+        R->RV64[Inst.rd] = (uint64_t)((int64_t)((int32_t)(res)));
         R->RV64_PC += Inst.instSize;
         return true;
       }
@@ -134,7 +92,7 @@ namespace SST{
         uint8_t opcode = 0b0111011;
         uint8_t funct7 = 0b0000001;
       };
-      std::vector<RevInstEntry > RV64MTable = {
+      static inline const std::vector<RevInstEntry> RV64MTable = {
       {RevInstEntryBuilder<Rev64MInstDefaults>().SetMnemonic("mulw %rd, %rs1, %rs2" ).SetFunct3(0b000).SetImplFunc(&mulw ).InstEntry},
       {RevInstEntryBuilder<Rev64MInstDefaults>().SetMnemonic("divw %rd, %rs1, %rs2" ).SetFunct3(0b100).SetImplFunc(&divw ).InstEntry},
       {RevInstEntryBuilder<Rev64MInstDefaults>().SetMnemonic("divuw %rd, %rs1, %rs2").SetFunct3(0b101).SetImplFunc(&divuw ).InstEntry},
@@ -58,7 +58,7 @@ namespace SST{
         RevImmFunc imm       = FImm;
         RevInstF format      = RVTypeI;
       };
-      std::vector<RevInstEntry> RV64PTable = {
+      static inline const std::vector<RevInstEntry> RV64PTable = {
       {RevInstEntryBuilder<Rev64PInstDefaults>().SetMnemonic("future %rd, $imm(%rs1)" ).SetFunct3(0b111).SetImplFunc(&future).InstEntry},
       {RevInstEntryBuilder<Rev64PInstDefaults>().SetMnemonic("rfuture %rd, $imm(%rs1)").SetFunct3(0b101).SetImplFunc(&rfuture).InstEntry},
       {RevInstEntryBuilder<Rev64PInstDefaults>().SetMnemonic("sfuture %rd, $imm(%rs1)").SetFunct3(0b100).SetImplFunc(&sfuture).InstEntry}
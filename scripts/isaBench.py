@@ -0,0 +1,200 @@
+import os
+import re
+import sys
+import csv
+import json
+import time
+import argparse
+import tempfile
+import subprocess
+
+parser = argparse.ArgumentParser(description="Run the ISA tests as a simulated-MIPS benchmark and compare against a stored baseline")
+parser.add_argument('-d', '--dir', dest='isaDir', required=False,
+                    default=os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'test', 'isa'),
+                    help="ISA test directory")
+parser.add_argument('-t', '--tests', dest='tests', nargs='+', required=False,
+                    help="tests to run; default is every test with an executable")
+parser.add_argument('-v', '--variants', dest='variants', nargs='+', required=False,
+                    default=['single', 'loop'], choices=['single', 'loop'],
+                    help="single: the test as built for the test suite; loop: the looped build from 'make bench'")
+parser.add_argument('-b', '--baseline', dest='baseline', required=False,
+                    help="baseline file; default is isa_bench_baseline.json in the ISA test directory")
+parser.add_argument('-o', '--out', dest='outFilename', required=False, default='isa_bench_report.json',
+                    help="machine-readable report")
+parser.add_argument('-u', '--update-baseline', dest='update', action='store_true',
+                    help="write the results of this run as the new baseline")
+parser.add_argument('--build', dest='build', action='store_true',
+                    help="run 'make bench' in the ISA test directory first")
+parser.add_argument('--sim-tol', dest='simTol', type=float, default=0.0,
+                    help="relative tolerance on simulated instructions and cycles (default 0.0)")
+parser.add_argument('--host-tol', dest='hostTol', type=float, default=0.25,
+                    help="relative tolerance on the host MIPS of each run (default 0.25)")
+parser.add_argument('--sst', dest='sst', required=False, default='sst')
+args = parser.parse_args()
+
+CLASSES = ['ALU', 'MulDiv', 'Load', 'Store', 'AMO', 'Branch', 'FP', 'System']
+
+PROFILE = re.compile(r'Self profile @ cycle (\d+): ([0-9.]+) host seconds; (\d+) instructions; ([0-9.]+) MIPS')
+
+isaDir = os.path.abspath(args.isaDir)
+baselineFile = args.baseline if args.baseline else os.path.join(isaDir, 'isa_bench_baseline.json')
+config = os.path.join(isaDir, 'rev-isa-bench.py')
+
+if args.build:
+  if subprocess.call(['make', '-C', isaDir, 'bench']) != 0:
+    print("Failed to build the ISA benchmarks in " + isaDir)
+    exit(1)
+
+# -- discover the tests
+if args.tests:
+  tests = args.tests
+else:
+  tests = sorted(f[:-4] for f in os.listdir(isaDir)
+                 if f.endswith('.exe') and not f.endswith('.loop.exe'))
+if not tests:
+  print("No ISA test executables found in " + isaDir + "; build them with 'make bench'")
+  exit(1)
+
+def readStats(statsFile):
+  # core 0 statistics from the SST CSV statistics output
+  stats = {}
+  with open(statsFile) as f:
+    rdr = csv.reader(f, skipinitialspace=True)
+    hdr = [h.strip() for h in next(rdr)]
+    iName = hdr.index('StatisticName')
+    iSub  = hdr.index('StatisticSubId')
+    iSum  = hdr.index('Sum.u64')
+    for row in rdr:
+      if len(row) <= max(iName, iSub, iSum):
+        continue
+      if row[iSub].strip() != 'core_0':
+        continue
+      stats[row[iName].strip()] = int(row[iSum])
+  return stats
+
+def runOne(test, variant):
+  exe = os.path.join(isaDir, test + ('.loop.exe' if variant == 'loop' else '.exe'))
+  res = {'test': test, 'variant': variant, 'status': 'missing'}
+  if not os.path.exists(exe):
+    return res
+
+  fd, statsFile = tempfile.mkstemp(suffix='.csv', prefix='isa_bench_')
+  os.close(fd)
+  env = dict(os.environ)
+  env['REV_ISA_BENCH_STATS'] = statsFile
+
+  start = time.time()
+  proc = subprocess.run([args.sst, '--model-options=' + exe, config], cwd=isaDir, env=env,
+                        stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+  res['host_wall'] = time.time() - start
+
+  out = proc.stdout
+  if proc.returncode != 0 or 'Simulation is complete' not in out:
+    res['status'] = 'fail'
+    os.remove(statsFile)
+    return res
+
+  stats = readStats(statsFile)
+  os.remove(statsFile)
+
+  classes = {c: stats.get('Inst' + c, 0) for c in CLASSES}
+  insts  = sum(classes.values())
+  cycles = stats.get('TotalCycles', 0)
+  res['status']  = 'pass'
+  res['insts']   = insts
+  res['cycles']  = cycles
+  res['ipc']     = (float(insts) / cycles) if cycles else 0.0
+  res['classes'] = classes
+
+  m = PROFILE.search(out)
+  if m:
+    res['host_sim'] = float(m.group(2))
+    res['mips']     = float(m.group(4))
+  else:
+    res['host_sim'] = res['host_wall']
+    res['mips']     = (insts / res['host_wall'] / 1.0e6) if res['host_wall'] > 0 else 0.0
+  return res
+
+def compare(res, base):
+  # returns the list of regressions of res against its baseline entry
+  regs = []
+  if base is None or base.get('status') != 'pass':
+    return regs
+  if res['status'] != 'pass':
+    regs.append('status ' + res['status'])
+    return regs
+  for key in ['insts', 'cycles']:
+    ref = base[key]
+    if ref and abs(res[key] - ref) > args.simTol * ref:
+      regs.append('{} {} vs {}'.format(key, res[key], ref))
+  if base['mips'] > 0 and res['mips'] < base['mips'] * (1.0 - args.hostTol):
+    regs.append('mips {:.3f} vs {:.3f}'.format(res['mips'], base['mips']))
+  return regs
+
+baseline = {}
+if os.path.exists(baselineFile):
+  with open(baselineFile) as f:
+    baseline = json.load(f).get('results', {})
+
+results = []
+failures = 0
+print('{:<12} {:<7} {:<6} {:>12} {:>12} {:>7} {:>9} {:>9}  {}'.format(
+      'test', 'variant', 'status', 'insts', 'cycles', 'ipc', 'host(s)', 'MIPS', 'baseline'))
+for test in tests:
+  for variant in args.variants:
+    res = runOne(test, variant)
+    if res['status'] == 'missing':
+      continue
+    key = test + ':' + variant
+    base = baseline.get(key)
+    res['regressions'] = compare(res, base)
+    if res['status'] == 'pass' and base is not None and base.get('mips', 0) > 0:
+      res['mips_delta'] = (res['mips'] - base['mips']) / base['mips']
+    if res['status'] != 'pass' or res['regressions']:
+      failures += 1
+    results.append(res)
+
+    verdict = 'none' if base is None else ('REGRESSED: ' + '; '.join(res['regressions']) if res['regressions'] else 'ok')
+    if res['status'] == 'pass':
+      print('{:<12} {:<7} {:<6} {:>12} {:>12} {:>7.3f} {:>9.3f} {:>9.3f}  {}'.format(
+            test, variant, res['status'], res['insts'], res['cycles'], res['ipc'],
+            res['host_sim'], res['mips'], verdict))
+    else:
+      print('{:<12} {:<7} {:<6} {:>12} {:>12} {:>7} {:>9} {:>9}  {}'.format(
+            test, variant, res['status'], '-', '-', '-', '-', '-', verdict))
+
+# -- per-instruction-class throughput; each run is attributed to its dominant class
+classSummary = {}
+for c in CLASSES:
+  runs = [r for r in results if r['status'] == 'pass' and r['insts'] and
+          max(r['classes'], key=r['classes'].get) == c]
+  insts = sum(r['insts'] for r in runs)
+  host  = sum(r['host_sim'] for r in runs)
+  classSummary[c] = {
+    'runs': len(runs),
+    'insts': insts,
+    'host_seconds': host,
+    'mips': (insts / host / 1.0e6) if host > 0 else 0.0
+  }
+
+report = {
+  'config': os.path.basename(config),
+  'sim_tol': args.simTol,
+  'host_tol': args.hostTol,
+  'baseline': baselineFile if baseline else None,
+  'failures': failures,
+  'results': results,
+  'classes': classSummary
+}
+with open(args.outFilename, 'w') as f:
+  json.dump(report, f, indent=2, sort_keys=True)
+print('Wrote ' + args.outFilename + '; ' + str(failures) + ' failures or regressions')
+
+if args.update:
+  keep = ['status', 'insts', 'cycles', 'ipc', 'mips', 'host_sim', 'classes']
+  with open(baselineFile, 'w') as f:
+    json.dump({'results': {r['test'] + ':' + r['variant']: {k: r[k] for k in keep if k in r}
+                           for r in results}}, f, indent=2, sort_keys=True)
+  print('Updated the baseline ' + baselineFile)
+
+exit(1 if (failures and not args.update) else 0)
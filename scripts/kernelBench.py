@@ -0,0 +1,166 @@
+import os
+import re
+import csv
+import json
+import time
+import argparse
+import tempfile
+import subprocess
+
+parser = argparse.ArgumentParser(description="Sweep the HPC kernel benchmarks across core counts and memory modes")
+parser.add_argument('-d', '--dir', dest='kernelDir', required=False,
+                    default=os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'test', 'benchmarks', 'kernels'),
+                    help="kernel benchmark directory")
+parser.add_argument('-k', '--kernels', dest='kernels', nargs='+', required=False,
+                    default=['stream', 'dgemm', 'spmv', 'stencil', 'bfs', 'histogram', 'fft'],
+                    help="kernels to run")
+parser.add_argument('-c', '--cores', dest='cores', nargs='+', type=int, required=False,
+                    default=[1, 2, 4, 8],
+                    help="core counts to sweep; each core runs one hart")
+parser.add_argument('-m', '--modes', dest='modes', nargs='+', required=False,
+                    default=['rev', 'memh'], choices=['rev', 'memh'],
+                    help="rev: the Rev internal memory model; memh: RevBasicMemCtrl and memHierarchy")
+parser.add_argument('-p', '--parts', dest='parts', nargs='+', type=int, required=False,
+                    default=[1],
+                    help="number of RevCPU components the cores are split across; more than one runs memh only")
+parser.add_argument('-n', '--threads', dest='threads', type=int, default=1,
+                    help="SST threads per simulation (default 1)")
+parser.add_argument('-o', '--out', dest='outFilename', required=False, default='kernel_bench_report.json',
+                    help="machine-readable report")
+parser.add_argument('--build', dest='build', action='store_true',
+                    help="build the kernels for the swept core counts first")
+parser.add_argument('--clock', dest='clock', type=float, default=1.0e9,
+                    help="simulated clock in Hz; must match rev-kernels.py (default 1.0e9)")
+parser.add_argument('--sst', dest='sst', required=False, default='sst')
+args = parser.parse_args()
+
+PROFILE = re.compile(r'Self profile @ cycle (\d+): ([0-9.]+) host seconds; (\d+) instructions; ([0-9.]+) MIPS; ([0-9.]+) KHz')
+CLASSES = ['ALU', 'MulDiv', 'Load', 'Store', 'AMO', 'Branch', 'FP', 'System']
+
+kernelDir = os.path.abspath(args.kernelDir)
+config = os.path.join(kernelDir, 'rev-kernels.py')
+
+if args.build:
+  cores = ' '.join(str(c) for c in args.cores)
+  if subprocess.call(['make', '-C', kernelDir, 'CORES=' + cores]) != 0:
+    print("Failed to build the kernels in " + kernelDir)
+    exit(1)
+
+def readStats(statsFile):
+  # per-core statistics from the SST CSV statistics output; stats[core][name]
+  stats = {}
+  with open(statsFile) as f:
+    rdr = csv.reader(f, skipinitialspace=True)
+    hdr = [h.strip() for h in next(rdr)]
+    iName = hdr.index('StatisticName')
+    iSub  = hdr.index('StatisticSubId')
+    iSum  = hdr.index('Sum.u64')
+    for row in rdr:
+      if len(row) <= max(iName, iSub, iSum):
+        continue
+      sub = row[iSub].strip()
+      if not sub.startswith('core_'):
+        continue
+      stats.setdefault(int(sub[5:]), {})[row[iName].strip()] = int(row[iSum])
+  return stats
+
+def runOne(kernel, cores, mode, parts):
+  exe = os.path.join(kernelDir, '{}.{}.exe'.format(kernel, cores))
+  res = {'kernel': kernel, 'cores': cores, 'mode': mode, 'parts': parts, 'status': 'missing'}
+  if not os.path.exists(exe) or parts > cores or (parts > 1 and mode != 'memh'):
+    return res
+
+  fd, statsFile = tempfile.mkstemp(suffix='.csv', prefix='kernel_bench_')
+  os.close(fd)
+  env = dict(os.environ)
+  env['REV_EXE'] = exe
+  env['REV_CORES'] = str(cores)
+  env['REV_MEMH'] = '1' if mode == 'memh' else '0'
+  env['REV_PARTS'] = str(parts)
+  env['REV_KERNEL_STATS'] = statsFile
+
+  start = time.time()
+  proc = subprocess.run([args.sst, '-n', str(args.threads), config], cwd=kernelDir, env=env,
+                        stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+  res['host_wall'] = time.time() - start
+
+  out = proc.stdout
+  if proc.returncode != 0 or 'Simulation is complete' not in out:
+    res['status'] = 'fail'
+    os.remove(statsFile)
+    return res
+
+  stats = readStats(statsFile)
+  os.remove(statsFile)
+
+  perCore = []
+  for c in range(cores):
+    s = stats.get(c, {})
+    perCore.append({
+      'insts': sum(s.get('Inst' + n, 0) for n in CLASSES),
+      'cycles': s.get('TotalCycles', 0),
+      'bytes': s.get('BytesRead', 0) + s.get('BytesWritten', 0)
+    })
+  insts  = sum(p['insts'] for p in perCore)
+  cycles = max(p['cycles'] for p in perCore) if perCore else 0
+  nbytes = sum(p['bytes'] for p in perCore)
+  res['status']   = 'pass'
+  res['insts']    = insts
+  res['cycles']   = cycles
+  res['bytes']    = nbytes
+  res['ipc']      = (float(insts) / cycles) if cycles else 0.0
+  res['core_ipc'] = [(float(p['insts']) / p['cycles']) if p['cycles'] else 0.0 for p in perCore]
+  res['gbps']     = (nbytes * args.clock / cycles / 1.0e9) if cycles else 0.0
+
+  # each component reports its own profile; the slowest one bounds the run
+  profs = PROFILE.findall(out)
+  if profs:
+    res['host_sim'] = max(float(m[1]) for m in profs)
+    res['mips']     = (sum(int(m[2]) for m in profs) / res['host_sim'] / 1.0e6) if res['host_sim'] > 0 else 0.0
+    res['khz']      = min(float(m[4]) for m in profs)
+  else:
+    res['host_sim'] = res['host_wall']
+    res['mips']     = (insts / res['host_wall'] / 1.0e6) if res['host_wall'] > 0 else 0.0
+    res['khz']      = (cycles / res['host_wall'] / 1.0e3) if res['host_wall'] > 0 else 0.0
+  return res
+
+results = []
+failures = 0
+print('{:<10} {:>5} {:<5} {:>5} {:<6} {:>12} {:>12} {:>7} {:>8} {:>8} {:>9} {:>9} {:>9}'.format(
+      'kernel', 'cores', 'mode', 'parts', 'status', 'insts', 'cycles', 'ipc', 'GB/s', 'speedup', 'host(s)', 'MIPS', 'KHz'))
+for kernel in args.kernels:
+  for mode in args.modes:
+    for parts in args.parts:
+      ref = None
+      for cores in args.cores:
+        res = runOne(kernel, cores, mode, parts)
+        if res['status'] == 'missing':
+          continue
+        if res['status'] != 'pass':
+          failures += 1
+          results.append(res)
+          print('{:<10} {:>5} {:<5} {:>5} {:<6}'.format(kernel, cores, mode, parts, res['status']))
+          continue
+
+        # modeled strong scaling relative to the smallest core count of the sweep
+        if ref is None:
+          ref = res
+        res['speedup']    = (float(ref['cycles']) / res['cycles']) if res['cycles'] else 0.0
+        res['efficiency'] = res['speedup'] * ref['cores'] / cores
+        results.append(res)
+        print('{:<10} {:>5} {:<5} {:>5} {:<6} {:>12} {:>12} {:>7.3f} {:>8.3f} {:>8.3f} {:>9.3f} {:>9.3f} {:>9.1f}'.format(
+              kernel, cores, mode, parts, res['status'], res['insts'], res['cycles'], res['ipc'],
+              res['gbps'], res['speedup'], res['host_sim'], res['mips'], res['khz']))
+
+report = {
+  'config': os.path.basename(config),
+  'clock': args.clock,
+  'threads': args.threads,
+  'failures': failures,
+  'results': results
+}
+with open(args.outFilename, 'w') as f:
+  json.dump(report, f, indent=2, sort_keys=True)
+print('Wrote ' + args.outFilename + '; ' + str(failures) + ' failures')
+
+exit(1 if failures else 0)
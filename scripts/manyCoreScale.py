@@ -0,0 +1,126 @@
+import os
+import re
+import json
+import time
+import argparse
+import subprocess
+
+parser = argparse.ArgumentParser(description="Measure RevCPU construction time, memory and per-cycle host cost as the core count grows")
+parser.add_argument('-d', '--dir', dest='testDir', required=False,
+                    default=os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'test', 'many_core'),
+                    help="many_core test directory")
+parser.add_argument('-c', '--cores', dest='cores', nargs='+', type=int, required=False,
+                    default=[1, 16, 256, 1024, 4096],
+                    help="core counts to instantiate")
+parser.add_argument('-o', '--out', dest='outFilename', required=False, default='many_core_scale.json',
+                    help="machine-readable report")
+parser.add_argument('--log', dest='logFilename', required=False,
+                    help="keep the simulator output of the largest passing run")
+parser.add_argument('--ref-cores', dest='refCores', type=int, default=16,
+                    help="scaling is judged against the smallest swept core count at or above this (default 16)")
+parser.add_argument('--threshold', dest='threshold', type=float, default=0.5,
+                    help="allowed relative growth of each per-core cost over the reference (default 0.5)")
+parser.add_argument('--sst', dest='sst', required=False, default='sst')
+args = parser.parse_args()
+
+PROFILE = re.compile(r'Self profile @ cycle (\d+): ([0-9.]+) host seconds; (\d+) instructions')
+BUILD   = re.compile(r'build: ([0-9.]+) host seconds for (\d+) cores')
+
+# per-core costs that must grow no faster than linearly in the core count
+METRICS = ['build_us_per_core', 'rss_kb_per_core', 'cycle_ns_per_core']
+
+testDir = os.path.abspath(args.testDir)
+config = os.path.join(testDir, 'rev-many-core-scale.py')
+exe = os.path.join(testDir, 'many_core.exe')
+if not os.path.exists(exe):
+  print("many_core.exe not found in " + testDir + "; build it with 'make'")
+  exit(1)
+
+def runOne(cores):
+  res = {'cores': cores, 'status': 'fail'}
+  env = dict(os.environ)
+  env['REV_EXE'] = exe
+  env['REV_CORES'] = str(cores)
+
+  # wait4 returns the resource usage of this simulation alone
+  start = time.time()
+  proc = subprocess.Popen([args.sst, config], cwd=testDir, env=env,
+                          stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+  out = proc.stdout.read()
+  proc.stdout.close()
+  pid, status, usage = os.wait4(proc.pid, 0)
+  res['host_wall'] = time.time() - start
+  res['rss_kb'] = usage.ru_maxrss
+  res['output'] = out
+
+  if not os.WIFEXITED(status) or os.WEXITSTATUS(status) != 0 or 'Simulation is complete' not in out:
+    return res
+  prof = PROFILE.search(out)
+  build = BUILD.search(out)
+  if not prof or not build:
+    return res
+
+  res['status']     = 'pass'
+  res['cycles']     = int(prof.group(1))
+  res['host_run']   = float(prof.group(2))
+  res['insts']      = int(prof.group(3))
+  res['host_build'] = float(build.group(1))
+  res['build_us_per_core'] = res['host_build'] * 1.0e6 / cores
+  res['cycle_ns_per_core'] = (res['host_run'] * 1.0e9 / res['cycles'] / cores) if res['cycles'] else 0.0
+  return res
+
+results = []
+failures = 0
+base = None
+ref = None
+print('{:>6} {:<6} {:>10} {:>12} {:>10} {:>12} {:>10} {:>12}  {}'.format(
+      'cores', 'status', 'build(s)', 'us/core', 'rss(MB)', 'KB/core', 'cycles', 'ns/cyc/core', 'scaling'))
+for cores in sorted(args.cores):
+  res = runOne(cores)
+  out = res.pop('output')
+  if res['status'] != 'pass':
+    failures += 1
+    results.append(res)
+    print('{:>6} {:<6}'.format(cores, res['status']))
+    continue
+  if args.logFilename:
+    with open(args.logFilename, 'w') as f:
+      f.write(out)
+
+  # memory per core is the growth over the smallest configuration
+  if base is None:
+    base = res
+  if cores > base['cores']:
+    res['rss_kb_per_core'] = float(res['rss_kb'] - base['rss_kb']) / (cores - base['cores'])
+  else:
+    res['rss_kb_per_core'] = float(res['rss_kb']) / cores
+
+  res['regressions'] = []
+  if ref is None and cores >= args.refCores:
+    ref = res
+  elif ref is not None:
+    for m in METRICS:
+      if ref[m] > 0 and res[m] > ref[m] * (1.0 + args.threshold):
+        res['regressions'].append('{} {:.3f} vs {:.3f} at {} cores'.format(m, res[m], ref[m], ref['cores']))
+    if res['regressions']:
+      failures += 1
+  results.append(res)
+
+  verdict = 'reference' if res is ref else ('-' if ref is None else
+            ('WORSE THAN LINEAR: ' + '; '.join(res['regressions']) if res['regressions'] else 'ok'))
+  print('{:>6} {:<6} {:>10.3f} {:>12.3f} {:>10.1f} {:>12.3f} {:>10} {:>12.3f}  {}'.format(
+        cores, res['status'], res['host_build'], res['build_us_per_core'], res['rss_kb'] / 1024.0,
+        res['rss_kb_per_core'], res['cycles'], res['cycle_ns_per_core'], verdict))
+
+report = {
+  'config': os.path.basename(config),
+  'ref_cores': ref['cores'] if ref else None,
+  'threshold': args.threshold,
+  'failures': failures,
+  'results': results
+}
+with open(args.outFilename, 'w') as f:
+  json.dump(report, f, indent=2, sort_keys=True)
+print('Wrote ' + args.outFilename + '; ' + str(failures) + ' failures or scaling regressions')
+
+exit(1 if failures else 0)
@@ -0,0 +1,67 @@
+import sys
+import struct
+import argparse
+
+parser = argparse.ArgumentParser(description="Convert a Rev sampled memory access trace (.mtr) to a DRAM simulator trace")
+parser.add_argument('-t', '--trace', dest='traceFilename', required=True)
+parser.add_argument('-o', '--out', dest='outFilename', required=False)
+parser.add_argument('-f', '--format', dest='format', required=False, default='dramsim3',
+                    choices=['dramsim2', 'dramsim3', 'ramulator', 'text'],
+                    help="dramsim2: k6 trace; dramsim3: addr op cycle; ramulator: DRAM mode addr R|W; text: every field")
+parser.add_argument('-v', '--virtual', dest='virtual', action='store_true',
+                    help="emit virtual rather than physical addresses")
+parser.add_argument('-c', '--core', dest='core', type=int, required=False,
+                    help="only convert the accesses of one core")
+args = parser.parse_args()
+
+OP_READ      = 0
+OP_WRITE     = 1
+OP_AMO_READ  = 2
+OP_AMO_WRITE = 3
+
+OP_NAMES = ['R', 'W', 'AR', 'AW']
+
+REC = struct.Struct('<QQQQIHBB')
+
+try:
+  trc = open(args.traceFilename, 'rb')
+except:
+  print("Cannot open file " + args.traceFilename)
+  exit(1)
+
+data = trc.read()
+trc.close()
+
+if len(data) < 12 or data[0:8] != b'REVMTR01':
+  print("File " + args.traceFilename + " is not a Rev memory access trace")
+  exit(1)
+
+sample = struct.unpack('<I', data[8:12])[0]
+
+out = sys.stdout
+if args.outFilename:
+  out = open(args.outFilename, 'w')
+
+if args.format == 'text':
+  out.write('# sampled 1 in {}\n'.format(sample))
+  out.write('# cycle core hart pc vaddr paddr size op\n')
+
+count = 0
+for cycle, pc, vaddr, paddr, core, hart, size, op in REC.iter_unpack(data[12:12 + ((len(data) - 12) // REC.size) * REC.size]):
+  if args.core is not None and core != args.core:
+    continue
+  addr = vaddr if args.virtual else paddr
+  write = (op == OP_WRITE) or (op == OP_AMO_WRITE)
+  if args.format == 'dramsim2':
+    out.write('0x{:x} {} {}\n'.format(addr, 'P_MEM_WR' if write else 'P_MEM_RD', cycle))
+  elif args.format == 'dramsim3':
+    out.write('0x{:x} {} {}\n'.format(addr, 'WRITE' if write else 'READ', cycle))
+  elif args.format == 'ramulator':
+    out.write('0x{:x} {}\n'.format(addr, 'W' if write else 'R'))
+  else:
+    out.write('{} {} {} 0x{:x} 0x{:x} 0x{:x} {} {}\n'.format(cycle, core, hart, pc, vaddr, paddr, size, OP_NAMES[op & 3]))
+  count += 1
+
+if out is not sys.stdout:
+  out.close()
+  print("Converted " + str(count) + " accesses sampled 1 in " + str(sample))
@@ -0,0 +1,110 @@
+import sys
+import struct
+import argparse
+
+parser = argparse.ArgumentParser(description="Convert a Rev binary instruction trace (.rtrc) to a spike style commit log")
+parser.add_argument('-t', '--trace', dest='traceFilename', required=True)
+parser.add_argument('-o', '--out', dest='outFilename', required=False)
+parser.add_argument('-f', '--format', dest='format', required=False, default='commit',
+                    choices=['commit', 'rdt'],
+                    help="commit: spike --log-commits lines; rdt: RDT lines for spikeCheck.py -s")
+args = parser.parse_args()
+
+TAG_JUMP  = 0x01
+TAG_RVC   = 0x02
+TAG_RD    = 0x04
+TAG_RDFP  = 0x08
+TAG_MEM   = 0x10
+TAG_WRITE = 0x20
+
+MASK64 = (1 << 64) - 1
+
+try:
+  trc = open(args.traceFilename, 'rb')
+except:
+  print("Cannot open file " + args.traceFilename)
+  exit(1)
+
+data = trc.read()
+trc.close()
+
+if len(data) < 13 or data[0:8] != b'REVTRC01':
+  print("File " + args.traceFilename + " is not a Rev instruction trace")
+  exit(1)
+
+xlen = data[8]
+core = struct.unpack('<I', data[9:13])[0]
+width = 8 if xlen == 32 else 16
+vmask = (1 << xlen) - 1
+
+out = sys.stdout
+if args.outFilename:
+  out = open(args.outFilename, 'w')
+
+def getVar(pos):
+  val = 0
+  shift = 0
+  while True:
+    b = data[pos]
+    pos += 1
+    val |= (b & 0x7f) << shift
+    shift += 7
+    if b < 0x80:
+      return val, pos
+
+def getDelta(pos):
+  val, pos = getVar(pos)
+  return (val >> 1) ^ (-(val & 1)), pos
+
+pos = 13
+prevPC = 0
+prevNext = 0
+prevMem = 0
+lastReg = [0] * 64
+count = 0
+
+while pos < len(data):
+  tag = data[pos]
+  pos += 1
+
+  pc = prevNext
+  if tag & TAG_JUMP:
+    d, pos = getDelta(pos)
+    pc = (prevPC + d) & MASK64
+
+  if tag & TAG_RVC:
+    inst = data[pos] | (data[pos+1] << 8)
+    pos += 2
+    size = 2
+  else:
+    inst = struct.unpack('<I', data[pos:pos+4])[0]
+    pos += 4
+    size = 4
+  prevPC = pc
+  prevNext = (pc + size) & MASK64
+
+  rdStr = ''
+  if tag & TAG_RD:
+    rd = data[pos]
+    pos += 1
+    reg = (rd & 0x1f) + (32 if tag & TAG_RDFP else 0)
+    d, pos = getDelta(pos)
+    lastReg[reg] = (lastReg[reg] + d) & MASK64
+    prefix = 'f' if tag & TAG_RDFP else 'x'
+    rdStr = ' {:<3} 0x{:0{w}x}'.format(prefix + str(rd), lastReg[reg] & (MASK64 if tag & TAG_RDFP else vmask), w=(16 if tag & TAG_RDFP else width))
+
+  memStr = ''
+  if tag & TAG_MEM:
+    d, pos = getDelta(pos)
+    prevMem = (prevMem + d) & MASK64
+    memStr = ' mem 0x{:0{w}x}'.format(prevMem & vmask, w=width)
+
+  if args.format == 'rdt':
+    out.write('RDT: Executed PC = {:x} Inst: 0x{:0{w}x}{}{}\n'.format(pc, inst, rdStr, memStr, w=size*2))
+  else:
+    out.write('core {:>3}: 3 0x{:0{w}x} (0x{:0{iw}x}){}{}\n'.format(core, pc & vmask, inst, rdStr, memStr, w=width, iw=size*2))
+  count += 1
+
+if out is not sys.stdout:
+  out.close()
+  print("Converted " + str(count) + " instructions from core " + str(core))
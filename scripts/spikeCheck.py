@@ -1,7 +1,7 @@
 import sys
 import argparse
 
-parser = argparse.ArgumentParser(description="Match SST output with spkie trace file - use with __REV_DEEP_TRACE__ define")
+parser = argparse.ArgumentParser(description="Match SST output with spkie trace file - use with __REV_DEEP_TRACE__ define or revTrace.py -f rdt")
 parser.add_argument('-a', '--asmFile', dest='asmFilename', required=True)
 parser.add_argument('-s', '--sstOut', dest='sstOutfile', required=True)
 parser.add_argument('-k', '--spikeOut', dest='spikeOutfile', required=True)
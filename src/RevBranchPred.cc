@@ -0,0 +1,202 @@
+//
+// _RevBranchPred_cc_
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#include "../include/RevBranchPred.h"
+
+using namespace SST::RevCPU;
+
+RevBranchPred::RevBranchPred(BPType Type, unsigned Entries,
+                             unsigned BTBEntries, unsigned RASDepth)
+  : type(Type), phtMask(0), btbMask(0), rasDepth(RASDepth), rasTop(0),
+    rasCount(0), ghr(0x00ull), branches(0x00ull), mispredicts(0x00ull),
+    btbMisses(0x00ull), rasMisses(0x00ull) {
+
+  Entries     = PowerOfTwo(Entries);
+  BTBEntries  = PowerOfTwo(BTBEntries);
+  if( rasDepth == 0 ){
+    rasDepth = 1;
+  }
+
+  phtMask = Entries-1;
+  btbMask = BTBEntries-1;
+
+  // counters start out weakly not-taken
+  pht.assign(Entries, 1);
+  btbTag.assign(BTBEntries, 0x00ull);
+  btbTarget.assign(BTBEntries, 0x00ull);
+  ras.assign(rasDepth, 0x00ull);
+}
+
+RevBranchPred::~RevBranchPred(){
+}
+
+bool RevBranchPred::ParseType(const std::string &Name, BPType &Type){
+  if( Name == "none" ){
+    Type = BPNone;
+  }else if( Name == "static" ){
+    Type = BPStatic;
+  }else if( Name == "bimodal" ){
+    Type = BPBimodal;
+  }else if( Name == "gshare" ){
+    Type = BPGshare;
+  }else{
+    return false;
+  }
+  return true;
+}
+
+unsigned RevBranchPred::PowerOfTwo(unsigned Val){
+  if( Val == 0 )
+    return 1;
+  unsigned P = 1;
+  while( (P<<1) <= Val ){
+    P <<= 1;
+  }
+  return P;
+}
+
+unsigned RevBranchPred::PHTIndex(uint64_t PC){
+  // instructions are at least 2-byte aligned, drop the low bit
+  if( type == BPGshare ){
+    return (unsigned)(((PC >> 1) ^ ghr) & phtMask);
+  }
+  return (unsigned)((PC >> 1) & phtMask);
+}
+
+bool RevBranchPred::PredictTaken(uint64_t PC, uint64_t Target){
+  switch( type ){
+  case BPStatic:
+    // backward taken, forward not taken
+    return (Target <= PC);
+    break;
+  case BPBimodal:
+  case BPGshare:
+    return (pht[PHTIndex(PC)] >= 2);
+    break;
+  default:
+    break;
+  }
+  return false;
+}
+
+bool RevBranchPred::BTBLookup(uint64_t PC, uint64_t &Target){
+  unsigned Idx = (unsigned)((PC >> 1) & btbMask);
+  if( btbTag[Idx] != PC ){
+    return false;
+  }
+  Target = btbTarget[Idx];
+  return true;
+}
+
+void RevBranchPred::RASPush(uint64_t Addr){
+  rasTop = (rasTop+1) % rasDepth;
+  ras[rasTop] = Addr;
+  if( rasCount < rasDepth ){
+    rasCount++;
+  }
+}
+
+bool RevBranchPred::RASPop(uint64_t &Addr){
+  if( rasCount == 0 ){
+    return false;
+  }
+  Addr = ras[rasTop];
+  rasTop = (rasTop+rasDepth-1) % rasDepth;
+  rasCount--;
+  return true;
+}
+
+uint64_t RevBranchPred::Predict(uint64_t PC, CFType Kind,
+                                uint64_t Fallthrough, uint64_t Target){
+  uint64_t Next = Fallthrough;
+
+  switch( Kind ){
+  case CFBranch:
+    if( PredictTaken(PC, Target) ){
+      // the direction is taken, but we can only redirect
+      // fetch if the BTB knows where we are going
+      if( !BTBLookup(PC, Next) ){
+        Next = Fallthrough;
+      }
+    }
+    break;
+  case CFCall:
+    RASPush(Fallthrough);
+    if( !BTBLookup(PC, Next) ){
+      Next = Fallthrough;
+    }
+    break;
+  case CFReturn:
+    if( !RASPop(Next) ){
+      if( !BTBLookup(PC, Next) ){
+        Next = Fallthrough;
+      }
+    }
+    break;
+  case CFJump:
+  case CFIndirect:
+    if( !BTBLookup(PC, Next) ){
+      Next = Fallthrough;
+    }
+    break;
+  case CFNone:
+  default:
+    break;
+  }
+
+  return Next;
+}
+
+bool RevBranchPred::Update(uint64_t PC, CFType Kind, uint64_t Fallthrough,
+                           uint64_t Pred, uint64_t Actual){
+  if( Kind == CFNone ){
+    return true;
+  }
+
+  bool Taken = (Actual != Fallthrough);
+  bool Correct = (Pred == Actual);
+
+  branches++;
+  if( !Correct ){
+    mispredicts++;
+    if( Kind == CFReturn ){
+      rasMisses++;
+    }else if( Taken ){
+      uint64_t Tmp = 0x00ull;
+      if( !BTBLookup(PC, Tmp) || (Tmp != Actual) ){
+        btbMisses++;
+      }
+    }
+  }
+
+  // train the direction predictor
+  if( Kind == CFBranch ){
+    unsigned Idx = PHTIndex(PC);
+    if( Taken ){
+      if( pht[Idx] < 3 )
+        pht[Idx]++;
+    }else{
+      if( pht[Idx] > 0 )
+        pht[Idx]--;
+    }
+    ghr = (ghr << 1) | (Taken ? 1 : 0);
+  }
+
+  // train the target buffer; returns are covered by the RAS
+  if( Taken && (Kind != CFReturn) ){
+    unsigned Idx = (unsigned)((PC >> 1) & btbMask);
+    btbTag[Idx]     = PC;
+    btbTarget[Idx]  = Actual;
+  }
+
+  return Correct;
+}
+
+// EOF
@@ -34,8 +34,10 @@ const char *pan_splash_msg = "\
 RevCPU::RevCPU( SST::ComponentId_t id, SST::Params& params )
   : SST::Component(id), testStage(0), PrivTag(0), address(-1), PrevAddr(_PAN_RDMA_MAILBOX_),
     EnableNIC(false), EnablePAN(false), EnablePANStats(false), EnableMemH(false),
-    ReadyForRevoke(false), Nic(nullptr), PNic(nullptr), PExec(nullptr), Ctrl(nullptr) {
+    ReadyForRevoke(false), Nic(nullptr), PNic(nullptr), PExec(nullptr), Ctrl(nullptr),
+    MemTrace(nullptr), HostProf(nullptr), HostProfInterval(0x00ull) {
 
+  const std::chrono::steady_clock::time_point BuildStart = std::chrono::steady_clock::now();
   const int Verbosity = params.find<int>("verbose", 0);
 
   // Initialize the output handler
@@ -69,6 +71,22 @@ RevCPU::RevCPU( SST::ComponentId_t id, SST::Params& params )
     numCores = 1; // force the PAN test to use a single core
   output.verbose(CALL_INFO, 1, 0, "Building Rev with %d cores\n", numCores);
 
+  // A node may be split across several RevCPU components that share memory
+  // through memHierarchy; coreBase is the node-wide index of our first core
+  coreBase = params.find<unsigned>("coreBase", 0);
+  nodeCores = params.find<unsigned>("nodeCores", 0);
+  if( (coreBase > 0) && (nodeCores == 0) )
+    output.fatal(CALL_INFO, -1,
+                 "Error: coreBase=%u requires nodeCores; every component of a split node must know the node-wide core count\n",
+                 coreBase);
+  if( (nodeCores > 0) && ((coreBase + numCores) > nodeCores) )
+    output.fatal(CALL_INFO, -1,
+                 "Error: cores %u-%u exceed nodeCores=%u\n",
+                 coreBase, coreBase + numCores - 1, nodeCores);
+  if( nodeCores > numCores )
+    output.verbose(CALL_INFO, 1, 0, "Building cores %u-%u of the %u core node\n",
+                   coreBase, coreBase + numCores - 1, nodeCores);
+
   // read the binary executable name
   Exe = params.find<std::string>("program", "a.out");
 
@@ -111,6 +129,51 @@ RevCPU::RevCPU( SST::ComponentId_t id, SST::Params& params )
     params.find_array<std::string>("prefetchDepth",prefetchDepths);
     if( !Opts->InitPrefetchDepth( prefetchDepths) )
       output.fatal(CALL_INFO, -1, "Error: failed to initalize the prefetch depth\n" );
+
+    std::vector<std::string> branchPreds;
+    params.find_array<std::string>("branchPred",branchPreds);
+    if( !Opts->InitBranchPred( branchPreds ) )
+      output.fatal(CALL_INFO, -1, "Error: failed to initialize the branch predictors\n" );
+
+    std::vector<std::string> branchPenalties;
+    params.find_array<std::string>("branchPenalty",branchPenalties);
+    if( !Opts->InitBranchPenalty( branchPenalties ) )
+      output.fatal(CALL_INFO, -1, "Error: failed to initialize the branch redirect penalties\n" );
+
+    std::vector<std::string> bpredEntries;
+    params.find_array<std::string>("bpredEntries",bpredEntries);
+    if( !Opts->InitBranchPredEntries( bpredEntries ) )
+      output.fatal(CALL_INFO, -1, "Error: failed to initialize the branch pattern table sizes\n" );
+
+    std::vector<std::string> btbEntries;
+    params.find_array<std::string>("btbEntries",btbEntries);
+    if( !Opts->InitBTBEntries( btbEntries ) )
+      output.fatal(CALL_INFO, -1, "Error: failed to initialize the branch target buffer sizes\n" );
+
+    std::vector<std::string> rasDepths;
+    params.find_array<std::string>("rasDepth",rasDepths);
+    if( !Opts->InitRASDepth( rasDepths ) )
+      output.fatal(CALL_INFO, -1, "Error: failed to initialize the return address stack depths\n" );
+
+    std::vector<std::string> fusionPolicies;
+    params.find_array<std::string>("fusion",fusionPolicies);
+    if( !Opts->InitFusion( fusionPolicies ) )
+      output.fatal(CALL_INFO, -1, "Error: failed to initialize the macro-op fusion policies\n" );
+
+    std::vector<std::string> jitModes;
+    params.find_array<std::string>("jit",jitModes);
+    if( !Opts->InitJIT( jitModes ) )
+      output.fatal(CALL_INFO, -1, "Error: failed to initialize the hot block translation modes\n" );
+
+    std::vector<std::string> profiles;
+    params.find_array<std::string>("profile",profiles);
+    if( !Opts->InitProfile( profiles ) )
+      output.fatal(CALL_INFO, -1, "Error: failed to initialize the guest profile prefixes\n" );
+
+    std::vector<std::string> traces;
+    params.find_array<std::string>("trace",traces);
+    if( !Opts->InitTrace( traces ) )
+      output.fatal(CALL_INFO, -1, "Error: failed to initialize the instruction trace prefixes\n" );
   }
 
   // See if we should load the network interface controller
@@ -211,18 +274,70 @@ RevCPU::RevCPU( SST::ComponentId_t id, SST::Params& params )
       output.verbose(CALL_INFO, 1, 0, "Warning: memory faults cannot be enabled with memHierarchy support\n");
   }
 
+  // Attach the sampled data access trace
+  const std::string memTraceFile = params.find<std::string>("memTrace", "");
+  if( !memTraceFile.empty() ){
+    std::vector<std::string> memTraceFilters;
+    params.find_array<std::string>("memTraceFilter", memTraceFilters);
+    std::vector<std::pair<uint64_t,uint64_t>> Ranges;
+    for( unsigned i=0; i<memTraceFilters.size(); i++ ){
+      std::pair<uint64_t,uint64_t> Range;
+      if( !RevMemTrace::ParseFilter(memTraceFilters[i], Range) )
+        output.fatal(CALL_INFO, -1, "Error: malformed memory trace filter %s\n",
+                     memTraceFilters[i].c_str() );
+      Ranges.push_back(Range);
+    }
+    const unsigned memTraceSample = params.find<unsigned>("memTraceSample", 1);
+    MemTrace = new RevMemTrace( memTraceFile, memTraceSample, Ranges );
+    if( !MemTrace->IsOpen() )
+      output.fatal(CALL_INFO, -1, "Error: failed to open the memory trace %s\n",
+                   memTraceFile.c_str() );
+    Mem->SetMemTrace(MemTrace);
+  }
+
   // Load the binary into memory
   Loader = new RevLoader( Exe, Args, Mem, &output );
   if( !Loader ){
     output.fatal(CALL_INFO, -1, "Error: failed to initialize the RISC-V loader\n" );
   }
 
+  // Node-wide core indices give each core a node-wide pid
+  if( nodeCores > numCores ){
+    if( !EnableMemH )
+      output.fatal(CALL_INFO, -1,
+                   "Error: a split node requires enable_memH; cores of separate components only share memory through memHierarchy\n");
+    Mem->SetPIDBase(1024 + coreBase * _REV_HART_COUNT_);
+    Mem->SetSplitNode(true);
+  }
+
+  // Checked translation compares against memory no other core may write
+  for( unsigned i=0; i<numCores; i++ ){
+    std::string JITMode;
+    Opts->GetJIT(i, JITMode);
+    if( (JITMode != "off") && (EnableMemH || (numCores > 1)) )
+      output.fatal(CALL_INFO, -1,
+                   "Error: jit=%s on core %u requires a single core without memHierarchy\n",
+                   JITMode.c_str(), coreBase + i);
+  }
+
   // Create the processor objects
   Procs.reserve(Procs.size() + numCores);
   for( unsigned i=0; i<numCores; i++ ){
     Procs.push_back( new RevProc( i, Opts, Mem, Loader, &output ) );
   }
 
+  // Measure the host time spent in each simulator subsystem
+  if( params.find<bool>("selfProfile", 0) ){
+    HostProf = new RevHostProf( params.find<unsigned>("selfProfileSample", 64), numCores );
+    HostProfInterval = params.find<uint64_t>("selfProfileInterval", 0);
+    for( unsigned i=0; i<Procs.size(); i++ ){
+      Procs[i]->SetHostProf(HostProf);
+    }
+    Mem->SetHostProf(HostProf);
+    if( Ctrl )
+      Ctrl->setHostProf(HostProf);
+  }
+
   // setup the per-proc statistics
   TotalCycles.reserve(TotalCycles.size() + numCores);
   CyclesWithIssue.reserve(CyclesWithIssue.size() + numCores);
@@ -233,17 +348,62 @@ RevCPU::RevCPU( SST::ComponentId_t id, SST::Params& params )
   BytesRead.reserve(BytesRead.size() + numCores);
   BytesWritten.reserve(BytesWritten.size() + numCores);
   FloatsExec.reserve(FloatsExec.size() + numCores);
+  BranchesExec.reserve(BranchesExec.size() + numCores);
+  BranchMispredicts.reserve(BranchMispredicts.size() + numCores);
+  BTBMisses.reserve(BTBMisses.size() + numCores);
+  RASMisses.reserve(RASMisses.size() + numCores);
+  CyclesRedirect.reserve(CyclesRedirect.size() + numCores);
+  PrefetchHits.reserve(PrefetchHits.size() + numCores);
+  PrefetchMisses.reserve(PrefetchMisses.size() + numCores);
+  PrefetchStalls.reserve(PrefetchStalls.size() + numCores);
+  FusedPairs.reserve(FusedPairs.size() + numCores);
+  JITBlocks.reserve(JITBlocks.size() + numCores);
+  JITChecks.reserve(JITChecks.size() + numCores);
+  ClassInsts.reserve(ClassInsts.size() + numCores);
+  ClassStalls.reserve(ClassStalls.size() + numCores);
+  InstMix.reserve(InstMix.size() + numCores);
 
   for(int s = 0; s < numCores; s++){
-    TotalCycles.push_back(registerStatistic<uint64_t>("TotalCycles", "core_" + std::to_string(s)));
-    CyclesWithIssue.push_back(registerStatistic<uint64_t>("CyclesWithIssue", "core_" + std::to_string(s)));
-    FloatsRead.push_back( registerStatistic<uint64_t>("FloatsRead", "core_" + std::to_string(s)));
-    FloatsWritten.push_back( registerStatistic<uint64_t>("FloatsWritten", "core_" + std::to_string(s)));
-    DoublesRead.push_back( registerStatistic<uint64_t>("DoublesRead", "core_" + std::to_string(s)));
-    DoublesWritten.push_back( registerStatistic<uint64_t>("DoublesWritten", "core_" + std::to_string(s)));
-    BytesRead.push_back( registerStatistic<uint64_t>("BytesRead", "core_" + std::to_string(s)));
-    BytesWritten.push_back( registerStatistic<uint64_t>("BytesWritten", "core_" + std::to_string(s)));
-    FloatsExec.push_back( registerStatistic<uint64_t>("FloatsExec", "core_" + std::to_string(s)));
+    TotalCycles.push_back(registerStatistic<uint64_t>("TotalCycles", "core_" + std::to_string(coreBase + s)));
+    CyclesWithIssue.push_back(registerStatistic<uint64_t>("CyclesWithIssue", "core_" + std::to_string(coreBase + s)));
+    FloatsRead.push_back( registerStatistic<uint64_t>("FloatsRead", "core_" + std::to_string(coreBase + s)));
+    FloatsWritten.push_back( registerStatistic<uint64_t>("FloatsWritten", "core_" + std::to_string(coreBase + s)));
+    DoublesRead.push_back( registerStatistic<uint64_t>("DoublesRead", "core_" + std::to_string(coreBase + s)));
+    DoublesWritten.push_back( registerStatistic<uint64_t>("DoublesWritten", "core_" + std::to_string(coreBase + s)));
+    BytesRead.push_back( registerStatistic<uint64_t>("BytesRead", "core_" + std::to_string(coreBase + s)));
+    BytesWritten.push_back( registerStatistic<uint64_t>("BytesWritten", "core_" + std::to_string(coreBase + s)));
+    FloatsExec.push_back( registerStatistic<uint64_t>("FloatsExec", "core_" + std::to_string(coreBase + s)));
+    BranchesExec.push_back( registerStatistic<uint64_t>("BranchesExec", "core_" + std::to_string(coreBase + s)));
+    BranchMispredicts.push_back( registerStatistic<uint64_t>("BranchMispredicts", "core_" + std::to_string(coreBase + s)));
+    BTBMisses.push_back( registerStatistic<uint64_t>("BTBMisses", "core_" + std::to_string(coreBase + s)));
+    RASMisses.push_back( registerStatistic<uint64_t>("RASMisses", "core_" + std::to_string(coreBase + s)));
+    CyclesRedirect.push_back( registerStatistic<uint64_t>("CyclesRedirect", "core_" + std::to_string(coreBase + s)));
+    PrefetchHits.push_back( registerStatistic<uint64_t>("PrefetchHits", "core_" + std::to_string(coreBase + s)));
+    PrefetchMisses.push_back( registerStatistic<uint64_t>("PrefetchMisses", "core_" + std::to_string(coreBase + s)));
+    PrefetchStalls.push_back( registerStatistic<uint64_t>("PrefetchStalls", "core_" + std::to_string(coreBase + s)));
+    FusedPairs.push_back( registerStatistic<uint64_t>("FusedPairs", "core_" + std::to_string(coreBase + s)));
+    JITBlocks.push_back( registerStatistic<uint64_t>("JITBlocks", "core_" + std::to_string(coreBase + s)));
+    JITChecks.push_back( registerStatistic<uint64_t>("JITChecks", "core_" + std::to_string(coreBase + s)));
+
+    // instruction mix by class and by instruction table entry
+    ClassInsts.push_back( std::vector<Statistic<uint64_t>*>() );
+    ClassStalls.push_back( std::vector<Statistic<uint64_t>*>() );
+    for( unsigned c=0; c<RevProc::InstClassCount; c++ ){
+      std::string Name = RevProc::GetInstClassName(c);
+      ClassInsts[s].push_back( registerStatistic<uint64_t>("Inst" + Name, "core_" + std::to_string(coreBase + s)));
+      ClassStalls[s].push_back( registerStatistic<uint64_t>("Stall" + Name, "core_" + std::to_string(coreBase + s)));
+    }
+    // entries that share a mnemonic share a statistic
+    std::map<std::string,Statistic<uint64_t>*> MixStats;
+    InstMix.push_back( std::vector<Statistic<uint64_t>*>() );
+    for( unsigned e=0; e<Procs[s]->GetNumEntries(); e++ ){
+      std::string Mnem = Procs[s]->GetEntryMnemonic(e);
+      if( MixStats.find(Mnem) == MixStats.end() ){
+        MixStats[Mnem] = registerStatistic<uint64_t>("InstMix", "core_" + std::to_string(coreBase + s) +
+                                                     "_" + Mnem);
+      }
+      InstMix[s].push_back( MixStats[Mnem] );
+    }
   }
 
   // setup the PAN execution contexts
@@ -263,6 +423,15 @@ RevCPU::RevCPU( SST::ComponentId_t id, SST::Params& params )
     Enabled[i] = true;
   }
 
+  // Every core starts on the active worklist
+  ActiveCores.reserve(numCores);
+  for( unsigned i=0; i<numCores; i++ ){
+    ActiveCores.push_back(i);
+  }
+  ParkedAt.assign(numCores, _REV_CORE_ACTIVE_);
+  LiveCores = numCores;
+  Ticks = 0;
+
   {
     const unsigned Splash = params.find<bool>("splash",0);
 
@@ -274,6 +443,10 @@ RevCPU::RevCPU( SST::ComponentId_t id, SST::Params& params )
     }
   }
 
+  // Charge the construction to the self profile; the run clock starts here
+  if( HostProf )
+    HostProf->MarkBuilt(std::chrono::duration<double>(std::chrono::steady_clock::now() - BuildStart).count());
+
   // Done with initialization
   if( EnablePANTest )
     output.verbose(CALL_INFO, 1, 0, "Initialization of PANTest harness complete.\n");
@@ -298,6 +471,16 @@ RevCPU::~RevCPU(){
   if( Ctrl )
     delete Ctrl;
 
+  // delete the self profile
+  if( HostProf )
+    delete HostProf;
+
+  // drain the memory trace before its memory object goes away
+  if( MemTrace ){
+    Mem->SetMemTrace(nullptr);
+    delete MemTrace;
+  }
+
   // delete the memory object
   delete Mem;
 
@@ -468,6 +651,26 @@ void RevCPU::setup(){
 }
 
 void RevCPU::finish(){
+  for( unsigned i=0; i<Procs.size(); i++ ){
+    Procs[i]->WriteProfile();
+  }
+  if( HostProf ){
+    ReportHostProf(getCurrentSimTime(timeConverter));
+  }
+  if( MemTrace ){
+    MemTrace->Flush();
+    output.verbose(CALL_INFO, 1, 0,
+                   "Memory trace: %" PRIu64 " records written; %" PRIu64 " dropped\n",
+                   MemTrace->GetRecords(), MemTrace->GetDropped());
+  }
+}
+
+void RevCPU::ReportHostProf(SST::Cycle_t currentCycle){
+  std::vector<uint64_t> Insts;
+  for( unsigned i=0; i<Procs.size(); i++ ){
+    Insts.push_back(Procs[i]->GetRetired());
+  }
+  output.output("%s", HostProf->Report((uint64_t)(currentCycle), Insts).c_str());
 }
 
 void RevCPU::init( unsigned int phase ){
@@ -993,6 +1196,7 @@ void RevCPU::PANHandleHalt(panNicEvent *event){
     PANBuildFailedToken(event);
     return ;
   }
+  // the core is parked once its pipeline drains
   Procs[HART]->Halt();
   PANBuildRawSuccess(event);
 }
@@ -1009,6 +1213,8 @@ void RevCPU::PANHandleResume(panNicEvent *event){
   for( unsigned i=0; i<Procs.size(); i++ ){
     if( !Procs[i]->Resume() )
       error = true;
+    else
+      WakeCore(i);
   }
   if( error )
     PANBuildFailedToken(event);
@@ -1099,6 +1305,7 @@ void RevCPU::PANHandleSingleStep(panNicEvent *event){
     PANBuildFailedToken(event);
     return ;
   }
+  WakeCore(HART);
 
   panNicEvent *SCmd = new panNicEvent(getName());
   PANBuildBasicSuccess(event,SCmd);
@@ -2170,14 +2377,8 @@ bool RevCPU::clockTickPANTest( SST::Cycle_t currentCycle ){
   // run test harness
   ExecPANTest();
 
-  // Execute each enabled core
-  for( unsigned i=0; i<Procs.size(); i++ ){
-    if( Enabled[i] ){
-      if( !Procs[i]->ClockTick(currentCycle) ){
-        Enabled[i] = false;
-      }
-    }
-  }
+  // Execute each active core
+  ClockActiveCores(currentCycle, false);
 
   // inject messages
   for( unsigned i=0; i< msgPerCycle; i++ ){
@@ -2187,10 +2388,8 @@ bool RevCPU::clockTickPANTest( SST::Cycle_t currentCycle ){
   }
 
   // check to see if all the processors are completed
-  for( unsigned i=0; i<Procs.size(); i++ ){
-    if( Enabled[i] )
-      rtn = false;
-  }
+  if( LiveCores )
+    rtn = false;
 
   // check to see if we have outstanding network messages and whether the tests are complete
   if( (!SendMB.empty() || !TrackTags.empty()) &&
@@ -2318,6 +2517,67 @@ void RevCPU::UpdateCoreStatistics(uint16_t coreNum){
   BytesRead[coreNum]->addData(stats.memStats.bytesRead);
   BytesWritten[coreNum]->addData(stats.memStats.bytesWritten);
   FloatsExec[coreNum]->addData(stats.floatsExec);
+  BranchesExec[coreNum]->addData(stats.branchesExec);
+  BranchMispredicts[coreNum]->addData(stats.branchMispredicts);
+  BTBMisses[coreNum]->addData(stats.btbMisses);
+  RASMisses[coreNum]->addData(stats.rasMisses);
+  CyclesRedirect[coreNum]->addData(stats.cyclesRedirect);
+  PrefetchHits[coreNum]->addData(stats.fetchHits);
+  PrefetchMisses[coreNum]->addData(stats.fetchMisses);
+  PrefetchStalls[coreNum]->addData(stats.fetchStalls);
+  FusedPairs[coreNum]->addData(stats.fusedPairs);
+  JITBlocks[coreNum]->addData(stats.jitBlocks);
+  JITChecks[coreNum]->addData(stats.jitChecks);
+  for( unsigned c=0; c<RevProc::InstClassCount; c++ ){
+    ClassInsts[coreNum][c]->addData(stats.classInsts[c]);
+    ClassStalls[coreNum][c]->addData(stats.classStalls[c]);
+  }
+  const std::vector<uint64_t> &Mix = Procs[coreNum]->GetInstMix();
+  for( unsigned e=0; e<Mix.size() && e<InstMix[coreNum].size(); e++ ){
+    if( Mix[e] )
+      InstMix[coreNum][e]->addData(Mix[e]);
+  }
+}
+
+void RevCPU::ClockActiveCores( SST::Cycle_t currentCycle, bool UpdateStats ){
+  Ticks++;
+
+  // compact the worklist in place so the cores keep their relative order
+  unsigned Keep = 0;
+  for( unsigned a=0; a<ActiveCores.size(); a++ ){
+    unsigned i = ActiveCores[a];
+    if( HostProf )
+      HostProf->EnterCore(i);
+    bool Running = Procs[i]->ClockTick(currentCycle);
+    if( HostProf )
+      HostProf->LeaveCore(i);
+    if( !Running ){
+      if( UpdateStats )
+        UpdateCoreStatistics(i);
+      Enabled[i] = false;
+      LiveCores--;
+      output.verbose(CALL_INFO, 5, 0, "Closing Processor %d at Cycle: %" PRIu64 "\n",
+                     i, static_cast<uint64_t>(currentCycle));
+    }else if( Procs[i]->IsQuiesced() ){
+      // halted with nothing in flight; skip the core until a resume or single step
+      ParkedAt[i] = Ticks;
+      output.verbose(CALL_INFO, 5, 0, "Parking Processor %d at Cycle: %" PRIu64 "\n",
+                     i, static_cast<uint64_t>(currentCycle));
+    }else{
+      ActiveCores[Keep++] = i;
+    }
+  }
+  ActiveCores.resize(Keep);
+}
+
+void RevCPU::WakeCore( unsigned Core ){
+  if( ParkedAt[Core] == _REV_CORE_ACTIVE_ )
+    return;
+
+  // charge the skipped ticks as idle cycles
+  Procs[Core]->SkipIdleCycles(Ticks - ParkedAt[Core]);
+  ParkedAt[Core] = _REV_CORE_ACTIVE_;
+  ActiveCores.insert(std::lower_bound(ActiveCores.begin(), ActiveCores.end(), Core), Core);
 }
 
 bool RevCPU::clockTick( SST::Cycle_t currentCycle ){
@@ -2325,19 +2585,18 @@ bool RevCPU::clockTick( SST::Cycle_t currentCycle ){
 
   output.verbose(CALL_INFO, 8, 0, "Cycle: %" PRIu64 "\n", static_cast<uint64_t>(currentCycle));
 
-  // Execute each enabled core
-  for( unsigned i=0; i<Procs.size(); i++ ){
-    if( Enabled[i] ){
-      if( !Procs[i]->ClockTick(currentCycle) ){
-         UpdateCoreStatistics(i);
-        Enabled[i] = false;
-      output.verbose(CALL_INFO, 5, 0, "Closing Processor %d at Cycle: %" PRIu64 "\n",
-                     i, static_cast<uint64_t>(currentCycle));
-      }
-    }
+  if( HostProf ){
+    HostProf->Tick();
+    if( HostProfInterval && ((currentCycle % HostProfInterval) == 0) )
+      ReportHostProf(currentCycle);
   }
+
+  // Execute each active core
+  ClockActiveCores(currentCycle, true);
+
   // Clock the PAN network transport module
   if( EnablePAN ){
+    RevHostScope HostScope(HostProf, RevHostProf::HostPAN);
 
     if( EnableRDMAMBox ){
       // process the incoming mailbox messages from our local cores
@@ -2374,10 +2633,8 @@ bool RevCPU::clockTick( SST::Cycle_t currentCycle ){
   }
 
   // check to see if all the processors are completed
-  for( unsigned i=0; i<Procs.size(); i++ ){
-    if( Enabled[i] )
-      rtn = false;
-  }
+  if( LiveCores )
+    rtn = false;
 
   // check to see if the network has any outstanding messages: fixme
   if( !SendMB.empty() || !TrackTags.empty() || !ZeroRqst.empty() || !RevokeHasArrived ){
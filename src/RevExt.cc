@@ -10,35 +10,38 @@
 
 #include "../include/RevExt.h"
 
+/// RevExt: table of an extension that does not register one
+static const std::vector<RevInstEntry> NoInsts;
+
 RevExt::RevExt( std::string Name,
                 RevFeature *Feature,
                 RevRegFile *RegFile,
                 RevMem *RevMem,
                 SST::Output *Output )
   : feature(Feature), mem(RevMem), name(Name),
-    output(Output) {
+    output(Output), table(&NoInsts), ctable(&NoInsts), otable(&NoInsts) {
   regFile = RegFile;
 }
 
 RevExt::~RevExt(){
 }
 
-void RevExt::SetTable(std::vector<RevInstEntry> InstVect){
-  table = InstVect;
+void RevExt::SetTable(const std::vector<RevInstEntry> &InstVect){
+  table = &InstVect;
 }
 
-void RevExt::SetCTable(std::vector<RevInstEntry> InstVect){
-  ctable = InstVect;
+void RevExt::SetCTable(const std::vector<RevInstEntry> &InstVect){
+  ctable = &InstVect;
 }
 
-void RevExt::SetOTable(std::vector<RevInstEntry> InstVect){
-  otable = InstVect;
+void RevExt::SetOTable(const std::vector<RevInstEntry> &InstVect){
+  otable = &InstVect;
 }
 
 bool RevExt::Execute(unsigned Inst, RevInst payload, uint16_t HartID){
 
   // ensure that the target instruction is within scope
-  if( Inst > (table.size()-1) ){
+  if( Inst > (table->size()-1) ){
     output->fatal(CALL_INFO, -1,
                   "Error: instruction at index=%d does not exist in extension=%s",
                   Inst,
@@ -52,31 +55,31 @@ bool RevExt::Execute(unsigned Inst, RevInst payload, uint16_t HartID){
   if( payload.compressed ){
 #if 0
     if( feature->IsRV32() ){
-      std::cout << "EXECUTING COMPRESSED INSTRUCTION: " << ctable[Inst].mnemonic
+      std::cout << "EXECUTING COMPRESSED INSTRUCTION: " << (*ctable)[Inst].mnemonic
                 << " @ 0x" << std::hex << regFile[threadID].RV32_PC << std::dec
                 << "; instSize = " << payload.instSize << std::endl;
     }else{
-      std::cout << "EXECUTING COMPRESSED INSTRUCTION: " << ctable[Inst].mnemonic
+      std::cout << "EXECUTING COMPRESSED INSTRUCTION: " << (*ctable)[Inst].mnemonic
                 << " @ 0x" << std::hex << regFile[threadID].RV64_PC << std::dec
                 << "; instSize = " << payload.instSize << std::endl;
     }
 #endif
     // this is a compressed instruction, grab the compressed trampoline function
-    func = ctable[Inst].func;
+    func = (*ctable)[Inst].func;
   }else{
 #if 0
     if( feature->IsRV32() ){
-      std::cout << "EXECUTING INSTRUCTION: " << table[Inst].mnemonic
+      std::cout << "EXECUTING INSTRUCTION: " << (*table)[Inst].mnemonic
                 << " @ 0x" << std::hex << regFile[threadID].RV32_PC << std::dec
                 << "; instSize = " << payload.instSize << std::endl;
     }else{
-      std::cout << "EXECUTING INSTRUCTION: " << table[Inst].mnemonic
+      std::cout << "EXECUTING INSTRUCTION: " << (*table)[Inst].mnemonic
                 << " @ 0x" << std::hex << regFile[threadID].RV64_PC << std::dec
                 << "; instSize = " << payload.instSize << std::endl;
     }
 #endif
     // retrieve the function pointer for this instruction
-    func = table[Inst].func;
+    func = (*table)[Inst].func;
   }
 
   // execute the instruction
@@ -86,18 +89,18 @@ bool RevExt::Execute(unsigned Inst, RevInst payload, uint16_t HartID){
 #if 0
   if( payload.compressed ){
     if( feature->IsRV32() ){
-      std::cout << "COMPLETING INSTRUCTION: " << ctable[Inst].mnemonic
+      std::cout << "COMPLETING INSTRUCTION: " << (*ctable)[Inst].mnemonic
                 << " @ 0x" << std::hex << regFile[threadID].RV32_PC-payload.instSize << std::dec << std::endl;
     }else{
-      std::cout << "COMPLETING INSTRUCTION: " << ctable[Inst].mnemonic
+      std::cout << "COMPLETING INSTRUCTION: " << (*ctable)[Inst].mnemonic
                 << " @ 0x" << std::hex << regFile[threadID].RV64_PC-payload.instSize << std::dec << std::endl;
     }
   }else{
     if( feature->IsRV32() ){
-      std::cout << "COMPLETING INSTRUCTION: " << table[Inst].mnemonic
+      std::cout << "COMPLETING INSTRUCTION: " << (*table)[Inst].mnemonic
                 << " @ 0x" << std::hex << regFile[threadID].RV32_PC-payload.instSize << std::dec << std::endl;
     }else{
-      std::cout << "COMPLETING INSTRUCTION: " << table[Inst].mnemonic
+      std::cout << "COMPLETING INSTRUCTION: " << (*table)[Inst].mnemonic
                 << " @ 0x" << std::hex << regFile[threadID].RV64_PC-payload.instSize << std::dec << std::endl;
     }
   }
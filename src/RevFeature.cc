@@ -36,6 +36,12 @@ bool RevFeature::HasCompressed(){
   return false;
 }
 
+bool RevFeature::HasDouble(){
+  if( IsModeEnabled(RV_D) )
+    return true;
+  return false;
+}
+
 bool RevFeature::IsRV32C(){
   if( IsRV32() && !IsRV64() && IsModeEnabled(RV_C) )
     return true;
@@ -0,0 +1,103 @@
+//
+// _RevHostProf_cc_
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#include <cinttypes>
+#include <cstdio>
+
+#include "../include/RevHostProf.h"
+
+using namespace SST::RevCPU;
+
+RevHostProf::RevHostProf(unsigned Sample, unsigned Cores)
+  : sample(Sample ? Sample : 1), tickCount(0), active(false), depth(0),
+    overflow(0), mark(0x00ull), coreMark(0x00ull), buildSeconds(0.0) {
+  for( unsigned i=0; i<HostPhaseCount; i++ ){
+    ticks[i] = 0x00ull;
+  }
+  coreTicks.assign(Cores, 0x00ull);
+  startTSC  = ReadTSC();
+  startWall = std::chrono::steady_clock::now();
+}
+
+RevHostProf::~RevHostProf(){
+}
+
+void RevHostProf::MarkBuilt(double Seconds){
+  buildSeconds = Seconds;
+  startTSC  = ReadTSC();
+  startWall = std::chrono::steady_clock::now();
+}
+
+const char *RevHostProf::GetPhaseName(HostPhase Phase){
+  switch( Phase ){
+  case HostCore:    return "core";    break;
+  case HostFetch:   return "fetch";   break;
+  case HostDecode:  return "decode";  break;
+  case HostExecute: return "execute"; break;
+  case HostMem:     return "mem";     break;
+  case HostEcall:   return "ecall";   break;
+  case HostMemCtrl: return "memctrl"; break;
+  case HostPAN:     return "pan";     break;
+  default:          return "unknown"; break;
+  }
+}
+
+std::string RevHostProf::Report(uint64_t Cycle, const std::vector<uint64_t> &CoreInsts){
+  double Wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - startWall).count();
+  uint64_t Elapsed = ReadTSC() - startTSC;
+
+  // the timestamp counter is calibrated against the wall clock over the whole run
+  double TicksPerSec = (Wall > 0.0) ? ((double)(Elapsed) / Wall) : 0.0;
+  double Scale = (TicksPerSec > 0.0) ? ((double)(sample) / TicksPerSec) : 0.0;
+
+  uint64_t Insts = 0x00ull;
+  for( unsigned i=0; i<CoreInsts.size(); i++ ){
+    Insts += CoreInsts[i];
+  }
+
+  std::string Out;
+  char Line[256];
+  snprintf(Line, sizeof(Line),
+           "Self profile @ cycle %" PRIu64 ": %.3f host seconds; %" PRIu64
+           " instructions; %.3f MIPS; %.3f KHz\n",
+           Cycle, Wall, Insts, (Wall > 0.0) ? ((double)(Insts) / Wall / 1.0e6) : 0.0,
+           (Wall > 0.0) ? ((double)(Cycle) / Wall / 1.0e3) : 0.0);
+  Out += Line;
+
+  snprintf(Line, sizeof(Line),
+           "  build: %.3f host seconds for %zu cores (%.3f us per core); %.3f us per cycle\n",
+           buildSeconds, coreTicks.size(),
+           coreTicks.size() ? (buildSeconds * 1.0e6 / (double)(coreTicks.size())) : 0.0,
+           Cycle ? (Wall * 1.0e6 / (double)(Cycle)) : 0.0);
+  Out += Line;
+
+  for( unsigned i=0; i<CoreInsts.size() && i<coreTicks.size(); i++ ){
+    double Host = (double)(coreTicks[i]) * Scale;
+    snprintf(Line, sizeof(Line),
+             "  core %u: %" PRIu64 " instructions; %.3f MIPS; %.3f host seconds in the core (%.3f MIPS)\n",
+             i, CoreInsts[i], (Wall > 0.0) ? ((double)(CoreInsts[i]) / Wall / 1.0e6) : 0.0,
+             Host, (Host > 0.0) ? ((double)(CoreInsts[i]) / Host / 1.0e6) : 0.0);
+    Out += Line;
+  }
+
+  uint64_t Total = 0x00ull;
+  for( unsigned i=0; i<HostPhaseCount; i++ ){
+    Total += ticks[i];
+  }
+  for( unsigned i=0; i<HostPhaseCount; i++ ){
+    snprintf(Line, sizeof(Line), "  %-8s %10.3f host seconds %6.2f%%\n",
+             GetPhaseName((HostPhase)(i)), (double)(ticks[i]) * Scale,
+             Total ? (100.0 * (double)(ticks[i]) / (double)(Total)) : 0.0);
+    Out += Line;
+  }
+  return Out;
+}
+
+// EOF
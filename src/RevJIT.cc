@@ -0,0 +1,453 @@
+//
+// _RevJIT_cc_
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#include "../include/RevJIT.h"
+
+using namespace SST::RevCPU;
+
+RevJIT::RevJIT(RevMem *Mem, SST::Output *Output, unsigned Core)
+  : mem(Mem), output(Output), core(Core), check(nullptr), checkHart(0),
+    checkIdx(0), checkLen(0), blocks(0x00ull), checks(0x00ull){
+  // the first instruction of every hart starts a block
+  entry.assign(_REV_HART_COUNT_, true);
+}
+
+RevJIT::~RevJIT(){
+  Invalidate();
+}
+
+bool RevJIT::ParseMode(const std::string &Name, JITMode &Mode){
+  if( Name == "off" ){
+    Mode = JITOff;
+  }else if( Name == "check" ){
+    Mode = JITCheck;
+  }else{
+    return false;
+  }
+  return true;
+}
+
+void RevJIT::Invalidate(){
+  for( auto &B : cache ){
+    delete B.second;
+  }
+  cache.clear();
+  heat.clear();
+  check = nullptr;
+}
+
+bool RevJIT::Decode(uint64_t PC, RevJITOp &Op){
+  uint32_t Inst = 0;
+  if( !mem->PeekMem(PC, sizeof(Inst), &Inst) ){
+    return false;
+  }
+
+  // compressed instructions are not translated
+  if( (Inst & 0b11) != 0b11 ){
+    return false;
+  }
+
+  Op.PC  = PC;
+  Op.Opc = (uint8_t)(Inst & 0x7f);
+  Op.Rd  = (uint8_t)((Inst >> 7) & 0x1f);
+  Op.F3  = (uint8_t)((Inst >> 12) & 0x7);
+  Op.Rs1 = (uint8_t)((Inst >> 15) & 0x1f);
+  Op.Rs2 = (uint8_t)((Inst >> 20) & 0x1f);
+  Op.F7  = (uint8_t)(Inst >> 25);
+
+  int64_t ImmI = (int64_t)((int32_t)(Inst)) >> 20;
+
+  switch( Op.Opc ){
+  case 0b0110111:   // lui
+  case 0b0010111:   // auipc
+    Op.Imm = (int64_t)((int32_t)(Inst & 0xfffff000));
+    return true;
+  case 0b1101111:   // jal
+    Op.Imm = (((int64_t)((int32_t)(Inst & 0x80000000))) >> 11) |
+             (int64_t)(Inst & 0x000ff000) |
+             (int64_t)((Inst >> 9) & 0x800) |
+             (int64_t)((Inst >> 20) & 0x7fe);
+    return true;
+  case 0b1100111:   // jalr
+    Op.Imm = ImmI;
+    return (Op.F3 == 0);
+  case 0b1100011:   // beq, bne, blt, bge, bltu, bgeu
+    Op.Imm = (((int64_t)((int32_t)(Inst & 0x80000000))) >> 19) |
+             (int64_t)((Inst << 4) & 0x800) |
+             (int64_t)((Inst >> 20) & 0x7e0) |
+             (int64_t)((Inst >> 7) & 0x1e);
+    return (Op.F3 != 0b010) && (Op.F3 != 0b011);
+  case 0b0000011:   // lb, lh, lw, ld, lbu, lhu, lwu
+    Op.Imm = ImmI;
+    return (Op.F3 != 0b111);
+  case 0b0100011:   // sb, sh, sw, sd
+    Op.Imm = (((int64_t)((int32_t)(Inst & 0xfe000000))) >> 20) |
+             (int64_t)((Inst >> 7) & 0x1f);
+    return (Op.F3 <= 0b011);
+  case 0b0010011:   // addi, slti, sltiu, xori, ori, andi, slli, srli, srai
+    Op.Imm = ImmI;
+    if( Op.F3 == 0b001 )
+      return ((Inst >> 26) == 0);
+    if( Op.F3 == 0b101 )
+      return (((Inst >> 26) == 0) || ((Inst >> 26) == 0x10));
+    return true;
+  case 0b0011011:   // addiw, slliw, srliw, sraiw
+    Op.Imm = ImmI;
+    if( Op.F3 == 0b000 )
+      return true;
+    if( Op.F3 == 0b001 )
+      return (Op.F7 == 0);
+    if( Op.F3 == 0b101 )
+      return ((Op.F7 == 0) || (Op.F7 == 0x20));
+    return false;
+  case 0b0110011:   // rv64i register ops and rv64m
+    Op.Imm = 0;
+    if( (Op.F7 == 0) || (Op.F7 == 1) )
+      return true;
+    return (Op.F7 == 0x20) && ((Op.F3 == 0b000) || (Op.F3 == 0b101));
+  case 0b0111011:   // rv64i and rv64m word ops
+    Op.Imm = 0;
+    if( Op.F7 == 0 )
+      return ((Op.F3 == 0b000) || (Op.F3 == 0b001) || (Op.F3 == 0b101));
+    if( Op.F7 == 0x20 )
+      return ((Op.F3 == 0b000) || (Op.F3 == 0b101));
+    if( Op.F7 == 1 )
+      return ((Op.F3 == 0b000) || (Op.F3 >= 0b100));
+    return false;
+  default:
+    // system, fence, atomic and floating point instructions end the block
+    return false;
+  }
+}
+
+RevJIT::RevJITBlock *RevJIT::Translate(uint64_t PC){
+  RevJITBlock *B = new RevJITBlock;
+  B->PC = PC;
+
+  // a block runs until an unconditional jump or the first
+  // instruction that is not translated
+  RevJITOp Op;
+  while( (B->Ops.size() < REVJIT_MAX_BLOCK) && Decode(PC, Op) ){
+    B->Ops.push_back(Op);
+    if( (Op.Opc == 0b1101111) || (Op.Opc == 0b1100111) )
+      break;
+    PC += 4;
+  }
+
+  if( B->Ops.empty() ){
+    delete B;
+    return nullptr;
+  }
+  blocks++;
+  return B;
+}
+
+uint64_t RevJIT::Load(uint64_t Addr, unsigned Size){
+  uint64_t Val = 0x00ull;
+  for( unsigned i=0; i<Size; i++ ){
+    uint8_t Byte = 0;
+    auto it = stores.find(Addr+i);
+    if( it != stores.end() ){
+      Byte = it->second;
+    }else{
+      mem->PeekMem(Addr+i, 1, &Byte);
+    }
+    Val |= ((uint64_t)(Byte) << (8*i));
+  }
+  return Val;
+}
+
+void RevJIT::Store(uint64_t Addr, unsigned Size, uint64_t Val){
+  for( unsigned i=0; i<Size; i++ ){
+    stores[Addr+i] = (uint8_t)(Val >> (8*i));
+  }
+}
+
+static inline uint64_t SExt32(uint64_t V){
+  return (uint64_t)((int64_t)((int32_t)(V)));
+}
+
+static inline uint64_t SExt(uint64_t V, unsigned Bytes){
+  unsigned Shift = 64 - (8*Bytes);
+  return (uint64_t)(((int64_t)(V << Shift)) >> Shift);
+}
+
+unsigned RevJIT::Run(const RevJITBlock *B, RevJITCtx &C){
+  unsigned N = 0;
+  for( const RevJITOp &Op : B->Ops ){
+    uint64_t A   = C.x[Op.Rs1];
+    uint64_t Bv  = C.x[Op.Rs2];
+    uint64_t Imm = (uint64_t)(Op.Imm);
+    uint64_t Rd  = 0x00ull;
+    uint64_t Next = Op.PC + 4;
+    bool Write = true;
+    bool Exit = false;
+    N++;
+
+    switch( Op.Opc ){
+    case 0b0110111:   // lui
+      Rd = Imm;
+      break;
+    case 0b0010111:   // auipc
+      Rd = Op.PC + Imm;
+      break;
+    case 0b1101111:   // jal
+      Rd = Next;
+      Next = Op.PC + Imm;
+      Exit = true;
+      break;
+    case 0b1100111:   // jalr
+      Rd = Next;
+      Next = (A + Imm) & ~(uint64_t)(1);
+      Exit = true;
+      break;
+    case 0b1100011: { // conditional branches leave the block when taken
+      bool Taken = false;
+      switch( Op.F3 ){
+      case 0b000: Taken = (A == Bv); break;
+      case 0b001: Taken = (A != Bv); break;
+      case 0b100: Taken = ((int64_t)(A) < (int64_t)(Bv)); break;
+      case 0b101: Taken = ((int64_t)(A) >= (int64_t)(Bv)); break;
+      case 0b110: Taken = (A < Bv); break;
+      case 0b111: Taken = (A >= Bv); break;
+      }
+      if( Taken ){
+        Next = Op.PC + Imm;
+        Exit = true;
+      }
+      Write = false;
+      break;
+    }
+    case 0b0000011: { // loads
+      unsigned Size = 1u << (Op.F3 & 0b11);
+      Rd = Load(A + Imm, Size);
+      if( (Op.F3 & 0b100) == 0 )
+        Rd = SExt(Rd, Size);
+      break;
+    }
+    case 0b0100011:   // stores
+      Store(A + Imm, 1u << Op.F3, Bv);
+      Write = false;
+      break;
+    case 0b0010011:   // register-immediate ops
+      switch( Op.F3 ){
+      case 0b000: Rd = A + Imm; break;
+      case 0b010: Rd = ((int64_t)(A) < (int64_t)(Imm)) ? 1 : 0; break;
+      case 0b011: Rd = (A < Imm) ? 1 : 0; break;
+      case 0b100: Rd = A ^ Imm; break;
+      case 0b110: Rd = A | Imm; break;
+      case 0b111: Rd = A & Imm; break;
+      case 0b001: Rd = A << (Imm & 0x3f); break;
+      case 0b101:
+        if( Imm & 0x400 )
+          Rd = (uint64_t)(((int64_t)(A)) >> (Imm & 0x3f));
+        else
+          Rd = A >> (Imm & 0x3f);
+        break;
+      }
+      break;
+    case 0b0011011:   // register-immediate word ops
+      switch( Op.F3 ){
+      case 0b000: Rd = SExt32(A + Imm); break;
+      case 0b001: Rd = SExt32((uint32_t)(A) << (Imm & 0x1f)); break;
+      case 0b101:
+        if( Imm & 0x400 )
+          Rd = SExt32((uint32_t)(((int32_t)(A)) >> (Imm & 0x1f)));
+        else
+          Rd = SExt32((uint32_t)(A) >> (Imm & 0x1f));
+        break;
+      }
+      break;
+    case 0b0110011:   // register-register ops
+      if( Op.F7 == 1 ){
+        int64_t SA = (int64_t)(A);
+        int64_t SB = (int64_t)(Bv);
+        switch( Op.F3 ){
+        case 0b000: Rd = A * Bv; break;
+        case 0b001: Rd = (uint64_t)(((__int128)(SA) * (__int128)(SB)) >> 64); break;
+        case 0b010: Rd = (uint64_t)(((__int128)(SA) * (__int128)(Bv)) >> 64); break;
+        case 0b011: Rd = (uint64_t)(((unsigned __int128)(A) * (unsigned __int128)(Bv)) >> 64); break;
+        case 0b100:
+          if( Bv == 0 )
+            Rd = ~(uint64_t)(0);
+          else if( (SA == INT64_MIN) && (SB == -1) )
+            Rd = A;
+          else
+            Rd = (uint64_t)(SA / SB);
+          break;
+        case 0b101: Rd = (Bv == 0) ? ~(uint64_t)(0) : (A / Bv); break;
+        case 0b110:
+          if( Bv == 0 )
+            Rd = A;
+          else if( (SA == INT64_MIN) && (SB == -1) )
+            Rd = 0;
+          else
+            Rd = (uint64_t)(SA % SB);
+          break;
+        case 0b111: Rd = (Bv == 0) ? A : (A % Bv); break;
+        }
+      }else{
+        switch( Op.F3 ){
+        case 0b000: Rd = (Op.F7 == 0x20) ? (A - Bv) : (A + Bv); break;
+        case 0b001: Rd = A << (Bv & 0x3f); break;
+        case 0b010: Rd = ((int64_t)(A) < (int64_t)(Bv)) ? 1 : 0; break;
+        case 0b011: Rd = (A < Bv) ? 1 : 0; break;
+        case 0b100: Rd = A ^ Bv; break;
+        case 0b101:
+          if( Op.F7 == 0x20 )
+            Rd = (uint64_t)(((int64_t)(A)) >> (Bv & 0x3f));
+          else
+            Rd = A >> (Bv & 0x3f);
+          break;
+        case 0b110: Rd = A | Bv; break;
+        case 0b111: Rd = A & Bv; break;
+        }
+      }
+      break;
+    case 0b0111011:   // register-register word ops
+      if( Op.F7 == 1 ){
+        int32_t SA = (int32_t)(A);
+        int32_t SB = (int32_t)(Bv);
+        uint32_t UA = (uint32_t)(A);
+        uint32_t UB = (uint32_t)(Bv);
+        switch( Op.F3 ){
+        case 0b000: Rd = SExt32(UA * UB); break;
+        case 0b100:
+          if( SB == 0 )
+            Rd = ~(uint64_t)(0);
+          else if( (SA == INT32_MIN) && (SB == -1) )
+            Rd = SExt32(UA);
+          else
+            Rd = SExt32((uint32_t)(SA / SB));
+          break;
+        case 0b101: Rd = (UB == 0) ? ~(uint64_t)(0) : SExt32(UA / UB); break;
+        case 0b110:
+          if( SB == 0 )
+            Rd = SExt32(UA);
+          else if( (SA == INT32_MIN) && (SB == -1) )
+            Rd = 0;
+          else
+            Rd = SExt32((uint32_t)(SA % SB));
+          break;
+        case 0b111: Rd = (UB == 0) ? SExt32(UA) : SExt32(UA % UB); break;
+        }
+      }else{
+        switch( Op.F3 ){
+        case 0b000: Rd = SExt32((Op.F7 == 0x20) ? (A - Bv) : (A + Bv)); break;
+        case 0b001: Rd = SExt32((uint32_t)(A) << (Bv & 0x1f)); break;
+        case 0b101:
+          if( Op.F7 == 0x20 )
+            Rd = SExt32((uint32_t)(((int32_t)(A)) >> (Bv & 0x1f)));
+          else
+            Rd = SExt32((uint32_t)(A) >> (Bv & 0x1f));
+          break;
+        }
+      }
+      break;
+    }
+
+    if( Write && (Op.Rd != 0) )
+      C.x[Op.Rd] = Rd;
+    C.pc = Next;
+    if( Exit )
+      break;
+  }
+  return N;
+}
+
+void RevJIT::Enter(unsigned Hart, uint64_t PC, RevRegFile *Regs){
+  if( check || !entry[Hart] )
+    return;
+
+  RevJITBlock *B = nullptr;
+  auto it = cache.find(PC);
+  if( it != cache.end() ){
+    B = it->second;
+  }else if( ++heat[PC] >= REVJIT_HOT_THRESHOLD ){
+    heat.erase(PC);
+    B = Translate(PC);
+    cache[PC] = B;
+  }
+  if( !B )
+    return;
+
+  // run the translation from the current registers; its stores are
+  // held back such that the interpreter still observes the memory
+  // the block started from
+  for( unsigned r=0; r<32; r++ ){
+    ctx.x[r] = Regs->RV64[r];
+  }
+  ctx.x[0] = 0;
+  ctx.pc = PC;
+  stores.clear();
+  checkLen  = Run(B, ctx);
+  checkIdx  = 0;
+  checkHart = Hart;
+  check     = B;
+}
+
+void RevJIT::Retire(unsigned Hart, uint64_t PC, unsigned Size, RevRegFile *Regs){
+  // a taken control transfer starts a new block
+  entry[Hart] = (Regs->RV64_PC != (PC + Size));
+
+  if( !check )
+    return;
+
+  if( Hart != checkHart ){
+    // another hart may write the block's data; drop the check
+    check = nullptr;
+    return;
+  }
+
+  if( PC != check->Ops[checkIdx].PC ){
+    output->fatal(CALL_INFO, -1,
+                  "Error: core %u translated block at PC=0x%" PRIx64 " expected PC=0x%" PRIx64
+                  " as instruction %u; the interpreter executed PC=0x%" PRIx64 "\n",
+                  core, check->PC, check->Ops[checkIdx].PC, checkIdx, PC);
+  }
+
+  if( ++checkIdx < checkLen )
+    return;
+
+  Compare(Regs);
+  check = nullptr;
+  checks++;
+}
+
+void RevJIT::Compare(RevRegFile *Regs){
+  for( unsigned r=1; r<32; r++ ){
+    if( ctx.x[r] != Regs->RV64[r] ){
+      output->fatal(CALL_INFO, -1,
+                    "Error: core %u translated block at PC=0x%" PRIx64 " wrote x%u=0x%" PRIx64
+                    "; the interpreter wrote 0x%" PRIx64 "\n",
+                    core, check->PC, r, ctx.x[r], Regs->RV64[r]);
+    }
+  }
+
+  if( ctx.pc != Regs->RV64_PC ){
+    output->fatal(CALL_INFO, -1,
+                  "Error: core %u translated block at PC=0x%" PRIx64 " exits to PC=0x%" PRIx64
+                  "; the interpreter continues at PC=0x%" PRIx64 "\n",
+                  core, check->PC, ctx.pc, Regs->RV64_PC);
+  }
+
+  for( auto &S : stores ){
+    uint8_t Byte = 0;
+    mem->PeekMem(S.first, 1, &Byte);
+    if( Byte != S.second ){
+      output->fatal(CALL_INFO, -1,
+                    "Error: core %u translated block at PC=0x%" PRIx64 " stored 0x%02x to 0x%" PRIx64
+                    "; memory holds 0x%02x after the interpreter\n",
+                    core, check->PC, (unsigned)(S.second), S.first, (unsigned)(Byte));
+    }
+  }
+}
+
+// EOF
@@ -10,6 +10,62 @@
 
 #include "../include/RevLoader.h"
 
+std::map<std::string,std::weak_ptr<RevElfImage>> RevLoader::imageCache;
+std::mutex RevLoader::imageLock;
+
+RevElfImage::RevElfImage( char *MemBuf, size_t Size )
+  : membuf(MemBuf), size(Size), is64(false), entry(0x00ull) {
+  memset(&info, 0, sizeof(ElfInfo));
+}
+
+RevElfImage::~RevElfImage(){
+  munmap( membuf, size );
+}
+
+void RevElfImage::AddSymbol( const char *Name, uint64_t Start, uint64_t Size,
+                             const char *Section ){
+  if( Start == 0x00ull || Name[0] == '\0' )
+    return;
+  RevSymbol Sym;
+  Sym.start   = Start;
+  Sym.size    = Size;
+  Sym.name    = Name;
+  Sym.section = Section;
+  symbols.push_back(Sym);
+}
+
+void RevElfImage::BuildSymbolIndex(){
+  // order by address; aliases of the same address keep the largest interval
+  std::sort(symbols.begin(), symbols.end(),
+            [](const RevSymbol &A, const RevSymbol &B){
+              if( A.start != B.start )
+                return A.start < B.start;
+              return A.size > B.size;
+            });
+
+  std::vector<RevSymbol> Index;
+  for( unsigned i=0; i<symbols.size(); i++ ){
+    if( !Index.empty() && Index.back().start == symbols[i].start )
+      continue;
+    Index.push_back(symbols[i]);
+  }
+
+  // assembly labels carry no size; they run up to the next
+  // symbol in the same section
+  for( unsigned i=0; i<Index.size(); i++ ){
+    if( Index[i].size == 0 && (i+1) < Index.size() &&
+        Index[i+1].section == Index[i].section ){
+      Index[i].size = Index[i+1].start - Index[i].start;
+    }
+  }
+
+  symbols.clear();
+  for( unsigned i=0; i<Index.size(); i++ ){
+    if( Index[i].size )
+      symbols.push_back(Index[i]);
+  }
+}
+
 RevLoader::RevLoader( std::string Exe, std::string Args,
                       RevMem *Mem, SST::Output *Output )
   : exe(Exe), args(Args), mem(Mem), output(Output),
@@ -55,118 +111,34 @@ bool RevLoader::IsRVBig( const Elf64_Ehdr eh64 ){
   return false;
 }
 
-// breaks the write into cache line chunks
-bool RevLoader::WriteCacheLine(uint64_t Addr, size_t Len, void *Data){
-  if( Len == 0 ){
-    // nothing to do here, move along
-    return true;
-  }
-
-  // calculate the cache line size
-  unsigned lineSize = mem->getLineSize();
-  if( lineSize == 0 ){
-    // default to 64byte cache lines
-    lineSize = 64;
-  }
-
-  // begin writing the data, if we have a small write
-  // then dispatch the write as normal.  Otherwise,
-  // block the writes as cache lines
-  if( Len < lineSize ){
-    // one cache line to write, dispatch it
-    return mem->WriteMem(Addr,Len,Data);
-  }
-
-  // calculate the base address of the first cache line
-  size_t Total = 0;
-  bool done = false;
-  uint64_t BaseCacheAddr = Addr;
-  while( !done ){
-    if( (BaseCacheAddr%(uint64_t)(lineSize)) == 0 ){
-      done = true;
-    }else{
-      BaseCacheAddr-=1;
-    }
-  }
-
-  // write the first cache line
-  size_t TmpSize = (size_t)((BaseCacheAddr+lineSize)-Addr);
-  uint64_t TmpData = (uint64_t)(Data);
-  uint64_t TmpAddr = Addr;
-  if( !mem->WriteMem(TmpAddr,TmpSize,(void *)(TmpData)) ){
-    output->fatal(CALL_INFO, -1, "Error: Failed to perform cache line write\n" );
-  }
-
-  TmpAddr += (uint64_t)(TmpSize);
-  TmpData += TmpSize;
-  Total += TmpSize;
-
-  // no perform the remainder of the writes
-  do{
-    if( (Len-Total) > lineSize ){
-      // setup another full cache line write
-      TmpSize = lineSize;
-    }else{
-      // this is probably the final write operation
-      TmpSize = (Len-Total);
-    }
-
-    if( !mem->WriteMem(TmpAddr, TmpSize, (void *)(TmpData)) ){
-      output->fatal(CALL_INFO, -1, "Error: Failed to perform cache line write\n" );
-    }
-
-    // incrememnt the temp counters
-    TmpAddr += (uint64_t)(TmpSize);
-    TmpData += TmpSize;
-    Total += TmpSize;
-
-  }while( Total < Len );
-
-  return true;
-}
-
 // Elf32_Ehdr, Elf32_Phdr, Elf32_Shdr, Elf32_Sym, from_le
-bool RevLoader::LoadElf32(char *membuf, size_t sz){
-  std::vector<uint8_t> zeros;
+bool RevLoader::ParseElf32(RevElfImage *Image){
+  char *membuf = Image->membuf;
+  size_t sz = Image->size;
   Elf32_Ehdr *eh = (Elf32_Ehdr *)(membuf);
   Elf32_Phdr *ph = (Elf32_Phdr *)(membuf + eh->e_phoff);
-  RV32Entry = eh->e_entry;
+  Image->entry = eh->e_entry;
   if( sz < eh->e_phoff + eh->e_phnum * sizeof(*ph) )
     output->fatal(CALL_INFO, -1, "Error: RV32 Elf is unrecognizable\n" );
 
-  // write the program header
-  elfinfo.phnum = eh->e_phnum;
-  elfinfo.phent = sizeof(Elf32_Phdr);
-  elfinfo.phdr  = eh->e_phoff;
-  elfinfo.phdr_size = eh->e_phnum * sizeof(Elf32_Phdr);
-  uint64_t sp = mem->GetStackTop() - (uint64_t)(elfinfo.phdr_size);
-  //mem->WriteMem(sp,elfinfo.phdr_size,(void *)(ph));
-  WriteCacheLine(sp,elfinfo.phdr_size,(void *)(ph));
-  mem->SetStackTop(sp);
+  // record the program header
+  Image->info.phnum = eh->e_phnum;
+  Image->info.phent = sizeof(Elf32_Phdr);
+  Image->info.phdr  = eh->e_phoff;
+  Image->info.phdr_size = eh->e_phnum * sizeof(Elf32_Phdr);
 
   for( unsigned i=0; i<eh->e_phnum; i++ ){
     if( ph[i].p_type == PT_LOAD && ph[i].p_memsz ){
       if( ph[i].p_filesz ){
         if( sz < ph[i].p_offset + ph[i].p_filesz )
           output->fatal(CALL_INFO, -1, "Error: RV32 Elf is unrecognizable\n" );
-#if 0
-        mem->WriteMem(ph[i].p_paddr,
-                      ph[i].p_filesz,
-                      (uint8_t*)(membuf+ph[i].p_offset));
-#endif
-        WriteCacheLine(ph[i].p_paddr,
-                      ph[i].p_filesz,
-                      (uint8_t*)(membuf+ph[i].p_offset));
       }
-      zeros.resize(ph[i].p_memsz - ph[i].p_filesz);
-#if 0
-      mem->WriteMem(ph[i].p_paddr + ph[i].p_filesz,
-                    ph[i].p_memsz - ph[i].p_filesz,
-                    &zeros[0]);
-#endif
-      WriteCacheLine(ph[i].p_paddr + ph[i].p_filesz,
-                    ph[i].p_memsz - ph[i].p_filesz,
-                    &zeros[0]);
+      RevElfSegment Seg;
+      Seg.paddr   = ph[i].p_paddr;
+      Seg.filesz  = ph[i].p_filesz;
+      Seg.memsz   = ph[i].p_memsz;
+      Seg.data    = membuf + ph[i].p_offset;
+      Image->segments.push_back(Seg);
     }
   }
 
@@ -209,56 +181,49 @@ bool RevLoader::LoadElf32(char *membuf, size_t sz){
         output->fatal(CALL_INFO, -1, "Error: RV32 Elf is unrecognizable\n" );
       if( strnlen(strtab + sym[i].st_name, maxlen) >= maxlen )
         output->fatal(CALL_INFO, -1, "Error: RV32 Elf is unrecognizable\n" );
-      symtable[strtab+sym[i].st_name] = sym[i].st_value;
+      Image->symtable[strtab+sym[i].st_name] = sym[i].st_value;
+      unsigned Type = sym[i].st_info & 0xf;
+      if( Type == STT_SECTION || Type == STT_FILE ||
+          sym[i].st_shndx == 0 || sym[i].st_shndx >= SHN_LORESERVE ||
+          sym[i].st_shndx >= eh->e_shnum )
+        continue;
+      Image->AddSymbol(strtab + sym[i].st_name, sym[i].st_value,
+                       sym[i].st_size,
+                       shstrtab + sh[sym[i].st_shndx].sh_name);
     }
+    Image->BuildSymbolIndex();
   }
 
   return true;
 }
 
-bool RevLoader::LoadElf64(char *membuf, size_t sz){
-  std::vector<uint8_t> zeros;
+bool RevLoader::ParseElf64(RevElfImage *Image){
+  char *membuf = Image->membuf;
+  size_t sz = Image->size;
   Elf64_Ehdr *eh = (Elf64_Ehdr *)(membuf);
   Elf64_Phdr *ph = (Elf64_Phdr *)(membuf + eh->e_phoff);
-  RV64Entry = eh->e_entry;
+  Image->entry = eh->e_entry;
   if( sz < eh->e_phoff + eh->e_phnum * sizeof(*ph) )
     output->fatal(CALL_INFO, -1, "Error: RV64 Elf is unrecognizable\n" );
 
-
-  // write the program header
-  elfinfo.phnum = eh->e_phnum;
-  elfinfo.phent = sizeof(Elf64_Phdr);
-  elfinfo.phdr  = eh->e_phoff;
-  elfinfo.phdr_size = eh->e_phnum * sizeof(Elf64_Phdr);
-  uint64_t sp = mem->GetStackTop() - (uint64_t)(elfinfo.phdr_size);
-  //mem->WriteMem(sp,elfinfo.phdr_size,(void *)(ph));
-  WriteCacheLine(sp,elfinfo.phdr_size,(void *)(ph));
-  mem->SetStackTop(sp);
-
+  // record the program header
+  Image->info.phnum = eh->e_phnum;
+  Image->info.phent = sizeof(Elf64_Phdr);
+  Image->info.phdr  = eh->e_phoff;
+  Image->info.phdr_size = eh->e_phnum * sizeof(Elf64_Phdr);
 
   for( unsigned i=0; i<eh->e_phnum; i++ ){
     if( ph[i].p_type == PT_LOAD && ph[i].p_memsz ){
       if( ph[i].p_filesz ){
         if( sz < ph[i].p_offset + ph[i].p_filesz )
           output->fatal(CALL_INFO, -1, "Error: RV64 Elf is unrecognizable\n" );
-#if 0
-        mem->WriteMem(ph[i].p_paddr,
-                      ph[i].p_filesz,
-                      (uint8_t*)(membuf+ph[i].p_offset));
-#endif
-        WriteCacheLine(ph[i].p_paddr,
-                      ph[i].p_filesz,
-                      (uint8_t*)(membuf+ph[i].p_offset));
       }
-      zeros.resize(ph[i].p_memsz - ph[i].p_filesz);
-#if 0
-      mem->WriteMem(ph[i].p_paddr + ph[i].p_filesz,
-                    ph[i].p_memsz - ph[i].p_filesz,
-                    &zeros[0]);
-#endif
-      WriteCacheLine(ph[i].p_paddr + ph[i].p_filesz,
-                    ph[i].p_memsz - ph[i].p_filesz,
-                    &zeros[0]);
+      RevElfSegment Seg;
+      Seg.paddr   = ph[i].p_paddr;
+      Seg.filesz  = ph[i].p_filesz;
+      Seg.memsz   = ph[i].p_memsz;
+      Seg.data    = membuf + ph[i].p_offset;
+      Image->segments.push_back(Seg);
     }
   }
 
@@ -296,8 +261,17 @@ bool RevLoader::LoadElf64(char *membuf, size_t sz){
         output->fatal(CALL_INFO, -1, "Error: RV64 Elf is unrecognizable\n" );
       if( strnlen(strtab + sym[i].st_name, maxlen) >= maxlen )
         output->fatal(CALL_INFO, -1, "Error: RV64 Elf is unrecognizable\n" );
-      symtable[strtab+sym[i].st_name] = sym[i].st_value;
+      Image->symtable[strtab+sym[i].st_name] = sym[i].st_value;
+      unsigned Type = sym[i].st_info & 0xf;
+      if( Type == STT_SECTION || Type == STT_FILE ||
+          sym[i].st_shndx == 0 || sym[i].st_shndx >= SHN_LORESERVE ||
+          sym[i].st_shndx >= eh->e_shnum )
+        continue;
+      Image->AddSymbol(strtab + sym[i].st_name, sym[i].st_value,
+                       sym[i].st_size,
+                       shstrtab + sh[sym[i].st_shndx].sh_name);
     }
+    Image->BuildSymbolIndex();
   }
 
   return true;
@@ -334,7 +308,7 @@ bool RevLoader::LoadProgramArgs(){
     size_t len = argv[i].size() + 1;
     mem->SetStackTop(sp-(uint64_t)(len));
     //mem->WriteMem(mem->GetStackTop(),len,(void *)(&tmpc));
-    WriteCacheLine(mem->GetStackTop(),len,(void *)(&tmpc));
+    mem->InitMem(mem->GetStackTop(),len,(void *)(&tmpc));
   }
 
   return true;
@@ -355,7 +329,7 @@ void RevLoader::splitStr(const std::string& s,
   }
 }
 
-bool RevLoader::LoadElf(){
+std::shared_ptr<RevElfImage> RevLoader::GetImage(){
   // open the target file
   int fd = open(exe.c_str(), O_RDONLY);
   struct stat FileStats;
@@ -364,6 +338,20 @@ bool RevLoader::LoadElf(){
 
   size_t FileSize = FileStats.st_size;
 
+  // images are keyed by path and modification time such that a
+  // rebuilt executable is never served from a stale entry
+  std::string Key = exe + ":" + std::to_string((long long)(FileStats.st_mtime)) +
+                    ":" + std::to_string((unsigned long long)(FileSize));
+
+  std::lock_guard<std::mutex> Lock(imageLock);
+  std::shared_ptr<RevElfImage> Image = imageCache[Key].lock();
+  if( Image ){
+    close(fd);
+    output->verbose(CALL_INFO,6,0,
+                    "Reusing the parsed image of %s\n", exe.c_str() );
+    return Image;
+  }
+
   // map the executable into memory
   char *membuf = (char *)(mmap(NULL,FileSize, PROT_READ, MAP_PRIVATE, fd, 0));
   if( membuf == MAP_FAILED )
@@ -372,6 +360,9 @@ bool RevLoader::LoadElf(){
   // close the target file
   close(fd);
 
+  // the mapping is owned by the image and released with it
+  Image = std::make_shared<RevElfImage>(membuf, FileSize);
+
   // check the size of the elf header
   if( FileSize < sizeof(Elf64_Ehdr) )
     output->fatal(CALL_INFO, -1, "Error: Elf header is unrecognizable\n" );
@@ -384,24 +375,64 @@ bool RevLoader::LoadElf(){
     output->fatal(CALL_INFO, -1, "Error: Not in little endian format\n" );
 
   if( IsRVElf32(*eh64) ){
-    if( !LoadElf32(membuf,FileSize) )
+    if( !ParseElf32(Image.get()) )
       output->fatal(CALL_INFO, -1, "Error: could not load Elf32 binary\n" );
   }else{
-    if( !LoadElf64(membuf,FileSize) )
+    Image->is64 = true;
+    if( !ParseElf64(Image.get()) )
       output->fatal(CALL_INFO, -1, "Error: could not load Elf64 binary\n" );
   }
 
-  // unmap the file
-  munmap( membuf, FileSize );
+  imageCache[Key] = Image;
+  return Image;
+}
+
+bool RevLoader::LoadImage(){
+  if( image->is64 ){
+    RV64Entry = image->entry;
+  }else{
+    RV32Entry = (uint32_t)(image->entry);
+  }
+
+  // write the program header
+  elfinfo.phnum = image->info.phnum;
+  elfinfo.phent = image->info.phent;
+  elfinfo.phdr  = image->info.phdr;
+  elfinfo.phdr_size = image->info.phdr_size;
+  uint64_t sp = mem->GetStackTop() - (uint64_t)(elfinfo.phdr_size);
+  mem->InitMem(sp,elfinfo.phdr_size,(void *)(image->membuf + elfinfo.phdr));
+  mem->SetStackTop(sp);
+
+  for( unsigned i=0; i<image->segments.size(); i++ ){
+    const RevElfSegment &Seg = image->segments[i];
+    if( Seg.filesz ){
+      mem->InitMem(Seg.paddr, Seg.filesz, (void *)(Seg.data));
+    }
+    // the remainder of the segment is zero-filled on first touch
+    mem->ZeroMem(Seg.paddr + Seg.filesz, Seg.memsz - Seg.filesz);
+  }
+
+  return true;
+}
+
+bool RevLoader::LoadElf(){
+  // retrieve the parsed image; components running the same
+  // executable in this process share a single copy
+  image = GetImage();
+
+  if( !LoadImage() )
+    output->fatal(CALL_INFO, -1, "Error: could not load executable image\n" );
 
   // print the symbol table entries
-  std::map<std::string,uint64_t>::iterator it = symtable.begin();
-  while( it != symtable.end() ){
+  std::map<std::string,uint64_t>::iterator it = image->symtable.begin();
+  while( it != image->symtable.end() ){
     output->verbose(CALL_INFO,6,0,
                     "Symbol Table Entry [%s:0x%" PRIx64 "]\n",
                     it->first.c_str(), it->second );
     it++;
   }
+  output->verbose(CALL_INFO,6,0,
+                  "Indexed %zu symbol intervals\n", image->symbols.size() );
 
   /// load the program arguments
   if( !LoadProgramArgs() )
@@ -414,10 +445,32 @@ bool RevLoader::LoadElf(){
   return true;
 }
 
+const RevSymbol *RevLoader::FindSymbol(uint64_t Addr, unsigned &Hint){
+  const std::vector<RevSymbol> &Syms = image->symbols;
+
+  // consecutive lookups from a core tend to stay within one function
+  if( Hint < Syms.size() && Addr >= Syms[Hint].start &&
+      Addr < (Syms[Hint].start + Syms[Hint].size) )
+    return &Syms[Hint];
+
+  std::vector<RevSymbol>::const_iterator it =
+    std::upper_bound(Syms.begin(), Syms.end(), Addr,
+                     [](uint64_t A, const RevSymbol &S){ return A < S.start; });
+  if( it == Syms.begin() )
+    return nullptr;
+  --it;
+  if( Addr >= (it->start + it->size) )
+    return nullptr;
+
+  Hint = (unsigned)(it - Syms.begin());
+  return &(*it);
+}
+
 uint64_t RevLoader::GetSymbolAddr(std::string Symbol){
   uint64_t tmp = 0x00ull;
-  if( symtable.find(Symbol) != symtable.end() ){
-    tmp = symtable[Symbol];
+  std::map<std::string,uint64_t>::iterator it = image->symtable.find(Symbol);
+  if( it != image->symtable.end() ){
+    tmp = it->second;
   }
   return tmp;
 }
@@ -11,6 +11,7 @@
 #include "../include/RevMem.h"
 #include <math.h>
 #include <mutex>
+#include <sys/mman.h>
 
 RevMem::RevMem( unsigned long MemSize, RevOpts *Opts,
                 RevMemCtrl *Ctrl, SST::Output *Output )
@@ -35,18 +36,17 @@ RevMem::RevMem( unsigned long MemSize, RevOpts *Opts, SST::Output *Output )
   : physMem(nullptr), memSize(MemSize), opts(Opts), ctrl(nullptr), output(Output),
     stacktop(0x00ull) {
 
-  // allocate the backing memory
-  physMem = new char [memSize];
+  // allocate the backing memory; anonymous mappings are zero-filled
+  // by the host on first touch, so there is nothing to clear here
+  physMem = (char *)(mmap(NULL, memSize, PROT_READ|PROT_WRITE,
+                          MAP_PRIVATE|MAP_ANONYMOUS|MAP_NORESERVE, -1, 0));
   pageSize = 262144; //Page Size (in Bytes)
   addrShift = int(log(pageSize) / log(2.0));
   nextPage = 0;
 
-  if( !physMem )
+  if( physMem == MAP_FAILED ){
+    physMem = nullptr;
     output->fatal(CALL_INFO, -1, "Error: could not allocate backing memory\n");
-
-  // zero the memory
-  for( unsigned long i=0; i<memSize; i++ ){
-    physMem[i] = 0;
   }
 
   stacktop = _REVMEM_BASE_ + memSize;
@@ -61,7 +61,7 @@ RevMem::RevMem( unsigned long MemSize, RevOpts *Opts, SST::Output *Output )
 
 RevMem::~RevMem(){
   if( physMem )
-    delete[] physMem;
+    munmap(physMem, memSize);
 }
 
 bool RevMem::outstandingRqsts(){
@@ -119,26 +119,48 @@ bool RevMem::StatusFuture(uint64_t Addr){
 }
 
 bool RevMem::LR(unsigned Hart, uint64_t Addr){
+  // a hart holds at most one reservation
+  std::vector<std::pair<unsigned,uint64_t>>::iterator it;
+  for( it = LRSC.begin(); it != LRSC.end(); ++it ){
+    if( Hart == std::get<0>(*it) ){
+      LRSC.erase(it);
+      break;
+    }
+  }
   std::pair<unsigned,uint64_t> Entry = std::make_pair(Hart,Addr);
   LRSC.push_back(Entry);
   return true;
 }
 
 bool RevMem::SC(unsigned Hart, uint64_t Addr){
-  // search the LRSC vector for the entry pair
+  // search the LRSC vector for the hart's reservation; a store
+  // conditional consumes it whether or not it succeeds
   std::vector<std::pair<unsigned,uint64_t>>::iterator it;
 
   for( it = LRSC.begin(); it != LRSC.end(); ++it ){
-    if( (Hart == std::get<0>(*it)) &&
-        (Addr == std::get<1>(*it)) ){
+    if( Hart == std::get<0>(*it) ){
+      bool Match = (Addr == std::get<1>(*it));
       LRSC.erase(it);
-      return true;
+      return Match;
     }
   }
 
   return false;
 }
 
+void RevMem::ClearLRSC(uint64_t Addr, size_t Len){
+  // reservations cover the naturally aligned doubleword of the reserved address
+  std::vector<std::pair<unsigned,uint64_t>>::iterator it = LRSC.begin();
+  while( it != LRSC.end() ){
+    uint64_t Base = std::get<1>(*it) & ~7ull;
+    if( (Addr < (Base + 8)) && (Base < (Addr + Len)) ){
+      it = LRSC.erase(it);
+    }else{
+      ++it;
+    }
+  }
+}
+
 unsigned RevMem::RandCost( unsigned Min, unsigned Max ){
   unsigned R = 0;
 
@@ -180,6 +202,7 @@ bool RevMem::FenceMem(){
 
 bool RevMem::WriteMem( uint64_t Addr, size_t Len, void *Data,
                        StandardMem::Request::flags_t flags){
+  RevHostScope HostScope(hostProf, RevHostProf::HostMem);
 #ifdef _REV_DEBUG_
   std::cout << "Writing " << Len << " Bytes Starting at 0x" << std::hex << Addr << std::dec << std::endl;
 #endif
@@ -188,8 +211,12 @@ bool RevMem::WriteMem( uint64_t Addr, size_t Len, void *Data,
     std::cout << "Found special write. Val = " << std::hex << *(int*)(Data) << std::dec << std::endl;
   }
   RevokeFuture(Addr); // revoke the future if it is present; ignore the return
+  ClearLRSC(Addr, Len);
+  lastAddr = Addr;
+  lastAccess = 2;
   uint64_t pageNum = Addr >> addrShift;
   uint64_t physAddr = CalcPhysAddr(pageNum, Addr);
+  TraceAccess(Addr, physAddr, Len, true);
 
   //check to see if we're about to walk off the page....
   uint32_t adjPageNum = 0;
@@ -252,7 +279,69 @@ bool RevMem::WriteMem( uint64_t Addr, size_t Len, void *Data,
 }
 
 
+bool RevMem::InitMem( uint64_t Addr, size_t Len, void *Data ){
+  // keep the local image coherent for host side accesses; the
+  // memHierarchy configuration has no local backing memory
+  char *DataMem = (char *)(Data);
+  size_t Cur = 0;
+  while( physMem && (Cur < Len) ){
+    uint64_t pageNum = (Addr+Cur) >> addrShift;
+    uint64_t physAddr = CalcPhysAddr(pageNum, Addr+Cur);
+    uint64_t endOfPage = (pageMap[pageNum].first << addrShift) + pageSize;
+    size_t Chunk = std::min((size_t)(endOfPage - physAddr), Len-Cur);
+    memcpy(&physMem[physAddr], &DataMem[Cur], Chunk);
+    Cur += Chunk;
+  }
+
+  // with a memory hierarchy, the image is delivered to the backing
+  // store during the init phase; after that, it must be timed
+  if( ctrl && !ctrl->sendINITWrite(Addr, (uint32_t)(Len), DataMem) ){
+    return WriteMem(Addr, Len, Data);
+  }
+  return true;
+}
+
+bool RevMem::PeekMem( uint64_t Addr, size_t Len, void *Data ){
+  // the memHierarchy configuration has no local image to read
+  if( !physMem )
+    return false;
+
+  char *DataMem = (char *)(Data);
+  size_t Cur = 0;
+  while( Cur < Len ){
+    uint64_t pageNum = (Addr+Cur) >> addrShift;
+    uint64_t physAddr = CalcPhysAddr(pageNum, Addr+Cur);
+    uint64_t endOfPage = (pageMap[pageNum].first << addrShift) + pageSize;
+    size_t Chunk = std::min((size_t)(endOfPage - physAddr), Len-Cur);
+    memcpy(&DataMem[Cur], &physMem[physAddr], Chunk);
+    Cur += Chunk;
+  }
+  return true;
+}
+
+bool RevMem::ZeroMem( uint64_t Addr, size_t Len ){
+  if( Len == 0 )
+    return true;
+
+  // pages are zero when they are first mapped, so only the portions of
+  // pages that are already in use need to be cleared.  the memHierarchy
+  // backing store is zero-initialized and has no local copy to clear.
+  uint64_t FirstPage = Addr >> addrShift;
+  uint64_t LastPage  = (Addr+Len-1) >> addrShift;
+  std::map<uint64_t, std::pair<uint32_t, bool>>::iterator it = pageMap.lower_bound(FirstPage);
+  while( physMem && (it != pageMap.end()) && (it->first <= LastPage) ){
+    uint64_t PageBase = it->first << addrShift;
+    uint64_t Start = std::max(Addr, PageBase);
+    uint64_t End = std::min(Addr+(uint64_t)(Len), PageBase+pageSize);
+    uint64_t physAddr = ((uint64_t)(it->second.first) << addrShift) + (Start & (pageSize-1));
+    memset(&physMem[physAddr], 0, (size_t)(End-Start));
+    it++;
+  }
+  return true;
+}
+
 bool RevMem::WriteMem( uint64_t Addr, size_t Len, void *Data ){
+  RevHostScope HostScope(hostProf, RevHostProf::HostMem);
 #ifdef _REV_DEBUG_
   std::cout << "Writing " << Len << " Bytes Starting at 0x" << std::hex << Addr << std::dec << std::endl;
 #endif
@@ -261,8 +350,12 @@ bool RevMem::WriteMem( uint64_t Addr, size_t Len, void *Data ){
     std::cout << "Found special write. Val = " << std::hex << *(int*)(Data) << std::dec << std::endl;
   }
   RevokeFuture(Addr); // revoke the future if it is present; ignore the return
+  ClearLRSC(Addr, Len);
+  lastAddr = Addr;
+  lastAccess = 2;
   uint64_t pageNum = Addr >> addrShift;
   uint64_t physAddr = CalcPhysAddr(pageNum, Addr);
+  TraceAccess(Addr, physAddr, Len, true);
 
   //check to see if we're about to walk off the page....
   uint32_t adjPageNum = 0;
@@ -345,11 +438,15 @@ bool RevMem::WriteMem( uint64_t Addr, size_t Len, void *Data ){
 }
 
 bool RevMem::ReadMem( uint64_t Addr, size_t Len, void *Data ){
+  RevHostScope HostScope(hostProf, RevHostProf::HostMem);
 #ifdef _REV_DEBUG_
   std::cout << "OLD READMEM: Reading " << Len << " Bytes Starting at 0x" << std::hex << Addr << std::dec << std::endl;
 #endif
+  lastAddr = Addr;
+  lastAccess = 1;
   uint64_t pageNum = Addr >> addrShift;
   uint64_t physAddr = CalcPhysAddr(pageNum, Addr);
+  TraceAccess(Addr, physAddr, Len, false);
 
   //check to see if we're about to walk off the page....
   uint32_t adjPageNum = 0;
@@ -384,11 +481,15 @@ bool RevMem::ReadMem( uint64_t Addr, size_t Len, void *Data ){
 
 bool RevMem::ReadMem(uint64_t Addr, size_t Len, void *Target,
                      StandardMem::Request::flags_t flags){
+  RevHostScope HostScope(hostProf, RevHostProf::HostMem);
 #ifdef _REV_DEBUG_
   std::cout << "NEW READMEM: Reading " << Len << " Bytes Starting at 0x" << std::hex << Addr << std::dec << std::endl;
 #endif
+  lastAddr = Addr;
+  lastAccess = 1;
   uint64_t pageNum = Addr >> addrShift;
   uint64_t physAddr = CalcPhysAddr(pageNum, Addr);
+  TraceAccess(Addr, physAddr, Len, false);
   //check to see if we're about to walk off the page....
   uint32_t adjPageNum = 0;
   uint64_t adjPhysAddr = 0;
@@ -400,7 +501,7 @@ bool RevMem::ReadMem(uint64_t Addr, size_t Len, void *Target,
     adjPageNum = ((Addr+Len)-span) >> addrShift;
     adjPhysAddr = CalcPhysAddr(adjPageNum, ((Addr+Len)-span));
     if( ctrl ){
-      ctrl->sendREADRequest(Addr, (uint64_t)(BaseMem), Len, Target, flags);
+      ctrl->sendREADRequest(Addr, (uint64_t)(BaseMem), Len, Target, pendingCtx, flags);
     }else{
       for( unsigned i=0; i< (Len-span); i++ ){
         DataMem[i] = BaseMem[i];
@@ -409,7 +510,7 @@ bool RevMem::ReadMem(uint64_t Addr, size_t Len, void *Target,
     BaseMem = &physMem[adjPhysAddr];
     if( ctrl ){
       unsigned Cur = (Len-span);
-      ctrl->sendREADRequest(Addr, (uint64_t)(BaseMem), Len, ((char*)Target)+Cur, flags);
+      ctrl->sendREADRequest(Addr, (uint64_t)(BaseMem), Len, ((char*)Target)+Cur, pendingCtx, flags);
     }else{
       unsigned Cur = (Len-span);
       for( unsigned i=0; i< span; i++ ){
@@ -422,7 +523,7 @@ bool RevMem::ReadMem(uint64_t Addr, size_t Len, void *Target,
 #endif
   }else{
     if( ctrl ){
-      ctrl->sendREADRequest(Addr, (uint64_t)(BaseMem), Len, Target, flags);
+      ctrl->sendREADRequest(Addr, (uint64_t)(BaseMem), Len, Target, pendingCtx, flags);
     }else{
       for( unsigned i=0; i<Len; i++ ){
         DataMem[i] = BaseMem[i];
@@ -434,6 +535,117 @@ bool RevMem::ReadMem(uint64_t Addr, size_t Len, void *Target,
   return true;
 }
 
+bool RevMem::LRMem(unsigned Hart, uint64_t Addr, size_t Len, void *Target,
+                   StandardMem::Request::flags_t flags){
+  RevHostScope HostScope(hostProf, RevHostProf::HostMem);
+  if( Addr & (Len-1) )
+    output->fatal(CALL_INFO, -1, "Error: misaligned LR at 0x%" PRIx64 "\n", Addr);
+  lastAddr = Addr;
+  lastAccess = 1;
+  uint64_t pageNum = Addr >> addrShift;
+  uint64_t physAddr = CalcPhysAddr(pageNum, Addr);
+  TraceAccess(Addr, physAddr, Len, false);
+
+  // the hart's reservation is always tracked here so an SC to any other
+  // address fails; with memHierarchy the line is also linked there, which
+  // makes the reservation visible to every component sharing the memory
+  LR(Hart, Addr);
+  if( ctrl ){
+    ctrl->sendLOADLINKRequest(Addr, (uint64_t)(&physMem[physAddr]), Len,
+                              Target, pendingCtx, flags);
+  }else{
+    uint64_t Val = 0x00ull;
+    std::memcpy(&Val, &physMem[physAddr], Len);
+    RevAMOResult(flags, Len, Val, Target);
+  }
+
+  memStats.bytesRead += Len;
+  return true;
+}
+
+bool RevMem::SCMem(unsigned Hart, uint64_t Addr, size_t Len, void *Data, void *Target,
+                   StandardMem::Request::flags_t flags){
+  RevHostScope HostScope(hostProf, RevHostProf::HostMem);
+  if( Addr & (Len-1) )
+    output->fatal(CALL_INFO, -1, "Error: misaligned SC at 0x%" PRIx64 "\n", Addr);
+  RevokeFuture(Addr); // revoke the future if it is present; ignore the return
+  lastAddr = Addr;
+  lastAccess = 2;
+  uint64_t pageNum = Addr >> addrShift;
+  uint64_t physAddr = CalcPhysAddr(pageNum, Addr);
+  TraceAccess(Addr, physAddr, Len, true);
+
+  bool Success = SC(Hart, Addr);
+  if( Success )
+    ClearLRSC(Addr, Len);
+  if( ctrl && Success ){
+    // memHierarchy decides whether the linked line survived
+    ctrl->sendSTORECONDRequest(Addr, (uint64_t)(&physMem[physAddr]), Len,
+                               (char *)(Data), Target, pendingCtx, flags);
+  }else{
+    if( Success )
+      std::memcpy(&physMem[physAddr], Data, Len);
+    RevAMOResult(flags, Len, Success ? 0 : 1, Target);
+  }
+
+  memStats.bytesWritten += Len;
+  return true;
+}
+
+bool RevMem::AMOMem(uint64_t Addr, size_t Len, void *Data, void *Target,
+                    StandardMem::Request::flags_t flags){
+  RevHostScope HostScope(hostProf, RevHostProf::HostMem);
+  if( Addr & (Len-1) )
+    output->fatal(CALL_INFO, -1, "Error: misaligned AMO at 0x%" PRIx64 "\n", Addr);
+  RevokeFuture(Addr); // revoke the future if it is present; ignore the return
+  lastAddr = Addr;
+  lastAccess = 2;
+  uint64_t pageNum = Addr >> addrShift;
+  uint64_t physAddr = CalcPhysAddr(pageNum, Addr);
+  TraceAccess(Addr, physAddr, Len, false);
+  TraceAccess(Addr, physAddr, Len, true);
+
+  // naturally aligned, so the access never spans a page
+  ClearLRSC(Addr, Len);
+  if( ctrl ){
+    ctrl->sendAMORequest(Addr, (uint64_t)(&physMem[physAddr]), Len,
+                         (char *)(Data), Target, pendingCtx, flags);
+  }else{
+    uint64_t Old = 0x00ull;
+    uint64_t Src = 0x00ull;
+    std::memcpy(&Old, &physMem[physAddr], Len);
+    std::memcpy(&Src, Data, Len);
+    uint64_t New = RevAMOApply(flags, Len, Old, Src);
+    std::memcpy(&physMem[physAddr], &New, Len);
+    RevAMOResult(flags, Len, Old, Target);
+  }
+
+  memStats.bytesRead += Len;
+  memStats.bytesWritten += Len;
+  return true;
+}
+
+bool RevMem::FetchMem(uint64_t Addr, size_t Len, void *Target, unsigned *Pending){
+  RevHostScope HostScope(hostProf, RevHostProf::HostMem);
+  uint64_t pageNum = Addr >> addrShift;
+  uint64_t physAddr = CalcPhysAddr(pageNum, Addr);
+  uint64_t endOfPage = (pageMap[pageNum].first << addrShift) + pageSize;
+  if( (!ctrl) || ((physAddr + Len) > endOfPage) ){
+    // no memory controller or the fetch spans pages; use the data path,
+    // counting the fetch rather than the executing instruction
+    unsigned *Ctx = pendingCtx;
+    pendingCtx = Pending;
+    bool rtn = ReadMem(Addr, Len, Target, REVMEM_FLAGS(0x00));
+    pendingCtx = Ctx;
+    return rtn;
+  }
+
+  ctrl->sendIFETCHRequest(Addr, (uint64_t)(&physMem[physAddr]), Len, Target,
+                          Pending, REVMEM_FLAGS(0x00));
+  memStats.bytesRead += Len;
+  return true;
+}
+
 uint8_t RevMem::ReadU8( uint64_t Addr ){
   uint8_t Value;
   if( !ReadMem( Addr, 1, (void *)(&Value) ) )
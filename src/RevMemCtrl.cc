@@ -19,46 +19,152 @@ using namespace RevCPU;
 RevMemOp::RevMemOp(uint64_t Addr, uint64_t PAddr, uint32_t Size,
                    RevMemOp::MemOp Op, StandardMem::Request::flags_t flags )
   : Addr(Addr), PAddr(PAddr), Size(Size), Inv(false), Op(Op), CustomOpc(0),
-    SplitRqst(1), flags(flags), target(nullptr){
+    SplitRqst(1), SplitDone(0), flags(flags), target(nullptr),
+    pending(nullptr){
 }
 
 RevMemOp::RevMemOp(uint64_t Addr, uint64_t PAddr, uint32_t Size, void *target,
                    RevMemOp::MemOp Op, StandardMem::Request::flags_t flags )
   : Addr(Addr), PAddr(PAddr), Size(Size), Inv(false), Op(Op), CustomOpc(0),
-    SplitRqst(1), flags(flags), target(target){
+    SplitRqst(1), SplitDone(0), flags(flags), target(target),
+    pending(nullptr){
 }
 
 RevMemOp::RevMemOp(uint64_t Addr, uint64_t PAddr, uint32_t Size,
                    char *buffer, RevMemOp::MemOp Op,
                    StandardMem::Request::flags_t flags )
   : Addr(Addr), PAddr(PAddr), Size(Size), Inv(false), Op(Op), CustomOpc(0),
-    SplitRqst(1), flags(flags), target(nullptr){
-  for(unsigned i=0; i<(unsigned)(Size); i++ ){
-    membuf.push_back((uint8_t)(buffer[i]));
-  }
+    SplitRqst(1), SplitDone(0), flags(flags), target(nullptr),
+    pending(nullptr){
+  membuf.assign((uint8_t *)(buffer), (uint8_t *)(buffer)+Size);
+}
+
+RevMemOp::RevMemOp(uint64_t Addr, uint64_t PAddr, uint32_t Size,
+                   char *buffer, void *target, RevMemOp::MemOp Op,
+                   StandardMem::Request::flags_t flags )
+  : Addr(Addr), PAddr(PAddr), Size(Size), Inv(false), Op(Op), CustomOpc(0),
+    SplitRqst(1), SplitDone(0), flags(flags), target(target),
+    pending(nullptr){
+  membuf.assign((uint8_t *)(buffer), (uint8_t *)(buffer)+Size);
 }
 
 RevMemOp::RevMemOp(uint64_t Addr, uint64_t PAddr, uint32_t Size,
                    void *target, unsigned CustomOpc, RevMemOp::MemOp Op,
                    StandardMem::Request::flags_t flags )
   : Addr(Addr), PAddr(PAddr), Size(Size), Inv(false), Op(Op),
-    CustomOpc(CustomOpc), SplitRqst(1), flags(flags),
-    target(target){
+    CustomOpc(CustomOpc), SplitRqst(1), SplitDone(0), flags(flags),
+    target(target), pending(nullptr){
 }
 
 RevMemOp::RevMemOp(uint64_t Addr, uint64_t PAddr, uint32_t Size, char *buffer,
                    unsigned CustomOpc, RevMemOp::MemOp Op,
                    StandardMem::Request::flags_t flags )
   : Addr(Addr), PAddr(PAddr), Size(Size), Inv(false), Op(Op),
-    CustomOpc(CustomOpc), SplitRqst(1), flags(flags), target(nullptr){
-  for(unsigned i=0; i<(unsigned)(Size); i++ ){
-    membuf.push_back((uint8_t)(buffer[i]));
-  }
+    CustomOpc(CustomOpc), SplitRqst(1), SplitDone(0), flags(flags), target(nullptr),
+    pending(nullptr){
+  membuf.assign((uint8_t *)(buffer), (uint8_t *)(buffer)+Size);
 }
 
 RevMemOp::~RevMemOp(){
 }
 
+void RevMemOp::setRange(uint64_t NewAddr, uint32_t NewSize){
+  PAddr = PAddr - Addr + NewAddr;
+  Addr  = NewAddr;
+  Size  = NewSize;
+}
+
+void RevMemOp::overlayWrite(RevMemOp *Op){
+  uint64_t Lo = std::min(Addr, Op->getAddr());
+  uint64_t Hi = std::max(Addr+Size, Op->getAddr()+Op->getSize());
+  std::vector<uint8_t> Buf(Hi-Lo);
+  std::copy(membuf.begin(), membuf.end(), Buf.begin()+(Addr-Lo));
+  std::copy(Op->getBuf().begin(), Op->getBuf().end(), Buf.begin()+(Op->getAddr()-Lo));
+  membuf.swap(Buf);
+  setRange(Lo, (uint32_t)(Hi-Lo));
+}
+
+void RevMemOp::forwardFrom(RevMemOp *Op){
+  uint64_t Off = Addr - Op->getAddr();
+  membuf.assign(Op->getBuf().begin()+Off, Op->getBuf().begin()+Off+Size);
+}
+
+// ---------------------------------------------------------------
+// RevRqstMap
+// ---------------------------------------------------------------
+RevRqstMap::RevRqstMap(unsigned Capacity)
+  : count(0), shift(64){
+  size_t Size = 1;
+  while( Size < (size_t)(Capacity) ){
+    Size <<= 1;
+  }
+  // keep at least one free slot so that every probe terminates
+  if( Size < 2 )
+    Size = 2;
+  keys.resize(Size);
+  vals.assign(Size, nullptr);
+  while( ((size_t)(1) << (64-shift)) < Size ){
+    shift--;
+  }
+}
+
+void RevRqstMap::insert(StandardMem::Request::id_t Id, RevMemOp *Op){
+  // grow at 50% load so that probe sequences stay short
+  if( (count+1)*2 > vals.size() )
+    grow();
+  size_t Mask = vals.size()-1;
+  size_t S = slot(Id);
+  while( vals[S] ){
+    S = (S+1) & Mask;
+  }
+  keys[S] = Id;
+  vals[S] = Op;
+  count++;
+}
+
+RevMemOp *RevRqstMap::remove(StandardMem::Request::id_t Id){
+  size_t Mask = vals.size()-1;
+  size_t S = slot(Id);
+  while( vals[S] && (keys[S] != Id) ){
+    S = (S+1) & Mask;
+  }
+  RevMemOp *Op = vals[S];
+  if( !Op )
+    return nullptr;
+
+  // backward shift deletion; pull each displaced entry of the probe
+  // run into the hole unless that would move it ahead of its home slot
+  size_t Hole = S;
+  size_t Next = (S+1) & Mask;
+  while( vals[Next] ){
+    size_t Home = slot(keys[Next]);
+    if( ((Next-Home) & Mask) >= ((Next-Hole) & Mask) ){
+      keys[Hole] = keys[Next];
+      vals[Hole] = vals[Next];
+      Hole = Next;
+    }
+    Next = (Next+1) & Mask;
+  }
+  vals[Hole] = nullptr;
+  count--;
+  return Op;
+}
+
+void RevRqstMap::grow(){
+  std::vector<StandardMem::Request::id_t> OldKeys;
+  std::vector<RevMemOp *> OldVals;
+  OldKeys.swap(keys);
+  OldVals.swap(vals);
+  keys.resize(OldVals.size()*2);
+  vals.assign(OldVals.size()*2, nullptr);
+  shift--;
+  count = 0;
+  for( size_t i=0; i<OldVals.size(); i++ ){
+    if( OldVals[i] )
+      insert(OldKeys[i], OldVals[i]);
+  }
+}
+
 // ---------------------------------------------------------------
 // RevMemCtrl
 // ---------------------------------------------------------------
@@ -78,12 +184,17 @@ RevMemCtrl::~RevMemCtrl(){
 // RevBasicMemCtrl
 // ---------------------------------------------------------------
 RevBasicMemCtrl::RevBasicMemCtrl(ComponentId_t id, Params& params)
-  : RevMemCtrl(id,params), memIface(nullptr), stdMemHandlers(nullptr),
-    hasCache(false), lineSize(0),
+  : RevMemCtrl(id,params), memIface(nullptr), iMemIface(nullptr),
+    stdMemHandlers(nullptr), hasCache(false), lineSize(0),
+    iHasCache(false), iLineSize(0),
     max_loads(64), max_stores(64), max_flush(64), max_llsc(64),
     max_readlock(64), max_writeunlock(64), max_custom(64), max_ops(2),
+    max_ifetch(16), max_ifetch_ops(1),
     num_read(0), num_write(0), num_flush(0), num_llsc(0), num_readlock(0),
-    num_writeunlock(0), num_custom(0), num_fence(0){
+    num_writeunlock(0), num_custom(0), num_fence(0), num_ifetch(0),
+    rqstSeq(0x00ull), rqstCount(0x00ull),
+    openRead(nullptr), openWrite(nullptr), fwdWrite(nullptr),
+    initBytes(0x00ull), initDone(false){
 
   stdMemHandlers = new RevBasicMemCtrl::RevStdMemHandlers(this,output);
 
@@ -97,8 +208,12 @@ RevBasicMemCtrl::RevBasicMemCtrl(ComponentId_t id, Params& params)
   max_writeunlock = params.find<unsigned>("max_writeunlock", 64);
   max_custom = params.find<unsigned>("max_custom", 64);
   max_ops = params.find<unsigned>("ops_per_cycle", 2);
+  max_ifetch = params.find<unsigned>("max_ifetch", 16);
+  max_ifetch_ops = params.find<unsigned>("ifetch_per_cycle", 1);
 
-  rqstQ.reserve(max_ops);
+  // size the outstanding request maps for the configured request windows
+  outstanding = RevRqstMap(2*(max_loads + max_stores + max_flush + max_llsc +
+                              max_readlock + max_writeunlock + max_custom));
 
   memIface = loadUserSubComponent<Interfaces::StandardMem>(
     "memIface", ComponentInfo::SHARE_NONE,//*/ComponentInfo::SHARE_PORTS | ComponentInfo::INSERT_STATS,
@@ -109,6 +224,21 @@ RevBasicMemCtrl::RevBasicMemCtrl(ComponentId_t id, Params& params)
     output->fatal(CALL_INFO, -1, "Error : memory interface is null\n");
   }
 
+  // the instruction fetch interface is optional; without it, instruction
+  // fetches share the data request queue and memIface
+  iMemIface = loadUserSubComponent<Interfaces::StandardMem>(
+    "iMemIface", ComponentInfo::SHARE_NONE,
+    getTimeConverter(ClockFreq), new StandardMem::Handler<SST::RevCPU::RevBasicMemCtrl>(
+      this, &RevBasicMemCtrl::processIMemEvent));
+
+  if( iMemIface ){
+    if( (max_ifetch == 0) || (max_ifetch_ops == 0) ){
+      output->fatal(CALL_INFO, -1, "Error : max_ifetch and ifetch_per_cycle must be non-zero\n");
+    }
+    ioutstanding = RevRqstMap(2*max_ifetch);
+    output->verbose(CALL_INFO, 5, 0, "Instruction fetches routed to iMemIface\n");
+  }
+
   registerStats();
 
   registerClock( ClockFreq,
@@ -116,10 +246,32 @@ RevBasicMemCtrl::RevBasicMemCtrl(ComponentId_t id, Params& params)
 }
 
 RevBasicMemCtrl::~RevBasicMemCtrl(){
-  for( unsigned i=0; i<rqstQ.size(); i++ ){
-    delete rqstQ[i];
+  for( unsigned q=0; q<NumOpQueues; q++ ){
+    for( unsigned i=0; i<rqstQ[q].size(); i++ ){
+      RevMemOp *op = rqstQ[q][i].second;
+      for( unsigned j=0; j<op->getMerged().size(); j++ ){
+        freeOp(op->getMerged()[j]);
+      }
+      freeOp(op);
+    }
+    rqstQ[q].clear();
+  }
+  for( unsigned i=0; i<fwdQ.size(); i++ ){
+    freeOp(fwdQ[i]);
+  }
+  fwdQ.clear();
+  for( unsigned i=0; i<ifetchQ.size(); i++ ){
+    freeOp(ifetchQ[i]);
   }
-  rqstQ.clear();
+  ifetchQ.clear();
+  for( unsigned i=0; i<opPool.size(); i++ ){
+    ::operator delete(opPool[i]);
+  }
+  opPool.clear();
+  for( unsigned i=0; i<initQ.size(); i++ ){
+    delete initQ[i];
+  }
+  initQ.clear();
   delete stdMemHandlers;
 }
 
@@ -146,17 +298,158 @@ void RevBasicMemCtrl::registerStats(){
   stats.push_back(registerStatistic<uint64_t>("CustomPending"));
   stats.push_back(registerStatistic<uint64_t>("CustomBytes"));
   stats.push_back(registerStatistic<uint64_t>("FencePending"));
+  stats.push_back(registerStatistic<uint64_t>("IFetchInFlight"));
+  stats.push_back(registerStatistic<uint64_t>("IFetchPending"));
+  stats.push_back(registerStatistic<uint64_t>("IFetchBytes"));
+  stats.push_back(registerStatistic<uint64_t>("ReadsMerged"));
+  stats.push_back(registerStatistic<uint64_t>("WritesMerged"));
+  stats.push_back(registerStatistic<uint64_t>("LoadsForwarded"));
 }
 
 void RevBasicMemCtrl::recordStat(RevBasicMemCtrl::MemCtrlStats Stat,
                                  uint64_t Data){
-  if( Stat > RevBasicMemCtrl::MemCtrlStats::FencePending){
+  if( Stat > RevBasicMemCtrl::MemCtrlStats::LoadsForwarded){
     // do nothing
     return ;
   }
   stats[Stat]->addData(Data);
 }
 
+void RevBasicMemCtrl::queueOp(RevMemOp *op){
+  closeMerges(op);
+  rqstQ[op->getOp()].push_back(std::make_pair(rqstSeq++, op));
+  rqstCount++;
+
+  // reads and writes within a cache line may absorb younger accesses
+  // to the same line while they wait in the queue
+  bool Open = hasCache && op->isCacheable() && op->inLine(lineSize);
+  if( op->getOp() == RevMemOp::MemOp::MemOpREAD ){
+    openRead = Open ? op : nullptr;
+  }else if( op->getOp() == RevMemOp::MemOp::MemOpWRITE ){
+    openWrite = Open ? op : nullptr;
+    fwdWrite = op;
+  }
+}
+
+void RevBasicMemCtrl::dequeueOp(unsigned q){
+  RevMemOp *op = rqstQ[q].front().second;
+  if( op == openRead )
+    openRead = nullptr;
+  if( op == openWrite )
+    openWrite = nullptr;
+  rqstQ[q].pop_front();
+  rqstCount--;
+}
+
+void RevBasicMemCtrl::closeMerges(RevMemOp *op){
+  switch(op->getOp()){
+  case RevMemOp::MemOp::MemOpREAD:
+    // a younger write to this line must not move ahead of the read
+    if( openWrite && ((openWrite->getAddr()/lineSize) == (op->getAddr()/lineSize)) )
+      openWrite = nullptr;
+    break;
+  case RevMemOp::MemOp::MemOpWRITE:
+    // a younger read of this line must not move ahead of the write
+    if( openRead && ((openRead->getAddr()/lineSize) == (op->getAddr()/lineSize)) )
+      openRead = nullptr;
+    break;
+  default:
+    // fences, atomics, flushes and custom operations order everything
+    openRead = nullptr;
+    openWrite = nullptr;
+    fwdWrite = nullptr;
+    break;
+  }
+}
+
+bool RevBasicMemCtrl::hasOlderConflict(unsigned q){
+  RevMemOp *op = rqstQ[q].front().second;
+  uint64_t Seq = rqstQ[q].front().first;
+  bool IsRead = (op->getOp() == RevMemOp::MemOp::MemOpREAD);
+  for( unsigned o=0; o<NumOpQueues; o++ ){
+    if( o == q )
+      continue;
+    for( auto it = rqstQ[o].begin(); (it != rqstQ[o].end()) && (it->first < Seq); ++it ){
+      RevMemOp *Old = it->second;
+      if( IsRead && (Old->getOp() == RevMemOp::MemOp::MemOpREAD) )
+        continue;
+      if( (op->getAddr() < (Old->getAddr()+Old->getSize())) &&
+          (Old->getAddr() < (op->getAddr()+op->getSize())) )
+        return true;
+    }
+  }
+  return false;
+}
+
+bool RevBasicMemCtrl::mergeRead(RevMemOp *op){
+  if( !hasCache || !op->isCacheable() ){
+    return false;
+  }
+
+  // forward from the youngest write when it holds every byte of the read;
+  // the read never reaches memory, so it does not order the queued writes
+  if( fwdWrite && fwdWrite->isCacheable() &&
+      (op->getAddr() >= fwdWrite->getAddr()) &&
+      ((op->getAddr()+op->getSize()) <= (fwdWrite->getAddr()+fwdWrite->getSize())) ){
+    op->forwardFrom(fwdWrite);
+    fwdQ.push_back(op);
+    recordStat(LoadsForwarded,1);
+    return true;
+  }
+
+  // coalesce into the open read of the same line; the first merge
+  // widens the queued read to the whole line
+  if( !openRead || !op->inLine(lineSize) ||
+      ((openRead->getAddr()/lineSize) != (op->getAddr()/lineSize)) ||
+      (openRead->getStdFlags() != op->getStdFlags()) ){
+    return false;
+  }
+  closeMerges(op);
+  if( openRead->getMerged().empty() ){
+    uint64_t LineAddr = (openRead->getAddr()/lineSize)*lineSize;
+    RevMemOp *Line = allocOp(LineAddr,
+                             openRead->getPhysAddr() - openRead->getAddr() + LineAddr,
+                             lineSize, (void *)(nullptr),
+                             RevMemOp::MemOp::MemOpREAD, openRead->getStdFlags());
+    Line->addMerged(openRead);
+    rqstQ[RevMemOp::MemOp::MemOpREAD].back().second = Line;
+    openRead = Line;
+  }
+  openRead->addMerged(op);
+  recordStat(ReadsMerged,1);
+  return true;
+}
+
+bool RevBasicMemCtrl::mergeWrite(RevMemOp *op){
+  // coalesce into the open write when the two touch or overlap and
+  // together stay within one cache line
+  if( !openWrite || !hasCache || !op->isCacheable() ||
+      (openWrite->getStdFlags() != op->getStdFlags()) ||
+      (op->getAddr() > (openWrite->getAddr()+openWrite->getSize())) ||
+      ((op->getAddr()+op->getSize()) < openWrite->getAddr()) ){
+    return false;
+  }
+  uint64_t Lo = std::min(op->getAddr(), openWrite->getAddr());
+  uint64_t Hi = std::max(op->getAddr()+op->getSize(),
+                         openWrite->getAddr()+openWrite->getSize());
+  if( (Lo/lineSize) != ((Hi-1)/lineSize) ){
+    return false;
+  }
+  if( openWrite->getMerged().empty() ){
+    RevMemOp *Line = allocOp(openWrite->getAddr(), openWrite->getPhysAddr(),
+                             openWrite->getSize(), (char *)(openWrite->getBuf().data()),
+                             RevMemOp::MemOp::MemOpWRITE, openWrite->getStdFlags());
+    Line->addMerged(openWrite);
+    rqstQ[RevMemOp::MemOp::MemOpWRITE].back().second = Line;
+    openWrite = Line;
+  }
+  openWrite->overlayWrite(op);
+  openWrite->addMerged(op);
+  fwdWrite = openWrite;
+  recordStat(WritesMerged,1);
+  return true;
+}
+
 bool RevBasicMemCtrl::sendFLUSHRequest(uint64_t Addr,
                                        uint64_t PAddr,
                                        uint32_t Size,
@@ -164,9 +457,9 @@ bool RevBasicMemCtrl::sendFLUSHRequest(uint64_t Addr,
                                        StandardMem::Request::flags_t flags){
   if( Size == 0 )
     return true;
-  RevMemOp *Op = new RevMemOp(Addr, PAddr, Size, RevMemOp::MemOp::MemOpFLUSH, flags);
+  RevMemOp *Op = allocOp(Addr, PAddr, Size, RevMemOp::MemOp::MemOpFLUSH, flags);
   Op->setInv(Inv);
-  rqstQ.push_back(Op);
+  queueOp(Op);
   recordStat(RevBasicMemCtrl::MemCtrlStats::FlushPending,1);
   return true;
 }
@@ -175,11 +468,14 @@ bool RevBasicMemCtrl::sendREADRequest(uint64_t Addr,
                                       uint64_t PAddr,
                                       uint32_t Size,
                                       void *target,
+                                      unsigned *pending,
                                       StandardMem::Request::flags_t flags){
   if( Size == 0 )
     return true;
-  RevMemOp *Op = new RevMemOp(Addr, PAddr, Size, target, RevMemOp::MemOp::MemOpREAD, flags);
-  rqstQ.push_back(Op);
+  RevMemOp *Op = allocOp(Addr, PAddr, Size, target, RevMemOp::MemOp::MemOpREAD, flags);
+  Op->setPending(pending);
+  if( !mergeRead(Op) )
+    queueOp(Op);
   recordStat(RevBasicMemCtrl::MemCtrlStats::ReadPending,1);
   return true;
 }
@@ -191,8 +487,9 @@ bool RevBasicMemCtrl::sendWRITERequest(uint64_t Addr,
                                        StandardMem::Request::flags_t flags){
   if( Size == 0 )
     return true;
-  RevMemOp *Op = new RevMemOp(Addr, PAddr, Size, buffer, RevMemOp::MemOp::MemOpWRITE, flags);
-  rqstQ.push_back(Op);
+  RevMemOp *Op = allocOp(Addr, PAddr, Size, buffer, RevMemOp::MemOp::MemOpWRITE, flags);
+  if( !mergeWrite(Op) )
+    queueOp(Op);
   recordStat(RevBasicMemCtrl::MemCtrlStats::WritePending,1);
   return true;
 }
@@ -204,8 +501,8 @@ bool RevBasicMemCtrl::sendREADLOCKRequest(uint64_t Addr,
                                           StandardMem::Request::flags_t flags){
   if( Size == 0 )
     return true;
-  RevMemOp *Op = new RevMemOp(Addr, PAddr, Size, target, RevMemOp::MemOp::MemOpREADLOCK, flags);
-  rqstQ.push_back(Op);
+  RevMemOp *Op = allocOp(Addr, PAddr, Size, target, RevMemOp::MemOp::MemOpREADLOCK, flags);
+  queueOp(Op);
   recordStat(RevBasicMemCtrl::MemCtrlStats::ReadLockPending,1);
   return true;
 }
@@ -217,20 +514,43 @@ bool RevBasicMemCtrl::sendWRITELOCKRequest(uint64_t Addr,
                                            StandardMem::Request::flags_t flags){
   if( Size == 0 )
     return true;
-  RevMemOp *Op = new RevMemOp(Addr, PAddr, Size, buffer, RevMemOp::MemOp::MemOpWRITEUNLOCK, flags);
-  rqstQ.push_back(Op);
+  RevMemOp *Op = allocOp(Addr, PAddr, Size, buffer, RevMemOp::MemOp::MemOpWRITEUNLOCK, flags);
+  queueOp(Op);
   recordStat(RevBasicMemCtrl::MemCtrlStats::WriteUnlockPending,1);
   return true;
 }
 
+bool RevBasicMemCtrl::sendAMORequest(uint64_t Addr,
+                                     uint64_t PAddr,
+                                     uint32_t Size,
+                                     char *buffer,
+                                     void *target,
+                                     unsigned *pending,
+                                     StandardMem::Request::flags_t flags){
+  if( Size == 0 )
+    return true;
+  // the readlock holds the line until handleAMOResp writes the result
+  // back with a writeunlock, so the update is atomic across every
+  // requestor of the memory hierarchy
+  RevMemOp *Op = allocOp(Addr, PAddr, Size, buffer, target,
+                         RevMemOp::MemOp::MemOpREADLOCK, flags);
+  Op->setPending(pending);
+  queueOp(Op);
+  recordStat(RevBasicMemCtrl::MemCtrlStats::ReadLockPending,1);
+  return true;
+}
+
 bool RevBasicMemCtrl::sendLOADLINKRequest(uint64_t Addr,
                                           uint64_t PAddr,
                                           uint32_t Size,
+                                          void *target,
+                                          unsigned *pending,
                                           StandardMem::Request::flags_t flags){
   if( Size == 0 )
     return true;
-  RevMemOp *Op = new RevMemOp(Addr, PAddr, Size, RevMemOp::MemOp::MemOpLOADLINK, flags);
-  rqstQ.push_back(Op);
+  RevMemOp *Op = allocOp(Addr, PAddr, Size, target, RevMemOp::MemOp::MemOpLOADLINK, flags);
+  Op->setPending(pending);
+  queueOp(Op);
   recordStat(RevBasicMemCtrl::MemCtrlStats::LoadLinkPending,1);
   return true;
 }
@@ -239,11 +559,15 @@ bool RevBasicMemCtrl::sendSTORECONDRequest(uint64_t Addr,
                                            uint64_t PAddr,
                                            uint32_t Size,
                                            char *buffer,
+                                           void *target,
+                                           unsigned *pending,
                                            StandardMem::Request::flags_t flags){
   if( Size == 0 )
     return true;
-  RevMemOp *Op = new RevMemOp(Addr, PAddr, Size, buffer, RevMemOp::MemOp::MemOpSTORECOND, flags);
-  rqstQ.push_back(Op);
+  RevMemOp *Op = allocOp(Addr, PAddr, Size, buffer, target,
+                         RevMemOp::MemOp::MemOpSTORECOND, flags);
+  Op->setPending(pending);
+  queueOp(Op);
   recordStat(RevBasicMemCtrl::MemCtrlStats::StoreCondPending,1);
   return true;
 }
@@ -256,8 +580,8 @@ bool RevBasicMemCtrl::sendCUSTOMREADRequest(uint64_t Addr,
                                             StandardMem::Request::flags_t flags){
   if( Size == 0 )
     return true;
-  RevMemOp *Op = new RevMemOp(Addr, PAddr, Size, target, Opc, RevMemOp::MemOp::MemOpCUSTOM, flags);
-  rqstQ.push_back(Op);
+  RevMemOp *Op = allocOp(Addr, PAddr, Size, target, Opc, RevMemOp::MemOp::MemOpCUSTOM, flags);
+  queueOp(Op);
   recordStat(RevBasicMemCtrl::MemCtrlStats::CustomPending,1);
   return true;
 }
@@ -270,19 +594,71 @@ bool RevBasicMemCtrl::sendCUSTOMWRITERequest(uint64_t Addr,
                                              StandardMem::Request::flags_t flags){
   if( Size == 0 )
     return true;
-  RevMemOp *Op = new RevMemOp(Addr, PAddr, Size, buffer, Opc, RevMemOp::MemOp::MemOpCUSTOM, flags);
-  rqstQ.push_back(Op);
+  RevMemOp *Op = allocOp(Addr, PAddr, Size, buffer, Opc, RevMemOp::MemOp::MemOpCUSTOM, flags);
+  queueOp(Op);
   recordStat(RevBasicMemCtrl::MemCtrlStats::CustomPending,1);
   return true;
 }
 
 bool RevBasicMemCtrl::sendFENCE(){
-  RevMemOp *Op = new RevMemOp(0x00ull, 0x00ull, 0x00, RevMemOp::MemOp::MemOpFENCE, 0x00);
-  rqstQ.push_back(Op);
+  RevMemOp *Op = allocOp(0x00ull, 0x00ull, 0x00, RevMemOp::MemOp::MemOpFENCE, 0x00);
+  queueOp(Op);
   recordStat(RevBasicMemCtrl::MemCtrlStats::FencePending,1);
   return true;
 }
 
+bool RevBasicMemCtrl::sendIFETCHRequest(uint64_t Addr,
+                                        uint64_t PAddr,
+                                        uint32_t Size,
+                                        void *target,
+                                        unsigned *pending,
+                                        StandardMem::Request::flags_t flags){
+  if( !iMemIface ){
+    // no dedicated instruction port; share the data path
+    return sendREADRequest(Addr, PAddr, Size, target, pending, flags);
+  }
+  if( Size == 0 )
+    return true;
+  RevMemOp *Op = allocOp(Addr, PAddr, Size, target, RevMemOp::MemOp::MemOpREAD, flags);
+  Op->setPending(pending);
+  ifetchQ.push_back(Op);
+  recordStat(RevBasicMemCtrl::MemCtrlStats::IFetchPending,1);
+  return true;
+}
+
+bool RevBasicMemCtrl::sendINITWrite(uint64_t Addr,
+                                    uint32_t Size,
+                                    char *buffer){
+  if( initDone ){
+    // untimed writes can only be delivered during init
+    return false;
+  }
+  if( Size == 0 )
+    return true;
+  std::vector<uint8_t> Data(buffer, buffer+Size);
+  initQ.push_back(new Interfaces::StandardMem::Write(Addr,
+                                                     (uint64_t)(Size),
+                                                     Data));
+  initBytes += Size;
+  return true;
+}
+
+void RevBasicMemCtrl::processIMemEvent(StandardMem::Request* ev){
+  output->verbose(CALL_INFO, 15, 0, "Received instruction fetch event\n");
+  if( ev == nullptr ){
+    output->fatal(CALL_INFO, -1, "Error : Received null instruction fetch event\n");
+  }
+  StandardMem::ReadResp *resp = dynamic_cast<StandardMem::ReadResp *>(ev);
+  if( !resp ){
+    // the instruction port only issues reads; drop anything else
+    // (eg, invalidation notices from the instruction cache)
+    output->verbose(CALL_INFO, 7, 0, "Dropping unexpected instruction fetch event\n");
+    delete ev;
+    return ;
+  }
+  handleIFetchResp(resp);
+}
+
 void RevBasicMemCtrl::processMemEvent(StandardMem::Request* ev){
   output->verbose(CALL_INFO, 15, 0, "Received memory request event\n");
   if( ev == nullptr ){
@@ -294,6 +670,17 @@ void RevBasicMemCtrl::processMemEvent(StandardMem::Request* ev){
 void RevBasicMemCtrl::init(unsigned int phase){
   memIface->init(phase);
 
+  // preload the queued image directly into the backing store
+  if( (phase == 0) && !initQ.empty() ){
+    output->verbose(CALL_INFO, 5, 0,
+                    "Preloading %" PRIu64 " bytes in %u untimed writes\n",
+                    initBytes, (unsigned)(initQ.size()));
+    for( unsigned i=0; i<initQ.size(); i++ ){
+      memIface->sendUntimedData(initQ[i]);
+    }
+    initQ.clear();
+  }
+
   // query the caching infrastructure
   if( phase == 1 ){
     lineSize = memIface->getLineSize();
@@ -305,10 +692,23 @@ void RevBasicMemCtrl::init(unsigned int phase){
       hasCache = false;
     }
   }
+
+  if( iMemIface ){
+    iMemIface->init(phase);
+    if( phase == 1 ){
+      iLineSize = iMemIface->getLineSize();
+      iHasCache = (iLineSize > 0);
+      output->verbose(CALL_INFO, 5, 0, "Instruction fetch line size=%d\n", iLineSize);
+    }
+  }
 }
 
 void RevBasicMemCtrl::setup(){
+  initDone = true;
   memIface->setup();
+  if( iMemIface ){
+    iMemIface->setup();
+  }
 }
 
 void RevBasicMemCtrl::finish(){
@@ -542,9 +942,7 @@ bool RevBasicMemCtrl::buildCacheMemRqst(RevMemOp *op,
     rqst = new Interfaces::StandardMem::Read(op->getAddr(),
                                              (uint64_t)(BaseCacheLineSize),
                                              TmpFlags);
-    requests.push_back(rqst->getID());
-    outstanding[rqst->getID()] = op;
-    memIface->send(rqst);
+    sendRqst(rqst, op);
     recordStat(ReadInFlight,1);
     num_read++;
     break;
@@ -557,9 +955,7 @@ bool RevBasicMemCtrl::buildCacheMemRqst(RevMemOp *op,
                                               (uint64_t)(BaseCacheLineSize),
                                               newBuf,
                                               TmpFlags);
-    requests.push_back(rqst->getID());
-    outstanding[rqst->getID()] = op;
-    memIface->send(rqst);
+    sendRqst(rqst, op);
     recordStat(WriteInFlight,1);
     num_write++;
     break;
@@ -569,9 +965,7 @@ bool RevBasicMemCtrl::buildCacheMemRqst(RevMemOp *op,
                                                   op->getInv(),
                                                   (uint64_t)(BaseCacheLineSize),
                                                   TmpFlags);
-    requests.push_back(rqst->getID());
-    outstanding[rqst->getID()] = op;
-    memIface->send(rqst);
+    sendRqst(rqst, op);
     recordStat(FlushInFlight,1);
     num_flush++;
     break;
@@ -579,9 +973,7 @@ bool RevBasicMemCtrl::buildCacheMemRqst(RevMemOp *op,
     rqst = new Interfaces::StandardMem::ReadLock(op->getAddr(),
                                                  (uint64_t)(BaseCacheLineSize),
                                                  TmpFlags);
-    requests.push_back(rqst->getID());
-    outstanding[rqst->getID()] = op;
-    memIface->send(rqst);
+    sendRqst(rqst, op);
     recordStat(ReadLockInFlight,1);
     num_readlock++;
     break;
@@ -595,9 +987,7 @@ bool RevBasicMemCtrl::buildCacheMemRqst(RevMemOp *op,
                                                     newBuf,
                                                     false,
                                                     TmpFlags);
-    requests.push_back(rqst->getID());
-    outstanding[rqst->getID()] = op;
-    memIface->send(rqst);
+    sendRqst(rqst, op);
     recordStat(WriteUnlockInFlight,1);
     num_writeunlock++;
     break;
@@ -605,9 +995,7 @@ bool RevBasicMemCtrl::buildCacheMemRqst(RevMemOp *op,
     rqst = new Interfaces::StandardMem::LoadLink(op->getAddr(),
                                                  (uint64_t)(BaseCacheLineSize),
                                                  TmpFlags);
-    requests.push_back(rqst->getID());
-    outstanding[rqst->getID()] = op;
-    memIface->send(rqst);
+    sendRqst(rqst, op);
     recordStat(LoadLinkInFlight,1);
     num_llsc++;
     break;
@@ -620,18 +1008,14 @@ bool RevBasicMemCtrl::buildCacheMemRqst(RevMemOp *op,
                                                          (uint64_t)(BaseCacheLineSize),
                                                          newBuf,
                                                          TmpFlags);
-    requests.push_back(rqst->getID());
-    outstanding[rqst->getID()] = op;
-    memIface->send(rqst);
+    sendRqst(rqst, op);
     recordStat(StoreCondInFlight,1);
     num_llsc++;
     break;
   case RevMemOp::MemOp::MemOpCUSTOM:
     // TODO: need more support for custom memory ops
     rqst = new Interfaces::StandardMem::CustomReq(nullptr, TmpFlags);
-    requests.push_back(rqst->getID());
-    outstanding[rqst->getID()] = op;
-    memIface->send(rqst);
+    sendRqst(rqst, op);
     recordStat(CustomInFlight,1);
     num_custom++;
     break;
@@ -665,9 +1049,7 @@ bool RevBasicMemCtrl::buildCacheMemRqst(RevMemOp *op,
       rqst = new Interfaces::StandardMem::Read(newBase,
                                                newSize,
                                                TmpFlags);
-      requests.push_back(rqst->getID());
-      outstanding[rqst->getID()] = op;
-      memIface->send(rqst);
+      sendRqst(rqst, op);
       recordStat(ReadInFlight,1);
       num_read++;
       break;
@@ -680,9 +1062,7 @@ bool RevBasicMemCtrl::buildCacheMemRqst(RevMemOp *op,
                                                 newSize,
                                                 newBuf,
                                                 TmpFlags);
-      requests.push_back(rqst->getID());
-      outstanding[rqst->getID()] = op;
-      memIface->send(rqst);
+      sendRqst(rqst, op);
       recordStat(WriteInFlight,1);
       num_write++;
       break;
@@ -692,9 +1072,7 @@ bool RevBasicMemCtrl::buildCacheMemRqst(RevMemOp *op,
                                                     op->getInv(),
                                                     newSize,
                                                     TmpFlags);
-      requests.push_back(rqst->getID());
-      outstanding[rqst->getID()] = op;
-      memIface->send(rqst);
+      sendRqst(rqst, op);
       recordStat(FlushInFlight,1);
       num_flush++;
       break;
@@ -702,9 +1080,7 @@ bool RevBasicMemCtrl::buildCacheMemRqst(RevMemOp *op,
       rqst = new Interfaces::StandardMem::ReadLock(newBase,
                                                    newSize,
                                                    TmpFlags);
-      requests.push_back(rqst->getID());
-      outstanding[rqst->getID()] = op;
-      memIface->send(rqst);
+      sendRqst(rqst, op);
       recordStat(ReadLockInFlight,1);
       num_readlock++;
       break;
@@ -718,9 +1094,7 @@ bool RevBasicMemCtrl::buildCacheMemRqst(RevMemOp *op,
                                                       newBuf,
                                                       false,
                                                       TmpFlags);
-      requests.push_back(rqst->getID());
-      outstanding[rqst->getID()] = op;
-      memIface->send(rqst);
+      sendRqst(rqst, op);
       recordStat(WriteUnlockInFlight,1);
       num_writeunlock++;
       break;
@@ -728,9 +1102,7 @@ bool RevBasicMemCtrl::buildCacheMemRqst(RevMemOp *op,
       rqst = new Interfaces::StandardMem::LoadLink(newBase,
                                                    newSize,
                                                    TmpFlags);
-      requests.push_back(rqst->getID());
-      outstanding[rqst->getID()] = op;
-      memIface->send(rqst);
+      sendRqst(rqst, op);
       recordStat(LoadLinkInFlight,1);
       num_llsc++;
       break;
@@ -743,18 +1115,14 @@ bool RevBasicMemCtrl::buildCacheMemRqst(RevMemOp *op,
                                                            newSize,
                                                            newBuf,
                                                            TmpFlags);
-      requests.push_back(rqst->getID());
-      outstanding[rqst->getID()] = op;
-      memIface->send(rqst);
+      sendRqst(rqst, op);
       recordStat(StoreCondInFlight,1);
       num_llsc++;
       break;
     case RevMemOp::MemOp::MemOpCUSTOM:
       // TODO: need more support for custom memory ops
       rqst = new Interfaces::StandardMem::CustomReq(nullptr, TmpFlags);
-      requests.push_back(rqst->getID());
-      outstanding[rqst->getID()] = op;
-      memIface->send(rqst);
+      sendRqst(rqst, op);
       recordStat(CustomInFlight,1);
       num_custom++;
       break;
@@ -786,9 +1154,7 @@ bool RevBasicMemCtrl::buildRawMemRqst(RevMemOp *op,
     rqst = new Interfaces::StandardMem::Read(op->getAddr(),
                                              (uint64_t)(op->getSize()),
                                              TmpFlags);
-    requests.push_back(rqst->getID());
-    outstanding[rqst->getID()] = op;
-    memIface->send(rqst);
+    sendRqst(rqst, op);
     recordStat(ReadInFlight,1);
     num_read++;
     break;
@@ -797,9 +1163,7 @@ bool RevBasicMemCtrl::buildRawMemRqst(RevMemOp *op,
                                               (uint64_t)(op->getSize()),
                                               op->getBuf(),
                                               TmpFlags);
-    requests.push_back(rqst->getID());
-    outstanding[rqst->getID()] = op;
-    memIface->send(rqst);
+    sendRqst(rqst, op);
     recordStat(WriteInFlight,1);
     num_write++;
     break;
@@ -809,9 +1173,7 @@ bool RevBasicMemCtrl::buildRawMemRqst(RevMemOp *op,
                                                   op->getInv(),
                                                   (uint64_t)(op->getSize()),
                                                   TmpFlags);
-    requests.push_back(rqst->getID());
-    outstanding[rqst->getID()] = op;
-    memIface->send(rqst);
+    sendRqst(rqst, op);
     recordStat(FlushInFlight,1);
     num_flush++;
     break;
@@ -819,9 +1181,7 @@ bool RevBasicMemCtrl::buildRawMemRqst(RevMemOp *op,
     rqst = new Interfaces::StandardMem::ReadLock(op->getAddr(),
                                                  (uint64_t)(op->getSize()),
                                                  TmpFlags);
-    requests.push_back(rqst->getID());
-    outstanding[rqst->getID()] = op;
-    memIface->send(rqst);
+    sendRqst(rqst, op);
     recordStat(ReadLockInFlight,1);
     num_readlock++;
     break;
@@ -831,9 +1191,7 @@ bool RevBasicMemCtrl::buildRawMemRqst(RevMemOp *op,
                                                     op->getBuf(),
                                                     false,
                                                     TmpFlags);
-    requests.push_back(rqst->getID());
-    outstanding[rqst->getID()] = op;
-    memIface->send(rqst);
+    sendRqst(rqst, op);
     recordStat(WriteUnlockInFlight,1);
     num_writeunlock++;
     break;
@@ -841,9 +1199,7 @@ bool RevBasicMemCtrl::buildRawMemRqst(RevMemOp *op,
     rqst = new Interfaces::StandardMem::LoadLink(op->getAddr(),
                                                  (uint64_t)(op->getSize()),
                                                  TmpFlags);
-    requests.push_back(rqst->getID());
-    outstanding[rqst->getID()] = op;
-    memIface->send(rqst);
+    sendRqst(rqst, op);
     recordStat(LoadLinkInFlight,1);
     num_llsc++;
     break;
@@ -852,18 +1208,14 @@ bool RevBasicMemCtrl::buildRawMemRqst(RevMemOp *op,
                                                         (uint64_t)(op->getSize()),
                                                         op->getBuf(),
                                                         TmpFlags);
-    requests.push_back(rqst->getID());
-    outstanding[rqst->getID()] = op;
-    memIface->send(rqst);
+    sendRqst(rqst, op);
     recordStat(StoreCondInFlight,1);
     num_llsc++;
     break;
   case RevMemOp::MemOp::MemOpCUSTOM:
     // TODO: need more support for custom memory ops
     rqst = new Interfaces::StandardMem::CustomReq(nullptr, TmpFlags);
-    requests.push_back(rqst->getID());
-    outstanding[rqst->getID()] = op;
-    memIface->send(rqst);
+    sendRqst(rqst, op);
     recordStat(CustomInFlight,1);
     num_custom++;
     break;
@@ -929,6 +1281,69 @@ bool RevBasicMemCtrl::buildStandardMemRqst(RevMemOp *op,
   }
 }
 
+bool RevBasicMemCtrl::processNextIFetch(){
+  if( ifetchQ.size() == 0 ){
+    return false;
+  }
+
+  RevMemOp *op = ifetchQ.front();
+  uint64_t Addr = op->getAddr();
+  uint64_t End  = Addr + (uint64_t)(op->getSize());
+
+  // split the fetch on instruction cache line boundaries
+  unsigned NumLines = 1;
+  StandardMem::Request::flags_t TmpFlags = op->getNonCacheFlags();
+  if( iHasCache && op->isCacheable() ){
+    NumLines = (unsigned)(((End-1)/iLineSize) - (Addr/iLineSize) + 1);
+    TmpFlags = op->getStdFlags();
+  }
+
+  if( (max_ifetch - num_ifetch) < NumLines ){
+    // not enough request slots, wait for responses
+    return false;
+  }
+
+  op->setSplitRqst(NumLines);
+  uint64_t Cur = Addr;
+  for( unsigned i=0; i<NumLines; i++ ){
+    uint64_t Next = End;
+    if( NumLines > 1 ){
+      Next = std::min(End, ((Cur/iLineSize)+1)*iLineSize);
+    }
+    Interfaces::StandardMem::Request *rqst =
+      new Interfaces::StandardMem::Read(Cur, Next-Cur, TmpFlags);
+    ioutstanding.insert(rqst->getID(), op);
+    iMemIface->send(rqst);
+    recordStat(IFetchInFlight,1);
+    num_ifetch++;
+    Cur = Next;
+  }
+
+  ifetchQ.pop_front();
+  return true;
+}
+
+void RevBasicMemCtrl::handleIFetchResp(StandardMem::ReadResp* ev){
+  RevMemOp *op = ioutstanding.remove(ev->getID());
+  if( !op ){
+    output->fatal(CALL_INFO, -1, "Error : found unknown instruction fetch ReadResp\n");
+  }
+
+  uint8_t *target = (uint8_t *)(op->getTarget());
+  target += (uint64_t)(ev->pAddr) - op->getAddr();
+  for( unsigned i=0; i<(unsigned)(ev->size); i++ ){
+    target[i] = ev->data[i];
+  }
+  recordStat(IFetchBytes,ev->size);
+
+  if( op->retireSplitRqst() ){
+    op->deliver();
+    freeOp(op);
+  }
+  delete ev;
+  num_ifetch--;
+}
+
 bool RevBasicMemCtrl::processNextRqst(unsigned &t_max_loads,
                                       unsigned &t_max_stores,
                                       unsigned &t_max_flush,
@@ -937,7 +1352,7 @@ bool RevBasicMemCtrl::processNextRqst(unsigned &t_max_loads,
                                       unsigned &t_max_writeunlock,
                                       unsigned &t_max_custom,
                                       unsigned &t_max_ops){
-  if( rqstQ.size() == 0 ){
+  if( rqstCount == 0 ){
     // nothing to do, saturate and exit this cycle
     t_max_ops = max_ops;
     return true;
@@ -945,10 +1360,25 @@ bool RevBasicMemCtrl::processNextRqst(unsigned &t_max_loads,
 
   bool success = false;
 
-  // retrieve the next candidate memory operation
-  for( unsigned i=0; i<rqstQ.size(); i++ ){
-    RevMemOp *op = rqstQ[i];
-    if( isMemOpAvail(op,
+  // retrieve the next candidate memory operation; this is the oldest
+  // queued operation whose class still has issue slots this cycle.
+  // each class is a FIFO, so the class heads are tried in age order;
+  // a head never passes an older operation that touches its bytes
+  bool Tried[NumOpQueues] = {false};
+  unsigned Best = NumOpQueues;
+  for( unsigned n=0; n<NumOpQueues; n++ ){
+    unsigned Oldest = NumOpQueues;
+    for( unsigned q=0; q<NumOpQueues; q++ ){
+      if( Tried[q] || rqstQ[q].empty() )
+        continue;
+      if( (Oldest == NumOpQueues) || (rqstQ[q].front().first < rqstQ[Oldest].front().first) )
+        Oldest = q;
+    }
+    if( Oldest == NumOpQueues )
+      break;
+    Tried[Oldest] = true;
+    if( !hasOlderConflict(Oldest) &&
+        isMemOpAvail(rqstQ[Oldest].front().second,
                      t_max_loads,
                      t_max_stores,
                      t_max_flush,
@@ -956,53 +1386,60 @@ bool RevBasicMemCtrl::processNextRqst(unsigned &t_max_loads,
                      t_max_readlock,
                      t_max_writeunlock,
                      t_max_custom) ){
-      // op is good to execute, build a StandardMem packet
-      t_max_ops++;
-
-      if( op->getOp() == RevMemOp::MemOp::MemOpFENCE ){
-        // time to fence!
-        // saturate and exit this cycle
-        // no need to build a StandardMem request
-        t_max_ops = max_ops;
-        rqstQ.erase(rqstQ.begin()+i);
-        num_fence+=1;
-        delete op;
-        return true;
-      }
+      Best = Oldest;
+      break;
+    }
+  }
 
-      // build a StandardMem request
-      if( !buildStandardMemRqst(op, success) ){
-        output->fatal(CALL_INFO, -1, "Error : failed to build memory request");
-        return false;
-      }
+  if( Best == NumOpQueues ){
+    // if we reach this point, then we've attempted to
+    // process all the potential requests.  none exist
+    // that can be dispatched at this time.
+    t_max_ops = max_ops;
 
-      // sent the request, remove it
-      if( success ){
-        rqstQ.erase(rqstQ.begin()+i);
-      }else{
-        // go ahead and max out our current request window
-        // otherwise, this request for induce an infinite loop
-        // we also leave the current (failed) request in the queue
-        t_max_ops = max_ops;
+#ifdef _REV_DEBUG_
+    for( unsigned q=0; q<NumOpQueues; q++ ){
+      for( unsigned i=0; i<rqstQ[q].size(); i++ ){
+        std::cout << "rqstQ[" << q << "][" << i << "] = " << rqstQ[q][i].second->getOp() << " @ 0x"
+                  << std::hex << rqstQ[q][i].second->getAddr() << std::dec
+                  << "; physAddr = 0x" << std::hex << rqstQ[q][i].second->getPhysAddr()
+                  << std::dec << std::endl;
       }
-
-      return true;
     }
+#endif
+    return true;
   }
 
-  // if we reach this point, then we've attempted to
-  // process all the potential requests.  none exist
-  // that can be dispatched at this time.
-  t_max_ops = max_ops;
+  // op is good to execute, build a StandardMem packet
+  RevMemOp *op = rqstQ[Best].front().second;
+  t_max_ops++;
 
-#ifdef _REV_DEBUG_
-  for( unsigned i=0; i<rqstQ.size(); i++ ){
-    std::cout << "rqstQ[" << i << "] = " << rqstQ[i]->getOp() << " @ 0x"
-              << std::hex << rqstQ[i]->getAddr() << std::dec
-              << "; physAddr = 0x" << std::hex << rqstQ[i]->getPhysAddr()
-              << std::dec << std::endl;
+  if( op->getOp() == RevMemOp::MemOp::MemOpFENCE ){
+    // time to fence!
+    // saturate and exit this cycle
+    // no need to build a StandardMem request
+    t_max_ops = max_ops;
+    dequeueOp(Best);
+    num_fence+=1;
+    freeOp(op);
+    return true;
+  }
+
+  // build a StandardMem request
+  if( !buildStandardMemRqst(op, success) ){
+    output->fatal(CALL_INFO, -1, "Error : failed to build memory request");
+    return false;
+  }
+
+  // sent the request, remove it
+  if( success ){
+    dequeueOp(Best);
+  }else{
+    // go ahead and max out our current request window
+    // otherwise, this request for induce an infinite loop
+    // we also leave the current (failed) request in the queue
+    t_max_ops = max_ops;
   }
-#endif
 
   return true;
 }
@@ -1010,205 +1447,199 @@ bool RevBasicMemCtrl::processNextRqst(unsigned &t_max_loads,
 void RevBasicMemCtrl::handleFlagResp(RevMemOp *op){
    StandardMem::Request::flags_t flags = op->getFlags();
 
+   // the response filled the low Size bytes of the target; the bytes
+   // above them still hold the register's previous value
+   unsigned Bits = op->getSize() * 8;
+
    if( ((uint32_t)(flags) & (uint32_t)(RevCPU::RevFlag::F_SEXT32)) ){
      uint32_t *target = (uint32_t *)(op->getTarget());
-     SEXTI(*target,32);
+     if( Bits < 32 ){
+       ZEXTI(*target,Bits);
+       SEXTI(*target,Bits);
+     }
    }else if( ((uint32_t)(flags) & (uint32_t)(RevCPU::RevFlag::F_SEXT64)) ){
      uint64_t *target = (uint64_t *)(op->getTarget());
-     SEXTI(*target,64);
+     if( Bits < 64 ){
+       ZEXTI64(*target,Bits);
+       SEXTI64(*target,Bits);
+     }
    }else if( ((uint32_t)(flags) & (uint32_t)(RevCPU::RevFlag::F_ZEXT32)) ){
      uint32_t *target = (uint32_t *)(op->getTarget());
-     ZEXTI(*target,32);
+     if( Bits < 32 )
+       ZEXTI(*target,Bits);
    }else if( ((uint32_t)(flags) & (uint32_t)(RevCPU::RevFlag::F_ZEXT64)) ){
      uint64_t *target = (uint64_t *)(op->getTarget());
-     ZEXTI64(*target,63);
+     if( Bits < 64 )
+       ZEXTI64(*target,Bits);
+   }else if( ((uint32_t)(flags) & (uint32_t)(RevCPU::RevFlag::F_FLOAT64)) ){
+     float val = 0.;
+     std::memcpy(&val, op->getTarget(), sizeof(float));
+     *(double *)(op->getTarget()) = (double)(val);
    }
 }
 
-unsigned RevBasicMemCtrl::getNumSplitRqsts(RevMemOp *op){
-  unsigned count = 0;
-  for (const auto& n : outstanding ){
-    if( n.second == op ){
-      count++;
-    }
-  }
-  return count;
+RevMemOp *RevBasicMemCtrl::claimRqst(StandardMem::Request *ev, const char *Kind){
+  RevMemOp *op = outstanding.remove(ev->getID());
+  if( !op )
+    output->fatal(CALL_INFO, -1, "Error : found unknown %s\n", Kind);
+  return op;
 }
 
 void RevBasicMemCtrl::handleReadResp(StandardMem::ReadResp* ev){
-  if( std::find(requests.begin(),requests.end(),ev->getID()) != requests.end() ){
-    requests.erase(std::find(requests.begin(),requests.end(),ev->getID()));
-    RevMemOp *op = outstanding[ev->getID()];
-    if( !op )
-      output->fatal(CALL_INFO, -1, "RevMemOp is null in handleReadResp\n" );
+  RevMemOp *op = claimRqst(ev, "ReadResp");
 #ifdef _REV_DEBUG_
-    std::cout << "handleReadResp : id=" << ev->getID() << " @Addr= 0x"
-              << std::hex << op->getAddr() << std::dec << std::endl;
-    for( unsigned i=0; i<(unsigned)(op->getSize()); i++ ){
-      std::cout << "               : data[" << i << "] = " << (unsigned)(ev->data[i]) << std::endl;
-    }
+  std::cout << "handleReadResp : id=" << ev->getID() << " @Addr= 0x"
+            << std::hex << op->getAddr() << std::dec << std::endl;
+  for( unsigned i=0; i<(unsigned)(ev->size); i++ ){
+    std::cout << "               : data[" << i << "] = " << (unsigned)(ev->data[i]) << std::endl;
+  }
 #endif
 
-    // determine if we have a split request
-    if( op->getSplitRqst() > 1 ){
-      // split request exists, determine how to handle it
+  if( op->getOp() == RevMemOp::MemOp::MemOpREADLOCK ){
+    handleAMOResp(op, ev);
+    return ;
+  }
 
-      uint8_t *target = (uint8_t *)(op->getTarget());
-      unsigned startByte = (unsigned)( (uint64_t)(ev->pAddr) - op->getAddr() );
-      target += (uint8_t)(startByte);
-      for( unsigned i=0; i<(unsigned)(ev->size); i++ ){
-        *target = ev->data[i];
-        target++;
-      }
+  if( op->getOp() == RevMemOp::MemOp::MemOpLOADLINK ){
+    // memHierarchy holds the reservation; deliver the loaded value
+    uint64_t Val = 0x00ull;
+    for( unsigned i=0; i<op->getSize(); i++ ){
+      Val |= ((uint64_t)(ev->data[i]) << (8*i));
+    }
+    RevAMOResult(op->getFlags(), op->getSize(), Val, op->getTarget());
+    retireOp(op);
+    delete ev;
+    num_llsc--;
+    return ;
+  }
 
-      if( getNumSplitRqsts(op) == 1 ){
-        // this was the last request to service, delete the op
-        handleFlagResp(op);
-        delete op;
+  // a coalesced line read delivers each of its reads
+  if( !op->getMerged().empty() ){
+    for( unsigned m=0; m<op->getMerged().size(); m++ ){
+      RevMemOp *Rd = op->getMerged()[m];
+      uint8_t *target = (uint8_t *)(Rd->getTarget());
+      uint64_t Off = Rd->getAddr() - op->getAddr();
+      for( unsigned i=0; i<Rd->getSize(); i++ ){
+        target[i] = ev->data[Off+i];
       }
-      outstanding.erase(ev->getID());
-      delete ev;
-      num_read--;
-      return ;
+      handleFlagResp(Rd);
     }
+    retireOp(op);
+    delete ev;
+    num_read--;
+    return ;
+  }
 
-    // no split request exists; handle as normal
+  // determine if we have a split request
+  if( op->getSplitRqst() > 1 ){
+    // split request exists, place this line at its offset in the target
     uint8_t *target = (uint8_t *)(op->getTarget());
-    for( unsigned i=0; i<(unsigned)(op->getSize()); i++ ){
+    target += (uint64_t)(ev->pAddr) - op->getAddr();
+    for( unsigned i=0; i<(unsigned)(ev->size); i++ ){
       *target = ev->data[i];
       target++;
     }
-    // determine if we need to sign/zero extend
-    handleFlagResp(op);
-    delete op;
-    outstanding.erase(ev->getID());
+
+    if( op->retireSplitRqst() ){
+      // this was the last request to service, retire the op
+      handleFlagResp(op);
+      retireOp(op);
+    }
     delete ev;
-  }else{
-    output->fatal(CALL_INFO, -1, "Error : found unknown ReadResp\n");
+    num_read--;
+    return ;
+  }
+
+  // no split request exists; handle as normal
+  uint8_t *target = (uint8_t *)(op->getTarget());
+  for( unsigned i=0; i<(unsigned)(op->getSize()); i++ ){
+    *target = ev->data[i];
+    target++;
   }
+  // determine if we need to sign/zero extend
+  handleFlagResp(op);
+  retireOp(op);
+  delete ev;
   num_read--;
 }
 
+void RevBasicMemCtrl::handleAMOResp(RevMemOp *op, StandardMem::ReadResp* ev){
+  uint64_t Old = 0x00ull;
+  uint64_t Src = 0x00ull;
+  const std::vector<uint8_t> &Buf = op->getBuf();
+  for( unsigned i=0; i<op->getSize(); i++ ){
+    Old |= ((uint64_t)(ev->data[i]) << (8*i));
+    Src |= ((uint64_t)(Buf[i]) << (8*i));
+  }
+  uint64_t New = RevAMOApply(op->getFlags(), op->getSize(), Old, Src);
+  RevAMOResult(op->getFlags(), op->getSize(), Old, op->getTarget());
+
+  // release the line with the updated value
+  RevMemOp *Wr = allocOp(op->getAddr(), op->getPhysAddr(), op->getSize(),
+                         (char *)(&New), RevMemOp::MemOp::MemOpWRITEUNLOCK,
+                         op->getStdFlags());
+  queueOp(Wr);
+  recordStat(RevBasicMemCtrl::MemCtrlStats::WriteUnlockPending,1);
+
+  retireOp(op);
+  delete ev;
+  num_readlock--;
+}
+
 void RevBasicMemCtrl::handleWriteResp(StandardMem::WriteResp* ev){
-  if( std::find(requests.begin(),requests.end(),ev->getID()) != requests.end() ){
-    requests.erase(std::find(requests.begin(),requests.end(),ev->getID()));
-    RevMemOp *op = outstanding[ev->getID()];
-    if( !op )
-      output->fatal(CALL_INFO, -1, "RevMemOp is null in handleWriteResp\n" );
+  RevMemOp *op = claimRqst(ev, "WriteResp");
 #ifdef _REV_DEBUG_
-    std::cout << "handleWriteResp : id=" << ev->getID() << " @Addr= 0x"
-              << std::hex << op->getAddr() << std::dec << std::endl;
+  std::cout << "handleWriteResp : id=" << ev->getID() << " @Addr= 0x"
+            << std::hex << op->getAddr() << std::dec << std::endl;
 #endif
 
-    // determine if we have a split request
-    if( op->getSplitRqst() > 1 ){
-      // split request exists, determine how to handle it
-      if( getNumSplitRqsts(op) == 1 ){
-        // this was the last request to service, delete the op
-        delete op;
-      }
-      outstanding.erase(ev->getID());
-      delete ev;
-      num_write--;
-      return ;
-    }
-
-    // no split request exists; handle as normal
-    delete op;
-    outstanding.erase(ev->getID());
-    delete ev;
+  if( op->getOp() == RevMemOp::MemOp::MemOpSTORECOND ){
+    // rd reports the outcome; zero on success
+    RevAMOResult(op->getFlags(), op->getSize(), ev->getFail() ? 1 : 0, op->getTarget());
+    num_llsc--;
+  }else if( op->getOp() == RevMemOp::MemOp::MemOpWRITEUNLOCK ){
+    num_writeunlock--;
   }else{
-    output->fatal(CALL_INFO, -1, "Error : found unknown WriteResp\n");
+    num_write--;
+  }
+
+  // split requests retire with their last response
+  if( op->retireSplitRqst() ){
+    retireOp(op);
   }
-  num_write--;
+  delete ev;
 }
 
 void RevBasicMemCtrl::handleFlushResp(StandardMem::FlushResp* ev){
-  if( std::find(requests.begin(),requests.end(),ev->getID()) != requests.end() ){
-    requests.erase(std::find(requests.begin(),requests.end(),ev->getID()));
-    RevMemOp *op = outstanding[ev->getID()];
-    if( !op )
-      output->fatal(CALL_INFO, -1, "RevMemOp is null in handleFlushResp\n" );
-
-    // determine if we have a split request
-    if( op->getSplitRqst() > 1 ){
-      // split request exists, determine how to handle it
-      if( getNumSplitRqsts(op) == 1 ){
-        // this was the last request to service, delete the op
-        delete op;
-      }
-      outstanding.erase(ev->getID());
-      delete ev;
-      num_flush--;
-      return ;
-    }
+  RevMemOp *op = claimRqst(ev, "FlushResp");
 
-    // no split request exists; handle as normal
-    delete op;
-    outstanding.erase(ev->getID());
-    delete ev;
-  }else{
-    output->fatal(CALL_INFO, -1, "Error : found unknown FlushResp\n");
+  // split requests retire with their last response
+  if( op->retireSplitRqst() ){
+    freeOp(op);
   }
+  delete ev;
   num_flush--;
 }
 
 void RevBasicMemCtrl::handleCustomResp(StandardMem::CustomResp* ev){
-  if( std::find(requests.begin(),requests.end(),ev->getID()) != requests.end() ){
-    requests.erase(std::find(requests.begin(),requests.end(),ev->getID()));
-    RevMemOp *op = outstanding[ev->getID()];
-    if( !op )
-      output->fatal(CALL_INFO, -1, "RevMemOp is null in handleCustomResp\n" );
-
-    // determine if we have a split request
-    if( op->getSplitRqst() > 1 ){
-      // split request exists, determine how to handle it
-      if( getNumSplitRqsts(op) == 1 ){
-        // this was the last request to service, delete the op
-        delete op;
-      }
-      outstanding.erase(ev->getID());
-      delete ev;
-      num_custom--;
-      return ;
-    }
+  RevMemOp *op = claimRqst(ev, "CustomResp");
 
-    // no split request exists; handle as normal
-    delete op;
-    outstanding.erase(ev->getID());
-    delete ev;
-  }else{
-    output->fatal(CALL_INFO, -1, "Error : found unknown CustomResp\n");
+  // split requests retire with their last response
+  if( op->retireSplitRqst() ){
+    freeOp(op);
   }
+  delete ev;
   num_custom--;
 }
 
 void RevBasicMemCtrl::handleInvResp(StandardMem::InvNotify* ev){
-  if( std::find(requests.begin(),requests.end(),ev->getID()) != requests.end() ){
-    requests.erase(std::find(requests.begin(),requests.end(),ev->getID()));
-    RevMemOp *op = outstanding[ev->getID()];
-    if( !op )
-      output->fatal(CALL_INFO, -1, "RevMemOp is null in handleInvResp\n" );
-
-    // determine if we have a split request
-    if( op->getSplitRqst() > 1 ){
-      // split request exists, determine how to handle it
-      if( getNumSplitRqsts(op) == 1 ){
-        // this was the last request to service, delete the op
-        delete op;
-      }
-      outstanding.erase(ev->getID());
-      delete ev;
-      return ;
-    }
+  RevMemOp *op = claimRqst(ev, "InvResp");
 
-    // no split request exists; handle as normal
-    delete op;
-    outstanding.erase(ev->getID());
-    delete ev;
-  }else{
-    output->fatal(CALL_INFO, -1, "Error : found unknown InvResp\n");
+  // split requests retire with their last response
+  if( op->retireSplitRqst() ){
+    freeOp(op);
   }
+  delete ev;
 }
 
 uint64_t RevBasicMemCtrl::getTotalRqsts(){
@@ -1217,10 +1648,33 @@ uint64_t RevBasicMemCtrl::getTotalRqsts(){
 }
 
 bool RevBasicMemCtrl::outstandingRqsts(){
-  return (requests.size() > 0 );
+  return ((!outstanding.empty()) || (!ioutstanding.empty()) || (!fwdQ.empty()));
 }
 
 bool RevBasicMemCtrl::clockTick(Cycle_t cycle){
+  RevHostScope HostScope(hostProf, RevHostProf::HostMemCtrl);
+
+  // instruction fetches have their own port and are not ordered by fences
+  if( iMemIface ){
+    for( unsigned i=0; i<max_ifetch_ops; i++ ){
+      if( !processNextIFetch() ){
+        break;
+      }
+    }
+  }
+
+  // forwarded reads complete one cycle after they were requested; as
+  // with a memory response, their data lands only once they complete
+  if( !fwdQ.empty() ){
+    std::vector<RevMemOp *> Fwd;
+    Fwd.swap(fwdQ);
+    for( unsigned i=0; i<Fwd.size(); i++ ){
+      const std::vector<uint8_t> &Buf = Fwd[i]->getBuf();
+      std::copy(Buf.begin(), Buf.end(), (uint8_t *)(Fwd[i]->getTarget()));
+      handleFlagResp(Fwd[i]);
+      retireOp(Fwd[i]);
+    }
+  }
 
   // check to see if the top request is a FENCE
   if( num_fence > 0 ){
@@ -0,0 +1,281 @@
+//
+// _RevMemReplay_cc_
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#include <cstring>
+
+#include "../include/RevMemReplay.h"
+
+using namespace SST::RevCPU;
+
+RevMemReplay::RevMemReplay( SST::ComponentId_t id, SST::Params& params )
+  : SST::Component(id), Ctrl(nullptr), trace(nullptr), core(-1), timing(true),
+    physical(false), maxOutstanding(16), lookahead(64), readPos(0),
+    readCount(0), eof(false), held(false), numOutstanding(0), replayed(0x00ull) {
+
+  const int Verbosity = params.find<int>("verbose", 0);
+
+  // Initialize the output handler
+  output.init("RevMemReplay[" + getName() + ":@p:@t]: ", Verbosity, 0, SST::Output::STDOUT);
+
+  traceFile       = params.find<std::string>("trace", "memtrace.mtr");
+  core            = params.find<int>("core", -1);
+  timing          = params.find<bool>("timing", 1);
+  physical        = params.find<bool>("physical", 0);
+  maxOutstanding  = params.find<unsigned>("maxOutstanding", 16);
+  lookahead       = params.find<unsigned>("lookahead", 64);
+  if( (maxOutstanding == 0) || (lookahead == 0) )
+    output.fatal(CALL_INFO, -1, "Error: maxOutstanding and lookahead must be non-zero\n" );
+
+  // Open the trace and check its header
+  trace = fopen(traceFile.c_str(), "rb");
+  if( !trace )
+    output.fatal(CALL_INFO, -1, "Error: failed to open the memory trace %s\n", traceFile.c_str() );
+  uint8_t Hdr[12];
+  if( (fread(Hdr, 1, sizeof(Hdr), trace) != sizeof(Hdr)) ||
+      (memcmp(Hdr, REVMTR_MAGIC, 8) != 0) )
+    output.fatal(CALL_INFO, -1, "Error: %s is not a Rev memory access trace\n", traceFile.c_str() );
+  readBuf.resize(REVREPLAY_READ_RECS * REVMTR_REC_BYTES);
+  sink.assign(256, 0);
+
+  // Load the memory controller that is being driven
+  Ctrl = loadUserSubComponent<RevMemCtrl>("memory");
+  if( !Ctrl )
+    output.fatal(CALL_INFO, -1, "Error: failed to initialize the memory controller subcomponent\n" );
+  Ctrl->setCompletionHandler([this](uint64_t Addr, bool Write){ Complete(Addr, Write); });
+
+  stats.push_back(registerStatistic<uint64_t>("ReplayReads"));
+  stats.push_back(registerStatistic<uint64_t>("ReplayWrites"));
+  stats.push_back(registerStatistic<uint64_t>("ReplayAMOs"));
+  stats.push_back(registerStatistic<uint64_t>("DependencyStalls"));
+  stats.push_back(registerStatistic<uint64_t>("WindowStalls"));
+  stats.push_back(registerStatistic<uint64_t>("GapCycles"));
+
+  registerClock(params.find<std::string>("clock", "1GHz"),
+                new SST::Clock::Handler<RevMemReplay>(this,&RevMemReplay::clockTick));
+
+  // Inform SST to wait until the trace has drained
+  registerAsPrimaryComponent();
+  primaryComponentDoNotEndSim();
+}
+
+RevMemReplay::~RevMemReplay(){
+  if( trace )
+    fclose(trace);
+}
+
+void RevMemReplay::init( unsigned int phase ){
+  Ctrl->init(phase);
+}
+
+void RevMemReplay::setup(){
+  Ctrl->setup();
+}
+
+void RevMemReplay::finish(){
+  Ctrl->finish();
+  output.verbose(CALL_INFO, 1, 0, "Replayed %" PRIu64 " accesses from %u harts\n",
+                 replayed, (unsigned)(streams.size()));
+}
+
+bool RevMemReplay::ReadNext(){
+  for(;;){
+    if( readPos == readCount ){
+      if( eof ){
+        return false;
+      }
+      size_t Len = fread(readBuf.data(), 1, readBuf.size(), trace);
+      readCount = (unsigned)(Len / REVMTR_REC_BYTES);
+      readPos   = 0;
+      if( readCount == 0 ){
+        eof = true;
+        return false;
+      }
+    }
+
+    const uint8_t *B = &readBuf[readPos * REVMTR_REC_BYTES];
+    readPos++;
+    auto Get = [&B](unsigned Bytes){
+      uint64_t V = 0x00ull;
+      for( unsigned i=0; i<Bytes; i++ ){
+        V |= ((uint64_t)(B[i]) << (8*i));
+      }
+      B += Bytes;
+      return V;
+    };
+    next.Cycle  = Get(8);
+    next.PC     = Get(8);
+    next.Addr   = Get(8);
+    next.PAddr  = Get(8);
+    next.Core   = (uint32_t)(Get(4));
+    next.Hart   = (uint16_t)(Get(2));
+    next.Size   = (uint8_t)(Get(1));
+    next.Op     = (uint8_t)(Get(1));
+
+    if( (core < 0) || (next.Core == (uint32_t)(core)) ){
+      return true;
+    }
+  }
+}
+
+void RevMemReplay::Refill(){
+  for(;;){
+    if( !held ){
+      if( !ReadNext() ){
+        return ;
+      }
+      held = true;
+    }
+
+    uint64_t Key = ((uint64_t)(next.Core) << 16) | next.Hart;
+    auto it = streamIdx.find(Key);
+    unsigned Idx = 0;
+    if( it == streamIdx.end() ){
+      RevReplayStream S;
+      S.lastCycle = 0x00ull;
+      S.lastIssue = 0x00ull;
+      S.started   = false;
+      Idx = (unsigned)(streams.size());
+      streams.push_back(S);
+      streamIdx[Key] = Idx;
+    }else{
+      Idx = it->second;
+    }
+
+    // a stream that runs far ahead holds back the rest of the trace
+    if( streams[Idx].pending.size() >= lookahead ){
+      return ;
+    }
+    streams[Idx].pending.push_back(next);
+    held = false;
+  }
+}
+
+bool RevMemReplay::HasDependency(RevReplayStream &S,
+                                 const RevMemTrace::RevMemTraceRec &R){
+  bool Write  = (R.Op == RevMemTrace::MemTraceWrite) ||
+                (R.Op == RevMemTrace::MemTraceAMOWrite);
+  uint64_t Addr = physical ? R.PAddr : R.Addr;
+
+  // an atomic waits for the older accesses of its hart to drain
+  if( (R.Op == RevMemTrace::MemTraceAMORead) && !S.outstanding.empty() ){
+    return true;
+  }
+
+  for( unsigned i=0; i<S.outstanding.size(); i++ ){
+    const RevReplayAccess &O = S.outstanding[i];
+    if( O.AMO && (R.Op != RevMemTrace::MemTraceAMOWrite) ){
+      // younger accesses wait for the atomic to complete
+      return true;
+    }
+    if( (Write || O.Write) &&
+        (Addr < (O.Addr + O.Size)) && (O.Addr < (Addr + R.Size)) ){
+      return true;
+    }
+  }
+  return false;
+}
+
+void RevMemReplay::IssueStream(unsigned Idx, SST::Cycle_t currentCycle){
+  RevReplayStream &S = streams[Idx];
+  while( !S.pending.empty() ){
+    const RevMemTrace::RevMemTraceRec &R = S.pending.front();
+
+    if( timing && S.started ){
+      uint64_t Gap = (R.Cycle > S.lastCycle) ? (R.Cycle - S.lastCycle) : 0x00ull;
+      if( (uint64_t)(currentCycle) < (S.lastIssue + Gap) ){
+        stats[GapCycles]->addData(1);
+        return ;
+      }
+    }
+    if( S.outstanding.size() >= maxOutstanding ){
+      stats[WindowStalls]->addData(1);
+      return ;
+    }
+    if( HasDependency(S, R) ){
+      stats[DependencyStalls]->addData(1);
+      return ;
+    }
+
+    RevReplayAccess A;
+    A.Addr  = physical ? R.PAddr : R.Addr;
+    A.Size  = R.Size;
+    A.Write = (R.Op == RevMemTrace::MemTraceWrite) ||
+              (R.Op == RevMemTrace::MemTraceAMOWrite);
+    A.AMO   = (R.Op == RevMemTrace::MemTraceAMORead) ||
+              (R.Op == RevMemTrace::MemTraceAMOWrite);
+
+    if( A.Write ){
+      Ctrl->sendWRITERequest(A.Addr, R.PAddr, A.Size, (char *)(sink.data()), 0x00);
+      stats[ReplayWrites]->addData(1);
+    }else{
+      Ctrl->sendREADRequest(A.Addr, R.PAddr, A.Size, (void *)(sink.data()), nullptr, 0x00);
+      stats[ReplayReads]->addData(1);
+    }
+    if( R.Op == RevMemTrace::MemTraceAMORead ){
+      stats[ReplayAMOs]->addData(1);
+    }
+
+    if( A.Size ){
+      // zero sized requests are dropped by the controller
+      S.outstanding.push_back(A);
+      inflight[std::make_pair(A.Addr, A.Write)].push_back(Idx);
+      numOutstanding++;
+    }
+    S.lastCycle = R.Cycle;
+    S.lastIssue = (uint64_t)(currentCycle);
+    S.started   = true;
+    S.pending.pop_front();
+    replayed++;
+  }
+}
+
+void RevMemReplay::Complete(uint64_t Addr, bool Write){
+  auto it = inflight.find(std::make_pair(Addr, Write));
+  if( it == inflight.end() ){
+    output.verbose(CALL_INFO, 2, 0, "Completion for untracked access at 0x%" PRIx64 "\n", Addr);
+    return ;
+  }
+
+  // accesses to the same address complete in issue order
+  RevReplayStream &S = streams[it->second.front()];
+  it->second.pop_front();
+  if( it->second.empty() ){
+    inflight.erase(it);
+  }
+  for( unsigned i=0; i<S.outstanding.size(); i++ ){
+    if( (S.outstanding[i].Addr == Addr) && (S.outstanding[i].Write == Write) ){
+      S.outstanding.erase(S.outstanding.begin()+i);
+      break;
+    }
+  }
+  numOutstanding--;
+}
+
+bool RevMemReplay::clockTick( SST::Cycle_t currentCycle ){
+  Refill();
+  for( unsigned i=0; i<streams.size(); i++ ){
+    IssueStream(i, currentCycle);
+  }
+
+  if( !eof || held || numOutstanding || Ctrl->outstandingRqsts() ){
+    return false;
+  }
+  for( unsigned i=0; i<streams.size(); i++ ){
+    if( !streams[i].pending.empty() ){
+      return false;
+    }
+  }
+
+  primaryComponentOKToEndSim();
+  output.verbose(CALL_INFO, 5, 0, "OK to end sim at cycle: %" PRIu64 "\n", static_cast<uint64_t>(currentCycle));
+  return true;
+}
+
+// EOF
@@ -0,0 +1,177 @@
+//
+// _RevMemTrace_cc_
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#include <cstring>
+
+#include "../include/RevMemTrace.h"
+
+using namespace SST::RevCPU;
+
+// -- trace file layout
+//
+// header : "REVMTR01", uint32 sample rate (little endian)
+// record : uint64 cycle, uint64 pc, uint64 vaddr, uint64 paddr,
+//          uint32 core, uint16 hart, uint8 size, uint8 op
+//
+// records are fixed size so the trace can be replayed or split
+// without decoding the preceding records
+
+RevMemTrace::RevMemTrace(const std::string &File, unsigned Sample,
+                         const std::vector<std::pair<uint64_t,uint64_t>> &Filters)
+  : file(nullptr), sample(Sample ? Sample : 1), skip(Sample ? Sample : 1),
+    filters(Filters), cur(0), count(0), dropping(false),
+    records(0x00ull), dropped(0x00ull), done(false) {
+  file = fopen(File.c_str(), "wb");
+  if( !file ){
+    return ;
+  }
+
+  uint8_t Hdr[12];
+  memcpy(Hdr, REVMTR_MAGIC, 8);
+  for( unsigned i=0; i<4; i++ ){
+    Hdr[8+i] = (uint8_t)(sample >> (8*i));
+  }
+  fwrite(Hdr, 1, sizeof(Hdr), file);
+
+  chunks.resize(REVMTR_CHUNKS);
+  fill.assign(REVMTR_CHUNKS, 0);
+  for( unsigned i=0; i<REVMTR_CHUNKS; i++ ){
+    chunks[i].resize(REVMTR_CHUNK_RECS);
+    if( i != cur ){
+      freeQ.push_back(i);
+    }
+  }
+  buf.reserve(REVMTR_CHUNK_RECS * REVMTR_REC_BYTES);
+
+  writer = std::thread(&RevMemTrace::Run, this);
+}
+
+RevMemTrace::~RevMemTrace(){
+  if( !file ){
+    return ;
+  }
+
+  Flush();
+  {
+    std::lock_guard<std::mutex> L(lock);
+    done = true;
+  }
+  fullCV.notify_one();
+  writer.join();
+  fclose(file);
+}
+
+bool RevMemTrace::ParseFilter(const std::string &Filter,
+                              std::pair<uint64_t,uint64_t> &Range){
+  size_t Split = Filter.find(':');
+  if( (Split == std::string::npos) || (Split == 0) || (Split == Filter.size()-1) ){
+    return false;
+  }
+  try{
+    Range.first   = std::stoull(Filter.substr(0, Split), nullptr, 0);
+    Range.second  = std::stoull(Filter.substr(Split+1), nullptr, 0);
+  }catch(...){
+    return false;
+  }
+  return (Range.first < Range.second);
+}
+
+void RevMemTrace::Submit(){
+  if( dropping ){
+    // the simulation never waits on the writer; retry the claim only
+    // when the queues are uncontended
+    std::unique_lock<std::mutex> L(lock, std::try_to_lock);
+    if( !L.owns_lock() || freeQ.empty() ){
+      return ;
+    }
+    cur = freeQ.front();
+    freeQ.pop_front();
+    count = 0;
+    dropping = false;
+    return ;
+  }
+
+  std::lock_guard<std::mutex> L(lock);
+  fill[cur] = count;
+  fullQ.push_back(cur);
+  fullCV.notify_one();
+
+  if( freeQ.empty() ){
+    // every chunk is in flight; discard records until the writer catches up
+    dropping = true;
+    return ;
+  }
+  cur = freeQ.front();
+  freeQ.pop_front();
+  count = 0;
+}
+
+void RevMemTrace::Flush(){
+  if( !file ){
+    return ;
+  }
+  if( count && !dropping ){
+    Submit();
+  }
+
+  // wait for every chunk handed to the writer to be released; the
+  // producer holds no chunk while it is dropping records
+  std::unique_lock<std::mutex> L(lock);
+  const unsigned Owned = dropping ? 0 : 1;
+  freeCV.wait(L, [this, Owned]{ return freeQ.size() == (REVMTR_CHUNKS-Owned); });
+  if( dropping ){
+    cur = freeQ.front();
+    freeQ.pop_front();
+    count = 0;
+    dropping = false;
+  }
+  fflush(file);
+}
+
+void RevMemTrace::Run(){
+  for(;;){
+    unsigned Idx = 0;
+    {
+      std::unique_lock<std::mutex> L(lock);
+      fullCV.wait(L, [this]{ return done || !fullQ.empty(); });
+      if( fullQ.empty() ){
+        return ;
+      }
+      Idx = fullQ.front();
+      fullQ.pop_front();
+    }
+
+    Encode(chunks[Idx], fill[Idx]);
+
+    {
+      std::lock_guard<std::mutex> L(lock);
+      freeQ.push_back(Idx);
+    }
+    freeCV.notify_one();
+  }
+}
+
+void RevMemTrace::Encode(const std::vector<RevMemTraceRec> &Chunk, unsigned Count){
+  buf.clear();
+  for( unsigned i=0; i<Count; i++ ){
+    const RevMemTraceRec &R = Chunk[i];
+    Put(R.Cycle, 8);
+    Put(R.PC,    8);
+    Put(R.Addr,  8);
+    Put(R.PAddr, 8);
+    Put(R.Core,  4);
+    Put(R.Hart,  2);
+    Put(R.Size,  1);
+    Put(R.Op,    1);
+  }
+  fwrite(buf.data(), 1, buf.size(), file);
+}
+
+// EOF
@@ -24,12 +24,27 @@ RevOpts::RevOpts( unsigned NumCores, const int Verbosity )
   // -- table = internal
   // -- memCosts[core] = 0:10
   // -- prefetch depth = 16
+  // -- branch predictor = none; penalty = 3
+  // -- pattern table = 4096; btb = 512; ras = 16
+  // -- fusion = none
+  // -- jit = off
+  // -- guest profile = disabled
+  // -- instruction trace = disabled
   for( unsigned i=0; i<numCores; i++ ){
     startAddr.insert( std::pair<unsigned,uint64_t>(i,(uint64_t)(0x00000000)) );
     machine.insert( std::pair<unsigned,std::string>(i,"G") );
     table.insert( std::pair<unsigned,std::string>(i,"_REV_INTERNAL_") );
     memCosts.push_back(InitialPair);
     prefetchDepth.insert( std::pair<unsigned,unsigned>(i,16) );
+    branchPred.insert( std::pair<unsigned,std::string>(i,"none") );
+    branchPenalty.insert( std::pair<unsigned,unsigned>(i,3) );
+    bpredEntries.insert( std::pair<unsigned,unsigned>(i,4096) );
+    btbEntries.insert( std::pair<unsigned,unsigned>(i,512) );
+    rasDepth.insert( std::pair<unsigned,unsigned>(i,16) );
+    fusion.insert( std::pair<unsigned,std::string>(i,"none") );
+    jit.insert( std::pair<unsigned,std::string>(i,"off") );
+    profile.insert( std::pair<unsigned,std::string>(i,"") );
+    trace.insert( std::pair<unsigned,std::string>(i,"") );
   }
 }
 
@@ -73,6 +88,113 @@ bool RevOpts::InitPrefetchDepth( std::vector<std::string> Depths ){
   return true;
 }
 
+bool RevOpts::InitCoreValues( std::vector<std::string> Values,
+                              std::map<unsigned,unsigned> &Target ){
+  std::vector<std::string> vstr;
+
+  // check to see if we expand into multiple cores
+  if( Values.size() == 1 ){
+    std::string s = Values[0];
+    splitStr(s,':',vstr);
+    if( vstr.size() != 2 )
+      return false;
+
+    if( vstr[0] == "CORES" ){
+      unsigned Val = (unsigned)(std::stoul(vstr[1],nullptr,0));
+      for( unsigned i=0; i<numCores; i++ ){
+        Target.at(i) = Val;
+      }
+      return true;
+    }
+  }
+
+  for( unsigned i=0; i<Values.size(); i++ ){
+    std::string s = Values[i];
+    splitStr(s,':',vstr);
+    if( vstr.size() != 2 )
+      return false;
+
+    unsigned Core = (unsigned)(std::stoi(vstr[0],nullptr,0));
+    if( Core >= numCores )
+      return false;
+
+    Target.at(Core) = (unsigned)(std::stoul(vstr[1],nullptr,0));
+    vstr.clear();
+  }
+  return true;
+}
+
+bool RevOpts::InitCoreStrings( std::vector<std::string> Values,
+                               std::map<unsigned,std::string> &Target ){
+  std::vector<std::string> vstr;
+
+  // check to see if we expand into multiple cores
+  if( Values.size() == 1 ){
+    std::string s = Values[0];
+    splitStr(s,':',vstr);
+    if( vstr.size() != 2 )
+      return false;
+
+    if( vstr[0] == "CORES" ){
+      for( unsigned i=0; i<numCores; i++ ){
+        Target.at(i) = vstr[1];
+      }
+      return true;
+    }
+  }
+
+  for( unsigned i=0; i<Values.size(); i++ ){
+    std::string s = Values[i];
+    splitStr(s,':',vstr);
+    if( vstr.size() != 2 )
+      return false;
+
+    unsigned Core = (unsigned)(std::stoi(vstr[0],nullptr,0));
+    if( Core >= numCores )
+      return false;
+
+    Target.at(Core) = vstr[1];
+    vstr.clear();
+  }
+  return true;
+}
+
+bool RevOpts::InitBranchPred( std::vector<std::string> Preds ){
+  return InitCoreStrings(Preds, branchPred);
+}
+
+bool RevOpts::InitBranchPenalty( std::vector<std::string> Penalties ){
+  return InitCoreValues(Penalties, branchPenalty);
+}
+
+bool RevOpts::InitBranchPredEntries( std::vector<std::string> Entries ){
+  return InitCoreValues(Entries, bpredEntries);
+}
+
+bool RevOpts::InitBTBEntries( std::vector<std::string> Entries ){
+  return InitCoreValues(Entries, btbEntries);
+}
+
+bool RevOpts::InitRASDepth( std::vector<std::string> Depths ){
+  return InitCoreValues(Depths, rasDepth);
+}
+
+bool RevOpts::InitFusion( std::vector<std::string> Policies ){
+  return InitCoreStrings(Policies, fusion);
+}
+
+bool RevOpts::InitJIT( std::vector<std::string> Modes ){
+  return InitCoreStrings(Modes, jit);
+}
+
+bool RevOpts::InitProfile( std::vector<std::string> Prefixes ){
+  return InitCoreStrings(Prefixes, profile);
+}
+
+bool RevOpts::InitTrace( std::vector<std::string> Prefixes ){
+  return InitCoreStrings(Prefixes, trace);
+}
+
 bool RevOpts::InitStartAddrs( std::vector<std::string> StartAddrs ){
   std::vector<std::string> vstr;
 
@@ -269,4 +391,76 @@ bool RevOpts::GetMemCost( unsigned Core, unsigned &Min, unsigned &Max ){
   return true;
 }
 
+bool RevOpts::GetBranchPred( unsigned Core, std::string &Pred ){
+  if( Core >= numCores )
+    return false;
+
+  Pred = branchPred.at(Core);
+  return true;
+}
+
+bool RevOpts::GetBranchPenalty( unsigned Core, unsigned &Penalty ){
+  if( Core >= numCores )
+    return false;
+
+  Penalty = branchPenalty.at(Core);
+  return true;
+}
+
+bool RevOpts::GetBranchPredEntries( unsigned Core, unsigned &Entries ){
+  if( Core >= numCores )
+    return false;
+
+  Entries = bpredEntries.at(Core);
+  return true;
+}
+
+bool RevOpts::GetBTBEntries( unsigned Core, unsigned &Entries ){
+  if( Core >= numCores )
+    return false;
+
+  Entries = btbEntries.at(Core);
+  return true;
+}
+
+bool RevOpts::GetRASDepth( unsigned Core, unsigned &Depth ){
+  if( Core >= numCores )
+    return false;
+
+  Depth = rasDepth.at(Core);
+  return true;
+}
+
+bool RevOpts::GetFusion( unsigned Core, std::string &Policy ){
+  if( Core >= numCores )
+    return false;
+
+  Policy = fusion.at(Core);
+  return true;
+}
+
+bool RevOpts::GetJIT( unsigned Core, std::string &Mode ){
+  if( Core >= numCores )
+    return false;
+
+  Mode = jit.at(Core);
+  return true;
+}
+
+bool RevOpts::GetProfile( unsigned Core, std::string &Prefix ){
+  if( Core >= numCores )
+    return false;
+
+  Prefix = profile.at(Core);
+  return true;
+}
+
+bool RevOpts::GetTrace( unsigned Core, std::string &Prefix ){
+  if( Core >= numCores )
+    return false;
+
+  Prefix = trace.at(Core);
+  return true;
+}
+
 // EOF
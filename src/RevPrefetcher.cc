@@ -10,194 +10,147 @@
 
 #include "../include/RevPrefetcher.h"
 
-bool RevPrefetcher::IsAvail(uint64_t Addr){
-
-  // note: this logic now considers compressed instructions
-  uint64_t lastAddr = 0x00ull;
-  for( unsigned i=0; i<baseAddr.size(); i++ ){
-    lastAddr = baseAddr[i] + (depth*4);
-    if( (Addr >= baseAddr[i]) && (Addr < lastAddr) ){
-      // found it, fetch the address
-      // first, calculate the vector offset
-      uint32_t Off = 0;
-      if( Addr == baseAddr[i] ){
-        Off = 0;  // lets avoid division by zero
-      }else{
-        Off = (uint32_t)((Addr-baseAddr[i])/4);
-      }
-      if( Off > (depth-1) ){
-        // some sort of error occurred
-        return false;
-      }
-
-      if( iStack[i][Off] == REVPREF_INIT_ADDR ){
-        // the instruction hasn't been filled yet, stall
-        return false;
-      }
-
-      // we may be short of instruction width in our current stream
-      // determine if an adjacent stream has the payload
-      if( lastAddr-Addr < 4 ){
-
-        uint32_t TmpInst;
-        bool Fetched = false;
-        if( !FetchUpper(Addr+2, Fetched, TmpInst) ){
-          return false;
-        }
-        if( !Fetched ){
-          // initiated a Fill
-          return false;
-        }
-      }
-
-      // the instruction is available in the stream cache
-      return true;
-    }
+RevPrefetcher::RevPrefetcher(RevMem *Mem, unsigned Depth)
+  : mem(Mem), depth(1), blockSize(4), blockMask(0x00ull), blockShift(2),
+    hits(0x00ull), misses(0x00ull), stalls(0x00ull){
+
+  // round the stream depth down to a power of two such that
+  // each stream covers a naturally aligned block
+  while( (depth<<1) <= Depth ){
+    depth <<= 1;
+    blockShift++;
   }
+  blockSize = depth*4;
+  blockMask = ~((uint64_t)(blockSize)-1);
 
-  // if we reach this point, then the instruction hasn't even triggered
-  // a stream prefetch.  Lets go ahead and initiate one via a 'Fill' operation
-  Fill(Addr);
-  return false;
-}
+  // each stream block is filled with a single request, which
+  // must not cross a page
+  assert( blockSize <= Mem->GetPageSize() );
 
-bool RevPrefetcher::FetchUpper(uint64_t Addr, bool &Fetched, uint32_t &UInst){
-  uint64_t lastAddr = 0x00ull;
-  for( unsigned i=0; i<baseAddr.size(); i++ ){
-    lastAddr = baseAddr[i] + (depth*4);
-    if( (Addr >= baseAddr[i]) && (Addr < lastAddr) ){
-      uint32_t Off = 0;
-      if( Addr == baseAddr[i] ){
-        Off = 0;  // lets avoid division by zero
-      }else{
-        Off = (uint32_t)((Addr-baseAddr[i])/4);
-      }
-      if( Off > (depth-1) ){
-        // some sort of error occurred
-        Fetched = false;
-        return false;
-      }
-
-      if( iStack[i][Off] == REVPREF_INIT_ADDR ){
-        // the instruction hasn't been filled yet, stall
-        Fetched = false;
-        return true;
-      }
-
-      // fetch the instruction
-      if( Addr == (baseAddr[i]+(Off*4)) ){
-        UInst = (iStack[i][Off]<<16);
-        Fetched = true;
-        return true;
-      }
-    }
-  }
+  baseAddr.assign(REVPREF_NUM_STREAMS, REVPREF_INVALID);
+  pending.assign(REVPREF_NUM_STREAMS, 0);
+  stale.assign(REVPREF_NUM_STREAMS, false);
+  iStack.assign(REVPREF_NUM_STREAMS*depth, 0x00);
+}
 
-  Fill(Addr);
-  Fetched = false;
+RevPrefetcher::~RevPrefetcher(){
+  baseAddr.clear();
+  pending.clear();
+  stale.clear();
+  iStack.clear();
+}
 
-  return true;
+bool RevPrefetcher::IsPending(unsigned S){
+  // the memory response releases the count once the block has landed
+  return (pending[S] > 0);
 }
 
-bool RevPrefetcher::InstFetch(uint64_t Addr, bool &Fetched, uint32_t &Inst){
-  // scan the baseAddr vector to see if the address is cached
-  uint64_t lastAddr = 0x00ull;
-  for( unsigned i=0; i<baseAddr.size(); i++ ){
-    lastAddr = baseAddr[i] + (depth*4);
-    if( (Addr >= baseAddr[i]) && (Addr < lastAddr) ){
-      // found it, fetch the address
-      // first, calculate the vector offset
-      uint32_t Off = 0;
-      if( Addr == baseAddr[i] ){
-        Off = 0;  // lets avoid division by zero
-      }else{
-        Off = (uint32_t)((Addr-baseAddr[i])/4);
-      }
-      if( Off > (depth-1) ){
-        // some sort of error occurred
-        Fetched = false;
-        return false;
-      }
-
-      if( iStack[i][Off] == REVPREF_INIT_ADDR ){
-        // the instruction hasn't been filled yet, stall
-        Fetched = false;
-        return true;
-      }
-
-      // fetch the instruction
-      if( Addr == (baseAddr[i]+(Off*4)) ){
-        Inst = iStack[i][Off];
-      }else{
-        // compressed instruction, adjust the offset
-        Inst = (iStack[i][Off] >> 16);
-        uint32_t TmpInst;
-        if( !FetchUpper(Addr+2, Fetched, TmpInst) )
-          return false;
-        if( !Fetched ){
-          // we initiated a fill
-          return true;
-        }
-        Inst |= TmpInst;
-      }
-
-      Fetched = true;
-
-      // if this is the last instruction in the stream buffer, we need to deallocate the stream
-      if( Off == (depth-1) ){
-        DeleteStream(i);
-        Fill(Addr+2);   // go ahead and fill the next instruction
-      }
-
-      return true;
-    }
+bool RevPrefetcher::Fill(uint64_t Base){
+  unsigned S = Slot(Base);
+  if( (baseAddr[S] == Base) && !stale[S] ){
+    return true;
   }
 
-  // we missed in the stream cache, lets perform a fill
-  Fill(Addr);
-  Fetched = false;
+  // never recycle a stream with an outstanding fill; the response
+  // would land on top of the new block
+  if( IsPending(S) ){
+    return false;
+  }
+
+  baseAddr[S] = Base;
+  stale[S]    = false;
 
+  // the block is naturally aligned and no larger than a page,
+  // so it never crosses one; fetch it with a single request
+  mem->FetchMem( Base, blockSize, (void *)(&iStack[S*depth]), &pending[S] );
   return true;
 }
 
-void RevPrefetcher::Fill(uint64_t Addr){
+RevPrefetcher::PrefStatus RevPrefetcher::FetchHalf(uint64_t Addr, uint32_t &Half,
+                                                   bool Allocate){
+  uint64_t Base = Addr & blockMask;
+  unsigned S    = Slot(Addr);
 
-  // determine if the address is 32bit aligned
-  if((Addr%4)!=0){
-    // not 32bit aligned, adjust the base address by 2 bytes
-    Fill(Addr&0xFFFFFFFFFFFFFFFC);
-    return;
+  if( (baseAddr[S] != Base) || stale[S] ){
+    if( Allocate )
+      Fill(Base);
+    return PrefMiss;
   }
 
-  // allocate a new stream buffer
-  baseAddr.push_back(Addr);
-  iStack.push_back( new uint32_t[depth] );
+  if( IsPending(S) ){
+    // the block hasn't been filled yet, stall
+    return PrefPending;
+  }
 
-  // initialize it
-  unsigned x = baseAddr.size()-1;
-  for( unsigned y = 0; y<depth; y++ ){
-    iStack[x][y] = REVPREF_INIT_ADDR;
+  uint32_t Word = iStack[(S*depth) + (unsigned)((Addr-Base)>>2)];
+  if( (Addr & 0x2) != 0 ){
+    Half = (Word >> 16);
+  }else{
+    Half = (Word & 0xFFFF);
   }
+  return PrefReady;
+}
+
+RevPrefetcher::PrefStatus RevPrefetcher::Fetch(uint64_t Addr, uint32_t &Inst,
+                                               bool Allocate){
+  uint32_t Lo = 0;
+  uint32_t Hi = 0;
 
-  // now fill it
-  for( unsigned y=0; y<depth; y++ ){
-    mem->ReadVal( Addr+(y*4),
-                  (uint32_t *)(&iStack[x][y]),
-                  REVMEM_FLAGS(0x00) );
+  PrefStatus Status = FetchHalf(Addr, Lo, Allocate);
+  if( Status != PrefReady ){
+    return Status;
+  }
 
+  if( (Lo & 0b11) != 0b11 ){
+    // compressed instruction, the upper parcel is not required
+    Inst = Lo;
+  }else{
+    // the upper parcel may reside in the adjacent stream
+    Status = FetchHalf(Addr+2, Hi, Allocate);
+    if( Status != PrefReady ){
+      return Status;
+    }
+    Inst = Lo | (Hi << 16);
   }
+
+  // keep the stream one block ahead of the fetch address
+  if( Allocate )
+    Fill((Addr & blockMask) + blockSize);
+
+  return PrefReady;
 }
 
-void RevPrefetcher::DeleteStream(unsigned i){
-  // delete the target stream as we no longer need it
-  if( i > (baseAddr.size()-1) ){
-    return ;
+bool RevPrefetcher::IsAvail(uint64_t Addr, uint32_t &Inst){
+  switch( Fetch(Addr, Inst, true) ){
+  case PrefReady:
+    hits++;
+    return true;
+    break;
+  case PrefPending:
+    stalls++;
+    break;
+  case PrefMiss:
+  default:
+    misses++;
+    break;
   }
+  return false;
+}
+
+bool RevPrefetcher::IsResident(uint64_t Addr, uint32_t &Inst){
+  return (Fetch(Addr, Inst, false) == PrefReady);
+}
 
-  // delete it
-  delete [] iStack[i];
-  iStack.erase(iStack.begin() + i);
-  baseAddr.erase(baseAddr.begin() + i);
+void RevPrefetcher::Invalidate(){
+  for( unsigned S=0; S<REVPREF_NUM_STREAMS; S++ ){
+    if( IsPending(S) ){
+      // the outstanding fill still owns the stream storage;
+      // refill the block once it lands
+      stale[S] = true;
+    }else{
+      baseAddr[S] = REVPREF_INVALID;
+    }
+  }
 }
 
 // EOF
@@ -13,6 +13,9 @@
 #include <filesystem>
 #include <sys/xattr.h>
 
+std::map<std::string,std::weak_ptr<const RevProc::RevTableSet>> RevProc::TableSets;
+std::mutex RevProc::TableSetMtx;
+
 RevProc::RevProc( unsigned Id,
                   RevOpts *Opts,
                   RevMem *Mem,
@@ -22,7 +25,9 @@ RevProc::RevProc( unsigned Id,
     CrackFault(false), ALUFault(false), fault_width(0),
     id(Id), HartToDecode(0), HartToExec(0), Retired(0x00ull),
     opts(Opts), mem(Mem), loader(Loader), output(Output),
-    feature(nullptr), PExec(nullptr), sfetch(nullptr) {
+    feature(nullptr), PExec(nullptr), sfetch(nullptr), fetchWord(0), bpred(nullptr),
+    branchPenalty(0), fusion(FuseNone), profiler(nullptr),
+    tracer(nullptr), jit(nullptr), hostProf(nullptr), BuildTables(nullptr) {
 
   // initialize the machine model for the target core
   std::string Machine;
@@ -45,12 +50,93 @@ RevProc::RevProc( unsigned Id,
   if( Depth == 0 ){
     Depth = 16;
   }
+  if( ((uint64_t)(Depth)*4) > Mem->GetPageSize() )
+    output->fatal(CALL_INFO, -1,
+                  "Error: prefetch depth of %u words exceeds the page size for core=%d\n",
+                  Depth, id);
 
   sfetch = new RevPrefetcher(Mem,Depth);
   if( !sfetch )
     output->fatal(CALL_INFO, -1,
                   "Error: failed to create the RevPrefetcher object for core=%d\n", id);
 
+  // initialize the branch predictor
+  std::string BPName;
+  Opts->GetBranchPred(Id, BPName);
+  RevBranchPred::BPType BPType = RevBranchPred::BPNone;
+  if( !RevBranchPred::ParseType(BPName, BPType) )
+    output->fatal(CALL_INFO, -1,
+                  "Error: unknown branch predictor '%s' for core=%d\n",
+                  BPName.c_str(), id);
+
+  if( BPType != RevBranchPred::BPNone ){
+    unsigned BPEntries = 0;
+    unsigned BTBEntries = 0;
+    unsigned RASDepth = 0;
+    Opts->GetBranchPenalty(Id, branchPenalty);
+    Opts->GetBranchPredEntries(Id, BPEntries);
+    Opts->GetBTBEntries(Id, BTBEntries);
+    Opts->GetRASDepth(Id, RASDepth);
+    bpred = new RevBranchPred(BPType, BPEntries, BTBEntries, RASDepth);
+    if( !bpred )
+      output->fatal(CALL_INFO, -1,
+                    "Error: failed to create the RevBranchPred object for core=%d\n", id);
+  }
+
+  // initialize the macro-op fusion policy
+  FuseValid = false;
+  std::string FuseName;
+  Opts->GetFusion(Id, FuseName);
+  if( FuseName == "fused" ){
+    fusion = FuseOne;
+  }else if( FuseName == "split" ){
+    fusion = FuseTwo;
+  }else if( FuseName != "none" ){
+    output->fatal(CALL_INFO, -1,
+                  "Error: unknown fusion policy '%s' for core=%d\n",
+                  FuseName.c_str(), id);
+  }
+
+  // initialize the guest profiler
+  Opts->GetProfile(Id, profPrefix);
+  if( !profPrefix.empty() ){
+    profiler = new RevProfiler(loader, _REV_HART_COUNT_);
+    if( !profiler )
+      output->fatal(CALL_INFO, -1,
+                    "Error: failed to create the RevProfiler object for core=%d\n", id);
+  }
+
+  // initialize the binary instruction tracer
+  std::string TracePrefix;
+  Opts->GetTrace(Id, TracePrefix);
+  if( !TracePrefix.empty() ){
+    std::string TraceFile = TracePrefix + ".core" + std::to_string(id) + ".rtrc";
+    tracer = new RevTracer(TraceFile, id, feature->GetXlen());
+    if( !tracer || !tracer->IsOpen() )
+      output->fatal(CALL_INFO, -1,
+                    "Error: failed to open the instruction trace %s for core=%d\n",
+                    TraceFile.c_str(), id);
+  }
+
+  // initialize the hot block translator
+  std::string JITName;
+  RevJIT::JITMode JITMode;
+  Opts->GetJIT(Id, JITName);
+  if( !RevJIT::ParseMode(JITName, JITMode) )
+    output->fatal(CALL_INFO, -1,
+                  "Error: unknown jit mode '%s' for core=%d\n",
+                  JITName.c_str(), id);
+  if( JITMode != RevJIT::JITOff ){
+    if( feature->GetXlen() != 64 )
+      output->fatal(CALL_INFO, -1,
+                    "Error: jit=%s requires an RV64 machine model for core=%d\n",
+                    JITName.c_str(), id);
+    jit = new RevJIT(mem, output, id);
+    if( !jit )
+      output->fatal(CALL_INFO, -1,
+                    "Error: failed to create the RevJIT object for core=%d\n", id);
+  }
+
   // Initialize ThreadTable (NOTE: Default PID = 1024 + ProcID)
   if( !InitThreadTable() )
     output->fatal(CALL_INFO, -1,
@@ -80,6 +166,21 @@ RevProc::RevProc( unsigned Id,
   Stats.cyclesStalled = 0;
   Stats.percentEff = 0.0;
   Stats.floatsExec = 0;
+  Stats.branchesExec = 0;
+  Stats.branchMispredicts = 0;
+  Stats.btbMisses = 0;
+  Stats.rasMisses = 0;
+  Stats.cyclesRedirect = 0;
+  Stats.fetchHits = 0;
+  Stats.fetchMisses = 0;
+  Stats.fetchStalls = 0;
+  Stats.fusedPairs = 0;
+  Stats.jitBlocks = 0;
+  Stats.jitChecks = 0;
+  for( unsigned i=0; i<InstClassCount; i++ ){
+    Stats.classInsts[i] = 0;
+    Stats.classStalls[i] = 0;
+  }
 }
 
 RevProc::~RevProc(){
@@ -87,6 +188,69 @@ RevProc::~RevProc(){
     delete Extensions[i];
   delete feature;
   delete sfetch;
+  delete bpred;
+  delete profiler;
+  delete tracer;
+  delete jit;
+}
+
+void RevProc::TraceInst(uint64_t PC, RevInst *Inst){
+  RevTracer::RevTraceRec &R = tracer->Next();
+  R.PC    = PC;
+  R.Size  = (uint8_t)(Inst->instSize);
+  R.Rd    = Inst->rd;
+  R.Flags = 0;
+  R.Inst  = Inst->encoding;
+  if( R.Size == 2 )
+    R.Inst &= 0xFFFF;
+
+  RevRegClass RdClass = Tables->InstTable[Inst->entry].rdClass;
+  if( (RdClass == RegGPR) && (Inst->rd != 0) ){
+    R.Flags |= RevTracer::TraceRd;
+    if( feature->GetXlen() == 32 ){
+      R.RdVal = (uint64_t)(RegFile->RV32[Inst->rd]);
+    }else{
+      R.RdVal = RegFile->RV64[Inst->rd];
+    }
+  }else if( RdClass == RegFLOAT ){
+    R.Flags |= (RevTracer::TraceRd | RevTracer::TraceRdFP);
+    // the destination format is the first suffix of the mnemonic, such
+    // that fcvt.s.d writes a single; the loads carry it in their name
+    const std::string &Mnem = Tables->InstTable[Inst->entry].mnemonic;
+    size_t Start = (Mnem.compare(0, 2, "c.") == 0) ? 2 : 0;
+    size_t Dot   = Mnem.find('.', Start);
+    char Fmt = ((Dot != std::string::npos) && (Dot < Mnem.find(' '))) ?
+               Mnem[Dot+1] : Mnem[Start+2];
+    if( Fmt == 'd' ){
+      memcpy(&R.RdVal, &RegFile->DPF[Inst->rd], sizeof(double));
+    }else{
+      // with the D extension singles are held widened in the D registers
+      float Val = feature->HasDouble() ? (float)(RegFile->DPF[Inst->rd]) :
+                                         RegFile->SPF[Inst->rd];
+      uint32_t Bits = 0;
+      memcpy(&Bits, &Val, sizeof(float));
+      R.RdVal = (uint64_t)(Bits);
+    }
+  }
+
+  bool Write = false;
+  if( mem->GetLastAccess(R.MemAddr, Write) ){
+    R.Flags |= RevTracer::TraceMem;
+    if( Write )
+      R.Flags |= RevTracer::TraceMemWrite;
+  }
+}
+
+bool RevProc::WriteProfile(){
+  if( !profiler )
+    return true;
+
+  if( !profiler->Write(profPrefix, id) ){
+    output->verbose(CALL_INFO, 1, 0,
+                    "Warning: failed to write the guest profile for core=%d\n", id);
+    return false;
+  }
+  return true;
 }
 
 RevProc::RevProcStats RevProc::GetStats(){
@@ -96,6 +260,17 @@ RevProc::RevProcStats RevProc::GetStats(){
   Stats.memStats.doublesWritten = mem->memStats.doublesWritten;
   Stats.memStats.floatsRead     = mem->memStats.floatsRead;
   Stats.memStats.floatsWritten  = mem->memStats.floatsWritten;
+  Stats.fetchHits               = sfetch->GetHits();
+  Stats.fetchMisses             = sfetch->GetMisses();
+  Stats.fetchStalls             = sfetch->GetStalls();
+  if( bpred ){
+    Stats.btbMisses             = bpred->GetBTBMisses();
+    Stats.rasMisses             = bpred->GetRASMisses();
+  }
+  if( jit ){
+    Stats.jitBlocks             = jit->GetBlocks();
+    Stats.jitChecks             = jit->GetChecks();
+  }
   return Stats;
 }
 
@@ -116,6 +291,22 @@ bool RevProc::Resume(){
   return false;
 }
 
+bool RevProc::IsQuiesced(){
+  // a halted core still drains its pipeline and polls for completion
+  if( !Halted || SingleStep || PendingCtxSwitch || !Pipeline.empty() )
+    return false;
+  return (GetPC() != _PAN_FWARE_JUMP_) && (GetPC() != 0x00ull);
+}
+
+void RevProc::SkipIdleCycles(uint64_t Cycles){
+  Stats.totalCycles += Cycles;
+  Stats.cyclesIdle_Total += Cycles;
+  if( HART_CTE.any() )
+    Stats.cyclesIdle_MemoryFetch += Cycles;
+  if( profiler )
+    profiler->Tick(Cycles);
+}
+
 bool RevProc::SingleStepHart(){
   if( SingleStep )
     return true;
@@ -140,19 +331,23 @@ bool RevProc::EnableExt(RevExt *Ext, bool Opt){
   // add the extension to our vector of enabled objects
   Extensions.push_back(Ext);
 
+  // the master table is only merged by the core that builds the table set
+  if( !BuildTables )
+    return true;
+
   // retrieve all the target instructions
-  std::vector<RevInstEntry> IT = Ext->GetInstTable();
+  const std::vector<RevInstEntry> &IT = Ext->GetInstTable();
 
   // setup the mapping of InstTable to Ext objects
-  InstTable.reserve(InstTable.size() + IT.size());
+  BuildTables->InstTable.reserve(BuildTables->InstTable.size() + IT.size());
 
   for( unsigned i=0; i<IT.size(); i++ ){
-    InstTable.push_back(IT[i]);
+    BuildTables->InstTable.push_back(IT[i]);
     std::pair<unsigned,unsigned> ExtObj =
       std::pair<unsigned,unsigned>(Extensions.size()-1,i);
-    EntryToExt.insert(
+    BuildTables->EntryToExt.insert(
       std::pair<unsigned,
-        std::pair<unsigned,unsigned>>(InstTable.size()-1,ExtObj));
+        std::pair<unsigned,unsigned>>(BuildTables->InstTable.size()-1,ExtObj));
   }
 
   // load the compressed instructions
@@ -161,33 +356,33 @@ bool RevProc::EnableExt(RevExt *Ext, bool Opt){
                     "Core %d ; Enabling compressed extension=%s\n",
                     id, Ext->GetName().c_str());
 
-    std::vector<RevInstEntry> CT = Ext->GetCInstTable();
-    InstTable.reserve(InstTable.size() + CT.size());
+    const std::vector<RevInstEntry> &CT = Ext->GetCInstTable();
+    BuildTables->InstTable.reserve(BuildTables->InstTable.size() + CT.size());
 
     for( unsigned i=0; i<CT.size(); i++ ){
-      InstTable.push_back(CT[i]);
+      BuildTables->InstTable.push_back(CT[i]);
       std::pair<unsigned,unsigned> ExtObj =
         std::pair<unsigned,unsigned>(Extensions.size()-1,i);
-      EntryToExt.insert(
+      BuildTables->EntryToExt.insert(
         std::pair<unsigned,
-          std::pair<unsigned,unsigned>>(InstTable.size()-1,ExtObj));
+          std::pair<unsigned,unsigned>>(BuildTables->InstTable.size()-1,ExtObj));
     }
     // load the optional compressed instructions
     if( Opt ){
       output->verbose(CALL_INFO, 6, 0,
                       "Core %d ; Enabling optional compressed extension=%s\n",
                       id, Ext->GetName().c_str());
-      CT = Ext->GetOInstTable();
+      const std::vector<RevInstEntry> &OT = Ext->GetOInstTable();
 
-      InstTable.reserve(InstTable.size() + CT.size());
+      BuildTables->InstTable.reserve(BuildTables->InstTable.size() + OT.size());
 
-      for( unsigned i=0; i<CT.size(); i++ ){
-        InstTable.push_back(CT[i]);
+      for( unsigned i=0; i<OT.size(); i++ ){
+        BuildTables->InstTable.push_back(OT[i]);
         std::pair<unsigned,unsigned> ExtObj =
           std::pair<unsigned,unsigned>(Extensions.size()-1,i);
-        EntryToExt.insert(
+        BuildTables->EntryToExt.insert(
           std::pair<unsigned,
-            std::pair<unsigned,unsigned>>(InstTable.size()-1,ExtObj));
+            std::pair<unsigned,unsigned>>(BuildTables->InstTable.size()-1,ExtObj));
       }
     }
   }
@@ -320,27 +515,27 @@ bool RevProc::InitTableMapping(){
                     "Core %d ; Initializing table mapping for machine model=%s\n",
                     id, feature->GetMachineModel().c_str());
 
-  for( unsigned i=0; i<InstTable.size(); i++ ){
-    NameToEntry.insert(
-      std::pair<std::string,unsigned>(ExtractMnemonic(InstTable[i]),i) );
-    if( !InstTable[i].compressed ){
+  for( unsigned i=0; i<BuildTables->InstTable.size(); i++ ){
+    BuildTables->NameToEntry.insert(
+      std::pair<std::string,unsigned>(ExtractMnemonic(BuildTables->InstTable[i]),i) );
+    if( !BuildTables->InstTable[i].compressed ){
       // map normal instruction
-      EncToEntry.insert(
-        std::pair<uint32_t,unsigned>(CompressEncoding(InstTable[i]),i) );
+      BuildTables->EncToEntry.insert(
+        std::pair<uint32_t,unsigned>(CompressEncoding(BuildTables->InstTable[i]),i) );
       output->verbose(CALL_INFO, 6, 0,
                       "Core %d ; Table Entry %d = %s\n",
                       id,
-                      CompressEncoding(InstTable[i]),
-                      ExtractMnemonic(InstTable[i]).c_str() );
+                      CompressEncoding(BuildTables->InstTable[i]),
+                      ExtractMnemonic(BuildTables->InstTable[i]).c_str() );
     }else{
       // map compressed instruction
-      CEncToEntry.insert(
-        std::pair<uint32_t,unsigned>(CompressCEncoding(InstTable[i]),i) );
+      BuildTables->CEncToEntry.insert(
+        std::pair<uint32_t,unsigned>(CompressCEncoding(BuildTables->InstTable[i]),i) );
       output->verbose(CALL_INFO, 6, 0,
                       "Core %d ; Compressed Table Entry %d = %s\n",
                       id,
-                      CompressCEncoding(InstTable[i]),
-                      ExtractMnemonic(InstTable[i]).c_str() );
+                      CompressCEncoding(BuildTables->InstTable[i]),
+                      ExtractMnemonic(BuildTables->InstTable[i]).c_str() );
     }
   }
   return true;
@@ -368,14 +563,14 @@ bool RevProc::ReadOverrideTables(){
   std::string Inst;
   std::string Cost;
   unsigned Entry;
-  std::map<std::string,unsigned>::iterator it;
+  std::map<std::string,unsigned>::const_iterator it;
   while( infile >> Inst >> Cost ){
-    it = NameToEntry.find(Inst);
-    if( it == NameToEntry.end() )
+    it = BuildTables->NameToEntry.find(Inst);
+    if( it == BuildTables->NameToEntry.end() )
       output->fatal(CALL_INFO, -1, "Error: could not find instruction in table for map value=%s\n", Inst.c_str() );
 
     Entry = it->second;
-    InstTable[Entry].cost = (unsigned)(std::stoi(Cost,nullptr,0));
+    BuildTables->InstTable[Entry].cost = (unsigned)(std::stoi(Cost,nullptr,0));
   }
 
   // close the file
@@ -384,19 +579,437 @@ bool RevProc::ReadOverrideTables(){
   return true;
 }
 
+// RVC expansion helpers; these build the canonical 32bit encodings
+#define RVC_BITS(x,lo,len)    ((uint32_t)(((x)>>(lo))&((1u<<(len))-1)))
+#define RVC_CREG(x,lo)        (RVC_BITS(x,lo,3)+8)
+#define RVC_ENC_R(f7,rs2,rs1,f3,rd,opc) \
+  (((uint32_t)(f7)<<25)|((uint32_t)(rs2)<<20)|((uint32_t)(rs1)<<15)|((uint32_t)(f3)<<12)|((uint32_t)(rd)<<7)|(uint32_t)(opc))
+#define RVC_ENC_I(imm,rs1,f3,rd,opc) \
+  ((((uint32_t)(imm)&0xFFF)<<20)|((uint32_t)(rs1)<<15)|((uint32_t)(f3)<<12)|((uint32_t)(rd)<<7)|(uint32_t)(opc))
+#define RVC_ENC_S(imm,rs2,rs1,f3,opc) \
+  (((((uint32_t)(imm)>>5)&0x7F)<<25)|((uint32_t)(rs2)<<20)|((uint32_t)(rs1)<<15)|((uint32_t)(f3)<<12)| \
+   (((uint32_t)(imm)&0x1F)<<7)|(uint32_t)(opc))
+#define RVC_ENC_B(imm,rs2,rs1,f3,opc) \
+  (((((uint32_t)(imm)>>12)&0x1)<<31)|((((uint32_t)(imm)>>5)&0x3F)<<25)|((uint32_t)(rs2)<<20)| \
+   ((uint32_t)(rs1)<<15)|((uint32_t)(f3)<<12)|((((uint32_t)(imm)>>1)&0xF)<<8)| \
+   ((((uint32_t)(imm)>>11)&0x1)<<7)|(uint32_t)(opc))
+#define RVC_ENC_J(imm,rd,opc) \
+  (((((uint32_t)(imm)>>20)&0x1)<<31)|((((uint32_t)(imm)>>1)&0x3FF)<<21)|((((uint32_t)(imm)>>11)&0x1)<<20)| \
+   ((((uint32_t)(imm)>>12)&0xFF)<<12)|((uint32_t)(rd)<<7)|(uint32_t)(opc))
+
+uint32_t RevProc::ExpandCompressed(uint16_t Inst){
+  const bool RV64 = (feature->GetXlen() == 64);
+  const uint32_t Quad   = RVC_BITS(Inst,0,2);
+  const uint32_t Funct3 = RVC_BITS(Inst,13,3);
+  const uint32_t Rd     = RVC_BITS(Inst,7,5);
+  const uint32_t Rs2    = RVC_BITS(Inst,2,5);
+  uint32_t Imm = 0;
+
+  // immediates shared by multiple encodings
+  const uint32_t ImmW   = (RVC_BITS(Inst,6,1)<<2) | (RVC_BITS(Inst,10,3)<<3) |
+                          (RVC_BITS(Inst,5,1)<<6);                              // c.lw/c.sw/c.flw/c.fsw
+  const uint32_t ImmD   = (RVC_BITS(Inst,10,3)<<3) | (RVC_BITS(Inst,5,2)<<6);  // c.ld/c.sd/c.fld/c.fsd
+  const uint32_t ImmCI  = (RVC_BITS(Inst,12,1) ? 0xFFFFFFC0 : 0) | RVC_BITS(Inst,2,5) |
+                          (RVC_BITS(Inst,12,1)<<5);                             // sign extended imm[5:0]
+  const uint32_t Shamt  = (RVC_BITS(Inst,12,1)<<5) | RVC_BITS(Inst,2,5);
+
+  switch( Quad ){
+  case 0b00:
+    switch( Funct3 ){
+    case 0b000:
+      // c.addi4spn -> addi rd', x2, nzuimm
+      Imm = (RVC_BITS(Inst,6,1)<<2) | (RVC_BITS(Inst,5,1)<<3) |
+            (RVC_BITS(Inst,11,2)<<4) | (RVC_BITS(Inst,7,4)<<6);
+      if( Imm == 0 )
+        return 0;
+      return RVC_ENC_I(Imm, 2, 0b000, RVC_CREG(Inst,2), 0b0010011);
+    case 0b001:
+      // c.fld -> fld rd', uimm(rs1')
+      return RVC_ENC_I(ImmD, RVC_CREG(Inst,7), 0b011, RVC_CREG(Inst,2), 0b0000111);
+    case 0b010:
+      // c.lw -> lw rd', uimm(rs1')
+      return RVC_ENC_I(ImmW, RVC_CREG(Inst,7), 0b010, RVC_CREG(Inst,2), 0b0000011);
+    case 0b011:
+      if( RV64 ){
+        // c.ld -> ld rd', uimm(rs1')
+        return RVC_ENC_I(ImmD, RVC_CREG(Inst,7), 0b011, RVC_CREG(Inst,2), 0b0000011);
+      }
+      // c.flw -> flw rd', uimm(rs1')
+      return RVC_ENC_I(ImmW, RVC_CREG(Inst,7), 0b010, RVC_CREG(Inst,2), 0b0000111);
+    case 0b101:
+      // c.fsd -> fsd rs2', uimm(rs1')
+      return RVC_ENC_S(ImmD, RVC_CREG(Inst,2), RVC_CREG(Inst,7), 0b011, 0b0100111);
+    case 0b110:
+      // c.sw -> sw rs2', uimm(rs1')
+      return RVC_ENC_S(ImmW, RVC_CREG(Inst,2), RVC_CREG(Inst,7), 0b010, 0b0100011);
+    case 0b111:
+      if( RV64 ){
+        // c.sd -> sd rs2', uimm(rs1')
+        return RVC_ENC_S(ImmD, RVC_CREG(Inst,2), RVC_CREG(Inst,7), 0b011, 0b0100011);
+      }
+      // c.fsw -> fsw rs2', uimm(rs1')
+      return RVC_ENC_S(ImmW, RVC_CREG(Inst,2), RVC_CREG(Inst,7), 0b010, 0b0100111);
+    default:
+      break;
+    }
+    break;
+  case 0b01:
+    switch( Funct3 ){
+    case 0b000:
+      // c.addi -> addi rd, rd, imm
+      return RVC_ENC_I(ImmCI, Rd, 0b000, Rd, 0b0010011);
+    case 0b001:
+      if( RV64 ){
+        // c.addiw -> addiw rd, rd, imm
+        if( Rd == 0 )
+          return 0;
+        return RVC_ENC_I(ImmCI, Rd, 0b000, Rd, 0b0011011);
+      }
+      // c.jal -> jal x1, offset
+      Imm = (RVC_BITS(Inst,3,3)<<1) | (RVC_BITS(Inst,11,1)<<4) | (RVC_BITS(Inst,2,1)<<5) |
+            (RVC_BITS(Inst,7,1)<<6) | (RVC_BITS(Inst,6,1)<<7) | (RVC_BITS(Inst,9,2)<<8) |
+            (RVC_BITS(Inst,8,1)<<10) | (RVC_BITS(Inst,12,1) ? 0xFFFFF800 : 0);
+      return RVC_ENC_J(Imm, 1, 0b1101111);
+    case 0b010:
+      // c.li -> addi rd, x0, imm
+      return RVC_ENC_I(ImmCI, 0, 0b000, Rd, 0b0010011);
+    case 0b011:
+      if( Rd == 2 ){
+        // c.addi16sp -> addi x2, x2, nzimm
+        Imm = (RVC_BITS(Inst,6,1)<<4) | (RVC_BITS(Inst,2,1)<<5) | (RVC_BITS(Inst,5,1)<<6) |
+              (RVC_BITS(Inst,3,2)<<7) | (RVC_BITS(Inst,12,1) ? 0xFFFFFE00 : 0);
+        if( Imm == 0 )
+          return 0;
+        return RVC_ENC_I(Imm, 2, 0b000, 2, 0b0010011);
+      }
+      // c.lui -> lui rd, nzimm
+      Imm = ImmCI << 12;
+      if( Imm == 0 )
+        return 0;
+      return (Imm & 0xFFFFF000) | (Rd<<7) | 0b0110111;
+    case 0b100:
+      switch( RVC_BITS(Inst,10,2) ){
+      case 0b00:
+        // c.srli -> srli rd', rd', shamt
+        if( !RV64 && (Shamt & 0b100000) )
+          return 0;
+        return RVC_ENC_I(Shamt, RVC_CREG(Inst,7), 0b101, RVC_CREG(Inst,7), 0b0010011);
+      case 0b01:
+        // c.srai -> srai rd', rd', shamt
+        if( !RV64 && (Shamt & 0b100000) )
+          return 0;
+        return RVC_ENC_I(Shamt|0x400, RVC_CREG(Inst,7), 0b101, RVC_CREG(Inst,7), 0b0010011);
+      case 0b10:
+        // c.andi -> andi rd', rd', imm
+        return RVC_ENC_I(ImmCI, RVC_CREG(Inst,7), 0b111, RVC_CREG(Inst,7), 0b0010011);
+      default:
+        break;
+      }
+      if( RVC_BITS(Inst,12,1) == 0 ){
+        switch( RVC_BITS(Inst,5,2) ){
+        case 0b00:
+          // c.sub -> sub rd', rd', rs2'
+          return RVC_ENC_R(0b0100000, RVC_CREG(Inst,2), RVC_CREG(Inst,7), 0b000, RVC_CREG(Inst,7), 0b0110011);
+        case 0b01:
+          // c.xor -> xor rd', rd', rs2'
+          return RVC_ENC_R(0b0000000, RVC_CREG(Inst,2), RVC_CREG(Inst,7), 0b100, RVC_CREG(Inst,7), 0b0110011);
+        case 0b10:
+          // c.or -> or rd', rd', rs2'
+          return RVC_ENC_R(0b0000000, RVC_CREG(Inst,2), RVC_CREG(Inst,7), 0b110, RVC_CREG(Inst,7), 0b0110011);
+        default:
+          // c.and -> and rd', rd', rs2'
+          return RVC_ENC_R(0b0000000, RVC_CREG(Inst,2), RVC_CREG(Inst,7), 0b111, RVC_CREG(Inst,7), 0b0110011);
+        }
+      }
+      if( RV64 ){
+        switch( RVC_BITS(Inst,5,2) ){
+        case 0b00:
+          // c.subw -> subw rd', rd', rs2'
+          return RVC_ENC_R(0b0100000, RVC_CREG(Inst,2), RVC_CREG(Inst,7), 0b000, RVC_CREG(Inst,7), 0b0111011);
+        case 0b01:
+          // c.addw -> addw rd', rd', rs2'
+          return RVC_ENC_R(0b0000000, RVC_CREG(Inst,2), RVC_CREG(Inst,7), 0b000, RVC_CREG(Inst,7), 0b0111011);
+        default:
+          break;
+        }
+      }
+      break;
+    case 0b101:
+      // c.j -> jal x0, offset
+      Imm = (RVC_BITS(Inst,3,3)<<1) | (RVC_BITS(Inst,11,1)<<4) | (RVC_BITS(Inst,2,1)<<5) |
+            (RVC_BITS(Inst,7,1)<<6) | (RVC_BITS(Inst,6,1)<<7) | (RVC_BITS(Inst,9,2)<<8) |
+            (RVC_BITS(Inst,8,1)<<10) | (RVC_BITS(Inst,12,1) ? 0xFFFFF800 : 0);
+      return RVC_ENC_J(Imm, 0, 0b1101111);
+    case 0b110:
+    case 0b111:
+      // c.beqz/c.bnez -> beq/bne rs1', x0, offset
+      Imm = (RVC_BITS(Inst,3,2)<<1) | (RVC_BITS(Inst,10,2)<<3) | (RVC_BITS(Inst,2,1)<<5) |
+            (RVC_BITS(Inst,5,2)<<6) | (RVC_BITS(Inst,12,1) ? 0xFFFFFF00 : 0);
+      return RVC_ENC_B(Imm, 0, RVC_CREG(Inst,7), (Funct3 & 0b1), 0b1100011);
+    default:
+      break;
+    }
+    break;
+  case 0b10:
+    switch( Funct3 ){
+    case 0b000:
+      // c.slli -> slli rd, rd, shamt
+      if( !RV64 && (Shamt & 0b100000) )
+        return 0;
+      return RVC_ENC_I(Shamt, Rd, 0b001, Rd, 0b0010011);
+    case 0b001:
+      // c.fldsp -> fld rd, uimm(x2)
+      Imm = (RVC_BITS(Inst,5,2)<<3) | (RVC_BITS(Inst,12,1)<<5) | (RVC_BITS(Inst,2,3)<<6);
+      return RVC_ENC_I(Imm, 2, 0b011, Rd, 0b0000111);
+    case 0b010:
+      // c.lwsp -> lw rd, uimm(x2)
+      if( Rd == 0 )
+        return 0;
+      Imm = (RVC_BITS(Inst,4,3)<<2) | (RVC_BITS(Inst,12,1)<<5) | (RVC_BITS(Inst,2,2)<<6);
+      return RVC_ENC_I(Imm, 2, 0b010, Rd, 0b0000011);
+    case 0b011:
+      if( RV64 ){
+        // c.ldsp -> ld rd, uimm(x2)
+        if( Rd == 0 )
+          return 0;
+        Imm = (RVC_BITS(Inst,5,2)<<3) | (RVC_BITS(Inst,12,1)<<5) | (RVC_BITS(Inst,2,3)<<6);
+        return RVC_ENC_I(Imm, 2, 0b011, Rd, 0b0000011);
+      }
+      // c.flwsp -> flw rd, uimm(x2)
+      Imm = (RVC_BITS(Inst,4,3)<<2) | (RVC_BITS(Inst,12,1)<<5) | (RVC_BITS(Inst,2,2)<<6);
+      return RVC_ENC_I(Imm, 2, 0b010, Rd, 0b0000111);
+    case 0b100:
+      if( RVC_BITS(Inst,12,1) == 0 ){
+        if( Rs2 == 0 ){
+          // c.jr -> jalr x0, 0(rs1)
+          if( Rd == 0 )
+            return 0;
+          return RVC_ENC_I(0, Rd, 0b000, 0, 0b1100111);
+        }
+        // c.mv -> add rd, x0, rs2
+        return RVC_ENC_R(0, Rs2, 0, 0b000, Rd, 0b0110011);
+      }
+      if( Rs2 == 0 ){
+        if( Rd == 0 ){
+          // c.ebreak -> ebreak
+          return 0x00100073;
+        }
+        // c.jalr -> jalr x1, 0(rs1)
+        return RVC_ENC_I(0, Rd, 0b000, 1, 0b1100111);
+      }
+      // c.add -> add rd, rd, rs2
+      return RVC_ENC_R(0, Rs2, Rd, 0b000, Rd, 0b0110011);
+    case 0b101:
+      // c.fsdsp -> fsd rs2, uimm(x2)
+      Imm = (RVC_BITS(Inst,10,3)<<3) | (RVC_BITS(Inst,7,3)<<6);
+      return RVC_ENC_S(Imm, Rs2, 2, 0b011, 0b0100111);
+    case 0b110:
+      // c.swsp -> sw rs2, uimm(x2)
+      Imm = (RVC_BITS(Inst,9,4)<<2) | (RVC_BITS(Inst,7,2)<<6);
+      return RVC_ENC_S(Imm, Rs2, 2, 0b010, 0b0100011);
+    case 0b111:
+      if( RV64 ){
+        // c.sdsp -> sd rs2, uimm(x2)
+        Imm = (RVC_BITS(Inst,10,3)<<3) | (RVC_BITS(Inst,7,3)<<6);
+        return RVC_ENC_S(Imm, Rs2, 2, 0b011, 0b0100011);
+      }
+      // c.fswsp -> fsw rs2, uimm(x2)
+      Imm = (RVC_BITS(Inst,9,4)<<2) | (RVC_BITS(Inst,7,2)<<6);
+      return RVC_ENC_S(Imm, Rs2, 2, 0b010, 0b0100111);
+    default:
+      break;
+    }
+    break;
+  default:
+    break;
+  }
+
+  // reserved or non-standard encoding
+  return 0;
+}
+
+bool RevProc::InitCompressedTable(){
+  BuildTables->CDecodeTable.clear();
+  if( !feature->HasCompressed() )
+    return true;
+
+  RevInst Invalid;
+  ResetInst(&Invalid);
+  Invalid.entry = _REV_INVALID_ENTRY_;
+  BuildTables->CDecodeTable.assign(65536, Invalid);
+
+  // the 32bit decoders set the cost of the active register file
+  uint32_t SavedCost = RegFile->cost;
+  unsigned Expanded = 0;
+
+  for( uint32_t i=0; i<65536; i++ ){
+    if( (i & 0b11) == 0b11 )
+      continue;
+
+    // the compressed table entry supplies the cost such that
+    // user overrides of the compressed mnemonics are honored
+    unsigned CEntry = 0;
+    if( !LookupCEntry((uint16_t)(i), CEntry) )
+      continue;
+
+    uint32_t Enc = ExpandCompressed((uint16_t)(i));
+    unsigned Entry = 0;
+    if( (Enc == 0) || !LookupEntry(Enc, Entry) ){
+      // reserved, hint or unsupported expansion;
+      // left to the compressed decoder
+      continue;
+    }
+
+    // the expanded form executes through the base instruction
+    // handlers; only the instruction size remains compressed
+    RevInst CInst     = DecodeStdInst(Enc, Entry);
+    CInst.instSize    = 2;
+    CInst.compressed  = false;
+    CInst.cost        = Tables->InstTable[CEntry].cost;
+    CInst.entry       = Entry;
+    BuildTables->CDecodeTable[i]   = CInst;
+    Expanded++;
+  }
+
+  RegFile->cost = SavedCost;
+
+  output->verbose(CALL_INFO, 6, 0,
+                  "Core %d ; Pre-expanded %u compressed encodings\n",
+                  id, Expanded);
+  return true;
+}
+
+const char *RevProc::GetInstClassName(unsigned Class){
+  switch( Class ){
+  case InstALU:     return "ALU";     break;
+  case InstMulDiv:  return "MulDiv";  break;
+  case InstLoad:    return "Load";    break;
+  case InstStore:   return "Store";   break;
+  case InstAMO:     return "AMO";     break;
+  case InstBranch:  return "Branch";  break;
+  case InstFP:      return "FP";      break;
+  case InstSystem:  return "System";  break;
+  default:          break;
+  }
+  return "Unknown";
+}
+
+RevProc::InstClass RevProc::ClassifyEntry(const RevInstEntry &Entry){
+  if( Entry.compressed ){
+    // compressed opcodes are shared across classes; use the mnemonic
+    std::string M = ExtractMnemonic(Entry);
+    if( (M == "c.lw") || (M == "c.ld") || (M == "c.lq") ||
+        (M == "c.lwsp") || (M == "c.ldsp") || (M == "c.lqsp") ||
+        (M == "c.flw") || (M == "c.fld") ||
+        (M == "c.flwsp") || (M == "c.fldsp") )
+      return InstLoad;
+    if( (M == "c.sw") || (M == "c.sd") || (M == "c.sq") ||
+        (M == "c.swsp") || (M == "c.sdsp") || (M == "c.sqsp") ||
+        (M == "c.fsw") || (M == "c.fsd") ||
+        (M == "c.fswsp") || (M == "c.fsdsp") )
+      return InstStore;
+    if( (M == "c.j") || (M == "c.jal") || (M == "c.jr") ||
+        (M == "c.jalr") || (M == "c.beqz") || (M == "c.bnez") )
+      return InstBranch;
+    if( M == "c.ebreak" )
+      return InstSystem;
+    return InstALU;
+  }
+
+  switch( Entry.opcode ){
+  case 0b0000011:   // integer loads
+  case 0b0000111:   // fp loads
+    return InstLoad;
+    break;
+  case 0b0100011:   // integer stores
+  case 0b0100111:   // fp stores
+    return InstStore;
+    break;
+  case 0b0101111:   // lr, sc, amo*
+    return InstAMO;
+    break;
+  case 0b1100011:   // branches
+  case 0b1100111:   // jalr
+  case 0b1101111:   // jal
+    return InstBranch;
+    break;
+  case 0b0110011:   // mul, div, rem
+  case 0b0111011:   // mulw, divw, remw
+    if( Entry.funct7 == 0b0000001 )
+      return InstMulDiv;
+    break;
+  case 0b1000011:   // fmadd
+  case 0b1000111:   // fmsub
+  case 0b1001011:   // fnmsub
+  case 0b1001111:   // fnmadd
+  case 0b1010011:   // fp arithmetic, conversion and compare
+    return InstFP;
+    break;
+  case 0b0001111:   // fence, fence.i
+  case 0b1110011:   // ecall, ebreak, csr*
+    return InstSystem;
+    break;
+  default:
+    break;
+  }
+  return InstALU;
+}
+
+bool RevProc::InitInstClasses(){
+  BuildTables->EntryClass.resize(BuildTables->InstTable.size());
+  for( unsigned i=0; i<BuildTables->InstTable.size(); i++ ){
+    BuildTables->EntryClass[i] = (uint8_t)(ClassifyEntry(BuildTables->InstTable[i]));
+  }
+  return true;
+}
+
 bool RevProc::LoadInstructionTable(){
-  // Stage 1: load the instruction table for each enable feature
-  if( !SeedInstTable() )
+  // cores with the same features and cost table share one set of decode tables
+  std::string Table;
+  if( !opts->GetInstTable(id, Table) )
     return false;
+  std::string Key = std::to_string(feature->GetXlen()) + ":" +
+                    std::to_string(feature->GetFeatures()) + ":" + Table;
 
-  // Stage 2: setup the internal mapping tables for performance
-  if( !InitTableMapping() )
-    return false;
+  std::lock_guard<std::mutex> lock(TableSetMtx);
+  std::shared_ptr<RevTableSet> Build;
+  Tables = TableSets[Key].lock();
+  if( !Tables ){
+    Build = std::make_shared<RevTableSet>();
+    BuildTables = Build.get();
+    Tables = Build;
+  }
 
-  // Stage 3: examine the user-defined cost tables to see if we need to override the defaults
-  if( !ReadOverrideTables() )
+  // Stage 1: create the extensions for each enabled feature and seed the table
+  if( !SeedInstTable() )
     return false;
 
+  if( BuildTables ){
+    // Stage 2: setup the internal mapping tables for performance
+    if( !InitTableMapping() )
+      return false;
+
+    // Stage 3: examine the user-defined cost tables to see if we need to override the defaults
+    if( !ReadOverrideTables() )
+      return false;
+
+    // Stage 4: pre-expand the compressed encodings using the final costs
+    if( !InitCompressedTable() )
+      return false;
+
+    // Stage 5: classify the entries for the instruction mix statistics
+    if( !InitInstClasses() )
+      return false;
+
+    TableSets[Key] = Build;
+    BuildTables = nullptr;
+  }else{
+    output->verbose(CALL_INFO, 6, 0,
+                    "Core %d ; Sharing the instruction tables for machine model=%s\n",
+                    id, feature->GetMachineModel().c_str());
+  }
+
+  InstMix.assign(Tables->InstTable.size(), 0x00ull);
   return true;
 }
 
@@ -471,10 +1084,10 @@ bool RevProc::Reset(){
 }
 
 bool RevProc::IsFloat(unsigned Entry){
-  if( (InstTable[Entry].rdClass == RegFLOAT) ||
-      (InstTable[Entry].rs1Class == RegFLOAT) ||
-      (InstTable[Entry].rs2Class == RegFLOAT) ||
-      (InstTable[Entry].rs3Class == RegFLOAT) ){
+  if( (Tables->InstTable[Entry].rdClass == RegFLOAT) ||
+      (Tables->InstTable[Entry].rs1Class == RegFLOAT) ||
+      (Tables->InstTable[Entry].rs2Class == RegFLOAT) ||
+      (Tables->InstTable[Entry].rs3Class == RegFLOAT) ){
     return true;
   }
   return false;
@@ -484,11 +1097,11 @@ RevInst RevProc::DecodeCRInst(uint16_t Inst, unsigned Entry){
   RevInst CompInst;
 
   // cost
-  RegFile->cost  = InstTable[Entry].cost;
+  RegFile->cost  = Tables->InstTable[Entry].cost;
 
   // encodings
-  CompInst.opcode  = InstTable[Entry].opcode;
-  CompInst.funct4  = InstTable[Entry].funct4;
+  CompInst.opcode  = Tables->InstTable[Entry].opcode;
+  CompInst.funct4  = Tables->InstTable[Entry].funct4;
 
   // registers
   CompInst.rd      = DECODE_RD(Inst);
@@ -506,11 +1119,11 @@ RevInst RevProc::DecodeCIInst(uint16_t Inst, unsigned Entry){
   RevInst CompInst;
 
   // cost
-  RegFile->cost  = InstTable[Entry].cost;
+  RegFile->cost  = Tables->InstTable[Entry].cost;
 
   // encodings
-  CompInst.opcode  = InstTable[Entry].opcode;
-  CompInst.funct3  = InstTable[Entry].funct3;
+  CompInst.opcode  = Tables->InstTable[Entry].opcode;
+  CompInst.funct3  = Tables->InstTable[Entry].funct3;
 
   // registers
   CompInst.rd      = DECODE_RD(Inst);
@@ -599,11 +1212,11 @@ RevInst RevProc::DecodeCSSInst(uint16_t Inst, unsigned Entry){
   RevInst CompInst;
 
   // cost
-  RegFile->cost  = InstTable[Entry].cost;
+  RegFile->cost  = Tables->InstTable[Entry].cost;
 
   // encodings
-  CompInst.opcode  = InstTable[Entry].opcode;
-  CompInst.funct3  = InstTable[Entry].funct3;
+  CompInst.opcode  = Tables->InstTable[Entry].opcode;
+  CompInst.funct3  = Tables->InstTable[Entry].funct3;
 
   // registers
   CompInst.rs2     = DECODE_LOWER_CRS2(Inst);
@@ -642,11 +1255,11 @@ RevInst RevProc::DecodeCIWInst(uint16_t Inst, unsigned Entry){
   RevInst CompInst;
 
   // cost
-  RegFile->cost  = InstTable[Entry].cost;
+  RegFile->cost  = Tables->InstTable[Entry].cost;
 
   // encodings
-  CompInst.opcode  = InstTable[Entry].opcode;
-  CompInst.funct3  = InstTable[Entry].funct3;
+  CompInst.opcode  = Tables->InstTable[Entry].opcode;
+  CompInst.funct3  = Tables->InstTable[Entry].funct3;
 
   // registers
   CompInst.rd      = ((Inst & 0b11100) >> 2);
@@ -676,11 +1289,11 @@ RevInst RevProc::DecodeCLInst(uint16_t Inst, unsigned Entry){
   RevInst CompInst;
 
   // cost
-  RegFile->cost  = InstTable[Entry].cost;
+  RegFile->cost  = Tables->InstTable[Entry].cost;
 
   // encodings
-  CompInst.opcode  = InstTable[Entry].opcode;
-  CompInst.funct3  = InstTable[Entry].funct3;
+  CompInst.opcode  = Tables->InstTable[Entry].opcode;
+  CompInst.funct3  = Tables->InstTable[Entry].funct3;
 
   // registers
   CompInst.rd      = ((Inst & 0b11100) >> 2);
@@ -739,11 +1352,11 @@ RevInst RevProc::DecodeCSInst(uint16_t Inst, unsigned Entry){
   RevInst CompInst;
 
   // cost
-  RegFile->cost  = InstTable[Entry].cost;
+  RegFile->cost  = Tables->InstTable[Entry].cost;
 
   // encodings
-  CompInst.opcode  = InstTable[Entry].opcode;
-  CompInst.funct3  = InstTable[Entry].funct3;
+  CompInst.opcode  = Tables->InstTable[Entry].opcode;
+  CompInst.funct3  = Tables->InstTable[Entry].funct3;
 
   // registers
   CompInst.rs2     = ((Inst & 0b011100) >> 2);
@@ -778,12 +1391,12 @@ RevInst RevProc::DecodeCAInst(uint16_t Inst, unsigned Entry){
   RevInst CompInst;
 
   // cost
-  RegFile->cost  = InstTable[Entry].cost;
+  RegFile->cost  = Tables->InstTable[Entry].cost;
 
   // encodings
-  CompInst.opcode  = InstTable[Entry].opcode;
-  CompInst.funct2  = InstTable[Entry].funct2;
-  CompInst.funct6  = InstTable[Entry].funct6;
+  CompInst.opcode  = Tables->InstTable[Entry].opcode;
+  CompInst.funct2  = Tables->InstTable[Entry].funct2;
+  CompInst.funct6  = Tables->InstTable[Entry].funct6;
 
   // registers
   CompInst.rs2     = ((Inst & 0b11100) >> 2);
@@ -800,11 +1413,11 @@ RevInst RevProc::DecodeCBInst(uint16_t Inst, unsigned Entry){
   RevInst CompInst;
 
   // cost
-  RegFile->cost  = InstTable[Entry].cost;
+  RegFile->cost  = Tables->InstTable[Entry].cost;
 
   // encodings
-  CompInst.opcode  = InstTable[Entry].opcode;
-  CompInst.funct3  = InstTable[Entry].funct3;
+  CompInst.opcode  = Tables->InstTable[Entry].opcode;
+  CompInst.funct3  = Tables->InstTable[Entry].funct3;
 
   // registers
   CompInst.rs1     = ((Inst & 0b1110000000) >> 7);
@@ -859,11 +1472,11 @@ RevInst RevProc::DecodeCJInst(uint16_t Inst, unsigned Entry){
   RevInst CompInst;
 
   // cost
-  RegFile->cost  = InstTable[Entry].cost;
+  RegFile->cost  = Tables->InstTable[Entry].cost;
 
   // encodings
-  CompInst.opcode  = InstTable[Entry].opcode;
-  CompInst.funct3  = InstTable[Entry].funct3;
+  CompInst.opcode  = Tables->InstTable[Entry].opcode;
+  CompInst.funct3  = Tables->InstTable[Entry].funct3;
 
   // registers
   uint16_t offset = ((Inst & 0b1111111111100) >> 2);
@@ -892,8 +1505,7 @@ RevInst RevProc::DecodeCJInst(uint16_t Inst, unsigned Entry){
   return CompInst;
 }
 
-RevInst RevProc::DecodeCompressed(uint32_t Inst){
-  uint16_t TmpInst = (uint16_t)(Inst&0b1111111111111111);
+bool RevProc::LookupCEntry(uint16_t Inst, unsigned &Entry){
   uint8_t opc     = 0;
   uint8_t funct2  = 0;
   uint8_t funct3  = 0;
@@ -901,21 +1513,10 @@ RevInst RevProc::DecodeCompressed(uint32_t Inst){
   uint8_t funct6  = 0;
   uint8_t l3      = 0;
   uint32_t Enc    = 0x00ul;
-  uint64_t PC     = GetPC();
-  RevInst TInst;
-
-  if( !feature->HasCompressed() ){
-    output->fatal(CALL_INFO, -1,
-                  "Error: failed to decode instruction at PC=0x%" PRIx64 "; Compressed instructions not enabled!\n",
-                  PC);
-
-  }
-
-  ResetInst(&TInst);
 
   // decode the opcode
-  opc = (TmpInst & 0b11);
-  l3  = ((TmpInst & 0b1110000000000000)>>13);
+  opc = (Inst & 0b11);
+  l3  = ((Inst & 0b1110000000000000)>>13);
   if( opc == 0b00 ){
     // quadrant 0
     funct3 = l3;
@@ -926,10 +1527,10 @@ RevInst RevProc::DecodeCompressed(uint32_t Inst){
       funct3 = l3;
     }else if( (l3 > 0b011) && (l3 < 0b101) ){
       // middle portion: arithmetics
-      uint8_t opSelect = ((TmpInst & 0b110000000000) >> 10);
+      uint8_t opSelect = ((Inst & 0b110000000000) >> 10);
       if( opSelect == 0b11 ){
-        funct6 = ((TmpInst & 0b1111110000000000) >> 10);
-        funct2 = ((TmpInst & 0b01100000) >> 5 );
+        funct6 = ((Inst & 0b1111110000000000) >> 10);
+        funct2 = ((Inst & 0b01100000) >> 5 );
       }else{
         funct3 = l3;
         funct2 = opSelect;
@@ -948,7 +1549,7 @@ RevInst RevProc::DecodeCompressed(uint32_t Inst){
       funct3 = l3;
     }else if( l3 == 0b100 ){
       // jump, mv, break, add
-      funct4 = ((TmpInst & 0b1111000000000000) >> 12);
+      funct4 = ((Inst & 0b1111000000000000) >> 12);
     }else{
       // float/double/quad store
       funct3 = l3;
@@ -961,28 +1562,41 @@ RevInst RevProc::DecodeCompressed(uint32_t Inst){
   Enc |= (uint32_t)(funct4 << 8);
   Enc |= (uint32_t)(funct6 << 12);
 
-  std::map<uint32_t,unsigned>::iterator it = CEncToEntry.find(Enc);
-  if( it == CEncToEntry.end() ){
-    output->fatal(CALL_INFO, -1,
-                  "Error: failed to decode instruction at PC=0x%" PRIx64 "; Enc=%d\n opc=%x; funct2=%x, funct3=%x, funct4=%x, funct6=%x\n",
-                  PC,
-                  Enc, opc, funct2, funct3, funct4, funct6 );
+  std::map<uint32_t,unsigned>::const_iterator it = Tables->CEncToEntry.find(Enc);
+  if( it == Tables->CEncToEntry.end() ){
+    return false;
   }
 
-  unsigned Entry = it->second;
-  if( Entry > (InstTable.size()-1) ){
+  Entry = it->second;
+  return (Entry < Tables->InstTable.size());
+}
+
+RevInst RevProc::DecodeCompressed(uint32_t Inst){
+  uint16_t TmpInst = (uint16_t)(Inst&0b1111111111111111);
+  uint64_t PC     = GetPC();
+  RevInst TInst;
+
+  if( !feature->HasCompressed() ){
     output->fatal(CALL_INFO, -1,
-                  "Error: no entry in table for instruction at PC=0x%" PRIx64 "\
-                  Opcode = %x Funct2 = %x Funct3 = %x Funct4 = %x Funct6 = %x Enc = %x \n", \
-                  PC, opc, funct2, funct3, funct4, funct6, Enc );
+                  "Error: failed to decode instruction at PC=0x%" PRIx64 "; Compressed instructions not enabled!\n",
+                  PC);
+
+  }
+
+  ResetInst(&TInst);
 
+  unsigned Entry = 0;
+  if( !LookupCEntry(TmpInst, Entry) ){
+    output->fatal(CALL_INFO, -1,
+                  "Error: failed to decode instruction at PC=0x%" PRIx64 "; Inst=0x%" PRIx32 "\n",
+                  PC, (uint32_t)(TmpInst) );
   }
 
   RegFile->Entry = Entry;
 
   RegFile->trigger = false;
 
-  switch( InstTable[Entry].format ){
+  switch( Tables->InstTable[Entry].format ){
   case RVCTypeCR:
     return DecodeCRInst(TmpInst,Entry);
     break;
@@ -1025,13 +1639,13 @@ RevInst RevProc::DecodeRInst(uint32_t Inst, unsigned Entry){
   RevInst DInst;
 
   // cost
-  RegFile->cost  = InstTable[Entry].cost;
+  RegFile->cost  = Tables->InstTable[Entry].cost;
 
   // encodings
-  DInst.opcode  = InstTable[Entry].opcode;
-  DInst.funct3  = InstTable[Entry].funct3;
+  DInst.opcode  = Tables->InstTable[Entry].opcode;
+  DInst.funct3  = Tables->InstTable[Entry].funct3;
   DInst.funct2  = 0x0;
-  DInst.funct7  = InstTable[Entry].funct7;
+  DInst.funct7  = Tables->InstTable[Entry].funct7;
 
   // registers
   DInst.rd      = 0x0;
@@ -1039,18 +1653,18 @@ RevInst RevProc::DecodeRInst(uint32_t Inst, unsigned Entry){
   DInst.rs2     = 0x0;
   DInst.rs3     = 0x0;
 
-  if( InstTable[Entry].rdClass != RegUNKNOWN ){
+  if( Tables->InstTable[Entry].rdClass != RegUNKNOWN ){
     DInst.rd  = DECODE_RD(Inst);
   }
-  if( InstTable[Entry].rs1Class != RegUNKNOWN ){
+  if( Tables->InstTable[Entry].rs1Class != RegUNKNOWN ){
     DInst.rs1  = DECODE_RS1(Inst);
   }
-  if( InstTable[Entry].rs2Class != RegUNKNOWN ){
+  if( Tables->InstTable[Entry].rs2Class != RegUNKNOWN ){
     DInst.rs2  = DECODE_RS2(Inst);
   }
 
   // imm
-  if( (InstTable[Entry].imm == FImm) && (InstTable[Entry].rs2Class == RegUNKNOWN)){
+  if( (Tables->InstTable[Entry].imm == FImm) && (Tables->InstTable[Entry].rs2Class == RegUNKNOWN)){
     DInst.imm  = DECODE_IMM12(Inst) & 0b011111; 
   }else{
     DInst.imm     = 0x0;
@@ -1083,11 +1697,11 @@ RevInst RevProc::DecodeIInst(uint32_t Inst, unsigned Entry){
   RevInst DInst;
 
   // cost
-  RegFile->cost  = InstTable[Entry].cost;
+  RegFile->cost  = Tables->InstTable[Entry].cost;
 
   // encodings
-  DInst.opcode  = InstTable[Entry].opcode;
-  DInst.funct3  = InstTable[Entry].funct3;
+  DInst.opcode  = Tables->InstTable[Entry].opcode;
+  DInst.funct3  = Tables->InstTable[Entry].funct3;
   DInst.funct2  = 0x0;
   DInst.funct7  = 0x0;
 
@@ -1097,10 +1711,10 @@ RevInst RevProc::DecodeIInst(uint32_t Inst, unsigned Entry){
   DInst.rs2     = 0x0;
   DInst.rs3     = 0x0;
 
-  if( InstTable[Entry].rdClass != RegUNKNOWN ){
+  if( Tables->InstTable[Entry].rdClass != RegUNKNOWN ){
     DInst.rd  = DECODE_RD(Inst);
   }
-  if( InstTable[Entry].rs1Class != RegUNKNOWN ){
+  if( Tables->InstTable[Entry].rs1Class != RegUNKNOWN ){
     DInst.rs1  = DECODE_RS1(Inst);
   }
 
@@ -1127,11 +1741,11 @@ RevInst RevProc::DecodeSInst(uint32_t Inst, unsigned Entry){
   RevInst DInst;
 
   // cost
-  RegFile->cost  = InstTable[Entry].cost;
+  RegFile->cost  = Tables->InstTable[Entry].cost;
 
   // encodings
-  DInst.opcode  = InstTable[Entry].opcode;
-  DInst.funct3  = InstTable[Entry].funct3;
+  DInst.opcode  = Tables->InstTable[Entry].opcode;
+  DInst.funct3  = Tables->InstTable[Entry].funct3;
   DInst.funct2  = 0x0;
   DInst.funct7  = 0x0;
 
@@ -1141,10 +1755,10 @@ RevInst RevProc::DecodeSInst(uint32_t Inst, unsigned Entry){
   DInst.rs2     = 0x0;
   DInst.rs3     = 0x0;
 
-  if( InstTable[Entry].rs1Class != RegUNKNOWN ){
+  if( Tables->InstTable[Entry].rs1Class != RegUNKNOWN ){
     DInst.rs1  = DECODE_RS1(Inst);
   }
-  if( InstTable[Entry].rs2Class != RegUNKNOWN ){
+  if( Tables->InstTable[Entry].rs2Class != RegUNKNOWN ){
     DInst.rs2  = DECODE_RS2(Inst);
   }
 
@@ -1171,10 +1785,10 @@ RevInst RevProc::DecodeUInst(uint32_t Inst, unsigned Entry){
   RevInst DInst;
 
   // cost
-  RegFile->cost  = InstTable[Entry].cost;
+  RegFile->cost  = Tables->InstTable[Entry].cost;
 
   // encodings
-  DInst.opcode  = InstTable[Entry].opcode;
+  DInst.opcode  = Tables->InstTable[Entry].opcode;
   DInst.funct3  = 0x0;
   DInst.funct2  = 0x0;
   DInst.funct7  = 0x0;
@@ -1185,7 +1799,7 @@ RevInst RevProc::DecodeUInst(uint32_t Inst, unsigned Entry){
   DInst.rs2     = 0x0;
   DInst.rs3     = 0x0;
 
-  if( InstTable[Entry].rdClass != RegUNKNOWN ){
+  if( Tables->InstTable[Entry].rdClass != RegUNKNOWN ){
     DInst.rd  = DECODE_RD(Inst);
   }
 
@@ -1207,11 +1821,11 @@ RevInst RevProc::DecodeBInst(uint32_t Inst, unsigned Entry){
   RevInst DInst;
 
   // cost
-  RegFile->cost  = InstTable[Entry].cost;
+  RegFile->cost  = Tables->InstTable[Entry].cost;
 
   // encodings
-  DInst.opcode  = InstTable[Entry].opcode;
-  DInst.funct3  = InstTable[Entry].funct3;
+  DInst.opcode  = Tables->InstTable[Entry].opcode;
+  DInst.funct3  = Tables->InstTable[Entry].funct3;
   DInst.funct2  = 0x0;
   DInst.funct7  = 0x0;
 
@@ -1221,10 +1835,10 @@ RevInst RevProc::DecodeBInst(uint32_t Inst, unsigned Entry){
   DInst.rs2     = 0x0;
   DInst.rs3     = 0x0;
 
-  if( InstTable[Entry].rs1Class != RegUNKNOWN ){
+  if( Tables->InstTable[Entry].rs1Class != RegUNKNOWN ){
     DInst.rs1  = DECODE_RS1(Inst);
   }
-  if( InstTable[Entry].rs2Class != RegUNKNOWN ){
+  if( Tables->InstTable[Entry].rs2Class != RegUNKNOWN ){
     DInst.rs2  = DECODE_RS2(Inst);
   }
 
@@ -1249,11 +1863,11 @@ RevInst RevProc::DecodeJInst(uint32_t Inst, unsigned Entry){
   RevInst DInst;
 
   // cost
-  RegFile->cost  = InstTable[Entry].cost;
+  RegFile->cost  = Tables->InstTable[Entry].cost;
 
   // encodings
-  DInst.opcode  = InstTable[Entry].opcode;
-  DInst.funct3  = InstTable[Entry].funct3;
+  DInst.opcode  = Tables->InstTable[Entry].opcode;
+  DInst.funct3  = Tables->InstTable[Entry].funct3;
   DInst.funct2  = 0x0;
   DInst.funct7  = 0x0;
 
@@ -1263,7 +1877,7 @@ RevInst RevProc::DecodeJInst(uint32_t Inst, unsigned Entry){
   DInst.rs2     = 0x0;
   DInst.rs3     = 0x0;
 
-  if( InstTable[Entry].rdClass != RegUNKNOWN ){
+  if( Tables->InstTable[Entry].rdClass != RegUNKNOWN ){
     DInst.rd  = DECODE_RD(Inst);
   }
 
@@ -1289,13 +1903,13 @@ RevInst RevProc::DecodeR4Inst(uint32_t Inst, unsigned Entry){
   RevInst DInst;
 
   // cost
-  RegFile->cost  = InstTable[Entry].cost;
+  RegFile->cost  = Tables->InstTable[Entry].cost;
 
   // encodings
-  DInst.opcode  = InstTable[Entry].opcode;
-  DInst.funct3  = InstTable[Entry].funct3;
+  DInst.opcode  = Tables->InstTable[Entry].opcode;
+  DInst.funct3  = Tables->InstTable[Entry].funct3;
   DInst.funct2  = DECODE_FUNCT2(Inst);
-  DInst.funct7  = InstTable[Entry].funct7;
+  DInst.funct7  = Tables->InstTable[Entry].funct7;
 
   // registers
   DInst.rd      = 0x0;
@@ -1303,16 +1917,16 @@ RevInst RevProc::DecodeR4Inst(uint32_t Inst, unsigned Entry){
   DInst.rs2     = 0x0;
   DInst.rs3     = 0x0;
 
-  if( InstTable[Entry].rdClass != RegUNKNOWN ){
+  if( Tables->InstTable[Entry].rdClass != RegUNKNOWN ){
     DInst.rd  = DECODE_RD(Inst);
   }
-  if( InstTable[Entry].rs1Class != RegUNKNOWN ){
+  if( Tables->InstTable[Entry].rs1Class != RegUNKNOWN ){
     DInst.rs1  = DECODE_RS1(Inst);
   }
-  if( InstTable[Entry].rs2Class != RegUNKNOWN ){
+  if( Tables->InstTable[Entry].rs2Class != RegUNKNOWN ){
     DInst.rs2  = DECODE_RS2(Inst);
   }
-  if( InstTable[Entry].rs3Class != RegUNKNOWN ){
+  if( Tables->InstTable[Entry].rs3Class != RegUNKNOWN ){
     DInst.rs3  = DECODE_RS3(Inst);
   }
 
@@ -1362,6 +1976,19 @@ bool RevProc::DebugWriteReg(unsigned Idx, uint64_t Value){
   }
 }
 
+bool RevProc::DebugDecode(uint64_t PC, RevInst &Inst){
+  if( feature->GetXlen() == 32 ){
+    RegFile->RV32_PC = (uint32_t)(PC);
+  }else{
+    RegFile->RV64_PC = PC;
+  }
+  if( !PrefetchInst() ){
+    return false;
+  }
+  Inst = DecodeInst();
+  return (Inst.entry != _REV_INVALID_ENTRY_);
+}
+
 uint64_t RevProc::GetPC(){
   if( feature->GetXlen() == 32 ){
     return (uint64_t)(RegFile->RV32_PC);
@@ -1393,30 +2020,20 @@ bool RevProc::PrefetchInst(){
     return false;
   }
 
-  return sfetch->IsAvail(PC);
+  return sfetch->IsAvail(PC, fetchWord);
 }
 
 RevInst RevProc::DecodeInst(){
-  uint32_t Enc  = 0x00ul;
-  uint32_t Inst = 0x00ul;
   uint64_t PC   = 0x00ull;
-  bool Fetched  = false;
-  RevInst TInst;
-
-  ResetInst(&TInst);
 
-  // Stage 1: Retrieve the instruction
+  // Stage 1: Retrieve the instruction; PrefetchInst returned
+  // it from the stream buffers this cycle
   if( feature->GetXlen() == 32 ){
     PC = (uint64_t)(RegFile->RV32_PC);
   }else{
     PC = RegFile->RV64_PC;
   }
-
-  if( !sfetch->InstFetch(PC, Fetched, Inst) ){
-    output->fatal(CALL_INFO, -1,
-                  "Error: failed to retrieve prefetched instruction at PC=0x%" PRIx64 "\n",
-                  PC);
-  }
+  uint32_t Inst = fetchWord;
 
 #if 0
   if( !mem->ReadMem( PC, 4, (void *)(&Inst)) ){
@@ -1453,11 +2070,43 @@ RevInst RevProc::DecodeInst(){
   // If we find a compressed instruction, then take
   // the compressed decode path
   if( (Opcode&0b11) != 0b11 ){
-    // this is a compressed instruction
+    // this is a compressed instruction; use the pre-expanded
+    // equivalent when one exists
+    if( !Tables->CDecodeTable.empty() ){
+      const RevInst &CInst = Tables->CDecodeTable[Inst & 0xFFFF];
+      if( CInst.entry != _REV_INVALID_ENTRY_ ){
+        RegFile->cost    = CInst.cost;
+        RegFile->Entry   = CInst.entry;
+        RegFile->trigger = false;
+        return CInst;
+      }
+    }
     return DecodeCompressed(Inst);
   }
 
-  // Stage 3: Determine if we have a funct3 field
+  // Stage 3: Look up the value in the table
+  unsigned Entry = 0;
+  if( !LookupEntry(Inst, Entry) ){
+    // failed to decode the instruction
+    output->fatal(CALL_INFO, -1,
+                  "Error: failed to decode instruction at PC=0x%" PRIx64 "; Inst=0x%" PRIx32 "\n",
+                  PC,
+                  Inst );
+  }
+
+  RegFile->Entry = Entry;
+
+  RegFile->trigger = false;
+
+  // Stage 4: Do a full deocode using the target format
+  return DecodeStdInst(Inst,Entry);
+}
+
+bool RevProc::LookupEntry(uint32_t Inst, unsigned &Entry){
+  uint32_t Enc  = 0x00ul;
+  const uint32_t Opcode = (uint32_t)(Inst&0b1111111);
+
+  // Stage 1: Determine if we have a funct3 field
   uint32_t Funct3 = 0x00ul;
   const uint32_t inst42 = ((Opcode&0b11100) >> 2);
   const uint32_t inst65 = ((Opcode&0b1100000) >> 5);
@@ -1476,7 +2125,7 @@ RevInst RevProc::DecodeInst(){
     Funct3 = ((Inst&0b111000000000000) >> 12 );
   }
 
-  // Stage 4: Determine if we have a funct7 field (R-Type and some specific I-Type)
+  // Stage 2: Determine if we have a funct7 field (R-Type and some specific I-Type)
   uint32_t Funct7 = 0x00ul;
   if( inst65 == 0b01 ) {
     if( (inst42 == 0b011) || (inst42 == 0b100) || (inst42 == 0b110) ){
@@ -1490,6 +2139,9 @@ RevInst RevProc::DecodeInst(){
   }else if((inst65== 0b10) && (inst42 == 0b100)){
       // R-Type encodings
       Funct7 = ((Inst >> 25) & 0b1111111);
+  }else if((inst65== 0b10) && (inst42 < 0b100)){
+      // R4-Type encodings: the fmt field selects single or double precision
+      Funct7 = ((Inst >> 25) & 0b11);
   }else if((inst65 == 0b00) && (inst42 == 0b110) && (Funct3 != 0)){
       // R-Type encodings
       Funct7 = ((Inst >> 25) & 0b1111111);
@@ -1500,27 +2152,27 @@ RevInst RevProc::DecodeInst(){
 
   uint32_t fcvtOp = 0;
   //Special encodings for FCVT instructions
-  if( (0b1010011 == Opcode) && ((0b1100000 == Funct7) || (0b1101000 == Funct7)) ){
+  if( (0b1010011 == Opcode) && ((0b1100000 == (Funct7 & 0b1111110)) || (0b1101000 == (Funct7 & 0b1111110))) ){
       fcvtOp =  DECODE_RS2(Inst);
   }
 
-  // Stage 5: Determine if we have an imm12 field
+  // Stage 3: Determine if we have an imm12 field
   uint32_t Imm12 = 0x00ul;
   if( (inst42 == 0b100) && (inst65 == 0b11)  && (Funct3 == 0)){
     Imm12 = ((Inst >> 19) & 0b111111111111);
   }
 
-  // Stage 6: Compress the encoding
+  // Stage 4: Compress the encoding
   Enc |= Opcode;
   Enc |= (Funct3<<8);
   Enc |= (Funct7<<11);
   Enc |= (Imm12<<18);
   Enc |= (fcvtOp<<30);
 
-  // Stage 7: Look up the value in the table
-  std::map<uint32_t,unsigned>::iterator it;
-  it = EncToEntry.find(Enc);
-   if( it == EncToEntry.end() && ((Funct3 == 7) || (Funct3==1)) && (inst65 == 0b10)){
+  // Stage 5: Look up the value in the table
+  std::map<uint32_t,unsigned>::const_iterator it;
+  it = Tables->EncToEntry.find(Enc);
+  if( it == Tables->EncToEntry.end() && ((Funct3 == 7) || (Funct3==1)) && (inst65 == 0b10)){
     //This is kind of a hack, but we may not have found the instruction becasue
     //  Funct3 is overloaded with rounding mode, so if this is a RV32F or RV64F
     //  set Funct3 to zero and check again
@@ -1529,33 +2181,23 @@ RevInst RevProc::DecodeInst(){
     Enc |= (Funct7<<11);
     Enc |= (Imm12<<18);
     Enc |= (fcvtOp<<30);
-    it = EncToEntry.find(Enc);
-    if( it == EncToEntry.end() ){
-      // failed to decode the instruction
-      output->fatal(CALL_INFO, -1,
-                  "Error: failed to decode instruction at PC=0x%" PRIx64 "; Enc=%d\n",
-                  PC,
-                  Enc );
-    }
-
+    it = Tables->EncToEntry.find(Enc);
   }
 
-  unsigned Entry = it->second;
-
-  if( Entry > (InstTable.size()-1) ){
-    output->fatal(CALL_INFO, -1,
-                  "Error: no entry in table for instruction at PC=0x%" PRIx64 " \
-                  Opcode = %x Funct3 = %x Funct7 = %x Imm12 = %x Enc = %x \n", \
-                  PC, Opcode, Funct3, Funct7, Imm12, Enc );
-
+  if( it == Tables->EncToEntry.end() ){
+    return false;
   }
 
-  RegFile->Entry = Entry;
+  Entry = it->second;
+  return (Entry < Tables->InstTable.size());
+}
 
-  RegFile->trigger = false;
+RevInst RevProc::DecodeStdInst(uint32_t Inst, unsigned Entry){
+  RevInst TInst;
 
-  // Stage 8: Do a full deocode using the target format
-  switch( InstTable[Entry].format ){
+  ResetInst(&TInst);
+
+  switch( Tables->InstTable[Entry].format ){
   case RVTypeR:
     return DecodeRInst(Inst,Entry);
     break;
@@ -1579,7 +2221,7 @@ RevInst RevProc::DecodeInst(){
     break;
   default:
     output->fatal(CALL_INFO, -1,
-                  "Error: failed to decode instruction format at PC=%" PRIx64 ".", PC );
+                  "Error: failed to decode instruction format at PC=%" PRIx64 ".", GetPC() );
     break;
   }
 
@@ -1764,6 +2406,321 @@ void RevProc::DependencyClear(uint16_t HartID, RevInst* Inst){
     }
 }
 
+RevBranchPred::CFType RevProc::GetCFType(RevInst *Inst){
+  bool Link = false;
+
+  switch( Tables->InstTable[Inst->entry].format ){
+  case RVTypeB:
+    return RevBranchPred::CFBranch;
+    break;
+  case RVTypeJ:
+    // jal: a link through x1/x5 is a call
+    Link = ((Inst->rd == 1) || (Inst->rd == 5));
+    return Link ? RevBranchPred::CFCall : RevBranchPred::CFJump;
+    break;
+  case RVTypeI:
+    if( Inst->opcode != 0b1100111 )
+      return RevBranchPred::CFNone;
+    // jalr
+    Link = ((Inst->rd == 1) || (Inst->rd == 5));
+    if( Link )
+      return RevBranchPred::CFCall;
+    if( (Inst->rd == 0) && ((Inst->rs1 == 1) || (Inst->rs1 == 5)) )
+      return RevBranchPred::CFReturn;
+    return RevBranchPred::CFIndirect;
+    break;
+  case RVCTypeCB:
+    // c.beqz, c.bnez
+    if( (Inst->opcode == 0b01) && (Inst->funct3 >= 0b110) )
+      return RevBranchPred::CFBranch;
+    break;
+  case RVCTypeCJ:
+    // c.jal (rv32) vs c.j
+    if( Inst->funct3 == 0b001 )
+      return RevBranchPred::CFCall;
+    return RevBranchPred::CFJump;
+    break;
+  case RVCTypeCR:
+    // c.jr, c.jalr; c.mv and c.add carry a non-zero rs2
+    if( (Inst->opcode != 0b10) || (Inst->rs2 != 0) || (Inst->rs1 == 0) )
+      return RevBranchPred::CFNone;
+    if( Inst->funct4 == 0b1001 )
+      return RevBranchPred::CFCall;
+    if( Inst->funct4 == 0b1000 ){
+      if( (Inst->rs1 == 1) || (Inst->rs1 == 5) )
+        return RevBranchPred::CFReturn;
+      return RevBranchPred::CFIndirect;
+    }
+    break;
+  default:
+    break;
+  }
+  return RevBranchPred::CFNone;
+}
+
+uint64_t RevProc::GetCFTarget(uint64_t PC, RevInst *Inst){
+  uint64_t Off = 0x00ull;
+
+  switch( Tables->InstTable[Inst->entry].format ){
+  case RVTypeB:
+    SEXT64(Off, (uint64_t)(Inst->imm), 13);
+    break;
+  case RVTypeJ:
+    SEXT64(Off, (uint64_t)(Inst->imm), 21);
+    break;
+  case RVCTypeCB:
+    SEXT64(Off, (uint64_t)(Inst->offset), 9);
+    break;
+  case RVCTypeCJ:
+    SEXT64(Off, (uint64_t)(Inst->jumpTarget), 12);
+    break;
+  default:
+    // indirect targets are not known until execution
+    return PC + Inst->instSize;
+    break;
+  }
+  return PC + Off;
+}
+
+void RevProc::ResolveBranch(uint64_t PC, RevInst *Inst){
+  RevBranchPred::CFType Kind = GetCFType(Inst);
+  if( Kind == RevBranchPred::CFNone )
+    return ;
+
+  uint64_t Fallthrough = PC + Inst->instSize;
+  uint64_t Pred = bpred->Predict(PC, Kind, Fallthrough, GetCFTarget(PC, Inst));
+  uint64_t Actual = GetPC();
+
+  Stats.branchesExec++;
+  if( !bpred->Update(PC, Kind, Fallthrough, Pred, Actual) ){
+    // the frontend fetched down the wrong path; stall retirement
+    // for the redirect before the next fetch can be issued
+    output->verbose(CALL_INFO, 7, 0,
+                    "Core %d ; Mispredicted PC= 0x%" PRIx64 "; Pred= 0x%" PRIx64 "; Actual= 0x%" PRIx64 "\n",
+                    id, PC, Pred, Actual);
+    Stats.branchMispredicts++;
+    Stats.cyclesRedirect += branchPenalty;
+    Inst->cost += branchPenalty;
+  }
+}
+
+bool RevProc::IsFuseHead(RevInst *Inst){
+  if( Inst->rd == 0 )
+    return false;
+
+  switch( Inst->opcode ){
+  case 0b0110111:   // lui
+  case 0b0010111:   // auipc
+    return true;
+    break;
+  case 0b0010011:   // slli, slti, sltiu
+    return ( (Inst->funct3 == 0b001) ||
+             (Inst->funct3 == 0b010) ||
+             (Inst->funct3 == 0b011) );
+    break;
+  case 0b0110011:   // slt, sltu
+    return ( (Inst->funct7 == 0b0000000) &&
+             ((Inst->funct3 == 0b010) || (Inst->funct3 == 0b011)) );
+    break;
+  default:
+    break;
+  }
+  return false;
+}
+
+bool RevProc::IsFuseTail(RevInst *Head, RevInst *Tail){
+  switch( Head->opcode ){
+  case 0b0110111:
+    // lui+addi(w): 32bit constant materialization
+    return ( ((Tail->opcode == 0b0010011) || (Tail->opcode == 0b0011011)) &&
+             (Tail->funct3 == 0b000) &&
+             (Tail->rs1 == Head->rd) && (Tail->rd == Head->rd) );
+    break;
+  case 0b0010111:
+    // auipc+jalr: far call or jump
+    if( Tail->opcode == 0b1100111 ){
+      return ( (Tail->rs1 == Head->rd) &&
+               ((Tail->rd == Head->rd) || (Tail->rd == 0)) );
+    }
+    // auipc+ld: pc relative load
+    return ( (Tail->opcode == 0b0000011) &&
+             (Tail->rs1 == Head->rd) && (Tail->rd == Head->rd) );
+    break;
+  case 0b0010011:
+    if( Head->funct3 == 0b001 ){
+      // slli+srli: zero extension
+      return ( (Tail->opcode == 0b0010011) && (Tail->funct3 == 0b101) &&
+               ((Tail->imm & 0x400) == 0) &&
+               (Tail->rs1 == Head->rd) && (Tail->rd == Head->rd) );
+    }
+    break;
+  case 0b0110011:
+    break;
+  default:
+    return false;
+    break;
+  }
+
+  // slt(i)(u)+beqz/bnez: compare and branch
+  if( (Tail->opcode != 0b1100011) || (Tail->funct3 > 0b001) )
+    return false;
+  return ( ((Tail->rs1 == Head->rd) && (Tail->rs2 == 0)) ||
+           ((Tail->rs1 == 0) && (Tail->rs2 == Head->rd)) );
+}
+
+bool RevProc::DecodeFuseTail(RevInst *Head){
+  if( !IsFuseHead(Head) )
+    return false;
+
+  // the tail is the sequential successor; pair it only if the stream
+  // buffers already hold it so fusion never misses or stalls fetch
+  uint64_t PC = GetPC() + Head->instSize;
+  uint32_t Raw = 0;
+  if( !sfetch->IsResident(PC, Raw) )
+    return false;
+
+  RevInst Tail;
+  if( (Raw & 0b11) != 0b11 ){
+    if( Tables->CDecodeTable.empty() )
+      return false;
+    Tail = Tables->CDecodeTable[Raw & 0xFFFF];
+    if( Tail.entry == _REV_INVALID_ENTRY_ )
+      return false;
+  }else{
+    // only decode the opcodes that can complete a pair
+    switch( Raw & 0b1111111 ){
+    case 0b0010011:
+    case 0b0011011:
+    case 0b0000011:
+    case 0b1100111:
+    case 0b1100011:
+      break;
+    default:
+      return false;
+      break;
+    }
+    unsigned Entry = 0;
+    if( !LookupEntry(Raw, Entry) )
+      return false;
+    uint32_t SavedCost = RegFile->cost;
+    Tail = DecodeStdInst(Raw, Entry);
+    Tail.cost  = RegFile->cost;
+    Tail.entry = Entry;
+    RegFile->cost = SavedCost;
+  }
+
+  if( !IsFuseTail(Head, &Tail) )
+    return false;
+
+  // the pair forms; the tail is fetched like any other instruction
+  sfetch->IsAvail(PC, Raw);
+  Tail.encoding = Raw;
+  FuseTail = Tail;
+  return true;
+}
+
+bool RevProc::FuseInst(RevInst *Head){
+  if( !FuseValid )
+    return false;
+  FuseValid = false;
+
+  // the head never redirects, but only a sequential successor may retire with it
+  uint64_t PC = GetPC();
+  if( PC != (ExecPC + Head->instSize) )
+    return false;
+
+  std::map<unsigned,std::pair<unsigned,unsigned>>::const_iterator it;
+  it = Tables->EntryToExt.find(FuseTail.entry);
+  if( it == Tables->EntryToExt.end() )
+    return false;
+
+  RevExt *Ext = Extensions[it->second.first];
+  Ext->SetRegFile(RegFile);
+  uint32_t SavedCost = RegFile->cost;
+  uint32_t TailCost = FuseTail.cost;
+  if( !ExecInst(Ext, it->second.second, &FuseTail, PC) ){
+    output->fatal(CALL_INFO, -1,
+                  "Error: failed to execute fused instruction at PC=%" PRIx64 ".", PC );
+  }
+
+  // the tail retires with the head; the memory latency its execution
+  // added and its redirect penalty are charged to the pair under
+  // either policy
+  uint32_t Extra = (RegFile->cost - SavedCost) + (FuseTail.cost - TailCost);
+  if( fusion == FuseTwo ){
+    Head->cost += TailCost;
+  }else if( TailCost > Head->cost ){
+    Head->cost = TailCost;
+  }
+  Head->cost += Extra;
+
+  // the tail destination stays busy until the pair retires
+  DependencySet(HartToExec, &FuseTail);
+  Head->fuseRd = FuseTail.rd;
+
+  output->verbose(CALL_INFO, 6, 0,
+                  "Core %d ; Thread %d; Fused PC= 0x%" PRIx64 " with PC= 0x%" PRIx64 "\n",
+                  id, HartToExec, ExecPC, PC);
+  Stats.fusedPairs++;
+  Retired++;
+  RetireInst(FuseTail.entry);
+  return true;
+}
+
+bool RevProc::ExecInst(RevExt *Ext, unsigned Idx, RevInst *Inst, uint64_t PC){
+  if( tracer ){
+    mem->ClearLastAccess();
+  }
+  if( mem->IsMemTraced() ){
+    mem->SetTraceCtx(id, HartToExec, PC, Stats.totalCycles,
+                     Tables->EntryClass[Inst->entry] == InstAMO);
+  }
+  mem->SetPendingCtx(&GetRegFile(HartToExec)->pending);
+  if( jit ){
+    jit->Enter(HartToExec, PC, GetRegFile(HartToExec));
+  }
+  if( hostProf ){
+    hostProf->Enter(RevHostProf::HostExecute);
+  }
+  bool rtn = Ext->Execute(Idx, *Inst, HartToExec);
+  if( hostProf ){
+    hostProf->Leave();
+  }
+  mem->ClearPendingCtx();
+  mem->ClearTraceCtx();
+  if( !rtn )
+    return false;
+
+  if( tracer ){
+    TraceInst(PC, Inst);
+  }
+
+  // the interpreter result is the reference for the translated block
+  if( jit ){
+    jit->Retire(HartToExec, PC, Inst->instSize, GetRegFile(HartToExec));
+  }
+
+  // attribute the instruction to its function and call stack
+  if( profiler ){
+    profiler->Exec(HartToExec, PC, GetCFType(Inst));
+  }
+
+  // fence.i orders prior stores ahead of subsequent fetches;
+  // drop the instructions already held in the stream buffers
+  if( (Inst->opcode == 0b0001111) && (Inst->funct3 == 0b001) ){
+    sfetch->Invalidate();
+    if( jit ){
+      jit->Invalidate();
+    }
+  }
+
+  // check the fetch redirect against the branch predictor
+  if( bpred ){
+    ResolveBranch(PC, Inst);
+  }
+  return true;
+}
+
 uint16_t RevProc::GetHartID(){
   if(HART_CTS.none()) { return HartToDecode;};
 
@@ -1787,7 +2744,11 @@ uint16_t RevProc::GetHartID(){
 
 bool RevProc::ClockTick( SST::Cycle_t currentCycle ){
   bool rtn = false;
+  bool Issued = false;
   Stats.totalCycles++;
+  if( profiler ){
+    profiler->Tick();
+  }
 
 #ifdef _REV_DEBUG_
   if((currentCycle % 100000000) == 0){
@@ -1834,7 +2795,12 @@ bool RevProc::ClockTick( SST::Cycle_t currentCycle ){
     //Determine the active thread
     HartToDecode = GetHartID();
 
-    if( !PrefetchInst() ){
+    bool Fetched = false;
+    {
+      RevHostScope HostScope(hostProf, RevHostProf::HostFetch);
+      Fetched = PrefetchInst();
+    }
+    if( !Fetched ){
       Stalled = true;
       Stats.cyclesStalled++;
     }else{
@@ -1844,9 +2810,17 @@ bool RevProc::ClockTick( SST::Cycle_t currentCycle ){
     // If the next instruction is our special bounce address
     // DO NOT decode it.  It will decode to a bogus instruction.
     // We do not want to retire this instruction until we're ready
+    FuseValid = false;
     if( (GetPC() != _PAN_FWARE_JUMP_) && (!Stalled) ){
+      RevHostScope HostScope(hostProf, RevHostProf::HostDecode);
       Inst = DecodeInst();
       Inst.entry = RegFile->Entry;
+      Inst.encoding = fetchWord;
+
+      // pair a fusible head with its already fetched successor
+      if( (fusion != FuseNone) && !SingleStep ){
+        FuseValid = DecodeFuseTail(&Inst);
+      }
     }
 
     //Now that we have decoded the instruction, check for pipeline hazards
@@ -1862,6 +2836,7 @@ bool RevProc::ClockTick( SST::Cycle_t currentCycle ){
     };
     Inst.cost = RegFile->cost;
     Inst.entry = RegFile->Entry;
+    Inst.fuseRd = 0;
     rtn = true;
     ExecPC = GetPC();
   }
@@ -1882,9 +2857,9 @@ bool RevProc::ClockTick( SST::Cycle_t currentCycle ){
     if( ExecPC != _PAN_FWARE_JUMP_ ){
 
       // Find the instruction extension
-      std::map<unsigned,std::pair<unsigned,unsigned>>::iterator it;
-      it = EntryToExt.find(RegFile->Entry);
-      if( it == EntryToExt.end() ){
+      std::map<unsigned,std::pair<unsigned,unsigned>>::const_iterator it;
+      it = Tables->EntryToExt.find(RegFile->Entry);
+      if( it == Tables->EntryToExt.end() ){
         // failed to find the extension
         output->fatal(CALL_INFO, -1,
                     "Error: failed to find the instruction extension at PC=%" PRIx64 ".", ExecPC );
@@ -1899,28 +2874,32 @@ bool RevProc::ClockTick( SST::Cycle_t currentCycle ){
 
 
       // execute the instruction
-      if( !Ext->Execute(EToE.second, Inst, HartToExec) ){
+      if( !ExecInst(Ext, EToE.second, &Inst, ExecPC) ){
         output->fatal(CALL_INFO, -1,
                     "Error: failed to execute instruction at PC=%" PRIx64 ".", ExecPC );
       }
+      Issued = true;
+
+      // execute the successor decoded with this instruction as a fused pair
+      FuseInst(&Inst);
       //#define __REV_DEEP_TRACE__
       #ifdef __REV_DEEP_TRACE__
       if(feature->IsRV32()){
-        std::cout << "RDT: Executed PC = " << std::hex << ExecPC \
-                                      << " Inst: " << std::setw(23) << InstTable[Inst.entry].mnemonic \ 
-                                      << " r" << std::dec << (uint32_t)Inst.rd  << "= " << std::hex << RegFile(HartToExec)->RV32[Inst.rd] \
-                                      << " r" << std::dec << (uint32_t)Inst.rs1 << "= " << std::hex << RegFile(HartToExec)->RV32[Inst.rs1] \
-                                      << " r" << std::dec << (uint32_t)Inst.rs2 << "= " << std::hex << RegFile(HartToExec)->RV32[Inst.rs2] \
-                                      << " imm = "                << std::hex << Inst.imm \
+        std::cout << "RDT: Executed PC = " << std::hex << ExecPC
+                                      << " Inst: " << std::setw(23) << Tables->InstTable[Inst.entry].mnemonic
+                                      << " r" << std::dec << (uint32_t)Inst.rd  << "= " << std::hex << RegFile->RV32[Inst.rd]
+                                      << " r" << std::dec << (uint32_t)Inst.rs1 << "= " << std::hex << RegFile->RV32[Inst.rs1]
+                                      << " r" << std::dec << (uint32_t)Inst.rs2 << "= " << std::hex << RegFile->RV32[Inst.rs2]
+                                      << " imm = "                << std::hex << Inst.imm
                                       << std::endl;
 
       }else{
-        std::cout << "RDT: Executed PC = " << std::hex << ExecPC \
-                                      << " Inst: " << std::setw(23) << InstTable[Inst.entry].mnemonic \ 
-                                      << " r" << std::dec << (uint32_t)Inst.rd  << "= " << std::hex << RegFile(HartToExec)->RV64[Inst.rd] \
-                                      << " r" << std::dec << (uint32_t)Inst.rs1 << "= " << std::hex << RegFile(HartToExec)->RV64[Inst.rs1] \
-                                      << " r" << std::dec << (uint32_t)Inst.rs2 << "= " << std::hex << RegFile(HartToExec)->RV64[Inst.rs2] \
-                                      << " imm = "                << std::hex << Inst.imm \
+        std::cout << "RDT: Executed PC = " << std::hex << ExecPC
+                                      << " Inst: " << std::setw(23) << Tables->InstTable[Inst.entry].mnemonic
+                                      << " r" << std::dec << (uint32_t)Inst.rd  << "= " << std::hex << RegFile->RV64[Inst.rd]
+                                      << " r" << std::dec << (uint32_t)Inst.rs1 << "= " << std::hex << RegFile->RV64[Inst.rs1]
+                                      << " r" << std::dec << (uint32_t)Inst.rs2 << "= " << std::hex << RegFile->RV64[Inst.rs2]
+                                      << " imm = "                << std::hex << Inst.imm
                                       << std::endl;
       }
       #endif
@@ -1940,7 +2919,13 @@ bool RevProc::ClockTick( SST::Cycle_t currentCycle ){
           #endif
 
           /* Execute system call on this RevProc */
-          ExecEcall(); 
+          if( hostProf ){
+            hostProf->Enter(RevHostProf::HostEcall);
+          }
+          ExecEcall();
+          if( hostProf ){
+            hostProf->Leave();
+          }
 
           #ifdef _REV_DEBUG_
           std::cout << "Hart "<< HartToExec << " returned from ecall with code: " << rc << std::endl;
@@ -2031,7 +3016,18 @@ bool RevProc::ClockTick( SST::Cycle_t currentCycle ){
     }
   }
 
-  if(!Pipeline.empty() && Pipeline.front().second.cost > 0){
+  // cycles without an issue are charged to the oldest instruction in flight
+  if( !Issued && !Pipeline.empty() &&
+      (Pipeline.front().second.entry < Tables->EntryClass.size()) ){
+    Stats.classStalls[Tables->EntryClass[Pipeline.front().second.entry]]++;
+  }
+
+  // through a memory controller a load writes rd when its response
+  // arrives; it keeps rd on the scoreboard until its hart's data is delivered
+  bool HoldLoad = !Pipeline.empty() && (Pipeline.front().second.cost == 1) &&
+                  (GetRegFile(Pipeline.front().first)->pending > 0);
+
+  if(!Pipeline.empty() && Pipeline.front().second.cost > 0 && !HoldLoad){
       Pipeline.front().second.cost--;
       if(Pipeline.front().second.cost == 0){
         uint16_t tID = Pipeline.front().first;
@@ -2040,7 +3036,13 @@ bool RevProc::ClockTick( SST::Cycle_t currentCycle ){
                       id, tID, ExecPC);
         Retired++;
         RevInst retiredInst = Pipeline.front().second;
+        RetireInst(retiredInst.entry);
         DependencyClear(tID, &retiredInst);
+        if( retiredInst.fuseRd != 0 ){
+          // fused tails are integer ops and retire with their head
+          retiredInst.rd = retiredInst.fuseRd;
+          DependencyClear(tID, &retiredInst);
+        }
         Pipeline.pop();
         GetRegFile(tID)->cost = 0;
       }
@@ -2723,6 +3725,12 @@ void RevProc::ECALL_clock_gettime(){
 /* ====================================== */
 void RevProc::ECALL_mmap(){
   output->verbose(CALL_INFO, 2, 0, "ECALL: mmap called\n"); 
+
+  // each component of a split node would hand out the same addresses
+  if( mem->IsSplitNode() )
+    output->fatal(CALL_INFO, -1,
+                  "Error: Core %d ; mmap is not supported when a node is split across components; the components do not share an allocator\n",
+                  id);
   return;
 }
 
@@ -0,0 +1,234 @@
+//
+// _RevProfiler_cc_
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+#include "../include/RevProfiler.h"
+
+using namespace SST::RevCPU;
+
+// functions larger than this keep their counters in the sparse map
+#define REVPROF_MAX_FUNC (1<<20)
+
+RevProfiler::RevProfiler(RevLoader *Loader, unsigned Harts)
+  : loader(Loader), numFuncs(0), symHint(0), cycles(0x00ull), insts(0x00ull),
+    lastCount(nullptr), lastNode(0) {
+  numFuncs = loader->GetNumSymbols();
+
+  // the final entry collects the PCs that are not covered by a symbol
+  funcs.resize(numFuncs+1);
+  for( unsigned i=0; i<funcs.size(); i++ ){
+    funcs[i].sym = nullptr;
+  }
+
+  // the root node is never charged by an instruction
+  RevProfNode Root;
+  Root.func   = numFuncs+1;
+  Root.parent = 0;
+  Root.depth  = 0;
+  Root.insts  = 0x00ull;
+  Root.cycles = 0x00ull;
+  nodes.push_back(Root);
+
+  RevProfHart H;
+  H.node      = 0;
+  H.overflow  = 0;
+  H.call      = false;
+  harts.assign(Harts, H);
+}
+
+RevProfiler::~RevProfiler(){
+}
+
+RevProfiler::RevProfCount *RevProfiler::GetCount(uint64_t PC, unsigned &Func){
+  const RevSymbol *Sym = loader->FindSymbol(PC, symHint);
+  if( !Sym ){
+    Func = numFuncs;
+    return &unknown[PC];
+  }
+
+  // FindSymbol leaves the index of the covering symbol in the hint
+  Func = symHint;
+  RevProfFunc &F = funcs[Func];
+  if( !F.sym ){
+    F.sym = Sym;
+    if( Sym->size <= REVPROF_MAX_FUNC ){
+      RevProfCount Zero = {0x00ull, 0x00ull};
+      F.pcs.assign((size_t)((Sym->size+1)>>1), Zero);
+    }
+  }
+  if( F.pcs.empty() ){
+    return &unknown[PC];
+  }
+  return &F.pcs[(size_t)((PC - Sym->start)>>1)];
+}
+
+unsigned RevProfiler::GetChild(unsigned Parent, unsigned Func){
+  std::map<unsigned,unsigned>::iterator it = nodes[Parent].children.find(Func);
+  if( it != nodes[Parent].children.end() ){
+    return it->second;
+  }
+
+  RevProfNode N;
+  N.func    = Func;
+  N.parent  = Parent;
+  N.depth   = nodes[Parent].depth+1;
+  N.insts   = 0x00ull;
+  N.cycles  = 0x00ull;
+  unsigned Idx = (unsigned)(nodes.size());
+  nodes.push_back(N);
+  nodes[Parent].children[Func] = Idx;
+  return Idx;
+}
+
+void RevProfiler::Exec(unsigned Hart, uint64_t PC, RevBranchPred::CFType Kind){
+  if( Hart >= harts.size() ){
+    return ;
+  }
+
+  RevProfHart &H = harts[Hart];
+  unsigned Func = 0;
+  RevProfCount *Count = GetCount(PC, Func);
+
+  if( H.call ){
+    // first instruction of a callee
+    H.call = false;
+    if( nodes[H.node].depth >= REVPROF_MAX_DEPTH ){
+      H.overflow++;
+    }else{
+      H.node = GetChild(H.node, Func);
+    }
+  }else if( nodes[H.node].func != Func ){
+    // tail calls, jumps between functions and unwinding replace the
+    // current frame rather than nesting beneath it
+    H.node = GetChild(nodes[H.node].parent, Func);
+  }
+
+  Count->insts++;
+  nodes[H.node].insts++;
+  insts++;
+  lastCount = Count;
+  lastNode  = H.node;
+
+  if( Kind == RevBranchPred::CFCall ){
+    H.call = true;
+  }else if( Kind == RevBranchPred::CFReturn ){
+    if( H.overflow ){
+      H.overflow--;
+    }else if( nodes[H.node].parent != 0 ){
+      H.node = nodes[H.node].parent;
+    }
+  }
+}
+
+std::string RevProfiler::FuncName(unsigned Func){
+  if( (Func < numFuncs) && funcs[Func].sym ){
+    return funcs[Func].sym->name;
+  }
+  return "[unknown]";
+}
+
+bool RevProfiler::Write(const std::string &Prefix, unsigned Core){
+  std::string Base = Prefix + ".core" + std::to_string(Core);
+
+  // -- flat profile: self counts per function from the calling context tree
+  std::vector<RevProfCount> Self(numFuncs+1, RevProfCount{0x00ull, 0x00ull});
+  for( unsigned i=1; i<nodes.size(); i++ ){
+    Self[nodes[i].func].insts   += nodes[i].insts;
+    Self[nodes[i].func].cycles  += nodes[i].cycles;
+  }
+
+  std::vector<unsigned> Order;
+  for( unsigned i=0; i<Self.size(); i++ ){
+    if( Self[i].insts || Self[i].cycles )
+      Order.push_back(i);
+  }
+  std::sort(Order.begin(), Order.end(),
+            [&Self](unsigned A, unsigned B){ return Self[A].cycles > Self[B].cycles; });
+
+  std::ofstream Flat(Base + ".prof");
+  if( !Flat.is_open() ){
+    return false;
+  }
+
+  Flat << "# core " << Core << ": " << cycles << " cycles, "
+       << insts << " instructions" << std::endl;
+  Flat << "#" << std::setw(15) << "cycles" << std::setw(9) << "%cycles"
+       << std::setw(16) << "insts" << "  function" << std::endl;
+  for( unsigned i=0; i<Order.size(); i++ ){
+    double Pct = cycles ? (100.0 * (double)(Self[Order[i]].cycles) / (double)(cycles)) : 0.0;
+    Flat << std::setw(16) << Self[Order[i]].cycles
+         << std::setw(9) << std::fixed << std::setprecision(2) << Pct
+         << std::setw(16) << Self[Order[i]].insts
+         << "  " << FuncName(Order[i]) << std::endl;
+  }
+
+  // -- hottest PCs
+  std::vector<std::pair<uint64_t,RevProfCount>> PCs;
+  for( unsigned i=0; i<numFuncs; i++ ){
+    for( unsigned j=0; j<funcs[i].pcs.size(); j++ ){
+      if( funcs[i].pcs[j].insts || funcs[i].pcs[j].cycles )
+        PCs.push_back(std::make_pair(funcs[i].sym->start + ((uint64_t)(j)<<1),
+                                     funcs[i].pcs[j]));
+    }
+  }
+  for( auto &U : unknown ){
+    PCs.push_back(U);
+  }
+  std::sort(PCs.begin(), PCs.end(),
+            [](const std::pair<uint64_t,RevProfCount> &A,
+               const std::pair<uint64_t,RevProfCount> &B){
+              return A.second.cycles > B.second.cycles;
+            });
+  if( PCs.size() > REVPROF_HOT_PCS ){
+    PCs.resize(REVPROF_HOT_PCS);
+  }
+
+  Flat << std::endl;
+  Flat << "#" << std::setw(15) << "cycles" << std::setw(16) << "insts"
+       << std::setw(20) << "pc" << "  location" << std::endl;
+  unsigned Hint = 0;
+  for( unsigned i=0; i<PCs.size(); i++ ){
+    const RevSymbol *Sym = loader->FindSymbol(PCs[i].first, Hint);
+    Flat << std::setw(16) << std::dec << PCs[i].second.cycles
+         << std::setw(16) << PCs[i].second.insts
+         << "  0x" << std::setw(16) << std::setfill('0') << std::hex
+         << PCs[i].first << std::setfill(' ') << "  ";
+    if( Sym ){
+      Flat << Sym->name << "+0x" << (PCs[i].first - Sym->start);
+    }else{
+      Flat << "[unknown]";
+    }
+    Flat << std::dec << std::endl;
+  }
+  Flat.close();
+
+  // -- folded stacks: one line per calling context weighted by cycles
+  std::ofstream Folded(Base + ".folded");
+  if( !Folded.is_open() ){
+    return false;
+  }
+  for( unsigned i=1; i<nodes.size(); i++ ){
+    if( nodes[i].cycles == 0 )
+      continue;
+    std::string Stack = FuncName(nodes[i].func);
+    for( unsigned p=nodes[i].parent; p!=0; p=nodes[p].parent ){
+      Stack = FuncName(nodes[p].func) + ";" + Stack;
+    }
+    Folded << Stack << " " << nodes[i].cycles << std::endl;
+  }
+  Folded.close();
+
+  return true;
+}
+
+// EOF
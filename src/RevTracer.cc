@@ -0,0 +1,177 @@
+//
+// _RevTracer_cc_
+//
+// Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+// All Rights Reserved
+// contact@tactcomplabs.com
+//
+// See LICENSE in the top level directory for licensing details
+//
+
+#include <cstring>
+
+#include "../include/RevTracer.h"
+
+using namespace SST::RevCPU;
+
+// -- trace file layout
+//
+// header : "REVTRC01", uint8 xlen, uint32 core (little endian)
+// record : uint8 tag
+//          [zigzag varint pc delta]      if the pc is not sequential
+//          uint16 or uint32 encoding     by the compressed bit
+//          [uint8 rd, zigzag varint]     value delta against the last write to rd
+//          [zigzag varint addr delta]    against the previous data address
+//
+// tag bits: 0=non-sequential pc, 1=compressed, 2=rd write,
+//           3=fp rd, 4=data access, 5=data write
+#define REVTRC_TAG_JUMP   0x01
+#define REVTRC_TAG_RVC    0x02
+#define REVTRC_TAG_RD     0x04
+#define REVTRC_TAG_RDFP   0x08
+#define REVTRC_TAG_MEM    0x10
+#define REVTRC_TAG_WRITE  0x20
+
+RevTracer::RevTracer(const std::string &File, unsigned Core, unsigned Xlen)
+  : file(nullptr), cur(0), count(0), records(0x00ull), done(false),
+    prevPC(0x00ull), prevNext(0x00ull), prevMem(0x00ull) {
+  memset(lastReg, 0, sizeof(lastReg));
+
+  file = fopen(File.c_str(), "wb");
+  if( !file ){
+    return ;
+  }
+
+  uint8_t Hdr[13];
+  memcpy(Hdr, REVTRC_MAGIC, 8);
+  Hdr[8] = (uint8_t)(Xlen);
+  for( unsigned i=0; i<4; i++ ){
+    Hdr[9+i] = (uint8_t)(Core >> (8*i));
+  }
+  fwrite(Hdr, 1, sizeof(Hdr), file);
+
+  chunks.resize(REVTRC_CHUNKS);
+  fill.assign(REVTRC_CHUNKS, 0);
+  for( unsigned i=0; i<REVTRC_CHUNKS; i++ ){
+    chunks[i].resize(REVTRC_CHUNK_RECS);
+    if( i != cur ){
+      freeQ.push_back(i);
+    }
+  }
+  buf.reserve(REVTRC_CHUNK_RECS * 8);
+
+  writer = std::thread(&RevTracer::Run, this);
+}
+
+RevTracer::~RevTracer(){
+  if( !file ){
+    return ;
+  }
+
+  Flush();
+  {
+    std::lock_guard<std::mutex> L(lock);
+    done = true;
+  }
+  fullCV.notify_one();
+  writer.join();
+  fclose(file);
+}
+
+void RevTracer::Submit(){
+  std::unique_lock<std::mutex> L(lock);
+  fill[cur] = count;
+  fullQ.push_back(cur);
+  fullCV.notify_one();
+
+  // the writer applies back pressure once every chunk is in flight
+  freeCV.wait(L, [this]{ return !freeQ.empty(); });
+  cur = freeQ.front();
+  freeQ.pop_front();
+  count = 0;
+}
+
+void RevTracer::Flush(){
+  if( !file ){
+    return ;
+  }
+  if( count ){
+    Submit();
+  }
+
+  // wait for every chunk but the one being filled to be released
+  std::unique_lock<std::mutex> L(lock);
+  freeCV.wait(L, [this]{ return freeQ.size() == (REVTRC_CHUNKS-1); });
+  fflush(file);
+}
+
+void RevTracer::Run(){
+  for(;;){
+    unsigned Idx = 0;
+    {
+      std::unique_lock<std::mutex> L(lock);
+      fullCV.wait(L, [this]{ return done || !fullQ.empty(); });
+      if( fullQ.empty() ){
+        return ;
+      }
+      Idx = fullQ.front();
+      fullQ.pop_front();
+    }
+
+    Encode(chunks[Idx], fill[Idx]);
+
+    {
+      std::lock_guard<std::mutex> L(lock);
+      freeQ.push_back(Idx);
+    }
+    freeCV.notify_one();
+  }
+}
+
+void RevTracer::Encode(const std::vector<RevTraceRec> &Chunk, unsigned Count){
+  buf.clear();
+  for( unsigned i=0; i<Count; i++ ){
+    const RevTraceRec &R = Chunk[i];
+    uint8_t Tag = 0;
+    if( R.PC != prevNext )
+      Tag |= REVTRC_TAG_JUMP;
+    if( R.Size == 2 )
+      Tag |= REVTRC_TAG_RVC;
+    if( R.Flags & TraceRd )
+      Tag |= REVTRC_TAG_RD;
+    if( R.Flags & TraceRdFP )
+      Tag |= REVTRC_TAG_RDFP;
+    if( R.Flags & TraceMem )
+      Tag |= REVTRC_TAG_MEM;
+    if( R.Flags & TraceMemWrite )
+      Tag |= REVTRC_TAG_WRITE;
+    buf.push_back(Tag);
+
+    if( Tag & REVTRC_TAG_JUMP )
+      PutDelta(R.PC, prevPC);
+    prevPC    = R.PC;
+    prevNext  = R.PC + R.Size;
+
+    buf.push_back((uint8_t)(R.Inst));
+    buf.push_back((uint8_t)(R.Inst >> 8));
+    if( R.Size != 2 ){
+      buf.push_back((uint8_t)(R.Inst >> 16));
+      buf.push_back((uint8_t)(R.Inst >> 24));
+    }
+
+    if( Tag & REVTRC_TAG_RD ){
+      unsigned Reg = (R.Rd & 0x1F) + ((Tag & REVTRC_TAG_RDFP) ? 32 : 0);
+      buf.push_back(R.Rd);
+      PutDelta(R.RdVal, lastReg[Reg]);
+      lastReg[Reg] = R.RdVal;
+    }
+
+    if( Tag & REVTRC_TAG_MEM ){
+      PutDelta(R.MemAddr, prevMem);
+      prevMem = R.MemAddr;
+    }
+  }
+  fwrite(buf.data(), 1, buf.size(), file);
+}
+
+// EOF
@@ -0,0 +1,83 @@
+/*
+ * bfs.c
+ *
+ * Level synchronous breadth first search over a periodic KBFS_DIM x KBFS_DIM grid graph in CSR form; vertices are partitioned and claimed with compare and swap
+ *
+ * Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+
+#include "kernel.h"
+
+#ifndef KBFS_DIM
+#define KBFS_DIM 32
+#endif
+
+#define KBFS_N (KBFS_DIM * KBFS_DIM)
+
+static int adjPtr[KBFS_N + 1];
+static int adj[4 * KBFS_N];
+static int level[KBFS_N];
+static volatile int changed[3];
+
+static int kdist(int a, int b){
+  int d = a > b ? a - b : b - a;
+  return d < KBFS_DIM - d ? d : KBFS_DIM - d;
+}
+
+int kmain(int rank){
+  int lo = KLO(KBFS_N, rank);
+  int hi = KHI(KBFS_N, rank);
+  int i, j, l;
+
+  for( i=lo; i<hi; i++ ){
+    int r = i / KBFS_DIM;
+    int c = i % KBFS_DIM;
+    adjPtr[i] = 4 * i;
+    adj[4*i]   = r * KBFS_DIM + (c + KBFS_DIM - 1) % KBFS_DIM;
+    adj[4*i+1] = r * KBFS_DIM + (c + 1) % KBFS_DIM;
+    adj[4*i+2] = ((r + KBFS_DIM - 1) % KBFS_DIM) * KBFS_DIM + c;
+    adj[4*i+3] = ((r + 1) % KBFS_DIM) * KBFS_DIM + c;
+    level[i] = (i == 0) ? 0 : -1;
+  }
+  if( rank == 0 )
+    adjPtr[KBFS_N] = 4 * KBFS_N;
+  kbarrier();
+
+  /*
+   * changed[l%3] records whether level l discovered a vertex; slot
+   * (l+2)%3 was last read before this level's barrier and is not
+   * written until the next one, so core 0 clears it here
+   */
+  for( l=0; ; l++ ){
+    int found = 0;
+    for( i=lo; i<hi; i++ ){
+      if( level[i] != l )
+        continue;
+      for( j=adjPtr[i]; j<adjPtr[i+1]; j++ ){
+        int expect = -1;
+        if( __atomic_compare_exchange_n(&level[adj[j]], &expect, l + 1, 0,
+                                        __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST) )
+          found = 1;
+      }
+    }
+    if( found )
+      changed[l % 3] = 1;
+    kbarrier();
+    if( !changed[l % 3] )
+      break;
+    if( rank == 0 )
+      changed[(l + 2) % 3] = 0;
+  }
+
+  if( rank == 0 ){
+    for( i=0; i<KBFS_N; i++ ){
+      kassert( level[i] == kdist(i / KBFS_DIM, 0) + kdist(i % KBFS_DIM, 0) );
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,58 @@
+/*
+ * dgemm.c
+ *
+ * Dense C = A * B over KDGEMM_N x KDGEMM_N doubles; rows of C are partitioned
+ *
+ * Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+
+#include "kernel.h"
+
+#ifndef KDGEMM_N
+#define KDGEMM_N 32
+#endif
+
+static double A[KDGEMM_N][KDGEMM_N];
+static double B[KDGEMM_N][KDGEMM_N];
+static double C[KDGEMM_N][KDGEMM_N];
+
+int kmain(int rank){
+  int lo = KLO(KDGEMM_N, rank);
+  int hi = KHI(KDGEMM_N, rank);
+  int i, j, k;
+
+  /* small integer operands keep every product exact */
+  for( i=lo; i<hi; i++ ){
+    for( j=0; j<KDGEMM_N; j++ ){
+      A[i][j] = (double)((i + j) % 7);
+      B[i][j] = (double)((i * j) % 5);
+      C[i][j] = 0.0;
+    }
+  }
+  kbarrier();
+
+  for( i=lo; i<hi; i++ ){
+    for( k=0; k<KDGEMM_N; k++ ){
+      double aik = A[i][k];
+      for( j=0; j<KDGEMM_N; j++ ){
+        C[i][j] += aik * B[k][j];
+      }
+    }
+  }
+  kbarrier();
+
+  if( rank == 0 ){
+    for( i=0; i<KDGEMM_N; i++ ){
+      double sum = 0.0;
+      for( k=0; k<KDGEMM_N; k++ )
+        sum += A[i][k] * B[k][i];
+      kassert( C[i][i] == sum );
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,86 @@
+/*
+ * fft.c
+ *
+ * Batched one dimensional complex FFTs with minfft (test/minfft); the batch is partitioned and each transform is checked against its inverse
+ *
+ * Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+
+#include "kernel.h"
+
+#include <math.h>
+#include "minfft.h"
+
+#ifndef KFFT_N
+#define KFFT_N 64
+#endif
+
+#ifndef KFFT_BATCH
+#define KFFT_BATCH 8
+#endif
+
+/*
+ * The aux data is built in place rather than with minfft_mkaux_dft_1d,
+ * which allocates; the exponent vector is shared and every core owns
+ * its temporary buffer
+ */
+static minfft_cmpl e[KFFT_N];
+static minfft_cmpl t[KCORES][KFFT_N];
+static minfft_aux  aux[KCORES];
+static minfft_cmpl x[KFFT_BATCH][KFFT_N];
+static minfft_cmpl y[KFFT_BATCH][KFFT_N];
+static minfft_cmpl z[KFFT_BATCH][KFFT_N];
+
+static void kmkaux(void){
+  const double pi = 3.141592653589793238462643383279502884;
+  minfft_real *ep = (minfft_real *)e;
+  int N, n;
+  for( N=KFFT_N; N>=16; N/=2 ){
+    for( n=0; n<N/4; n++ ){
+      *ep++ = cos(-2*pi*n/N);
+      *ep++ = sin(-2*pi*n/N);
+      *ep++ = cos(-2*pi*3*n/N);
+      *ep++ = sin(-2*pi*3*n/N);
+    }
+  }
+}
+
+int kmain(int rank){
+  int lo = KLO(KFFT_BATCH, rank);
+  int hi = KHI(KFFT_BATCH, rank);
+  int b, n;
+
+  if( rank == 0 )
+    kmkaux();
+  aux[rank].N    = KFFT_N;
+  aux[rank].t    = (KFFT_N >= 16) ? t[rank] : 0;
+  aux[rank].e    = (KFFT_N >= 16) ? e : 0;
+  aux[rank].sub1 = 0;
+  aux[rank].sub2 = 0;
+  for( b=lo; b<hi; b++ ){
+    minfft_real *xp = (minfft_real *)x[b];
+    for( n=0; n<KFFT_N; n++ ){
+      xp[2*n]   = (double)((n + b) % 5);
+      xp[2*n+1] = (double)((n * b) % 3);
+    }
+  }
+  kbarrier();
+
+  /* the unnormalized inverse returns KFFT_N times the input */
+  for( b=lo; b<hi; b++ ){
+    minfft_real *xp = (minfft_real *)x[b];
+    minfft_real *zp = (minfft_real *)z[b];
+    minfft_dft(x[b], y[b], &aux[rank]);
+    minfft_invdft(y[b], z[b], &aux[rank]);
+    for( n=0; n<2*KFFT_N; n++ ){
+      kassert( fabs(zp[n] - KFFT_N * xp[n]) < 1e-9 );
+    }
+  }
+  kbarrier();
+  return 0;
+}
@@ -0,0 +1,57 @@
+/*
+ * histogram.c
+ *
+ * Histogram of KHIST_N hashed keys into KHIST_BINS shared bins updated with atomic adds
+ *
+ * Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+
+#include "kernel.h"
+
+#ifndef KHIST_N
+#define KHIST_N 8192
+#endif
+
+#ifndef KHIST_BINS
+#define KHIST_BINS 64
+#endif
+
+static unsigned bins[KHIST_BINS];
+static unsigned check[KHIST_BINS];
+
+static unsigned khash(unsigned x){
+  x ^= x >> 16;
+  x *= 0x7feb352dU;
+  x ^= x >> 15;
+  x *= 0x846ca68bU;
+  x ^= x >> 16;
+  return x % KHIST_BINS;
+}
+
+int kmain(int rank){
+  int lo = KLO(KHIST_N, rank);
+  int hi = KHI(KHIST_N, rank);
+  int i;
+
+  for( i=lo; i<hi; i++ ){
+    __atomic_fetch_add(&bins[khash(i)], 1, __ATOMIC_RELAXED);
+  }
+  kbarrier();
+
+  if( rank == 0 ){
+    unsigned total = 0;
+    for( i=0; i<KHIST_N; i++ )
+      check[khash(i)]++;
+    for( i=0; i<KHIST_BINS; i++ ){
+      kassert( bins[i] == check[i] );
+      total += bins[i];
+    }
+    kassert( total == KHIST_N );
+  }
+  return 0;
+}
@@ -0,0 +1,52 @@
+/*
+ * kernel.h
+ *
+ * Common definitions for the HPC kernel benchmarks
+ *
+ * Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+
+#ifndef _KERNEL_H_
+#define _KERNEL_H_
+
+/*
+ * Number of cores the kernel is partitioned across; must match the
+ * numCores of the simulation (see the Makefile)
+ */
+#ifndef KCORES
+#define KCORES 1
+#endif
+
+/* [KLO,KHI) is the block of the n work items owned by core r */
+#define KLO(n, r) (((n) * (r)) / KCORES)
+#define KHI(n, r) (((n) * ((r) + 1)) / KCORES)
+
+/* an illegal instruction stops the simulation on a failed check */
+#define kassert(x) if (!(x)) { asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); }
+
+static volatile int kbar_count = 0;
+static volatile int kbar_sense = 0;
+
+/* sense reversing barrier across all KCORES cores */
+static inline void kbarrier(void){
+  int sense = kbar_sense;
+  if( __atomic_add_fetch(&kbar_count, 1, __ATOMIC_SEQ_CST) == KCORES ){
+    kbar_count = 0;
+    __atomic_store_n(&kbar_sense, !sense, __ATOMIC_SEQ_CST);
+  }else{
+    while( __atomic_load_n(&kbar_sense, __ATOMIC_ACQUIRE) == sense ){
+    }
+  }
+}
+
+/* kernel entry; called by kstart.S on every core */
+int kmain(int rank);
+
+#endif
+
+/* EOF */
@@ -0,0 +1,156 @@
+#
+# Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+# All Rights Reserved
+# contact@tactcomplabs.com
+#
+# See LICENSE in the top level directory for licensing details
+#
+# rev-kernels.py
+#
+# Configuration for the HPC kernel benchmarks; driven by run_kernels.sh
+# and scripts/kernelBench.py through the environment:
+#
+#   REV_EXE            kernel executable (<kernel>.<cores>.exe)
+#   REV_CORES          number of cores; must match the executable
+#   REV_MEMH           0: Rev internal memory model, 1: memHierarchy
+#   REV_PARTS          number of RevCPU components the cores are split across;
+#                      more than one requires REV_MEMH=1 (default 1)
+#   REV_KERNEL_STATS   statistics output file
+#
+
+import os
+import sys
+import sst
+
+MEM_SIZE = 1024*1024*1024-1
+NUM_CORES = int(os.getenv("REV_CORES", "1"))
+ENABLE_MEMH = int(os.getenv("REV_MEMH", "0"))
+NUM_PARTS = int(os.getenv("REV_PARTS", "1"))
+
+if NUM_PARTS < 1 or NUM_PARTS > NUM_CORES:
+  sys.stderr.write("REV_PARTS must be between 1 and REV_CORES\n")
+  raise SystemExit(1)
+if NUM_PARTS > 1 and not ENABLE_MEMH:
+  sys.stderr.write("Cores split across components only share memory through memHierarchy; set REV_MEMH=1\n")
+  raise SystemExit(1)
+
+# Define SST core options
+sst.setProgramOption("timebase", "1ps")
+
+# Tell SST what statistics handling we want
+sst.setStatisticLoadLevel(4)
+
+# Define the simulation components
+# The internal memory cost is fixed such that simulated cycles are deterministic
+def buildCPU(name, cores, base):
+  comp_cpu = sst.Component(name, "revcpu.RevCPU")
+  comp_cpu.addParams({
+	"verbose" : 0,                                # Verbosity
+        "numCores" : cores,                           # Number of cores
+        "coreBase" : base,                            # Node-wide index of the first core
+        "nodeCores" : NUM_CORES,                      # Node-wide core count
+	"clock" : "1.0GHz",                           # Clock
+        "memSize" : MEM_SIZE,                         # Memory size in bytes
+        "machine" : "[CORES:RV64IMAFD]",              # Core:Config; RV64IMAFD for all cores
+        "startAddr" : "[CORES:0x00000000]",           # Starting address for all cores
+        "memCost" : ",".join("[%d:1:1]" % i for i in range(cores)),  # Memory loads require 1 cycle
+        "program" : os.getenv("REV_EXE", "stream.1.exe"),  # Target executable
+        "enable_memH" : ENABLE_MEMH,                  # Enable memHierarchy support
+        "selfProfile" : 1,                            # Report host time and MIPS at finish
+        "splash" : 0                                  # Display the splash message
+  })
+  comp_cpu.enableAllStatistics()
+  if not ENABLE_MEMH:
+    return None
+
+  # Create the RevMemCtrl subcomponent
+  comp_lsq = comp_cpu.setSubComponent("memory", "revcpu.RevBasicMemCtrl");
+  comp_lsq.addParams({
+        "verbose"         : "0",
+        "clock"           : "1.0Ghz",
+        "max_loads"       : 16,
+        "max_stores"      : 16,
+        "max_flush"       : 16,
+        "max_llsc"        : 16,
+        "max_readlock"    : 16,
+        "max_writeunlock" : 16,
+        "max_custom"      : 16,
+        "ops_per_cycle"   : 16
+  })
+  comp_lsq.enableAllStatistics({"type":"sst.AccumulatorStatistic"})
+
+  iface = comp_lsq.setSubComponent("memIface", "memHierarchy.standardInterface")
+  iface.addParams({
+        "verbose" : 0
+  })
+  return iface
+
+def buildCache(name, size, L1):
+  cache = sst.Component(name, "memHierarchy.Cache")
+  cache.addParams({
+      "access_latency_cycles" : "4" if L1 else "10",
+      "cache_frequency" : "1 Ghz",
+      "replacement_policy" : "lru",
+      "coherence_protocol" : "MESI",
+      "associativity" : "8",
+      "cache_line_size" : "64",
+      "L1" : "1" if L1 else "0",
+      "cache_size" : size
+  })
+  return cache
+
+# Split the cores as evenly as possible; every component runs the same
+# executable and the kernels derive the node-wide rank from the pid
+ifaces = []
+for p in range(NUM_PARTS):
+  lo = (NUM_CORES * p) // NUM_PARTS
+  hi = (NUM_CORES * (p + 1)) // NUM_PARTS
+  ifaces.append(buildCPU("cpu" if NUM_PARTS == 1 else "cpu" + str(p), hi - lo, lo))
+
+if ENABLE_MEMH:
+  memctrl = sst.Component("memory", "memHierarchy.MemController")
+  memctrl.addParams({
+      "debug" : 0,
+      "clock" : "1GHz",
+      "verbose" : 0,
+      "addr_range_start" : 0,
+      "addr_range_end" : MEM_SIZE,
+      "backing" : "malloc"
+  })
+
+  memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+  memory.addParams({
+      "access_time" : "100ns",
+      "mem_size" : "8GB"
+  })
+
+  if NUM_PARTS == 1:
+    link_iface_mem = sst.Link("link_iface_mem")
+    link_iface_mem.connect( (ifaces[0], "port", "50ps"), (memctrl, "direct_link", "50ps") )
+  else:
+    # A private coherent L1 per component and a shared L2 keep the components'
+    # view of memory consistent; each component may then be placed on its own rank
+    bus = sst.Component("bus", "memHierarchy.Bus")
+    bus.addParams({
+        "bus_frequency" : "1 Ghz"
+    })
+    for p in range(NUM_PARTS):
+      l1 = buildCache("l1cache" + str(p), "32KiB", True)
+      link_cpu_l1 = sst.Link("link_cpu_l1_" + str(p))
+      link_cpu_l1.connect( (ifaces[p], "port", "50ps"), (l1, "high_network_0", "50ps") )
+      link_l1_bus = sst.Link("link_l1_bus_" + str(p))
+      link_l1_bus.connect( (l1, "low_network_0", "50ps"), (bus, "high_network_" + str(p), "50ps") )
+
+    l2 = buildCache("l2cache", "1MiB", False)
+    link_bus_l2 = sst.Link("link_bus_l2")
+    link_bus_l2.connect( (bus, "low_network_0", "50ps"), (l2, "high_network_0", "50ps") )
+    link_l2_mem = sst.Link("link_l2_mem")
+    link_l2_mem.connect( (l2, "low_network_0", "50ps"), (memctrl, "direct_link", "50ps") )
+
+sst.setStatisticOutput("sst.statOutputCSV", {
+    "filepath" : os.getenv("REV_KERNEL_STATS", "kernel_stats.csv"),
+    "separator" : ","
+})
+sst.enableAllStatisticsForAllComponents()
+
+# EOF
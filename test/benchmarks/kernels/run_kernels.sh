@@ -0,0 +1,29 @@
+#!/bin/bash
+
+#Build the kernels for one and two cores
+make CORES="1 2"
+
+# Run every kernel on each core count with the internal memory model,
+# then STREAM through memHierarchy with the cores in one component and
+# split across two
+RUNS=""
+for k in stream dgemm spmv stencil bfs histogram fft; do
+  RUNS="$RUNS $k:1:0:1 $k:2:0:1"
+done
+RUNS="$RUNS stream:2:1:1 stream:2:1:2"
+
+for r in $RUNS; do
+  IFS=: read KERNEL NCORES MEMH PARTS <<< "$r"
+  EXE=$KERNEL.$NCORES.exe
+  if [ ! -f $EXE ]; then
+    echo "Test KERNELS: $EXE not Found - likely build failed"
+    exit 1
+  fi
+  REV_EXE=$EXE REV_CORES=$NCORES REV_MEMH=$MEMH REV_PARTS=$PARTS REV_KERNEL_STATS=kernels.csv \
+    sst ./rev-kernels.py > kernels.log 2>&1
+  if ! grep -q "Simulation is complete" kernels.log; then
+    echo "Test KERNELS: $KERNEL failed on $NCORES cores (memH=$MEMH, components=$PARTS)"
+    exit 1
+  fi
+done
+cat kernels.log
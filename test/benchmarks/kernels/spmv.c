@@ -0,0 +1,76 @@
+/*
+ * spmv.c
+ *
+ * Sparse matrix-vector product in CSR form; the matrix is the 5-point Laplacian of a periodic KSPMV_DIM x KSPMV_DIM grid
+ *
+ * Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+
+#include "kernel.h"
+
+#ifndef KSPMV_DIM
+#define KSPMV_DIM 64
+#endif
+
+#ifndef KSPMV_ITERS
+#define KSPMV_ITERS 2
+#endif
+
+#define KSPMV_N   (KSPMV_DIM * KSPMV_DIM)
+#define KSPMV_NNZ (5 * KSPMV_N)
+
+static int    rowPtr[KSPMV_N + 1];
+static int    colIdx[KSPMV_NNZ];
+static double val[KSPMV_NNZ];
+static double x[KSPMV_N];
+static double y[KSPMV_N];
+
+int kmain(int rank){
+  int lo = KLO(KSPMV_N, rank);
+  int hi = KHI(KSPMV_N, rank);
+  int i, j, k;
+
+  for( i=lo; i<hi; i++ ){
+    int r = i / KSPMV_DIM;
+    int c = i % KSPMV_DIM;
+    int p = 5 * i;
+    rowPtr[i] = p;
+    colIdx[p]   = i;
+    colIdx[p+1] = r * KSPMV_DIM + (c + KSPMV_DIM - 1) % KSPMV_DIM;
+    colIdx[p+2] = r * KSPMV_DIM + (c + 1) % KSPMV_DIM;
+    colIdx[p+3] = ((r + KSPMV_DIM - 1) % KSPMV_DIM) * KSPMV_DIM + c;
+    colIdx[p+4] = ((r + 1) % KSPMV_DIM) * KSPMV_DIM + c;
+    val[p] = 4.0;
+    for( j=1; j<5; j++ )
+      val[p+j] = -1.0;
+    x[i] = (double)(i % 3);
+  }
+  if( rank == 0 )
+    rowPtr[KSPMV_N] = KSPMV_NNZ;
+  kbarrier();
+
+  for( k=0; k<KSPMV_ITERS; k++ ){
+    for( i=lo; i<hi; i++ ){
+      double sum = 0.0;
+      for( j=rowPtr[i]; j<rowPtr[i+1]; j++ )
+        sum += val[j] * x[colIdx[j]];
+      y[i] = sum;
+    }
+    kbarrier();
+  }
+
+  /* every column of the periodic Laplacian sums to zero */
+  if( rank == 0 ){
+    double sum = 0.0;
+    for( i=0; i<KSPMV_N; i++ )
+      sum += y[i];
+    kassert( sum == 0.0 );
+    kassert( y[0] == 4.0 * x[0] - x[1] - x[KSPMV_DIM-1] - x[KSPMV_DIM] - x[KSPMV_N-KSPMV_DIM] );
+  }
+  return 0;
+}
@@ -0,0 +1,67 @@
+/*
+ * stencil.c
+ *
+ * Jacobi sweeps of a 5-point stencil over a periodic KSTENCIL_DIM x KSTENCIL_DIM grid; rows are partitioned
+ *
+ * Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+
+#include "kernel.h"
+
+#ifndef KSTENCIL_DIM
+#define KSTENCIL_DIM 64
+#endif
+
+#ifndef KSTENCIL_ITERS
+#define KSTENCIL_ITERS 4
+#endif
+
+static double grid[2][KSTENCIL_DIM][KSTENCIL_DIM];
+
+int kmain(int rank){
+  int lo = KLO(KSTENCIL_DIM, rank);
+  int hi = KHI(KSTENCIL_DIM, rank);
+  int i, j, k;
+
+  for( i=lo; i<hi; i++ ){
+    for( j=0; j<KSTENCIL_DIM; j++ ){
+      grid[0][i][j] = (double)((i * 7 + j * 3) % 11);
+    }
+  }
+  kbarrier();
+
+  /* the weights are powers of two that sum to one, so the grid total is conserved exactly */
+  for( k=0; k<KSTENCIL_ITERS; k++ ){
+    double (*src)[KSTENCIL_DIM] = grid[k & 1];
+    double (*dst)[KSTENCIL_DIM] = grid[(k + 1) & 1];
+    for( i=lo; i<hi; i++ ){
+      int up = (i + KSTENCIL_DIM - 1) % KSTENCIL_DIM;
+      int dn = (i + 1) % KSTENCIL_DIM;
+      for( j=0; j<KSTENCIL_DIM; j++ ){
+        int lf = (j + KSTENCIL_DIM - 1) % KSTENCIL_DIM;
+        int rt = (j + 1) % KSTENCIL_DIM;
+        dst[i][j] = 0.5 * src[i][j] +
+                    0.125 * (src[up][j] + src[dn][j] + src[i][lf] + src[i][rt]);
+      }
+    }
+    kbarrier();
+  }
+
+  if( rank == 0 ){
+    double before = 0.0;
+    double after = 0.0;
+    for( i=0; i<KSTENCIL_DIM; i++ ){
+      for( j=0; j<KSTENCIL_DIM; j++ ){
+        before += (double)((i * 7 + j * 3) % 11);
+        after  += grid[KSTENCIL_ITERS & 1][i][j];
+      }
+    }
+    kassert( before == after );
+  }
+  return 0;
+}
@@ -0,0 +1,69 @@
+/*
+ * stream.c
+ *
+ * STREAM copy, scale, add and triad over KSTREAM_N doubles
+ *
+ * Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+
+#include "kernel.h"
+
+#ifndef KSTREAM_N
+#define KSTREAM_N 4096
+#endif
+
+#ifndef KSTREAM_ITERS
+#define KSTREAM_ITERS 2
+#endif
+
+static double a[KSTREAM_N];
+static double b[KSTREAM_N];
+static double c[KSTREAM_N];
+
+int kmain(int rank){
+  const double s = 3.0;
+  int lo = KLO(KSTREAM_N, rank);
+  int hi = KHI(KSTREAM_N, rank);
+  int i, k;
+
+  for( i=lo; i<hi; i++ ){
+    a[i] = 1.0;
+    b[i] = 2.0;
+    c[i] = 0.0;
+  }
+  kbarrier();
+
+  for( k=0; k<KSTREAM_ITERS; k++ ){
+    for( i=lo; i<hi; i++ )
+      c[i] = a[i];
+    kbarrier();
+    for( i=lo; i<hi; i++ )
+      b[i] = s * c[i];
+    kbarrier();
+    for( i=lo; i<hi; i++ )
+      c[i] = a[i] + b[i];
+    kbarrier();
+    for( i=lo; i<hi; i++ )
+      a[i] = b[i] + s * c[i];
+    kbarrier();
+  }
+
+  if( rank == 0 ){
+    double ea = 1.0, eb = 2.0, ec = 0.0;
+    for( k=0; k<KSTREAM_ITERS; k++ ){
+      ec = ea;
+      eb = s * ec;
+      ec = ea + eb;
+      ea = eb + s * ec;
+    }
+    for( i=0; i<KSTREAM_N; i++ ){
+      kassert( a[i] == ea && b[i] == eb && c[i] == ec );
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,50 @@
+/*
+ * bpred.c
+ *
+ * RISC-V ISA: RV64I
+ *
+ * Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+
+uint64_t A[256];
+
+/* non-inlined leaf to exercise the call/return stack */
+__attribute__((noinline)) uint64_t leaf(uint64_t v){
+  if( v & 1 ){
+    return v * 3;
+  }
+  return v >> 1;
+}
+
+int main(int argc, char **argv){
+  uint64_t i = 0;
+  uint64_t j = 0;
+  uint64_t r = 0;
+
+  for( i=0; i<256; i++ ){
+    A[i] = i * 7;
+  }
+
+  for( i=0; i<64; i++ ){
+    for( j=0; j<256; j++ ){
+      /* alternating and data dependent branches */
+      if( (j & 3) == 0 ){
+        r += leaf(A[j]);
+      }else if( A[j] & 8 ){
+        r ^= A[j];
+      }
+    }
+  }
+
+  if( r == 0 )
+    return 1;
+  return 0;
+}
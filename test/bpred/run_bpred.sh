@@ -0,0 +1,45 @@
+#!/bin/bash
+
+#Build the test
+make
+
+# Check that the exec was built...
+if [ -f bpred.exe ]; then
+  rm -f bpred_stats.csv
+  sst ./rev-test-bpred.py > bpred.log 2>&1
+
+  # core 0 totals from the CSV statistics
+  stat(){
+    awk -F', *' -v Name="$1" '
+      NR==1 { for(i=1;i<=NF;i++){ if($i=="StatisticName") n=i; if($i=="StatisticSubId") s=i; if($i=="Sum.u64") v=i } next }
+      $n==Name && $s=="core_0" { t+=$v }
+      END { print t+0 }' bpred_stats.csv
+  }
+  BRANCHES=$(stat BranchesExec)
+  MISPRED=$(stat BranchMispredicts)
+  BTB=$(stat BTBMisses)
+  RAS=$(stat RASMisses)
+  echo "Test BPRED: branches=$BRANCHES mispredicts=$MISPRED btb=$BTB ras=$RAS"
+
+  # 64x256 inner loop iterations; the loop and the leaf calls are
+  # regular, so a trained predictor misses a small fraction of them,
+  # every taken branch misses the BTB once, and the 4096 leaf returns
+  # are covered by the RAS
+  if [ "$BRANCHES" -lt 16384 ]; then
+    echo "Test BPRED: too few branches executed"
+    exit 1
+  elif [ "$MISPRED" -eq 0 ] || [ $((MISPRED * 4)) -ge "$BRANCHES" ]; then
+    echo "Test BPRED: implausible mispredict count"
+    exit 1
+  elif [ "$BTB" -eq 0 ] || [ "$BTB" -gt "$MISPRED" ]; then
+    echo "Test BPRED: implausible BTB miss count"
+    exit 1
+  elif [ "$RAS" -ge 64 ]; then
+    echo "Test BPRED: leaf returns missed the RAS"
+    exit 1
+  fi
+  cat bpred.log
+else
+  echo "Test BPRED: bpred.exe not Found - likely build failed"
+  exit 1
+fi
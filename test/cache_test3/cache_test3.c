@@ -0,0 +1,40 @@
+/*
+ * cache_test3.c
+ *
+ * RISC-V ISA: RV32I
+ *
+ * Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+
+#include <stdlib.h>
+
+#define N 256
+
+int A[N];
+int B[N];
+
+int main(int argc, char **argv){
+  int i = 0;
+  int sum = 0;
+
+  // interleave instruction fetches with a stream of loads and stores
+  for( i=0; i<N; i++ ){
+    A[i] = i + argc;
+  }
+  for( i=0; i<N; i++ ){
+    B[i] = A[i] * 3;
+  }
+  for( i=0; i<N; i++ ){
+    sum += B[i];
+  }
+
+  if( sum != (3*((N*(N-1))/2) + 3*N*argc) ){
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,12 @@
+#!/bin/bash
+
+#Build the test
+make
+
+# Check that the exec was built...
+if [ -f cache_test3.exe ]; then
+  sst ./rev-test-cache3.py
+else
+  echo "Test CACHE-TEST3: cache_test3.exe not Found - likely build failed"
+  exit 1
+fi 
@@ -0,0 +1,47 @@
+/*
+ * fusion.c
+ *
+ * RISC-V ISA: RV64I
+ *
+ * Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+
+uint64_t G = 0x12345678ull;
+
+int main(int argc, char **argv){
+  uint64_t i = 0;
+  uint64_t r = 0;
+  uint64_t t = 0;
+
+  for( i=0; i<128; i++ ){
+    /* lui+addi */
+    asm volatile("lui %0, 0x12345\n\taddi %0, %0, 0x678" : "=r"(t));
+    r += t;
+
+    /* auipc+ld */
+    asm volatile("1: auipc %0, %%pcrel_hi(G)\n\tld %0, %%pcrel_lo(1b)(%0)" : "=r"(t));
+    r += t;
+
+    /* slli+srli */
+    t = 0xffffffff00000000ull | i;
+    asm volatile("slli %0, %0, 32\n\tsrli %0, %0, 32" : "+r"(t));
+    r += t;
+
+    /* slt+bnez */
+    asm volatile("slt %0, %1, %2\n\tbnez %0, 2f\n\taddi %0, x0, 2\n2:"
+                 : "=&r"(t) : "r"(i), "r"((uint64_t)(64)));
+    r += t;
+  }
+
+  if( r != (128*0x12345678ull*2) + (127*128/2) + 64 + 64*2 )
+    return 1;
+  return 0;
+}
@@ -0,0 +1,46 @@
+#!/bin/bash
+
+#Build the test
+make
+
+# Check that the exec was built...
+if [ -f fusion.exe ]; then
+  # core 0 totals from the CSV statistics
+  stat(){
+    awk -F', *' -v Name="$2" '
+      NR==1 { for(i=1;i<=NF;i++){ if($i=="StatisticName") n=i; if($i=="StatisticSubId") s=i; if($i=="Sum.u64") v=i } next }
+      $n==Name && $s=="core_0" { t+=$v }
+      END { print t+0 }' fusion_$1.csv
+  }
+
+  # run the same program under both timing policies
+  for p in fused split; do
+    rm -f fusion_$p.csv
+    REV_FUSION=$p REV_FUSION_STATS=fusion_$p.csv sst ./rev-test-fusion.py > fusion_$p.log 2>&1
+    if ! grep -q "Simulation is complete" fusion_$p.log; then
+      cat fusion_$p.log
+      echo "Test FUSION: the $p policy failed"
+      exit 1
+    fi
+  done
+
+  FUSED=$(stat fused FusedPairs)
+  SPLIT=$(stat split FusedPairs)
+  FUSED_CYCLES=$(stat fused TotalCycles)
+  SPLIT_CYCLES=$(stat split TotalCycles)
+  echo "Test FUSION: fused pairs=$FUSED cycles=$FUSED_CYCLES; split pairs=$SPLIT cycles=$SPLIT_CYCLES"
+
+  # each of the 128 loop iterations forms four pairs; both policies
+  # recognize the same pairs and only differ in how they are timed
+  if [ "$FUSED" -lt 512 ] || [ "$FUSED" -ne "$SPLIT" ]; then
+    echo "Test FUSION: expected the same fused pairs under both policies"
+    exit 1
+  elif [ "$FUSED_CYCLES" -eq "$SPLIT_CYCLES" ]; then
+    echo "Test FUSION: the timing policies did not change the cycle count"
+    exit 1
+  fi
+  cat fusion_fused.log
+else
+  echo "Test FUSION: fusion.exe not Found - likely build failed"
+  exit 1
+fi
@@ -0,0 +1,114 @@
+/*
+ * amomax_d.c
+ *
+ * RISC-V ISA: RV64A
+ *
+ * Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <stdbool.h>
+#include "isa_test_macros.h"
+
+
+int main(int argc, char **argv){
+
+ // #-------------------------------------------------------------
+ // # Basic tests
+ // #-------------------------------------------------------------
+
+  //# rd receives the full 64 bit old value
+
+  TEST_CASE( 2, x14, 0xc000000000000000, \
+    ASM_GEN(la  x1, amo_operand); \
+    ASM_GEN(li  x15, 0xc000000000000000); \
+    ASM_GEN(sd  x15, 0(x1)); \
+    ASM_GEN(li  x2, 0x0000000000000001); \
+    ASM_GEN(amomax.d x14, x2, (x1)); \
+  )
+
+  //# memory holds the signed maximum
+
+  TEST_CASE( 3, x14, 0x0000000000000001, \
+    ASM_GEN(la  x1, amo_operand); \
+    ASM_GEN(ld  x14, 0(x1)); \
+  )
+
+  //# a second operation returns the first result
+
+  TEST_CASE( 4, x14, 0x0000000000000001, \
+    ASM_GEN(la  x1, amo_operand); \
+    ASM_GEN(li  x2, 0x7fffffffffffffff); \
+    ASM_GEN(amomax.d x14, x2, (x1)); \
+  )
+
+  TEST_CASE( 5, x14, 0x7fffffffffffffff, \
+    ASM_GEN(la  x1, amo_operand); \
+    ASM_GEN(ld  x14, 0(x1)); \
+  )
+
+  //# rd == x0 still updates memory
+
+  TEST_CASE( 6, x14, 0x0000000000000001, \
+    ASM_GEN(la  x1, amo_operand); \
+    ASM_GEN(li  x15, 0xc000000000000000); \
+    ASM_GEN(sd  x15, 0(x1)); \
+    ASM_GEN(li  x2, 0x0000000000000001); \
+    ASM_GEN(amomax.d x0, x2, (x1)); \
+    ASM_GEN(ld  x14, 0(x1)); \
+  )
+
+  //# rd aliases rs2
+
+  TEST_CASE( 7, x2, 0xc000000000000000, \
+    ASM_GEN(la  x1, amo_operand); \
+    ASM_GEN(li  x15, 0xc000000000000000); \
+    ASM_GEN(sd  x15, 0(x1)); \
+    ASM_GEN(li  x2, 0x0000000000000001); \
+    ASM_GEN(amomax.d x2, x2, (x1)); \
+  )
+
+  TEST_CASE( 8, x14, 0x0000000000000001, \
+    ASM_GEN(la  x1, amo_operand); \
+    ASM_GEN(ld  x14, 0(x1)); \
+  )
+
+  //# rd aliases rs1
+
+  TEST_CASE( 9, x1, 0xc000000000000000, \
+    ASM_GEN(la  x1, amo_operand); \
+    ASM_GEN(li  x15, 0xc000000000000000); \
+    ASM_GEN(sd  x15, 0(x1)); \
+    ASM_GEN(li  x2, 0x0000000000000001); \
+    ASM_GEN(amomax.d x1, x2, (x1)); \
+  )
+
+  TEST_CASE( 10, x14, 0x0000000000000001, \
+    ASM_GEN(la  x3, amo_operand); \
+    ASM_GEN(ld  x14, 0(x3)); \
+  )
+
+
+  asm volatile(" bne x0, gp, pass;");
+asm volatile("pass:" );
+     asm volatile("j continue");
+
+asm volatile("fail:" );
+     assert(false);
+
+asm volatile("continue:");
+asm volatile("li ra, 0x0");
+
+  return 0;
+}
+
+  asm(".data");
+RVTEST_DATA_BEGIN
+  asm ("amo_operand:  .dword 0x0000000000000000");
+RVTEST_DATA_END
@@ -43,7 +43,7 @@ int main(int argc, char **argv){
   a = 3.14159265;
   b = 0.00000001;
   q = a + b;
-  assert( 3.1459265 == q );
+  assert( 3.14159265f == q );
 
   a = 2.5;
   b = 1.0;
@@ -59,7 +59,7 @@ int main(int argc, char **argv){
   a = 3.14159265;
   b = 0.00000001;
   q = a + b;
-  assert( 3.1459265 == q );
+  assert( 3.14159265f == q );
 
   a = 2.5;
   b = 1.0;
@@ -70,12 +70,12 @@ int main(int argc, char **argv){
   a = -1235.1;
   b = -1.1;
   q = a * b;
-  assert( 1358.61 == q );
+  assert( 1358.61f == q );
 
   a = 3.14159265;
   b = 0.00000001;
   q = a * b;
-  assert( 3.1459265e-8 == q );
+  assert( 3.14159265e-8f == q );
 
 
 //  TEST_FP_OP2_S( 2,  fadd.s, 0,                3.5,        2.5,        1.0 );
@@ -0,0 +1,75 @@
+/*
+ * fetch.c
+ *
+ * RISC-V ISA: instruction fetch
+ *
+ * Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <stdbool.h>
+#include "isa_test_macros.h"
+
+
+int main(int argc, char **argv){
+
+ // #-------------------------------------------------------------
+ // # Basic tests
+ // #-------------------------------------------------------------
+
+  //# code sharing a prefetch block with arbitrary data words still executes
+
+  TEST_CASE( 2, x14, 0x0000000000000003, \
+    ASM_GEN(li  x14, 0); \
+    ASM_GEN(j   1f); \
+    ASM_GEN(.balign 4); \
+    ASM_GEN(.word 0xdeadbeef); \
+    ASM_GEN(.word 0xdeadbeef); \
+    ASM_GEN(.word 0x00000000); \
+    ASM_GEN(.word 0xffffffff); \
+    ASM_GEN(1: addi x14, x14, 1); \
+    ASM_GEN(j   2f); \
+    ASM_GEN(.balign 4); \
+    ASM_GEN(.word 0xdeadbeef); \
+    ASM_GEN(2: addi x14, x14, 1); \
+    ASM_GEN(addi x14, x14, 1); \
+  )
+
+  //# a loop whose body shares its block with the same data words
+
+  TEST_CASE( 3, x14, 0x0000000000000040, \
+    ASM_GEN(li  x14, 0); \
+    ASM_GEN(li  x5, 64); \
+    ASM_GEN(j   2f); \
+    ASM_GEN(.balign 4); \
+    ASM_GEN(1: .word 0xdeadbeef); \
+    ASM_GEN(2: addi x14, x14, 1); \
+    ASM_GEN(addi x5, x5, -1); \
+    ASM_GEN(bnez x5, 2b); \
+  )
+
+  //# execution runs on past every stream, recycling the blocks that held the data words
+
+  TEST_CASE( 4, x14, 0x0000000000000100, \
+    ASM_GEN(li  x14, 0); \
+    ASM_GEN(.rept 256; addi x14, x14, 1; .endr); \
+  )
+
+  asm volatile(" bne x0, gp, pass;");
+asm volatile("pass:" );
+     asm volatile("j continue");
+
+asm volatile("fail:" );
+     assert(false);
+
+asm volatile("continue:");
+asm volatile("li ra, 0x0");
+
+  return 0;
+}
@@ -0,0 +1,38 @@
+/*
+ * isa_bench_loop.c
+ *
+ * Looped driver for the ISA benchmark mode; runs an ISA test body
+ * ISA_BENCH_LOOPS times.  The test is compiled with -Dmain=isa_test_main
+ * and -finstrument-functions; see the 'bench' target in the Makefile
+ *
+ * Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+
+#ifndef ISA_BENCH_LOOPS
+#define ISA_BENCH_LOOPS 100
+#endif
+
+int isa_test_main(int argc, char **argv);
+
+/*
+ * The test bodies clear ra before returning.  The instrumentation hooks
+ * make the test main a non-leaf function, so it reloads ra from its frame
+ * and returns here
+ */
+void __attribute__((no_instrument_function)) __cyg_profile_func_enter(void *fn, void *site){
+}
+
+void __attribute__((no_instrument_function)) __cyg_profile_func_exit(void *fn, void *site){
+}
+
+int main(int argc, char **argv){
+  for( volatile int i=0; i<ISA_BENCH_LOOPS; i++ ){
+    isa_test_main(argc, argv);
+  }
+  return 0;
+}
@@ -0,0 +1,177 @@
+/*
+ * lrsc_w.c
+ *
+ * RISC-V ISA: RV32A
+ *
+ * Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <stdbool.h>
+#include "isa_test_macros.h"
+
+
+int main(int argc, char **argv){
+
+ // #-------------------------------------------------------------
+ // # Basic tests
+ // #-------------------------------------------------------------
+
+  //# lr returns the sign extended value
+
+  TEST_CASE( 2, x14, 0xffffffff80000000, \
+    ASM_GEN(la  x1, amo_operand); \
+    ASM_GEN(li  x15, 0xffffffff80000000); \
+    ASM_GEN(sw  x15, 0(x1)); \
+    ASM_GEN(lr.w x14, (x1)); \
+  )
+
+  //# a store conditional after its reservation succeeds
+
+  TEST_CASE( 3, x14, 0x0000000000000000, \
+    ASM_GEN(la  x1, amo_operand); \
+    ASM_GEN(lr.w x3, (x1)); \
+    ASM_GEN(li  x2, 0x5a5a5a5a12345678); \
+    ASM_GEN(sc.w x14, x2, (x1)); \
+  )
+
+  TEST_CASE( 4, x14, 0x0000000012345678, \
+    ASM_GEN(la  x1, amo_operand); \
+    ASM_GEN(lw  x14, 0(x1)); \
+  )
+
+  //# the reservation is consumed; a second store conditional fails
+
+  TEST_CASE( 5, x14, 0x0000000000000001, \
+    ASM_GEN(la  x1, amo_operand); \
+    ASM_GEN(li  x2, 0x0000000000000077); \
+    ASM_GEN(sc.w x14, x2, (x1)); \
+  )
+
+  TEST_CASE( 6, x14, 0x0000000012345678, \
+    ASM_GEN(la  x1, amo_operand); \
+    ASM_GEN(lw  x14, 0(x1)); \
+  )
+
+  //# a store conditional to another address fails and ends the reservation
+
+  TEST_CASE( 7, x14, 0x0000000000000001, \
+    ASM_GEN(la  x1, amo_operand); \
+    ASM_GEN(lr.w x3, (x1)); \
+    ASM_GEN(la  x4, amo_other); \
+    ASM_GEN(li  x2, 0x0000000000000077); \
+    ASM_GEN(sc.w x14, x2, (x4)); \
+    ASM_GEN(sc.w x5, x2, (x1)); \
+    ASM_GEN(bne x5, x14, fail); \
+  )
+
+  TEST_CASE( 8, x14, 0x0000000012345678, \
+    ASM_GEN(la  x1, amo_operand); \
+    ASM_GEN(lw  x14, 0(x1)); \
+  )
+
+  //# a store between the lr and the sc breaks the reservation
+
+  TEST_CASE( 9, x14, 0x0000000000000001, \
+    ASM_GEN(la  x1, amo_operand); \
+    ASM_GEN(lr.w x3, (x1)); \
+    ASM_GEN(sw  x3, 0(x1)); \
+    ASM_GEN(li  x2, 0x0000000000000077); \
+    ASM_GEN(sc.w x14, x2, (x1)); \
+  )
+
+  //# rd == x0 still reserves and stores
+
+  TEST_CASE( 10, x14, 0x0000000000000077, \
+    ASM_GEN(la  x1, amo_operand); \
+    ASM_GEN(lr.w x0, (x1)); \
+    ASM_GEN(li  x2, 0x0000000000000077); \
+    ASM_GEN(sc.w x0, x2, (x1)); \
+    ASM_GEN(lw  x14, 0(x1)); \
+  )
+
+  //# lr rd aliases rs1
+
+  TEST_CASE( 11, x1, 0x0000000000000077, \
+    ASM_GEN(la  x1, amo_operand); \
+    ASM_GEN(lr.w x1, (x1)); \
+  )
+
+  TEST_CASE( 12, x14, 0x0000000000000000, \
+    ASM_GEN(la  x4, amo_operand); \
+    ASM_GEN(li  x2, 0x5a5a5a5a12345678); \
+    ASM_GEN(sc.w x14, x2, (x4)); \
+  )
+
+  //# sc rd aliases rs2
+
+  TEST_CASE( 13, x2, 0x0000000000000000, \
+    ASM_GEN(la  x1, amo_operand); \
+    ASM_GEN(li  x15, 0xffffffff80000000); \
+    ASM_GEN(sw  x15, 0(x1)); \
+    ASM_GEN(lr.w x3, (x1)); \
+    ASM_GEN(li  x2, 0x5a5a5a5a12345678); \
+    ASM_GEN(sc.w x2, x2, (x1)); \
+  )
+
+  TEST_CASE( 14, x14, 0x0000000012345678, \
+    ASM_GEN(la  x1, amo_operand); \
+    ASM_GEN(lw  x14, 0(x1)); \
+  )
+
+  //# sc rd aliases rs1
+
+  TEST_CASE( 15, x1, 0x0000000000000000, \
+    ASM_GEN(la  x1, amo_operand); \
+    ASM_GEN(li  x15, 0xffffffff80000000); \
+    ASM_GEN(sw  x15, 0(x1)); \
+    ASM_GEN(lr.w x3, (x1)); \
+    ASM_GEN(li  x2, 0x0000000000000077); \
+    ASM_GEN(sc.w x1, x2, (x1)); \
+  )
+
+  TEST_CASE( 16, x14, 0x0000000000000077, \
+    ASM_GEN(la  x3, amo_operand); \
+    ASM_GEN(lw  x14, 0(x3)); \
+  )
+
+  //# an lr/sc increment loop
+
+  TEST_CASE( 17, x14, 0x0000000000000040, \
+    ASM_GEN(la  x1, amo_operand); \
+    ASM_GEN(sw  x0, 0(x1)); \
+    ASM_GEN(li  x5, 64); \
+    ASM_GEN(1: lr.w x3, (x1)); \
+    ASM_GEN(addi x3, x3, 1); \
+    ASM_GEN(sc.w x4, x3, (x1)); \
+    ASM_GEN(bnez x4, 1b); \
+    ASM_GEN(addi x5, x5, -1); \
+    ASM_GEN(bnez x5, 1b); \
+    ASM_GEN(lw  x14, 0(x1)); \
+  )
+
+
+  asm volatile(" bne x0, gp, pass;");
+asm volatile("pass:" );
+     asm volatile("j continue");
+
+asm volatile("fail:" );
+     assert(false);
+
+asm volatile("continue:");
+asm volatile("li ra, 0x0");
+
+  return 0;
+}
+
+  asm(".data");
+RVTEST_DATA_BEGIN
+  asm ("amo_operand:  .dword 0x0000000000000000");
+  asm ("amo_other:    .dword 0x0000000000000000");
+RVTEST_DATA_END
@@ -0,0 +1,68 @@
+/*
+ * rem.c
+ *
+ * RISC-V ISA: RV64M
+ *
+ * Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <stdbool.h>
+#include "isa_test_macros.h"
+
+int main(int argc, char **argv){
+
+ // #-------------------------------------------------------------
+ // # Arithmetic tests
+ // #-------------------------------------------------------------
+
+  TEST_RR_OP( 2, rem, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000 );
+  TEST_RR_OP( 3, rem, 0x0000000000000000, 0x0000000000000001, 0x0000000000000001 );
+  TEST_RR_OP( 4, rem, 0x0000000000000003, 0x0000000000000003, 0x0000000000000007 );
+  TEST_RR_OP( 5, rem, 0x0000000000000002, 0x0000000000000014, 0x0000000000000006 );
+  TEST_RR_OP( 6, rem, 0xfffffffffffffffe, 0xffffffffffffffec, 0x0000000000000006 );
+  TEST_RR_OP( 7, rem, 0x0000000000000002, 0x0000000000000014, 0xfffffffffffffffa );
+  TEST_RR_OP( 8, rem, 0xfffffffffffffffe, 0xffffffffffffffec, 0xfffffffffffffffa );
+  TEST_RR_OP( 9, rem, 0x0000000000000000, 0x8000000000000000, 0x0000000000000001 );
+  TEST_RR_OP( 10, rem, 0x0000000000000000, 0x8000000000000000, 0xffffffffffffffff );
+  TEST_RR_OP( 11, rem, 0x8000000000000000, 0x8000000000000000, 0x0000000000000000 );
+  TEST_RR_OP( 12, rem, 0x0000000000000001, 0x0000000000000001, 0x0000000000000000 );
+  TEST_RR_OP( 13, rem, 0x0000000000000000, 0xffffffff80000000, 0xffffffffffffffff );
+  TEST_RR_OP( 14, rem, 0x0000000000000000, 0x0000000080000000, 0xffffffffffffffff );
+  TEST_RR_OP( 15, rem, 0x0000000000000001, 0x000000007fffffff, 0x0000000000000003 );
+  TEST_RR_OP( 16, rem, 0x1e1e1e1e0000000d, 0x5a5a5a5a00000010, 0x3c3c3c3c00000003 );
+  TEST_RR_OP( 17, rem, 0xfffffffffffd642a, 0xaaaaaaaaaaaaaaab, 0x000000000002fe7d );
+  TEST_RR_OP( 18, rem, 0x000000000002fe7d, 0x000000000002fe7d, 0xaaaaaaaaaaaaaaab );
+  TEST_RR_OP( 19, rem, 0x0000000000000000, 0xffffffffffff8000, 0xffffffffffff8000 );
+  TEST_RR_OP( 20, rem, 0x0000000000000000, 0xffffffff80000000, 0xffffffff80000000 );
+  TEST_RR_OP( 21, rem, 0x0000000000000000, 0xffffffffffffffff, 0xffffffffffffffff );
+  TEST_RR_OP( 22, rem, 0x0000000000000000, 0x7fffffffffffffff, 0x7fffffffffffffff );
+  TEST_RR_OP( 23, rem, 0x0000000000000000, 0x8000000000000000, 0x8000000000000000 );
+  TEST_RR_OP( 24, rem, 0x0000000200000000, 0x0000000200000000, 0x0000000300000000 );
+  TEST_RR_OP( 25, rem, 0x00000000deadbeef, 0x00000000deadbeef, 0x0000000000000000 );
+
+  //-------------------------------------------------------------
+  // Source/Destination tests
+  //-------------------------------------------------------------
+  TEST_RR_SRC1_EQ_DEST( 26, rem, 0xfffffffffffffffe, 0xffffffffffffffec, 0x0000000000000006 );
+  TEST_RR_SRC2_EQ_DEST( 27, rem, 0x0000000000000002, 0x0000000000000014, 0xfffffffffffffffa );
+  TEST_RR_SRC12_EQ_DEST( 28, rem, 0x0000000000000000, 0xffffffffffffffec );
+
+  asm volatile(" bne x0, gp, pass;");
+asm volatile("pass:" );
+     asm volatile("j continue");
+
+asm volatile("fail:" );
+     assert(false);
+
+asm volatile("continue:");
+asm volatile("li ra, 0x0");
+
+  return 0;
+}
@@ -0,0 +1,50 @@
+#
+# Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+# All Rights Reserved
+# contact@tactcomplabs.com
+#
+# See LICENSE in the top level directory for licensing details
+#
+# rev-isa-bench.py
+#
+# Fixed configuration for the ISA benchmark mode; driven by scripts/isaBench.py
+#
+
+import os
+import sst
+import sys
+
+if len(sys.argv) != 2:
+    sys.stderr.write("Usage: You must pass the executable you wish to simulate using the '--model-options' option with sst")
+    raise SystemExit(1)
+
+# Define SST core options
+sst.setProgramOption("timebase", "1ps")
+
+# Tell SST what statistics handling we want
+sst.setStatisticLoadLevel(4)
+
+# Define the simulation components
+# The memory cost is fixed such that simulated cycles are deterministic
+comp_cpu = sst.Component("cpu", "revcpu.RevCPU")
+comp_cpu.addParams({
+	"verbose" : 0,                                # Verbosity
+        "numCores" : 1,                               # Number of cores
+	"clock" : "1.0GHz",                           # Clock
+        "memSize" : 1024*1024*1024,                   # Memory size in bytes
+        "machine" : "[0:RV64IMAFDC]",                 # Core:Config; RV64IMAFDC for core 0
+        "startAddr" : "[0:0x00000000]",               # Starting address for core 0
+        "memCost" : "[0:1:1]",                        # Memory loads require 1 cycle
+        "program" : os.getenv("REV_EXE", sys.argv[1]),  # Target executable
+        "selfProfile" : 1,                            # Report host time and MIPS at finish
+        "splash" : 0                                  # Display the splash message
+})
+comp_cpu.enableAllStatistics()
+
+sst.setStatisticOutput("sst.statOutputCSV", {
+    "filepath" : os.getenv("REV_ISA_BENCH_STATS", "isa_bench_stats.csv"),
+    "separator" : ","
+})
+sst.enableAllStatisticsForAllComponents()
+
+# EOF
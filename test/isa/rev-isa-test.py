@@ -24,6 +24,9 @@ sst.setStatisticLoadLevel(4)
 
 max_addr_gb = 1
 
+# REV_ISA_MEMH=1 runs the test through RevBasicMemCtrl and memHierarchy
+enable_memh = int(os.getenv("REV_ISA_MEMH", "0"))
+
 # Define the simulation components
 comp_cpu = sst.Component("cpu", "revcpu.RevCPU")
 comp_cpu.addParams({
@@ -35,10 +38,50 @@ comp_cpu.addParams({
         "startAddr" : "[0:0x00000000]",               # Starting address for core 0
         "memCost" : "[0:1:10]",                       # Memory loads required 1-10 cycles
         "program" : os.getenv("REV_EXE", sys.argv[1]),  # Target executable
+        "enable_memH" : enable_memh,                  # Enable memHierarchy support
         "splash" : 1                                  # Display the splash message
 })
 comp_cpu.enableAllStatistics()
 
+if enable_memh:
+    # the tests are linked at 0x80000000; memHierarchy sees virtual addresses
+    comp_lsq = comp_cpu.setSubComponent("memory", "revcpu.RevBasicMemCtrl")
+    comp_lsq.addParams({
+          "verbose"         : "5",
+          "clock"           : "1.0Ghz",
+          "max_loads"       : 16,
+          "max_stores"      : 16,
+          "max_flush"       : 16,
+          "max_llsc"        : 16,
+          "max_readlock"    : 16,
+          "max_writeunlock" : 16,
+          "max_custom"      : 16,
+          "ops_per_cycle"   : 16
+    })
+    comp_lsq.enableAllStatistics({"type":"sst.AccumulatorStatistic"})
+
+    iface = comp_lsq.setSubComponent("memIface", "memHierarchy.standardInterface")
+    iface.addParams({
+          "verbose" : 2
+    })
+
+    memctrl = sst.Component("memory", "memHierarchy.MemController")
+    memctrl.addParams({
+        "clock" : "1GHz",
+        "addr_range_start" : 0,
+        "addr_range_end" : 4*1024*1024*1024-1,
+        "backing" : "malloc"
+    })
+
+    memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+    memory.addParams({
+        "access_time" : "10ns",
+        "mem_size" : "4GB"
+    })
+
+    link_iface_mem = sst.Link("link_iface_mem")
+    link_iface_mem.connect( (iface, "port", "50ps"), (memctrl, "direct_link", "50ps") )
+
 sst.setStatisticOutput("sst.statOutputCSV")
 sst.enableAllStatisticsForAllComponents()
 
@@ -0,0 +1,131 @@
+/*
+ * rvc.c
+ *
+ * RISC-V ISA: RV64C
+ *
+ * Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <stdbool.h>
+#include "isa_test_macros.h"
+
+int main(int argc, char **argv){
+
+ // #-------------------------------------------------------------
+ // # Compressed arithmetic tests
+ // #-------------------------------------------------------------
+
+  TEST_CASE( 2, x10, 0x0000000000000008, \
+    ASM_GEN(c.li x10, 5); \
+    ASM_GEN(c.addi x10, 3); \
+  )
+  TEST_CASE( 3, x10, 0xfffffffffffffff0, \
+    ASM_GEN(c.li x10, -16); \
+  )
+  TEST_CASE( 4, x10, 0x0000000000001000, \
+    ASM_GEN(c.lui x10, 1); \
+  )
+  TEST_CASE( 5, x10, 0x000000000000000f, \
+    ASM_GEN(c.li x10, -1); \
+    ASM_GEN(c.srli x10, 60); \
+  )
+  TEST_CASE( 6, x10, 0xffffffffffffffff, \
+    ASM_GEN(c.li x10, -16); \
+    ASM_GEN(c.srai x10, 4); \
+  )
+  TEST_CASE( 7, x10, 0x0000000000000050, \
+    ASM_GEN(c.li x10, 5); \
+    ASM_GEN(c.slli x10, 4); \
+  )
+  TEST_CASE( 8, x10, 0x0000000000000005, \
+    ASM_GEN(c.li x10, 13); \
+    ASM_GEN(c.andi x10, 7); \
+  )
+  TEST_CASE( 9, x11, 0x0000000000000007, \
+    ASM_GEN(c.li x11, 12); \
+    ASM_GEN(c.li x12, 5); \
+    ASM_GEN(c.sub x11, x12); \
+  )
+  TEST_CASE( 10, x11, 0x0000000000000009, \
+    ASM_GEN(c.li x11, 12); \
+    ASM_GEN(c.li x12, 5); \
+    ASM_GEN(c.xor x11, x12); \
+  )
+  TEST_CASE( 11, x11, 0x000000000000000d, \
+    ASM_GEN(c.li x11, 12); \
+    ASM_GEN(c.li x12, 5); \
+    ASM_GEN(c.or x11, x12); \
+  )
+  TEST_CASE( 12, x11, 0x0000000000000004, \
+    ASM_GEN(c.li x11, 12); \
+    ASM_GEN(c.li x12, 5); \
+    ASM_GEN(c.and x11, x12); \
+  )
+  TEST_CASE( 13, x11, 0xffffffff80000000, \
+    ASM_GEN_MASK(x11, 0x7fffffff); \
+    ASM_GEN(c.li x12, 1); \
+    ASM_GEN(c.addw x11, x12); \
+  )
+  TEST_CASE( 14, x11, 0x000000007fffffff, \
+    ASM_GEN_MASK(x11, 0xffffffff80000000); \
+    ASM_GEN(c.li x12, 1); \
+    ASM_GEN(c.subw x11, x12); \
+  )
+  TEST_CASE( 15, x10, 0xffffffff80000000, \
+    ASM_GEN_MASK(x10, 0x7fffffff); \
+    ASM_GEN(c.addiw x10, 1); \
+  )
+  TEST_CASE( 16, x13, 0x0000000000000011, \
+    ASM_GEN(c.li x10, 6); \
+    ASM_GEN(c.li x13, 11); \
+    ASM_GEN(c.add x13, x10); \
+  )
+  TEST_CASE( 17, x13, 0x0000000000000006, \
+    ASM_GEN(c.li x10, 6); \
+    ASM_GEN(c.mv x13, x10); \
+  )
+
+ // #-------------------------------------------------------------
+ // # Compressed control flow tests
+ // #-------------------------------------------------------------
+
+  TEST_CASE( 18, x11, 0x0000000000000001, \
+    ASM_GEN(c.li x10, 0); \
+    ASM_GEN(c.li x11, 1); \
+    ASM_GEN(c.beqz x10, 1f); \
+    ASM_GEN(c.li x11, 2); \
+    ASM_GEN(1:); \
+  )
+  TEST_CASE( 19, x11, 0x0000000000000001, \
+    ASM_GEN(c.li x10, 3); \
+    ASM_GEN(c.li x11, 1); \
+    ASM_GEN(c.bnez x10, 1f); \
+    ASM_GEN(c.li x11, 2); \
+    ASM_GEN(1:); \
+  )
+  TEST_CASE( 20, x11, 0x0000000000000001, \
+    ASM_GEN(c.li x11, 1); \
+    ASM_GEN(c.j 1f); \
+    ASM_GEN(c.li x11, 2); \
+    ASM_GEN(1:); \
+  )
+
+asm volatile(" bne x0, gp, pass;");
+asm volatile("pass:" );
+     asm volatile("j continue");
+
+asm volatile("fail:" );
+     assert(false);
+
+asm volatile("continue:");
+asm volatile("li ra, 0x0");
+
+  return 0;
+}
@@ -0,0 +1,39 @@
+#
+# Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+# All Rights Reserved
+# contact@tactcomplabs.com
+#
+# See LICENSE in the top level directory for licensing details
+#
+# rev-many-core-scale.py
+#
+# Many-core scaling configuration; driven by scripts/manyCoreScale.py
+# with the number of cores in REV_CORES
+#
+
+import os
+import sst
+
+NUM_CORES = int(os.getenv("REV_CORES", "1"))
+
+# Define SST core options
+sst.setProgramOption("timebase", "1ps")
+
+# Define the simulation components
+# The memory cost is fixed such that simulated cycles are deterministic
+comp_cpu = sst.Component("cpu", "revcpu.RevCPU")
+comp_cpu.addParams({
+	"verbose" : 0,                                # Verbosity
+        "numCores" : NUM_CORES,                       # Number of cores
+	"clock" : "1.0GHz",                           # Clock
+        "memSize" : 1024*1024*1024,                   # Memory size in bytes
+        "machine" : "[CORES:RV64G]",                  # Core:Config; RV64G for all cores
+        "startAddr" : "[CORES:0x00000000]",           # Starting address for all cores
+        "memCost" : ",".join("[%d:1:1]" % i for i in range(NUM_CORES)),  # Memory loads require 1 cycle
+        "program" : os.getenv("REV_EXE", "many_core.exe"),  # Target executable
+        "selfProfile" : 1,                            # Report construction and host time at finish
+        "selfProfileSample" : 1024,                   # Keep the per-core sampling overhead low
+        "splash" : 0                                  # Display the splash message
+})
+
+# EOF
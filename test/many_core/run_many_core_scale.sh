@@ -0,0 +1,18 @@
+#!/bin/bash
+
+#Build the test
+make
+
+# Check that the exec was built...
+if [ -f many_core.exe ]; then
+  # the full sweep to 4096 cores is run by hand; keep the test suite to 256
+  if python3 ../../scripts/manyCoreScale.py -c 1 16 256 -o many_core_scale.json --log many_core_scale.log; then
+    cat many_core_scale.log
+  else
+    echo "Test MANY_CORE_SCALE: scaling check failed"
+    exit 1
+  fi
+else
+  echo "Test MANY_CORE_SCALE: many_core.exe not Found - likely build failed"
+  exit 1
+fi
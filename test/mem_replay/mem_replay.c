@@ -0,0 +1,33 @@
+/*
+ * mem_replay.c
+ *
+ * RISC-V ISA: RV64IMAFD
+ *
+ * Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+
+#include <stdlib.h>
+
+#define assert(x) if (!(x)) { asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); }
+
+long data[256];
+long counter;
+
+int main(int argc, char **argv){
+  long sum = 0;
+
+  for( long i=0; i<256; i++ ){
+    data[i] = i;
+  }
+  for( long i=0; i<256; i+=8 ){
+    sum += data[i];
+    __atomic_fetch_add(&counter, 1, __ATOMIC_RELAXED);
+  }
+  assert(sum == 3968);
+  return 0;
+}
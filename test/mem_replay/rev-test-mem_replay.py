@@ -0,0 +1,69 @@
+#
+# Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+# All Rights Reserved
+# contact@tactcomplabs.com
+#
+# See LICENSE in the top level directory for licensing details
+#
+# rev-test-mem_replay.py
+#
+
+import os
+import sst
+
+VERBOSE = 2
+MEM_SIZE = 1024*1024*1024-1
+
+# Replay the recorded accesses without executing the program
+comp_replay = sst.Component("replay", "revcpu.RevMemReplay")
+comp_replay.addParams({
+	"verbose" : 1,                                # Verbosity
+	"clock" : "1.0GHz",                           # Clock
+        "trace" : "mem_replay.mtr",                   # Trace written by rev-test-mem_replay-record.py
+        "timing" : 1,                                 # Preserve the recorded gaps
+        "maxOutstanding" : 8                          # Outstanding accesses per hart
+})
+comp_replay.enableAllStatistics()
+
+# Create the RevMemCtrl subcomponent
+comp_lsq = comp_replay.setSubComponent("memory", "revcpu.RevBasicMemCtrl");
+comp_lsq.addParams({
+      "verbose"         : "0",
+      "clock"           : "1.0Ghz",
+      "max_loads"       : 16,
+      "max_stores"      : 16,
+      "max_flush"       : 16,
+      "max_llsc"        : 16,
+      "max_readlock"    : 16,
+      "max_writeunlock" : 16,
+      "max_custom"      : 16,
+      "ops_per_cycle"   : 16
+})
+comp_lsq.enableAllStatistics({"type":"sst.AccumulatorStatistic"})
+
+iface = comp_lsq.setSubComponent("memIface", "memHierarchy.standardInterface")
+iface.addParams({
+      "verbose" : VERBOSE
+})
+
+memctrl = sst.Component("memory", "memHierarchy.MemController")
+memctrl.addParams({
+    "clock" : "1GHz",
+    "verbose" : VERBOSE,
+    "addr_range_start" : 0,
+    "addr_range_end" : MEM_SIZE,
+    "backing" : "malloc"
+})
+
+memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+memory.addParams({
+    "access_time" : "100ns",
+    "mem_size" : "8GB"
+})
+
+link_iface_mem = sst.Link("link_iface_mem")
+link_iface_mem.connect( (iface, "port", "50ps"), (memctrl, "direct_link", "50ps") )
+
+sst.setStatisticOutput("sst.statOutputCSV")
+
+# EOF
@@ -0,0 +1,25 @@
+#!/bin/bash
+
+#Build the test
+make
+
+# Check that the exec was built...
+if [ -f mem_replay.exe ]; then
+  rm -f mem_replay.mtr
+  sst ./rev-test-mem_replay-record.py > mem_replay-record.log 2>&1
+  if [ ! -s mem_replay.mtr ]; then
+    echo "Test MEM_REPLAY: mem_replay.mtr was not recorded"
+    exit 1
+  fi
+  # replay the recorded accesses into RevBasicMemCtrl
+  sst ./rev-test-mem_replay.py > mem_replay.log 2>&1
+  if grep -q "Replayed [1-9][0-9]* accesses" mem_replay.log; then
+    cat mem_replay.log
+  else
+    echo "Test MEM_REPLAY: no accesses were replayed"
+    exit 1
+  fi
+else
+  echo "Test MEM_REPLAY: mem_replay.exe not Found - likely build failed"
+  exit 1
+fi
@@ -0,0 +1,125 @@
+/*
+ * merge.c
+ *
+ * RISC-V ISA: RV32IA
+ *
+ * Exercises the RevBasicMemCtrl line merging and store to load
+ * forwarding through memHierarchy.  Every core stores bytes to its
+ * own cache line and reads them back, loads sign extended values of
+ * a word still waiting in the store queue and interleaves reads and
+ * writes on one line; all of the cores then read a shared line at
+ * once such that their loads coalesce.  A wrong value executes an
+ * illegal instruction.
+ *
+ * Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+
+#include <stdint.h>
+
+#define NCORES 4
+
+#define assert(x) if (!(x)) { asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); }
+
+static volatile uint8_t line[NCORES][64] __attribute__((aligned(64))) = {
+  [0 ... NCORES-1] = { [32] = 0x44, 0x33, 0x22, 0x11, 0x88, 0x77, 0x66, 0x55 }
+};
+
+static volatile uint8_t shared[64] __attribute__((aligned(64))) = {
+  0x01, 0x82, 0x03, 0x84
+};
+
+uint32_t merge_ticket = 0;
+
+// Every core starts at main with the same stack pointer; draw the
+// core rank from a shared ticket, give each core its own 4KB of stack
+// and run merge(rank).  Returning to address zero retires the core.
+asm("  .text\n"
+    "  .align 2\n"
+    "  .globl main\n"
+    "  .type main, @function\n"
+    "main:\n"
+    "  la    t1, merge_ticket\n"
+    "  li    t0, 1\n"
+    "  amoadd.w a0, t0, (t1)\n"
+    "  slli  t0, a0, 12\n"
+    "  sub   sp, sp, t0\n"
+    "  andi  sp, sp, -16\n"
+    "  call  merge\n"
+    "  li    ra, 0\n"
+    "  ret\n"
+    "  .size main, .-main\n");
+
+void merge(int rank){
+  uint32_t b0, b1, b2, b3, w0;
+  int32_t sb, sh, sw;
+  uint32_t r0, r1, r2, r3;
+  volatile uint8_t *p = line[rank];
+
+  // byte stores to one line coalesce into a single write; the
+  // loads that follow are forwarded from it
+  asm volatile("li   t0, 0x81;"
+               "sb   t0, 0(%5);"
+               "li   t0, 0x42;"
+               "sb   t0, 1(%5);"
+               "li   t0, 0xc3;"
+               "sb   t0, 2(%5);"
+               "li   t0, 0x24;"
+               "sb   t0, 3(%5);"
+               "lbu  %0, 0(%5);"
+               "lbu  %1, 1(%5);"
+               "lbu  %2, 2(%5);"
+               "lbu  %3, 3(%5);"
+               "lw   %4, 0(%5);"
+               : "=&r"(b0), "=&r"(b1), "=&r"(b2), "=&r"(b3), "=&r"(w0)
+               : "r"(p) : "t0", "memory");
+  assert(b0 == 0x81);
+  assert(b1 == 0x42);
+  assert(b2 == 0xc3);
+  assert(b3 == 0x24);
+  assert(w0 == 0x24c34281);
+
+  // sign extended loads of a word still waiting in the store queue
+  asm volatile("li   t0, 0x80ff80f0;"
+               "sw   t0, 16(%3);"
+               "lb   %0, 16(%3);"
+               "lh   %1, 18(%3);"
+               "lw   %2, 16(%3);"
+               : "=&r"(sb), "=&r"(sh), "=&r"(sw)
+               : "r"(p) : "t0", "memory");
+  assert(sb == -16);
+  assert(sh == (int32_t)0xffff80ff);
+  assert(sw == (int32_t)0x80ff80f0);
+
+  // a write between two reads of the same line must not be
+  // observed by the older read nor bypassed by the younger one
+  asm volatile("lw   %0, 32(%4);"
+               "li   t0, 0x5a5a5a5a;"
+               "sw   t0, 32(%4);"
+               "lw   %1, 32(%4);"
+               "lw   %2, 36(%4);"
+               "lhu  %3, 34(%4);"
+               : "=&r"(r0), "=&r"(r1), "=&r"(r2), "=&r"(r3)
+               : "r"(p) : "t0", "memory");
+  assert(r0 == 0x11223344);
+  assert(r1 == 0x5a5a5a5a);
+  assert(r2 == 0x55667788);
+  assert(r3 == 0x5a5a);
+
+  // the cores read the shared line together; their loads queue
+  // behind one another and merge into a single line read
+  asm volatile("lb   %0, 0(%4);"
+               "lb   %1, 1(%4);"
+               "lbu  %2, 2(%4);"
+               "lbu  %3, 3(%4);"
+               : "=&r"(r0), "=&r"(r1), "=&r"(r2), "=&r"(r3)
+               : "r"(shared) : "memory");
+  assert(r0 == 0x01);
+  assert(r1 == 0xffffff82);
+  assert(r2 == 0x03);
+  assert(r3 == 0x84);
+}
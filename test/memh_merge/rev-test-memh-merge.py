@@ -0,0 +1,104 @@
+#
+# Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+# All Rights Reserved
+# contact@tactcomplabs.com
+#
+# See LICENSE in the top level directory for licensing details
+#
+# rev-test-memh-merge.py
+#
+# Four cores behind one RevBasicMemCtrl and an L1 cache; the controller
+# issues a single load and store per cycle such that same line requests
+# queue up long enough to be merged or forwarded
+#
+
+import os
+import sst
+
+NUM_CORES = 4
+MEM_SIZE = 1024*1024*1024-1
+
+# Define SST core options
+sst.setProgramOption("timebase", "1ps")
+
+# Tell SST what statistics handling we want
+sst.setStatisticLoadLevel(4)
+
+# Define the simulation components
+comp_cpu = sst.Component("cpu", "revcpu.RevCPU")
+comp_cpu.addParams({
+	"verbose" : 0,                                # Verbosity
+        "numCores" : NUM_CORES,                       # Number of cores
+	"clock" : "1.0GHz",                           # Clock
+        "memSize" : MEM_SIZE,                         # Memory size in bytes
+        "machine" : "[CORES:RV32IA]",                 # Core:Config; RV32IA for all cores
+        "startAddr" : "[CORES:0x00000000]",           # Starting address for all cores
+        "memCost" : ",".join("[%d:1:1]" % i for i in range(NUM_CORES)),  # Memory loads require 1 cycle
+        "program" : os.getenv("REV_EXE", "merge.exe"),  # Target executable
+        "enable_memH" : 1,                            # Enable memHierarchy support
+        "splash" : 1                                  # Display the splash message
+})
+comp_cpu.enableAllStatistics()
+
+# Create the RevMemCtrl subcomponent
+comp_lsq = comp_cpu.setSubComponent("memory", "revcpu.RevBasicMemCtrl");
+comp_lsq.addParams({
+      "verbose"         : "0",
+      "clock"           : "1.0Ghz",
+      "max_loads"       : 1,
+      "max_stores"      : 1,
+      "max_flush"       : 16,
+      "max_llsc"        : 16,
+      "max_readlock"    : 16,
+      "max_writeunlock" : 16,
+      "max_custom"      : 16,
+      "ops_per_cycle"   : 16
+})
+comp_lsq.enableAllStatistics({"type":"sst.AccumulatorStatistic"})
+
+iface = comp_lsq.setSubComponent("memIface", "memHierarchy.standardInterface")
+iface.addParams({
+      "verbose" : 0
+})
+
+# Merging requires a cache line size from the memory interface
+l1cache = sst.Component("l1cache", "memHierarchy.Cache")
+l1cache.addParams({
+    "access_latency_cycles" : "4",
+    "cache_frequency" : "1 Ghz",
+    "replacement_policy" : "lru",
+    "coherence_protocol" : "MESI",
+    "associativity" : "8",
+    "cache_line_size" : "64",
+    "L1" : "1",
+    "cache_size" : "16KiB"
+})
+
+memctrl = sst.Component("memory", "memHierarchy.MemController")
+memctrl.addParams({
+    "debug" : 0,
+    "clock" : "1GHz",
+    "verbose" : 0,
+    "addr_range_start" : 0,
+    "addr_range_end" : MEM_SIZE,
+    "backing" : "malloc"
+})
+
+memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+memory.addParams({
+    "access_time" : "100ns",
+    "mem_size" : "8GB"
+})
+
+link_cpu_l1 = sst.Link("link_cpu_l1")
+link_cpu_l1.connect( (iface, "port", "50ps"), (l1cache, "high_network_0", "50ps") )
+link_l1_mem = sst.Link("link_l1_mem")
+link_l1_mem.connect( (l1cache, "low_network_0", "50ps"), (memctrl, "direct_link", "50ps") )
+
+sst.setStatisticOutput("sst.statOutputCSV", {
+    "filepath" : "merge_stats.csv",
+    "separator" : ","
+})
+sst.enableAllStatisticsForAllComponents()
+
+# EOF
@@ -0,0 +1,47 @@
+#!/bin/bash
+
+#Build the test
+make
+
+# Check that the exec was built...
+if [ -f merge.exe ]; then
+  rm -f merge_stats.csv
+  sst ./rev-test-memh-merge.py > merge.log 2>&1
+
+  # a wrong value executes an illegal instruction and stops the simulation
+  if ! grep -q "Simulation is complete" merge.log; then
+    cat merge.log
+    echo "Test MEMH_MERGE: a load returned the wrong value"
+    exit 1
+  fi
+
+  # memory controller totals from the CSV statistics
+  stat(){
+    awk -F', *' -v Name="$1" '
+      NR==1 { for(i=1;i<=NF;i++){ if($i=="StatisticName") n=i; if($i=="Sum.u64") v=i } next }
+      $n==Name { t+=$v }
+      END { print t+0 }' merge_stats.csv
+  }
+  RMERGE=$(stat ReadsMerged)
+  WMERGE=$(stat WritesMerged)
+  FWD=$(stat LoadsForwarded)
+  echo "Test MEMH_MERGE: reads merged=$RMERGE writes merged=$WMERGE loads forwarded=$FWD"
+
+  # the byte stores to each core's line coalesce, the loads behind
+  # them forward from the queued write and the cores' loads of the
+  # shared line merge into one line read
+  if [ "$WMERGE" -eq 0 ]; then
+    echo "Test MEMH_MERGE: no writes were merged"
+    exit 1
+  elif [ "$FWD" -eq 0 ]; then
+    echo "Test MEMH_MERGE: no loads were forwarded"
+    exit 1
+  elif [ "$RMERGE" -eq 0 ]; then
+    echo "Test MEMH_MERGE: no reads were merged"
+    exit 1
+  fi
+  cat merge.log
+else
+  echo "Test MEMH_MERGE: merge.exe not Found - likely build failed"
+  exit 1
+fi
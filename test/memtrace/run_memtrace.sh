@@ -0,0 +1,21 @@
+#!/bin/bash
+
+#Build the test
+make
+
+# Check that the exec was built...
+if [ -f memtrace.exe ]; then
+  rm -f memtrace.mtr memtrace.txt
+  sst ./rev-test-memtrace.py > memtrace.log 2>&1
+  # the trace must export the loads, stores and atomics of the program
+  python3 ../../scripts/memTrace.py -t memtrace.mtr -f text -o memtrace.txt
+  if grep -q " R$" memtrace.txt && grep -q " W$" memtrace.txt && grep -q " AW$" memtrace.txt; then
+    cat memtrace.log
+  else
+    echo "Test MEMTRACE: loads, stores or atomics missing from memtrace.txt"
+    exit 1
+  fi
+else
+  echo "Test MEMTRACE: memtrace.exe not Found - likely build failed"
+  exit 1
+fi
@@ -0,0 +1,44 @@
+/*
+ * profile.c
+ *
+ * RISC-V ISA: RV64IMAFD
+ *
+ * Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+
+#include <stdlib.h>
+
+#define assert(x) if (!(x)) { asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); }
+
+__attribute__((noinline)) long leaf(long x){
+  long r = 0;
+  for( long i=0; i<x; i++ ){
+    r += i * x;
+  }
+  return r;
+}
+
+__attribute__((noinline)) long middle(long x){
+  return leaf(x) + leaf(x+1);
+}
+
+__attribute__((noinline)) long fib(long n){
+  if( n < 2 )
+    return n;
+  return fib(n-1) + fib(n-2);
+}
+
+int main(int argc, char **argv){
+  long r = 0;
+  for( long i=0; i<8; i++ ){
+    r += middle(i);
+  }
+  assert(r == 868);
+  assert(fib(12) == 144);
+  return 0;
+}
@@ -0,0 +1,20 @@
+#!/bin/bash
+
+#Build the test
+make
+
+# Check that the exec was built...
+if [ -f profile.exe ]; then
+  rm -f profile.core0.prof profile.core0.folded
+  sst ./rev-test-profile.py > profile.log 2>&1
+  # the call stacks must nest the callees beneath main
+  if grep -q "main;middle;leaf " profile.core0.folded; then
+    cat profile.log
+  else
+    echo "Test PROFILE: call stacks not found in profile.core0.folded"
+    exit 1
+  fi
+else
+  echo "Test PROFILE: profile.exe not Found - likely build failed"
+  exit 1
+fi
@@ -0,0 +1,19 @@
+#!/bin/bash
+
+#Build the test
+make
+
+# Check that the exec was built...
+if [ -f self_profile.exe ]; then
+  sst ./rev-test-self_profile.py > self_profile.log 2>&1
+  # the final report must attribute host time to the execute phase
+  if grep -q "Self profile @ cycle" self_profile.log && grep -q "  execute " self_profile.log; then
+    cat self_profile.log
+  else
+    echo "Test SELF_PROFILE: no self profile report found in self_profile.log"
+    exit 1
+  fi
+else
+  echo "Test SELF_PROFILE: self_profile.exe not Found - likely build failed"
+  exit 1
+fi
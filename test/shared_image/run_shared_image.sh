@@ -0,0 +1,12 @@
+#!/bin/bash
+
+#Build the test
+make
+
+# Check that the exec was built...
+if [ -f shared_image.exe ]; then
+  sst ./rev-test-shared-image.py
+else
+  echo "Test SHARED_IMAGE: File shared_image.exe not found - likely build failed"
+  exit 1
+fi 
@@ -0,0 +1,31 @@
+/*
+ * shared_image.c
+ *
+ * RISC-V ISA: RV64I
+ *
+ * Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+
+#include <stdlib.h>
+
+#define assert(x) if (!(x)) { asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); }
+
+int table[16] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 };
+
+int main(int argc, char **argv){
+  int i;
+  int sum = 0;
+
+  // every component writes its private copy of the image
+  for( i=0; i<16; i++ ){
+    table[i] = table[i] * 2;
+    sum += table[i];
+  }
+  assert(sum == 272);
+  return 0;
+}
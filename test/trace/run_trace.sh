@@ -0,0 +1,21 @@
+#!/bin/bash
+
+#Build the test
+make
+
+# Check that the exec was built...
+if [ -f trace.exe ]; then
+  rm -f trace.core0.rtrc trace.core0.log
+  sst ./rev-test-trace.py > trace.log 2>&1
+  # the trace must convert back into a commit log with memory accesses
+  python3 ../../scripts/revTrace.py -t trace.core0.rtrc -o trace.core0.log
+  if grep -q " mem 0x" trace.core0.log; then
+    cat trace.log
+  else
+    echo "Test TRACE: no memory accesses found in trace.core0.log"
+    exit 1
+  fi
+else
+  echo "Test TRACE: trace.exe not Found - likely build failed"
+  exit 1
+fi
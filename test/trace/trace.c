@@ -0,0 +1,38 @@
+/*
+ * trace.c
+ *
+ * RISC-V ISA: RV64IMAFD
+ *
+ * Copyright (C) 2017-2023 Tactical Computing Laboratories, LLC
+ * All Rights Reserved
+ * contact@tactcomplabs.com
+ *
+ * See LICENSE in the top level directory for licensing details
+ *
+ */
+
+#include <stdlib.h>
+
+#define assert(x) if (!(x)) { asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); asm(".byte 0x00"); }
+
+long data[64];
+double fdata[16];
+
+int main(int argc, char **argv){
+  long sum = 0;
+  double fsum = 0.0;
+
+  for( long i=0; i<64; i++ ){
+    data[i] = i * 3;
+  }
+  for( long i=0; i<64; i++ ){
+    sum += data[i];
+  }
+  for( long i=0; i<16; i++ ){
+    fdata[i] = (double)(i) * 0.5;
+    fsum += fdata[i];
+  }
+  assert(sum == 6048);
+  assert(fsum == 60.0);
+  return 0;
+}